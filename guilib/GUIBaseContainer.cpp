@@ -59,13 +59,16 @@ CGUIBaseContainer::CGUIBaseContainer(int parentID, int controlID, float posX, fl
   m_layout = NULL;
   m_focusedLayout = NULL;
   m_cacheItems = preloadItems;
+  m_lastScrollOffset = 0;
+  m_lastOffset = 0;
+  m_lastCursor = 0;
 }
 
 CGUIBaseContainer::~CGUIBaseContainer(void)
 {
 }
 
-void CGUIBaseContainer::Render()
+void CGUIBaseContainer::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   ValidateOffset();
 
@@ -74,7 +77,7 @@ void CGUIBaseContainer::Render()
 
   if (!m_layout || !m_focusedLayout) return;
 
-  UpdateScrollOffset();
+  UpdateScrollOffset(currentTime);
 
   int offset = (int)floorf(m_scrollOffset / m_layout->Size(m_orientation));
 
@@ -85,6 +88,137 @@ void CGUIBaseContainer::Render()
   if ((int)m_items.size() > m_itemsPerPage + cacheBefore + cacheAfter)
     FreeMemory(CorrectOffset(offset - cacheBefore, 0), CorrectOffset(offset + m_itemsPerPage + 1 + cacheAfter, 0));
 
+  CPoint origin = CPoint(m_posX, m_posY) + m_renderOffset;
+  float pos = (m_orientation == VERTICAL) ? origin.y : origin.x;
+  float end = (m_orientation == VERTICAL) ? m_posY + m_height : m_posX + m_width;
+
+  // we offset our draw position to take into account scrolling and whether or not our focused
+  // item is offscreen "above" the list.
+  float drawOffset = (offset - cacheBefore) * m_layout->Size(m_orientation) - m_scrollOffset;
+  if (m_offset + m_cursor < offset)
+    drawOffset += m_focusedLayout->Size(m_orientation) - m_layout->Size(m_orientation);
+  pos += drawOffset;
+  end += cacheAfter * m_layout->Size(m_orientation);
+
+  float focusedPos = 0;
+  CGUIListItemPtr focusedItem;
+  int current = offset - cacheBefore;
+  while (pos < end && m_items.size())
+  {
+    int itemNo = CorrectOffset(current, 0);
+    if (itemNo >= (int)m_items.size())
+      break;
+    bool focused = (current == m_offset + m_cursor);
+    if (itemNo >= 0)
+    {
+      CGUIListItemPtr item = m_items[itemNo];
+      // process our item
+      if (focused)
+      {
+        focusedPos = pos;
+        focusedItem = item;
+      }
+      else
+      {
+        if (m_orientation == VERTICAL)
+          ProcessItem(origin.x, pos, item.get(), false, currentTime, dirtyregions);
+        else
+          ProcessItem(pos, origin.y, item.get(), false, currentTime, dirtyregions);
+      }
+    }
+    // increment our position
+    pos += focused ? m_focusedLayout->Size(m_orientation) : m_layout->Size(m_orientation);
+    current++;
+  }
+  // process focused item last, as it's rendered last
+  if (focusedItem)
+  {
+    if (m_orientation == VERTICAL)
+      ProcessItem(origin.x, focusedPos, focusedItem.get(), true, currentTime, dirtyregions);
+    else
+      ProcessItem(focusedPos, origin.y, focusedItem.get(), true, currentTime, dirtyregions);
+  }
+
+  UpdatePageControl(offset);
+
+  MarkDirtyIfMoved();
+}
+
+void CGUIBaseContainer::MarkDirtyIfMoved()
+{
+  if (m_scrollOffset != m_lastScrollOffset || m_offset != m_lastOffset || m_cursor != m_lastCursor ||
+      m_processedItems != m_lastProcessedItems)
+    MarkDirtyRegion();
+
+  m_lastScrollOffset = m_scrollOffset;
+  m_lastOffset = m_offset;
+  m_lastCursor = m_cursor;
+  m_lastProcessedItems.swap(m_processedItems);
+  m_processedItems.clear();
+}
+
+void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItem *item, bool focused, unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  if (!m_focusedLayout || !m_layout) return;
+
+  m_processedItems.push_back(item);
+
+  // set the origin, which the regions our items mark dirty take into account
+  g_graphicsContext.SetOrigin(posX, posY);
+
+  if (m_bInvalidated)
+    item->SetInvalid();
+  if (focused)
+  {
+    if (!item->GetFocusedLayout())
+    {
+      CGUIListItemLayout *layout = new CGUIListItemLayout(*m_focusedLayout);
+      item->SetFocusedLayout(layout);
+    }
+    if (item->GetFocusedLayout())
+    {
+      if (item != m_lastItem || !HasFocus())
+      {
+        item->GetFocusedLayout()->SetFocusedItem(0);
+      }
+      if (item != m_lastItem && HasFocus())
+      {
+        item->GetFocusedLayout()->ResetAnimation(ANIM_TYPE_UNFOCUS);
+        unsigned int subItem = 1;
+        if (m_lastItem && m_lastItem->GetFocusedLayout())
+          subItem = m_lastItem->GetFocusedLayout()->GetFocusedItem();
+        item->GetFocusedLayout()->SetFocusedItem(subItem ? subItem : 1);
+      }
+      item->GetFocusedLayout()->Process(item, m_parentID, currentTime, dirtyregions);
+    }
+    m_lastItem = item;
+  }
+  else
+  {
+    if (item->GetFocusedLayout())
+      item->GetFocusedLayout()->SetFocusedItem(0);  // focus is not set
+    if (!item->GetLayout())
+    {
+      CGUIListItemLayout *layout = new CGUIListItemLayout(*m_layout);
+      item->SetLayout(layout);
+    }
+    if (item->GetFocusedLayout() && item->GetFocusedLayout()->IsAnimating(ANIM_TYPE_UNFOCUS))
+      item->GetFocusedLayout()->Process(item, m_parentID, currentTime, dirtyregions);
+    else if (item->GetLayout())
+      item->GetLayout()->Process(item, m_parentID, currentTime, dirtyregions);
+  }
+  g_graphicsContext.RestoreOrigin();
+}
+
+void CGUIBaseContainer::Render()
+{
+  if (!m_layout || !m_focusedLayout) return;
+
+  int offset = (int)floorf(m_scrollOffset / m_layout->Size(m_orientation));
+
+  int cacheBefore, cacheAfter;
+  GetCacheOffsets(cacheBefore, cacheAfter);
+
   if (g_graphicsContext.SetClipRegion(m_posX, m_posY, m_width, m_height))
   {
     CPoint origin = CPoint(m_posX, m_posY) + m_renderOffset;
@@ -141,12 +275,9 @@ void CGUIBaseContainer::Render()
     g_graphicsContext.RestoreClipRegion();
   }
 
-  UpdatePageControl(offset);
-
   CGUIControl::Render();
 }
 
-
 void CGUIBaseContainer::RenderItem(float posX, float posY, CGUIListItem *item, bool focused)
 {
   if (!m_focusedLayout || !m_layout) return;
@@ -154,42 +285,14 @@ void CGUIBaseContainer::RenderItem(float posX, float posY, CGUIListItem *item, b
   // set the origin
   g_graphicsContext.SetOrigin(posX, posY);
 
-  if (m_bInvalidated)
-    item->SetInvalid();
+  // render the layout we processed
   if (focused)
   {
-    if (!item->GetFocusedLayout())
-    {
-      CGUIListItemLayout *layout = new CGUIListItemLayout(*m_focusedLayout);
-      item->SetFocusedLayout(layout);
-    }
     if (item->GetFocusedLayout())
-    {
-      if (item != m_lastItem || !HasFocus())
-      {
-        item->GetFocusedLayout()->SetFocusedItem(0);
-      }
-      if (item != m_lastItem && HasFocus())
-      {
-        item->GetFocusedLayout()->ResetAnimation(ANIM_TYPE_UNFOCUS);
-        unsigned int subItem = 1;
-        if (m_lastItem && m_lastItem->GetFocusedLayout())
-          subItem = m_lastItem->GetFocusedLayout()->GetFocusedItem();
-        item->GetFocusedLayout()->SetFocusedItem(subItem ? subItem : 1);
-      }
       item->GetFocusedLayout()->Render(item, m_parentID, m_renderTime);
-    }
-    m_lastItem = item;
   }
   else
   {
-    if (item->GetFocusedLayout())
-      item->GetFocusedLayout()->SetFocusedItem(0);  // focus is not set
-    if (!item->GetLayout())
-    {
-      CGUIListItemLayout *layout = new CGUIListItemLayout(*m_layout);
-      item->SetLayout(layout);
-    }
     if (item->GetFocusedLayout() && item->GetFocusedLayout()->IsAnimating(ANIM_TYPE_UNFOCUS))
       item->GetFocusedLayout()->Render(item, m_parentID, m_renderTime);
     else if (item->GetLayout())
@@ -677,15 +780,20 @@ void CGUIBaseContainer::ValidateOffset()
 {
 }
 
-void CGUIBaseContainer::DoRender(unsigned int currentTime)
+void CGUIBaseContainer::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
-  m_renderTime = currentTime;
-  CGUIControl::DoRender(currentTime);
+  CGUIControl::DoProcess(currentTime, dirtyregions);
   if (m_pageChangeTimer.GetElapsedMilliseconds() > 200)
     m_pageChangeTimer.Stop();
   m_wasReset = false;
 }
 
+void CGUIBaseContainer::DoRender(unsigned int currentTime)
+{
+  m_renderTime = currentTime;
+  CGUIControl::DoRender(currentTime);
+}
+
 void CGUIBaseContainer::AllocResources()
 {
   CalculateLayout();
@@ -862,9 +970,9 @@ void CGUIBaseContainer::SetContainerMoving(int direction)
     g_infoManager.SetContainerMoving(GetID(), direction > 0, m_scrollSpeed != 0);
 }
 
-void CGUIBaseContainer::UpdateScrollOffset()
+void CGUIBaseContainer::UpdateScrollOffset(unsigned int currentTime)
 {
-  m_scrollOffset += m_scrollSpeed * (m_renderTime - m_scrollLastTime);
+  m_scrollOffset += m_scrollSpeed * (currentTime - m_scrollLastTime);
   if ((m_scrollSpeed < 0 && m_scrollOffset < m_offset * m_layout->Size(m_orientation)) ||
       (m_scrollSpeed > 0 && m_scrollOffset > m_offset * m_layout->Size(m_orientation)))
   {
@@ -872,7 +980,7 @@ void CGUIBaseContainer::UpdateScrollOffset()
     m_scrollSpeed = 0;
     m_scrollTimer.Stop();
   }
-  m_scrollLastTime = m_renderTime;
+  m_scrollLastTime = currentTime;
 }
 
 int CGUIBaseContainer::CorrectOffset(int offset, int cursor) const
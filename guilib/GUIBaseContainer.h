@@ -67,6 +67,7 @@ public:
   virtual void SaveStates(std::vector<CControlState> &states);
   virtual int GetSelectedItem() const;
 
+  virtual void DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void DoRender(unsigned int currentTime);
   void LoadLayout(TiXmlElement *layout);
   void LoadContent(TiXmlElement *content);
@@ -96,6 +97,8 @@ public:
 protected:
   virtual EVENT_RESULT OnMouseEvent(const CPoint &point, const CMouseEvent &event);
   bool OnClick(int actionID);
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
+  virtual void ProcessItem(float posX, float posY, CGUIListItem *item, bool focused, unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
   virtual void RenderItem(float posX, float posY, CGUIListItem *item, bool focused);
   virtual void Scroll(int amount);
@@ -107,6 +110,13 @@ protected:
   virtual void SetPageControlRange();
   virtual void UpdatePageControl(int offset);
   virtual void CalculateLayout();
+
+  /*! \brief Mark ourselves dirty if we scrolled, moved our cursor or show other items than last frame.
+   Our items mark the regions they change themselves, but not the space they leave behind, so then all
+   of us is redrawn. Called at the end of Process(), once all items are processed.
+   */
+  void MarkDirtyIfMoved();
+
   virtual void SelectItem(int item) {};
   virtual bool SelectItemFromPoint(const CPoint &point) { return false; };
   virtual int GetCursorFromPoint(const CPoint &point, CPoint *itemPoint = NULL) const { return -1; };
@@ -147,7 +157,7 @@ protected:
 
   void ScrollToOffset(int offset);
   void SetContainerMoving(int direction);
-  void UpdateScrollOffset();
+  void UpdateScrollOffset(unsigned int currentTime);
 
   unsigned int m_scrollLastTime;
   int          m_scrollTime;
@@ -173,6 +183,11 @@ protected:
   void OnJumpLetter(char letter);
   void OnJumpSMS(int letter);
   std::vector< std::pair<int, CStdString> > m_letterOffsets;
+  float m_lastScrollOffset;                 ///< scroll offset as of the last frame, see MarkDirtyIfMoved()
+  int m_lastOffset;
+  int m_lastCursor;
+  std::vector<CGUIListItem*> m_processedItems;     ///< items processed this frame, in order
+  std::vector<CGUIListItem*> m_lastProcessedItems; ///< items processed last frame
 private:
   int m_cacheItems;
   float m_scrollSpeed;
@@ -40,6 +40,20 @@ CGUIBorderedImage::~CGUIBorderedImage(void)
 {
 }
 
+void CGUIBorderedImage::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  if (m_borderImage.IsChanging())
+    MarkDirtyRegion();
+  CGUIImage::Process(currentTime, dirtyregions);
+}
+
+CRect CGUIBorderedImage::CalcRenderRegion() const
+{
+  // our border is rendered outside of the image
+  CRect rect(m_posX - m_borderSize.x1, m_posY - m_borderSize.y1, m_posX + m_width + m_borderSize.x2, m_posY + m_height + m_borderSize.y2);
+  return g_graphicsContext.ScaleFinalRect(rect);
+}
+
 void CGUIBorderedImage::Render()
 {
   if (!m_borderImage.GetFileName().IsEmpty() && m_texture.ReadyToRender())
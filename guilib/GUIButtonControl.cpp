@@ -44,15 +44,16 @@ CGUIButtonControl::~CGUIButtonControl(void)
 {
 }
 
-void CGUIButtonControl::Render()
+void CGUIButtonControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
+  bool changed = false;
   if (m_bInvalidated)
   {
-    m_imgFocus.SetWidth(m_width);
-    m_imgFocus.SetHeight(m_height);
+    changed |= m_imgFocus.SetWidth(m_width);
+    changed |= m_imgFocus.SetHeight(m_height);
 
-    m_imgNoFocus.SetWidth(m_width);
-    m_imgNoFocus.SetHeight(m_height);
+    changed |= m_imgNoFocus.SetWidth(m_width);
+    changed |= m_imgNoFocus.SetHeight(m_height);
   }
 
   if (HasFocus())
@@ -68,17 +69,26 @@ void CGUIButtonControl::Render()
 
       alphaChannel += 192;
       alphaChannel = (unsigned int)((float)m_alpha * (float)alphaChannel / 255.0f);
-      m_imgFocus.SetAlpha((unsigned char)alphaChannel);
+      changed |= m_imgFocus.SetAlpha((unsigned char)alphaChannel);
     }
-    m_imgFocus.SetVisible(true);
-    m_imgNoFocus.SetVisible(false);
+    changed |= m_imgFocus.SetVisible(true);
+    changed |= m_imgNoFocus.SetVisible(false);
     m_focusCounter++;
   }
   else
   {
-    m_imgFocus.SetVisible(false);
-    m_imgNoFocus.SetVisible(true);
+    changed |= m_imgFocus.SetVisible(false);
+    changed |= m_imgNoFocus.SetVisible(true);
   }
+
+  if (changed || m_imgFocus.IsChanging() || m_imgNoFocus.IsChanging())
+    MarkDirtyRegion();
+
+  ProcessText();
+}
+
+void CGUIButtonControl::Render()
+{
   // render both so the visibility settings cause the frame counter to resetcorrectly
   m_imgFocus.Render();
   m_imgNoFocus.Render();
@@ -96,27 +106,37 @@ CGUILabel::COLOR CGUIButtonControl::GetTextColor() const
   return CGUILabel::COLOR_TEXT;
 }
 
-void CGUIButtonControl::RenderText()
+void CGUIButtonControl::ProcessText()
 {
-  m_label.SetMaxRect(m_posX, m_posY, m_width, m_height);
-  m_label.SetText(m_info.GetLabel(m_parentID));
-  m_label.SetScrolling(HasFocus());
+  bool changed = m_label.SetMaxRect(m_posX, m_posY, m_width, m_height);
+  changed |= m_label.SetText(m_info.GetLabel(m_parentID));
+  changed |= m_label.SetScrolling(HasFocus());
+  changed |= m_label.SetColor(GetTextColor());
 
-  // render the second label if it exists
+  // update the second label if it exists
   CStdString label2(m_info2.GetLabel(m_parentID));
+  changed |= m_label2.SetText(label2);
   if (!label2.IsEmpty())
   {
-    m_label2.SetMaxRect(m_posX, m_posY, m_width, m_height);
-    m_label2.SetText(label2);
+    changed |= m_label2.SetMaxRect(m_posX, m_posY, m_width, m_height);
     m_label2.SetAlign(XBFONT_RIGHT | (m_label.GetLabelInfo().align & XBFONT_CENTER_Y) | XBFONT_TRUNCATED);
-    m_label2.SetScrolling(HasFocus());
+    changed |= m_label2.SetScrolling(HasFocus());
 
     CGUILabel::CheckAndCorrectOverlap(m_label, m_label2);
 
-    m_label2.SetColor(GetTextColor());
-    m_label2.Render();
+    changed |= m_label2.SetColor(GetTextColor());
   }
-  m_label.SetColor(GetTextColor());
+
+  // scrolling labels change every frame
+  if (changed || m_label.IsScrolling() || m_label2.IsScrolling())
+    MarkDirtyRegion();
+}
+
+void CGUIButtonControl::RenderText()
+{
+  // render the second label if it exists
+  if (m_label2.GetTextWidth() > 0)
+    m_label2.Render();
   m_label.Render();
 }
 
@@ -214,13 +234,14 @@ void CGUIButtonControl::SetPosition(float posX, float posY)
 void CGUIButtonControl::SetAlpha(unsigned char alpha)
 {
   m_alpha = alpha;
-  m_imgFocus.SetAlpha(alpha);
-  m_imgNoFocus.SetAlpha(alpha);
+  if (m_imgFocus.SetAlpha(alpha) | m_imgNoFocus.SetAlpha(alpha))
+    MarkDirtyRegion();
 }
 
 void CGUIButtonControl::UpdateColors()
 {
-  m_label.UpdateColors();
+  if (m_label.UpdateColors())
+    MarkDirtyRegion();
   CGUIControl::UpdateColors();
   m_imgFocus.SetDiffuseColor(m_diffuseColor);
   m_imgNoFocus.SetDiffuseColor(m_diffuseColor);
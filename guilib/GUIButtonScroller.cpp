@@ -308,7 +308,7 @@ void CGUIButtonScroller::SetInvalid()
   m_imgNoFocus.SetInvalid();
 }
 
-void CGUIButtonScroller::Render()
+void CGUIButtonScroller::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   if (m_bInvalidated)
   {
@@ -327,10 +327,6 @@ void CGUIButtonScroller::Render()
       m_posY = m_xmlPosY + (m_xmlHeight - m_height) * 0.5f;
     }
   }
-  float posX = m_posX;
-  float posY = m_posY;
-  // set our viewport
-  g_graphicsContext.SetClipRegion(posX, posY, m_width, m_height);
   // if we're scrolling, update our scroll offset
   if (m_bScrollUp || m_bScrollDown)
   {
@@ -357,22 +353,58 @@ void CGUIButtonScroller::Render()
       m_bScrollUp = false;
       m_bScrollDown = false;
     }
-    else
+  }
+  // and if we're moving up or down, update our focus position
+  if (HasFocus() && (m_bMoveUp || m_bMoveDown))
+  {
+    float maxScroll = m_bHorizontal ? m_imgFocus.GetWidth() : m_imgFocus.GetHeight();
+    maxScroll += m_buttonGap;
+    m_scrollOffset += maxScroll / SCROLL_SPEED + 1;
+    if (m_scrollOffset > maxScroll || !m_bSmoothScrolling)
     {
-      if (m_bScrollUp)
+      m_scrollOffset = 0;
+      if (m_bMoveUp)
       {
-        if (m_bHorizontal)
-          posX -= m_scrollOffset;
-        else
-          posY -= m_scrollOffset;
+        if (m_iCurrentSlot > 0)
+          m_iCurrentSlot--;
       }
       else
       {
-        if (m_bHorizontal)
-          posX += m_scrollOffset - maxScroll;
-        else
-          posY += m_scrollOffset - maxScroll;
+        if (m_iCurrentSlot + 1 < m_iNumSlots)
+          m_iCurrentSlot++;
       }
+      m_bMoveUp = false;
+      m_bMoveDown = false;
+    }
+  }
+  // our labels are info labels, so we redraw every frame
+  CGUIControl::Process(currentTime, dirtyregions);
+}
+
+void CGUIButtonScroller::Render()
+{
+  float posX = m_posX;
+  float posY = m_posY;
+  // set our viewport
+  g_graphicsContext.SetClipRegion(posX, posY, m_width, m_height);
+  // offset by our scroll position
+  if (m_bScrollUp || m_bScrollDown)
+  {
+    float maxScroll = m_bHorizontal ? m_imgFocus.GetWidth() : m_imgFocus.GetHeight();
+    maxScroll += m_buttonGap;
+    if (m_bScrollUp)
+    {
+      if (m_bHorizontal)
+        posX -= m_scrollOffset;
+      else
+        posY -= m_scrollOffset;
+    }
+    else
+    {
+      if (m_bHorizontal)
+        posX += m_scrollOffset - maxScroll;
+      else
+        posY += m_scrollOffset - maxScroll;
     }
   }
   float posX3 = posX;
@@ -396,44 +428,19 @@ void CGUIButtonScroller::Render()
     posX = m_posX;
     posY = m_posY;
     // check if we're moving up or down
-    if (m_bMoveUp || m_bMoveDown)
+    if (m_bMoveUp)
     {
-      float maxScroll = m_bHorizontal ? m_imgFocus.GetWidth() : m_imgFocus.GetHeight();
-      maxScroll += m_buttonGap;
-      m_scrollOffset += maxScroll / SCROLL_SPEED + 1;
-      if (m_scrollOffset > maxScroll || !m_bSmoothScrolling)
-      {
-        m_scrollOffset = 0;
-        if (m_bMoveUp)
-        {
-          if (m_iCurrentSlot > 0)
-            m_iCurrentSlot--;
-        }
-        else
-        {
-          if (m_iCurrentSlot + 1 < m_iNumSlots)
-            m_iCurrentSlot++;
-        }
-        m_bMoveUp = false;
-        m_bMoveDown = false;
-      }
+      if (m_bHorizontal)
+        posX -= m_scrollOffset;
       else
-      {
-        if (m_bMoveUp)
-        {
-          if (m_bHorizontal)
-            posX -= m_scrollOffset;
-          else
-            posY -= m_scrollOffset;
-        }
-        else
-        {
-          if (m_bHorizontal)
-            posX += m_scrollOffset;
-          else
-            posY += m_scrollOffset;
-        }
-      }
+        posY -= m_scrollOffset;
+    }
+    else if (m_bMoveDown)
+    {
+      if (m_bHorizontal)
+        posX += m_scrollOffset;
+      else
+        posY += m_scrollOffset;
     }
     if (m_bHorizontal)
       posX += m_iCurrentSlot * ((int)m_imgFocus.GetWidth() + m_buttonGap);
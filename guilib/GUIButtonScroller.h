@@ -66,6 +66,7 @@ public:
   virtual void OnRight();
   virtual void OnDown();
   virtual bool OnMouseOver(const CPoint &point);
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
   virtual void AllocResources();
   virtual void FreeResources(bool immediately = false);
@@ -41,9 +41,11 @@ CGUICheckMarkControl::CGUICheckMarkControl(int parentID, int controlID, float po
 CGUICheckMarkControl::~CGUICheckMarkControl(void)
 {}
 
-void CGUICheckMarkControl::Render()
+void CGUICheckMarkControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
-  m_label.SetText(m_strLabel);
+  bool changed = false;
+
+  changed |= m_label.SetText(m_strLabel);
 
   float textWidth = m_label.GetTextWidth();
   m_width = textWidth + 5 + m_imgCheckMark.GetWidth();
@@ -57,20 +59,24 @@ void CGUICheckMarkControl::Render()
   else
     checkMarkPosX += textWidth + 5;
 
-  m_label.SetMaxRect(textPosX, m_posY, textWidth, m_height);
-  m_label.SetColor(GetTextColor());
+  changed |= m_label.SetMaxRect(textPosX, m_posY, textWidth, m_height);
+  changed |= m_label.SetColor(GetTextColor());
+
+  changed |= m_imgCheckMark.SetPosition(checkMarkPosX, m_posY);
+  changed |= m_imgCheckMarkNoFocus.SetPosition(checkMarkPosX, m_posY);
+
+  if (changed || m_label.IsScrolling() || (m_bSelected ? m_imgCheckMark : m_imgCheckMarkNoFocus).IsChanging())
+    MarkDirtyRegion();
+}
+
+void CGUICheckMarkControl::Render()
+{
   m_label.Render();
 
   if (m_bSelected)
-  {
-    m_imgCheckMark.SetPosition(checkMarkPosX, m_posY);
     m_imgCheckMark.Render();
-  }
   else
-  {
-    m_imgCheckMarkNoFocus.SetPosition(checkMarkPosX, m_posY);
     m_imgCheckMarkNoFocus.Render();
-  }
   CGUIControl::Render();
 }
 
@@ -88,6 +94,7 @@ bool CGUICheckMarkControl::OnAction(const CAction &action)
   if (action.GetID() == ACTION_SELECT_ITEM)
   {
     m_bSelected = !m_bSelected;
+    MarkDirtyRegion();
     CGUIMessage msg(GUI_MSG_CLICKED, GetID(), GetParentID(), action.GetID());
     SendWindowMessage(msg);
     return true;
@@ -140,7 +147,11 @@ void CGUICheckMarkControl::SetInvalid()
 
 void CGUICheckMarkControl::SetSelected(bool bOnOff)
 {
-  m_bSelected = bOnOff;
+  if (m_bSelected != bOnOff)
+  {
+    m_bSelected = bOnOff;
+    MarkDirtyRegion();
+  }
 }
 
 bool CGUICheckMarkControl::GetSelected() const
@@ -61,6 +61,8 @@ CGUIControl::CGUIControl()
   m_hasCamera = false;
   m_pushedUpdates = false;
   m_pulseOnSelect = false;
+  m_controlIsDirty = true;
+  m_hasProcessed = false;
 }
 
 CGUIControl::CGUIControl(int parentID, int controlID, float posX, float posY, float width, float height)
@@ -94,6 +96,8 @@ CGUIControl::CGUIControl(int parentID, int controlID, float posX, float posY, fl
   m_hasCamera = false;
   m_pushedUpdates = false;
   m_pulseOnSelect = false;
+  m_controlIsDirty = true;
+  m_hasProcessed = false;
 }
 
 
@@ -132,13 +136,67 @@ void CGUIControl::DynamicResourceAlloc(bool bOnOff)
 
 }
 
-// the main render routine.
+// the main process routine.
 // 1. animate and set the animation transform
+// 2. if visible, process
+// 3. compare our region on screen with the last frame, and mark the regions dirty if we've changed
+// 4. reset the animation transform
+void CGUIControl::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  CRect lastRegion(m_renderRegion);
+
+  Animate(currentTime);
+  if (m_hasCamera)
+    g_graphicsContext.SetCameraPosition(m_camera);
+  if (IsVisible())
+  {
+    GUIPROFILER_PROCESS_BEGIN(this);
+    Process(currentTime, dirtyregions);
+    GUIPROFILER_PROCESS_END(this);
+    m_renderRegion = CalcRenderRegion();
+  }
+  else
+    m_renderRegion = CRect();
+  if (m_hasCamera)
+    g_graphicsContext.RestoreCameraPosition();
+  g_graphicsContext.RemoveTransform();
+
+  if (m_controlIsDirty || m_renderRegion != lastRegion)
+  {
+    if (!lastRegion.IsEmpty())
+      dirtyregions.push_back(lastRegion);
+    if (!m_renderRegion.IsEmpty() && m_renderRegion != lastRegion)
+      dirtyregions.push_back(m_renderRegion);
+    m_controlIsDirty = false;
+  }
+  m_hasProcessed = true;
+}
+
+void CGUIControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // we don't know whether we've changed, so we have to assume we have
+  MarkDirtyRegion();
+}
+
+CRect CGUIControl::CalcRenderRegion() const
+{
+  return g_graphicsContext.ScaleFinalRect(CRect(m_posX, m_posY, m_posX + m_width, m_posY + m_height));
+}
+
+// the main render routine.
+// 1. set the animation transform, processing the control first if it hasn't been
 // 2. if visible, paint
 // 3. reset the animation transform
 void CGUIControl::DoRender(unsigned int currentTime)
 {
-  Animate(currentTime);
+  if (!m_hasProcessed)
+  { // we're being rendered directly (eg as part of a list item layout) so haven't been processed yet
+    CDirtyRegionList dirtyregions;
+    DoProcess(currentTime, dirtyregions);
+  }
+  m_hasProcessed = false;
+
+  g_graphicsContext.AddTransform(m_transform);
   if (m_hasCamera)
     g_graphicsContext.SetCameraPosition(m_camera);
   if (IsVisible())
@@ -312,6 +370,8 @@ void CGUIControl::SetFocus(bool focus)
     QueueAnimation(ANIM_TYPE_UNFOCUS);
   else if (!m_bHasFocus && focus)
     QueueAnimation(ANIM_TYPE_FOCUS);
+  if (m_bHasFocus != focus)
+    MarkDirtyRegion();
   m_bHasFocus = focus;
 }
 
@@ -403,6 +463,8 @@ bool CGUIControl::IsDisabled() const
 
 void CGUIControl::SetEnabled(bool bEnable)
 {
+  if (m_enabled != bEnable)
+    MarkDirtyRegion();
   m_enabled = bEnable;
 }
 
@@ -562,7 +624,7 @@ void CGUIControl::UpdateVisibility(const CGUIListItem *item)
   // and check for conditional enabling - note this overrides SetEnabled() from the code currently
   // this may need to be reviewed at a later date
   if (m_enableCondition)
-    m_enabled = g_infoManager.GetBool(m_enableCondition, m_parentID, item);
+    SetEnabled(g_infoManager.GetBool(m_enableCondition, m_parentID, item));
   m_allowHiddenFocus.Update(m_parentID, item);
   UpdateColors();
   // and finally, update our control information (if not pushed)
@@ -572,7 +634,8 @@ void CGUIControl::UpdateVisibility(const CGUIListItem *item)
 
 void CGUIControl::UpdateColors()
 {
-  m_diffuseColor.Update();
+  if (m_diffuseColor.Update())
+    MarkDirtyRegion();
 }
 
 void CGUIControl::SetInitialVisibility()
@@ -766,7 +829,12 @@ void CGUIControl::Animate(unsigned int currentTime)
   for (unsigned int i = 0; i < m_animations.size(); i++)
   {
     CAnimation &anim = m_animations[i];
+    ANIMATION_PROCESS lastProcess = anim.GetProcess();
+    ANIMATION_STATE lastState = anim.GetState();
     anim.Animate(currentTime, HasRendered() || visible == DELAYED);
+    // we need redrawing whenever an animation is in progress or has just changed state
+    if (anim.GetState() == ANIM_STATE_IN_PROCESS || anim.GetState() != lastState || anim.GetProcess() != lastProcess)
+      MarkDirtyRegion();
     // Update the control states (such as visibility)
     UpdateStates(anim.GetType(), anim.GetProcess(), anim.GetState());
     // and render the animation effect
@@ -40,6 +40,12 @@ class CMouseEvent;
 
 enum ORIENTATION { HORIZONTAL = 0, VERTICAL };
 
+/*!
+ \brief List of regions of the screen (in screen coordinates) that need redrawing
+ \sa CGUIControl::DoProcess, CGUIWindowManager::ProcessWindows
+ */
+typedef std::vector<CRect> CDirtyRegionList;
+
 class CControlState
 {
 public:
@@ -75,10 +81,46 @@ public:
   virtual ~CGUIControl(void);
   virtual CGUIControl *Clone() const=0;
 
+  /*! \brief Update the control prior to rendering
+   Animates the control and, if visible, processes it, keeping track of the region of the screen the
+   control covers.  If the control has changed on screen, the regions it covered and now covers are added
+   to the dirty regions.  Controls that aren't processed prior to DoRender() are processed from there.
+   \param currentTime the time of the current frame
+   \param dirtyregions the list of regions to add the control's region to if it has changed
+   \sa Process, DoRender, MarkDirtyRegion
+   */
+  virtual void DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions);
+
+  /*! \brief Update the state of a visible control
+   Controls that can tell when they change on screen should override this and call MarkDirtyRegion()
+   when they do.  The default implementation marks the control dirty every frame, so that controls
+   which can't tell are always redrawn.
+   \param currentTime the time of the current frame
+   \param dirtyregions the list of dirty regions (used by groups to process their children)
+   \sa DoProcess, MarkDirtyRegion
+   */
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
+
   virtual void DoRender(unsigned int currentTime);
   virtual void Render();
   bool HasRendered() const { return m_hasRendered; };
 
+  /*! \brief Mark the control as needing to be redrawn on the next frame
+   \sa Process
+   */
+  void MarkDirtyRegion() { m_controlIsDirty = true; };
+
+  /*! \brief Compute the region of the screen the control renders to, given the current transform
+   \return the bounding rectangle of the control in screen coordinates
+   \sa GetRenderRegion
+   */
+  virtual CRect CalcRenderRegion() const;
+
+  /*! \brief Get the region of the screen the control rendered to when last processed
+   \sa CalcRenderRegion
+   */
+  const CRect &GetRenderRegion() const { return m_renderRegion; };
+
   // OnAction() is called by our window when we are the focused control.
   // We should process any control-specific actions in the derived classes,
   // and return true if we have taken care of the action.  Returning false
@@ -189,7 +231,7 @@ public:
   virtual void UpdateVisibility(const CGUIListItem *item = NULL);
   virtual void SetInitialVisibility();
   virtual void SetEnabled(bool bEnable);
-  virtual void SetInvalid() { m_bInvalidated = true; };
+  virtual void SetInvalid() { m_bInvalidated = true; MarkDirtyRegion(); };
   virtual void SetPulseOnSelect(bool pulse) { m_pulseOnSelect = pulse; };
   virtual CStdString GetDescription() const { return ""; };
 
@@ -336,6 +378,11 @@ protected:
   CPoint m_camera;
   bool m_hasCamera;
   TransformMatrix m_transform;
+
+  // dirty region tracking
+  CRect m_renderRegion;   ///< region of the screen the control covered when last processed
+  bool m_controlIsDirty;  ///< true if the control needs redrawing
+  bool m_hasProcessed;    ///< true if the control has been processed since it was last rendered
 };
 
 #endif
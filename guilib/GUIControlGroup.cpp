@@ -97,17 +97,38 @@ void CGUIControlGroup::DynamicResourceAlloc(bool bOnOff)
   }
 }
 
-void CGUIControlGroup::Render()
+void CGUIControlGroup::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   CPoint pos(GetPosition());
   g_graphicsContext.SetOrigin(pos.x, pos.y);
-  CGUIControl *focusedControl = NULL;
   for (iControls it = m_children.begin(); it != m_children.end(); ++it)
   {
     CGUIControl *control = *it;
     GUIPROFILER_VISIBILITY_BEGIN(control);
     control->UpdateVisibility();
     GUIPROFILER_VISIBILITY_END(control);
+    control->DoProcess(currentTime, dirtyregions);
+  }
+  g_graphicsContext.RestoreOrigin();
+}
+
+CRect CGUIControlGroup::CalcRenderRegion() const
+{
+  // we don't render anything ourselves, so we cover the regions of our children
+  CRect region;
+  for (ciControls it = m_children.begin(); it != m_children.end(); ++it)
+    region.Union((*it)->GetRenderRegion());
+  return region;
+}
+
+void CGUIControlGroup::Render()
+{
+  CPoint pos(GetPosition());
+  g_graphicsContext.SetOrigin(pos.x, pos.y);
+  CGUIControl *focusedControl = NULL;
+  for (iControls it = m_children.begin(); it != m_children.end(); ++it)
+  {
+    CGUIControl *control = *it;
     if (m_renderFocusedLast && control->HasFocus())
       focusedControl = control;
     else
@@ -47,11 +47,12 @@ CGUIControlGroupList::~CGUIControlGroupList(void)
 {
 }
 
-void CGUIControlGroupList::Render()
+void CGUIControlGroupList::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   if (m_scrollSpeed != 0)
   {
-    m_offset += m_scrollSpeed * (m_renderTime - m_scrollLastTime);
+    MarkDirtyRegion();
+    m_offset += m_scrollSpeed * (currentTime - m_scrollLastTime);
     if ((m_scrollSpeed < 0 && m_offset < m_scrollOffset) ||
         (m_scrollSpeed > 0 && m_offset > m_scrollOffset))
     {
@@ -59,7 +60,7 @@ void CGUIControlGroupList::Render()
       m_scrollSpeed = 0;
     }
   }
-  m_scrollLastTime = m_renderTime;
+  m_scrollLastTime = currentTime;
 
   // first we update visibility of all our items, to ensure our size and
   // alignment computations are correct.
@@ -79,6 +80,26 @@ void CGUIControlGroupList::Render()
     CGUIMessage message2(GUI_MSG_ITEM_SELECT, GetParentID(), m_pageControl, (int)m_offset);
     SendWindowMessage(message2);
   }
+  // we run through the controls, processing as we go
+  float pos = GetAlignOffset();
+  for (iControls it = m_children.begin(); it != m_children.end(); ++it)
+  {
+    // note we process all controls, even if they're offscreen, as then they'll be updated
+    // with respect to animations
+    CGUIControl *control = *it;
+    if (m_orientation == VERTICAL)
+      g_graphicsContext.SetOrigin(m_posX, m_posY + pos - m_offset);
+    else
+      g_graphicsContext.SetOrigin(m_posX + pos - m_offset, m_posY);
+    control->DoProcess(currentTime, dirtyregions);
+    if (control->IsVisible())
+      pos += Size(control) + m_itemGap;
+    g_graphicsContext.RestoreOrigin();
+  }
+}
+
+void CGUIControlGroupList::Render()
+{
   // we run through the controls, rendering as we go
   bool render(g_graphicsContext.SetClipRegion(m_posX, m_posY, m_width, m_height));
   float pos = GetAlignOffset();
@@ -39,7 +39,9 @@ public:
   virtual ~CGUIControlGroupList(void);
   virtual CGUIControlGroupList *Clone() const { return new CGUIControlGroupList(*this); };
 
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
+  virtual CRect CalcRenderRegion() const { return CGUIControl::CalcRenderRegion(); };
   virtual bool OnMessage(CGUIMessage& message);
 
   virtual EVENT_RESULT SendMouseEvent(const CPoint &point, const CMouseEvent &event);
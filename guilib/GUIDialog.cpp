@@ -247,12 +247,12 @@ void CGUIDialog::FrameMove()
   CGUIWindow::FrameMove();
 }
 
-void CGUIDialog::Render()
+void CGUIDialog::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
-  CGUIWindow::Render();
+  CGUIWindow::DoProcess(currentTime, dirtyregions);
   // Check to see if we should close at this point
-  // We check after the controls have finished rendering, as we may have to close due to
-  // the controls rendering after the window has finished it's animation
+  // We check after the controls have finished processing, as we may have to close due to
+  // the controls animating after the window has finished it's animation
   // we call the base class instead of this class so that we can find the change
   if (m_dialogClosing && !CGUIWindow::IsAnimating(ANIM_TYPE_WINDOW_CLOSE))
   {
@@ -363,6 +363,18 @@ void CGUIEditControl::RecalcLabelPosition()
     m_textOffset = 0;
 }
 
+void CGUIEditControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // our text is laid out as we render, and the cursor blinks
+  MarkDirtyRegion();
+  CGUIButtonControl::Process(currentTime, dirtyregions);
+}
+
+void CGUIEditControl::ProcessText()
+{
+  // the labels are laid out in RenderText()
+}
+
 void CGUIEditControl::RenderText()
 {
   if (m_smsTimer.GetElapsedMilliseconds() > smsDelay)
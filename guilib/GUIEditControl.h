@@ -77,7 +77,10 @@ public:
 
   bool HasTextChangeActions() { return m_textChangeActions.size() > 0; };
 
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
+
 protected:
+  virtual void ProcessText();
   virtual void RenderText();
   CStdStringW GetDisplayedText() const;
   void RecalcLabelPosition();
@@ -35,7 +35,6 @@ CGUIFadeLabelControl::CGUIFadeLabelControl(int parentID, int controlID, float po
   m_fadeAnim = CAnimation::CreateFader(100, 0, timeToDelayAtEnd, 200);
   if (m_fadeAnim)
     m_fadeAnim->ApplyAnimation();
-  m_renderTime = 0;
   m_lastLabel = -1;
   m_scrollSpeed = labelInfo.scrollSpeed;  // save it for later
   m_resetOnLabelChange = resetOnLabelChange;
@@ -55,7 +54,6 @@ CGUIFadeLabelControl::CGUIFadeLabelControl(const CGUIFadeLabelControl &from)
   if (m_fadeAnim)
     m_fadeAnim->ApplyAnimation();
   m_currentLabel = 0;
-  m_renderTime = 0;
   m_lastLabel = -1;
   ControlType = GUICONTROL_FADELABEL;
 }
@@ -76,29 +74,22 @@ void CGUIFadeLabelControl::AddLabel(const string &label)
   m_infoLabels.push_back(CGUIInfoLabel(label));
 }
 
-void CGUIFadeLabelControl::DoRender(unsigned int currentTime)
-{
-  m_renderTime = currentTime;
-  CGUIControl::DoRender(currentTime);
-}
-
 void CGUIFadeLabelControl::UpdateColors()
 {
-  m_label.UpdateColors();
+  if (m_label.UpdateColors())
+    MarkDirtyRegion();
   CGUIControl::UpdateColors();
 }
 
-void CGUIFadeLabelControl::Render()
+void CGUIFadeLabelControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   if (m_infoLabels.size() == 0 || !m_label.font)
-  { // nothing to render
-    CGUIControl::Render();
-    return ;
-  }
+    return; // nothing to render
 
   if (m_currentLabel >= m_infoLabels.size() )
     m_currentLabel = 0;
 
+  bool changed = false;
   if (m_textLayout.Update(GetLabel()))
   { // changed label - update our suffix based on length of available text
     float width, height;
@@ -114,26 +105,20 @@ void CGUIFadeLabelControl::Render()
       m_scrollInfo.Reset();
       m_fadeAnim->ResetAnimation();
     }
+    changed = true;
   }
   if (m_currentLabel != m_lastLabel)
   { // new label - reset scrolling
     m_scrollInfo.Reset();
     m_fadeAnim->QueueAnimation(ANIM_PROCESS_REVERSE);
     m_lastLabel = m_currentLabel;
+    changed = true;
   }
 
-  float posY = m_posY;
-  if (m_label.align & XBFONT_CENTER_Y)
-    posY += m_height * 0.5f;
   if (m_infoLabels.size() == 1 && m_shortText)
-  { // single label set and no scrolling required - just display
-    float posX = m_posX + m_label.offsetX;
-    if (m_label.align & XBFONT_CENTER_X)
-      posX = m_posX + m_width * 0.5f;
-    else if (m_label.align & XBFONT_RIGHT)
-      posX = m_posX + m_width;
-    m_textLayout.Render(posX, posY, 0, m_label.textColor, m_label.shadowColor, m_label.align, m_width - m_label.offsetX);
-    CGUIControl::Render();
+  { // single label set and no scrolling required - we only change when the label does
+    if (changed)
+      MarkDirtyRegion();
     return;
   }
 
@@ -155,16 +140,55 @@ void CGUIFadeLabelControl::Render()
     moveToNextLabel = true;
 
   // apply the fading animation
-  TransformMatrix matrix;
-  m_fadeAnim->Animate(m_renderTime, true);
-  m_fadeAnim->RenderAnimation(matrix);
-  g_graphicsContext.AddTransform(matrix);
+  m_fadeMatrix.Reset();
+  m_fadeAnim->Animate(currentTime, true);
+  m_fadeAnim->RenderAnimation(m_fadeMatrix);
 
   if (m_fadeAnim->GetState() == ANIM_STATE_APPLIED)
     m_fadeAnim->ResetAnimation();
 
   m_scrollInfo.SetSpeed((m_fadeAnim->GetProcess() == ANIM_PROCESS_NONE) ? m_scrollSpeed : 0);
 
+  if (moveToNextLabel)
+  { // increment the label and reset scrolling - the new label is picked up next frame, once faded out
+    if (m_fadeAnim->GetProcess() != ANIM_PROCESS_NORMAL)
+    {
+      if (++m_currentLabel >= m_infoLabels.size())
+        m_currentLabel = 0;
+      m_scrollInfo.Reset();
+      m_fadeAnim->QueueAnimation(ANIM_PROCESS_REVERSE);
+    }
+  }
+
+  // we're scrolling or fading
+  MarkDirtyRegion();
+}
+
+void CGUIFadeLabelControl::Render()
+{
+  if (m_infoLabels.size() == 0 || !m_label.font)
+  { // nothing to render
+    CGUIControl::Render();
+    return ;
+  }
+
+  float posY = m_posY;
+  if (m_label.align & XBFONT_CENTER_Y)
+    posY += m_height * 0.5f;
+  if (m_infoLabels.size() == 1 && m_shortText)
+  { // single label set and no scrolling required - just display
+    float posX = m_posX + m_label.offsetX;
+    if (m_label.align & XBFONT_CENTER_X)
+      posX = m_posX + m_width * 0.5f;
+    else if (m_label.align & XBFONT_RIGHT)
+      posX = m_posX + m_width;
+    m_textLayout.Render(posX, posY, 0, m_label.textColor, m_label.shadowColor, m_label.align, m_width - m_label.offsetX);
+    CGUIControl::Render();
+    return;
+  }
+
+  g_graphicsContext.AddTransform(m_fadeMatrix);
+
   if (!m_scrollOut && m_shortText)
   {
     float posX = m_posX + m_label.offsetX;
@@ -177,17 +201,6 @@ void CGUIFadeLabelControl::Render()
   else
     m_textLayout.RenderScrolling(m_posX, posY, 0, m_label.textColor, m_label.shadowColor, (m_label.align & ~3), m_width, m_scrollInfo);
 
-  if (moveToNextLabel)
-  { // increment the label and reset scrolling
-    if (m_fadeAnim->GetProcess() != ANIM_PROCESS_NORMAL)
-    {
-      if (++m_currentLabel >= m_infoLabels.size())
-        m_currentLabel = 0;
-      m_scrollInfo.Reset();
-      m_fadeAnim->QueueAnimation(ANIM_PROCESS_REVERSE);
-    }
-  }
-
   g_graphicsContext.RemoveTransform();
 
   CGUIControl::Render();
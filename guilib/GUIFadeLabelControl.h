@@ -44,7 +44,7 @@ public:
   virtual ~CGUIFadeLabelControl(void);
   virtual CGUIFadeLabelControl *Clone() const { return new CGUIFadeLabelControl(*this); };
 
-  virtual void DoRender(unsigned int currentTime);
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
   virtual bool CanFocus() const;
   virtual bool OnMessage(CGUIMessage& message);
@@ -78,7 +78,7 @@ protected:
   CScrollInfo m_scrollInfo;
   CGUITextLayout m_textLayout;
   CAnimation *m_fadeAnim;
-  unsigned int m_renderTime;
+  TransformMatrix m_fadeMatrix;
   unsigned int m_scrollSpeed;
   bool m_resetOnLabelChange;
 };
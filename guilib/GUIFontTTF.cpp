@@ -30,6 +30,7 @@
 #include "WindowingFactory.h"
 
 #include <math.h>
+#include <map>
 
 // stuff for freetype
 #ifndef _LINUX
@@ -41,6 +42,7 @@
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_STROKER_H
+#include FT_SIZES_H
 
 #define USE_RELEASE_LIBS
 
@@ -48,7 +50,7 @@ using namespace std;
 
 
 #define CHARS_PER_TEXTURE_LINE 20 // number of characters to cache per texture line
-#define CHAR_CHUNK    64      // 64 chars allocated at a time (1024 bytes)
+#define CHARS_PER_PAGE 256        // number of letters per page of the character lookup
 
 int CGUIFontTTFBase::justification_word_weight = 6;   // weight of word spacing over letter spacing when justifying.
                                                   // A larger number means more of the "dead space" is placed between
@@ -68,7 +70,12 @@ public:
       FT_Done_FreeType(m_library);
   }
 
-  FT_Face GetFont(const CStdString &filename, float size, float aspect)
+  /*! \brief Get the font face for the given file, with a new size object of the given size activated.
+   The face is shared between all sizes of the font, so the size object needs to be activated
+   prior to using the face.
+   \param faceSize [out] the size object of the face.
+   */
+  FT_Face GetFont(const CStdString &filename, float size, float aspect, FT_Size &faceSize)
   {
     // don't have it yet - create it
     if (!m_library)
@@ -81,9 +88,15 @@ public:
 
     FT_Face face;
 
-    // ok, now load the font face
-    if (FT_New_Face( m_library, _P(filename).c_str(), 0, &face ))
-      return NULL;
+    std::map<CStdString, CFace>::iterator it = m_faces.find(filename);
+    if (it == m_faces.end())
+    {
+      // ok, now load the font face
+      if (FT_New_Face( m_library, _P(filename).c_str(), 0, &face ))
+        return NULL;
+      it = m_faces.insert(make_pair(filename, CFace(face))).first;
+    }
+    face = it->second.face;
 
     unsigned int ydpi = GetDPI();
     unsigned int xdpi = (unsigned int)MathUtils::round_int(ydpi * aspect);
@@ -92,12 +105,20 @@ public:
     // we cache our characters (for rendering speed) so it's probably
     // not a good idea to allow free scaling of fonts - rather, just
     // scaling to pixel ratio on screen perhaps?
+    if (FT_New_Size( face, &faceSize ))
+    {
+      ReleaseFace(it);
+      return NULL;
+    }
+    FT_Activate_Size(faceSize);
     if (FT_Set_Char_Size( face, 0, (int)(size*64 + 0.5f), xdpi, ydpi ))
     {
-      FT_Done_Face(face);
+      FT_Done_Size(faceSize);
+      ReleaseFace(it);
       return NULL;
     }
 
+    it->second.references++;
     return face;
   };
   
@@ -113,10 +134,19 @@ public:
     return stroker;
   };
 
-  void ReleaseFont(FT_Face face)
+  void ReleaseFont(FT_Face face, FT_Size faceSize)
   {
     assert(face);
-    FT_Done_Face(face);
+    FT_Done_Size(faceSize);
+    for (std::map<CStdString, CFace>::iterator it = m_faces.begin(); it != m_faces.end(); ++it)
+    {
+      if (it->second.face == face)
+      {
+        it->second.references--;
+        ReleaseFace(it);
+        break;
+      }
+    }
   };
   
   void ReleaseStroker(FT_Stroker stroker)
@@ -131,7 +161,24 @@ public:
   };
 
 private:
+  class CFace
+  {
+  public:
+    CFace(FT_Face f) { face = f; references = 0; };
+    FT_Face      face;
+    unsigned int references; ///< number of fonts using the face
+  };
+
+  void ReleaseFace(std::map<CStdString, CFace>::iterator it)
+  {
+    if (it->second.references)
+      return;
+    FT_Done_Face(it->second.face);
+    m_faces.erase(it);
+  }
+
   FT_Library   m_library;
+  std::map<CStdString, CFace> m_faces; ///< faces by filename, shared between the sizes of a font
 };
 
 CFreeTypeLibrary g_freeTypeLibrary; // our freetype library
@@ -139,8 +186,6 @@ CFreeTypeLibrary g_freeTypeLibrary; // our freetype library
 CGUIFontTTFBase::CGUIFontTTFBase(const CStdString& strFileName)
 {
   m_texture = NULL;
-  m_char = NULL;
-  m_maxChars = 0;
   m_nestedBeginCount = 0;
 
   m_bTextureLoaded = false;
@@ -148,13 +193,13 @@ CGUIFontTTFBase::CGUIFontTTFBase(const CStdString& strFileName)
   m_vertex        = (SVertex*)malloc(m_vertex_size * sizeof(SVertex));
 
   m_face = NULL;
+  m_faceSize = NULL;
   m_stroker = NULL;
-  memset(m_charquick, 0, sizeof(m_charquick));
+  memset(m_charPages, 0, sizeof(m_charPages));
   m_strFileName = strFileName;
   m_referenceCount = 0;
   m_originX = m_originY = 0.0f;
   m_cellBaseLine = m_cellHeight = 0;
-  m_numChars = 0;
   m_posX = m_posY = 0;
   m_textureHeight = m_textureWidth = 0;
   m_textureScaleX = m_textureScaleY = 0.0;
@@ -190,33 +235,34 @@ void CGUIFontTTFBase::ClearCharacterCache()
   DeleteHardwareTexture();
 
   m_texture = NULL;
-  delete[] m_char;
-  m_char = new Character[CHAR_CHUNK];
-  memset(m_charquick, 0, sizeof(m_charquick));
-  m_numChars = 0;
-  m_maxChars = CHAR_CHUNK;
+  ClearCharacters();
   // set the posX and posY so that our texture will be created on first character write.
   m_posX = m_textureWidth;
   m_posY = -(int)m_cellHeight;
   m_textureHeight = 0;
 }
 
+void CGUIFontTTFBase::ClearCharacters()
+{
+  for (unsigned int i = 0; i < sizeof(m_charPages) / sizeof(m_charPages[0]); i++)
+    delete[] m_charPages[i];
+  memset(m_charPages, 0, sizeof(m_charPages));
+  m_char.clear();
+}
+
 void CGUIFontTTFBase::Clear()
 {
   delete(m_texture);
   m_texture = NULL;
-  delete[] m_char;
-  memset(m_charquick, 0, sizeof(m_charquick));
-  m_char = NULL;
-  m_maxChars = 0;
-  m_numChars = 0;
+  ClearCharacters();
   m_posX = 0;
   m_posY = 0;
   m_nestedBeginCount = 0;
 
   if (m_face)
-    g_freeTypeLibrary.ReleaseFont(m_face);
+    g_freeTypeLibrary.ReleaseFont(m_face, m_faceSize);
   m_face = NULL;
+  m_faceSize = NULL;
   if (m_stroker)
     g_freeTypeLibrary.ReleaseStroker(m_stroker);
   m_stroker = NULL;
@@ -230,7 +276,7 @@ bool CGUIFontTTFBase::Load(const CStdString& strFilename, float height, float as
 {
   // we now know that this object is unique - only the GUIFont objects are non-unique, so no need
   // for reference tracking these fonts
-  m_face = g_freeTypeLibrary.GetFont(strFilename, height, aspect);
+  m_face = g_freeTypeLibrary.GetFont(strFilename, height, aspect, m_faceSize);
 
   if (!m_face)
     return false;
@@ -244,7 +290,7 @@ bool CGUIFontTTFBase::Load(const CStdString& strFilename, float height, float as
   {
     m_stroker = g_freeTypeLibrary.GetStroker();
 
-    FT_Pos strength = FT_MulFix( m_face->units_per_EM, m_face->size->metrics.y_scale) / 12;
+    FT_Pos strength = FT_MulFix( m_face->units_per_EM, m_faceSize->metrics.y_scale) / 12;
     if (strength < 128)
       strength = 128;
     m_cellHeight += 2*strength;
@@ -278,11 +324,7 @@ bool CGUIFontTTFBase::Load(const CStdString& strFilename, float height, float as
 
   delete(m_texture);
   m_texture = NULL;
-  delete[] m_char;
-  m_char = NULL;
-
-  m_maxChars = 0;
-  m_numChars = 0;
+  ClearCharacters();
 
   m_strFilename = strFilename;
 
@@ -439,8 +481,8 @@ float CGUIFontTTFBase::GetTextHeight(float lineSpacing, int numLines) const
 
 float CGUIFontTTFBase::GetLineHeight(float lineSpacing) const
 {
-  if (m_face)
-    return lineSpacing * m_face->size->metrics.height / 64.0f;
+  if (m_faceSize)
+    return lineSpacing * m_faceSize->metrics.height / 64.0f;
   return 0.0f;
 }
 
@@ -453,61 +495,23 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   if (letter == L'\r')
     return NULL;
 
-  // quick access to ascii chars
-  if (letter < 255)
-  {
-    character_t ch = (style << 8) | letter;
-    if (m_charquick[ch])
-      return m_charquick[ch];
-  }
-
-  // letters are stored based on style and letter
-  character_t ch = (style << 16) | letter;
-
-  int low = 0;
-  int high = m_numChars - 1;
-  int mid;
-  while (low <= high)
-  {
-    mid = (low + high) >> 1;
-    if (ch > m_char[mid].letterAndStyle)
-      low = mid + 1;
-    else if (ch < m_char[mid].letterAndStyle)
-      high = mid - 1;
-    else
-      return &m_char[mid];
-  }
-  // if we get to here, then low is where we should insert the new character
-
-  // increase the size of the buffer if we need it
-  if (m_numChars >= m_maxChars)
-  { // need to increase the size of the buffer
-    Character *newTable = new Character[m_maxChars + CHAR_CHUNK];
-    if (m_char)
-    {
-      memcpy(newTable, m_char, low * sizeof(Character));
-      memcpy(newTable + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
-      delete[] m_char;
-    }
-    m_char = newTable;
-    m_maxChars += CHAR_CHUNK;
+  // letters are looked up based on style and letter, in pages of CHARS_PER_PAGE letters
+  unsigned int pageIndex = (style << 8) | (letter / CHARS_PER_PAGE);
+  Character **page = m_charPages[pageIndex];
+  if (page && page[letter % CHARS_PER_PAGE])
+    return page[letter % CHARS_PER_PAGE];
 
-  }
-  else
-  { // just move the data along as necessary
-    memmove(m_char + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
-  }
   // render the character to our texture
   // must End() as we can't render text to our texture during a Begin(), End() block
+  Character ch;
   unsigned int nestedBeginCount = m_nestedBeginCount;
   m_nestedBeginCount = 1;
   if (nestedBeginCount) End();
-  if (!CacheCharacter(letter, style, m_char + low))
+  if (!CacheCharacter(letter, style, &ch))
   { // unable to cache character - try clearing them all out and starting over
-    CLog::Log(LOGDEBUG, "GUIFontTTF::GetCharacter: Unable to cache character.  Clearing character cache of %i characters", m_numChars);
+    CLog::Log(LOGDEBUG, "GUIFontTTF::GetCharacter: Unable to cache character.  Clearing character cache of %u characters", (unsigned int)m_char.size());
     ClearCharacterCache();
-    low = 0;
-    if (!CacheCharacter(letter, style, m_char + low))
+    if (!CacheCharacter(letter, style, &ch))
     {
       CLog::Log(LOGERROR, "GUIFontTTF::GetCharacter: Unable to cache character (out of memory?)");
       if (nestedBeginCount) Begin();
@@ -518,22 +522,24 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   if (nestedBeginCount) Begin();
   m_nestedBeginCount = nestedBeginCount;
 
-  // fixup quick access
-  memset(m_charquick, 0, sizeof(m_charquick));
-  for(int i=0;i<m_numChars;i++)
+  // add it to our lookup (the pages are all gone if we cleared the cache)
+  m_char.push_back(ch);
+  page = m_charPages[pageIndex];
+  if (!page)
   {
-    if ((m_char[i].letterAndStyle & 0xffff) < 255)
-    {
-      character_t ch = ((m_char[i].letterAndStyle & 0xffff0000) >> 8) | (m_char[i].letterAndStyle & 0xff);
-      m_charquick[ch] = m_char+i;
-    }
+    page = m_charPages[pageIndex] = new Character*[CHARS_PER_PAGE];
+    memset(page, 0, CHARS_PER_PAGE * sizeof(Character *));
   }
+  page[letter % CHARS_PER_PAGE] = &m_char.back();
 
-  return m_char + low;
+  return &m_char.back();
 }
 
 bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
 {
+  // our face is shared with the other sizes of this font
+  FT_Activate_Size(m_faceSize);
+
   int glyph_index = FT_Get_Char_Index( m_face, letter );
 
   FT_Glyph glyph = NULL;
@@ -621,7 +627,6 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
     CopyCharToTexture(bitGlyph, ch);
   }
   m_posX += 1 + (unsigned short)max(ch->right - ch->left + ch->offsetX, ch->advance);
-  m_numChars++;
 
   m_textureScaleX = 1.0f / m_textureWidth;
   m_textureScaleY = 1.0f / m_textureHeight;
@@ -799,7 +804,7 @@ void CGUIFontTTFBase::EmboldenGlyph(FT_GlyphSlot slot)
 
   /* some reasonable strength */
   FT_Pos strength = FT_MulFix( m_face->units_per_EM,
-                    m_face->size->metrics.y_scale ) / 24;
+                    m_faceSize->metrics.y_scale ) / 24;
 
   FT_BBox bbox_before, bbox_after;
   FT_Outline_Get_CBox( &slot->outline, &bbox_before );
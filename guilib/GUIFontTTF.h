@@ -28,16 +28,20 @@
  *
  */
 
+#include <deque>
+
 // forward definition
 class CBaseTexture;
 
 struct FT_FaceRec_;
+struct FT_SizeRec_;
 struct FT_LibraryRec_;
 struct FT_GlyphSlotRec_;
 struct FT_BitmapGlyphRec_;
 struct FT_StrokerRec_;
 
 typedef struct FT_FaceRec_ *FT_Face;
+typedef struct FT_SizeRec_ *FT_Size;
 typedef struct FT_LibraryRec_ *FT_Library;
 typedef struct FT_GlyphSlotRec_ *FT_GlyphSlot;
 typedef struct FT_BitmapGlyphRec_ *FT_BitmapGlyph;
@@ -107,6 +111,7 @@ protected:
   bool CacheCharacter(wchar_t letter, uint32_t style, Character *ch);
   void RenderCharacter(float posX, float posY, const Character *ch, color_t color, bool roundX);
   void ClearCharacterCache();
+  void ClearCharacters();
 
   virtual CBaseTexture* ReallocTexture(unsigned int& newHeight) = 0;
   virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, Character *ch) = 0;
@@ -126,10 +131,8 @@ protected:
 
   color_t m_color;
 
-  Character *m_char;                 // our characters
-  Character *m_charquick[256*4];     // ascii chars (4 styles) here
-  int m_maxChars;                    // size of character array (can be incremented)
-  int m_numChars;                    // the current number of cached characters
+  std::deque<Character> m_char;      // our characters (pointers to them remain valid as characters are added)
+  Character **m_charPages[4*256];    // lookup of our characters by style and letter, in (lazily allocated) pages of 256 letters
 
   float m_ellipsesWidth;               // this is used every character (width of '.')
 
@@ -139,7 +142,8 @@ protected:
   unsigned int m_nestedBeginCount;             // speedups
 
   // freetype stuff
-  FT_Face    m_face;
+  FT_Face    m_face;                 // shared between all sizes of the font
+  FT_Size    m_faceSize;             // our size of m_face, activated prior to using m_face
   FT_Stroker m_stroker;
 
   float m_originX;
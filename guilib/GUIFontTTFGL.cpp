@@ -49,6 +49,8 @@ using namespace std;
 CGUIFontTTFGL::CGUIFontTTFGL(const CStdString& strFileName)
 : CGUIFontTTFBase(strFileName)
 {
+  m_updateY1 = 0;
+  m_updateY2 = 0;
 }
 
 CGUIFontTTFGL::~CGUIFontTTFGL(void)
@@ -78,6 +80,17 @@ void CGUIFontTTFGL::Begin()
 
       VerifyGLState();
       m_bTextureLoaded = true;
+      m_updateY1 = m_updateY2 = 0;
+    }
+    else if (m_updateY2 > m_updateY1)
+    {
+      // upload only the rows that have changed since the last upload
+      glBindTexture(GL_TEXTURE_2D, m_nTexture);
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, m_updateY1, m_texture->GetWidth(), m_updateY2 - m_updateY1,
+                      GL_ALPHA, GL_UNSIGNED_BYTE, (unsigned char *)m_texture->GetPixels() + m_updateY1 * m_texture->GetPitch());
+
+      VerifyGLState();
+      m_updateY1 = m_updateY2 = 0;
     }
 
     // Turn Blending On
@@ -197,6 +210,15 @@ CBaseTexture* CGUIFontTTFGL::ReallocTexture(unsigned int& newHeight)
     delete m_texture;
   }
 
+  // the texture has changed size, so needs uploading in full
+  if (m_bTextureLoaded)
+  {
+    g_graphicsContext.BeginPaint();  //FIXME
+    DeleteHardwareTexture();
+    g_graphicsContext.EndPaint();
+  }
+  m_updateY1 = m_updateY2 = 0;
+
   return newTexture;
 }
 
@@ -215,14 +237,22 @@ bool CGUIFontTTFGL::CopyCharToTexture(FT_BitmapGlyph bitGlyph, Character* ch)
   }
   // THE SOURCE VALUES ARE THE SAME IN BOTH SITUATIONS.
 
-  // Since we have a new texture, we need to delete the old one
+  // mark the rows as needing upload on the next Begin(), rather than reuploading the whole texture
   // the Begin(); End(); stuff is handled by whoever called us
-  if (m_bTextureLoaded)
+  if (m_bTextureLoaded && bitmap.rows > 0)
   {
-    g_graphicsContext.BeginPaint();  //FIXME
-    DeleteHardwareTexture();
-    g_graphicsContext.EndPaint();
-    m_bTextureLoaded = false;
+    unsigned int y1 = m_posY + ch->offsetY;
+    unsigned int y2 = y1 + bitmap.rows;
+    if (m_updateY2 > m_updateY1)
+    {
+      m_updateY1 = min(m_updateY1, y1);
+      m_updateY2 = max(m_updateY2, y2);
+    }
+    else
+    {
+      m_updateY1 = y1;
+      m_updateY2 = y2;
+    }
   }
 
   return TRUE;
@@ -51,6 +51,8 @@ protected:
   virtual void DeleteHardwareTexture();
   virtual void RenderInternal(SVertex* v) {}
 
+  unsigned int m_updateY1; ///< first row of the texture modified since it was last uploaded
+  unsigned int m_updateY2; ///< row after the last row modified since the texture was last uploaded
 };
 
 #endif
@@ -93,13 +93,25 @@ void CGUIImage::AllocateOnDemand()
     AllocResources();
 }
 
-void CGUIImage::Render()
+void CGUIImage::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
-  if (!IsVisible()) return;
-
   // check whether our image failed to allocate, and if so drop back to the fallback image
   if (m_texture.FailedToAlloc() && !m_texture.GetFileName().Equals(m_info.GetFallback()))
+  {
     m_texture.SetFileName(m_info.GetFallback());
+    MarkDirtyRegion();
+  }
+
+  // crossfading, animated and loading textures change every frame
+  if (m_fadingTextures.size() || (m_crossFadeTime && m_currentFadeTime < m_crossFadeTime) || m_texture.IsChanging())
+    MarkDirtyRegion();
+  else if (m_crossFadeTime)
+    m_lastRenderTime = currentTime; // keep our fade clock running while we aren't being rendered
+}
+
+void CGUIImage::Render()
+{
+  if (!IsVisible()) return;
 
   if (m_crossFadeTime)
   {
@@ -255,7 +267,8 @@ const CStdString &CGUIImage::GetFileName() const
 
 void CGUIImage::SetAspectRatio(const CAspectRatio &aspect)
 {
-  m_texture.SetAspectRatio(aspect);
+  if (m_texture.SetAspectRatio(aspect))
+    MarkDirtyRegion();
 }
 
 void CGUIImage::SetCrossFade(unsigned int time)
@@ -281,12 +294,14 @@ void CGUIImage::SetFileName(const CStdString& strFileName, bool setConstant)
       m_fadingTextures.push_back(new CFadingTexture(m_texture, m_currentFadeTime));
     }
     m_currentFadeTime = 0;
+    MarkDirtyRegion();
   }
   if (!m_currentTexture.Equals(strFileName))
   { // texture is changing - attempt to load it, and save the name in m_currentTexture.
-    // we'll check whether it loaded or not in Render()
+    // we'll check whether it loaded or not in Process()
     m_currentTexture = strFileName;
-    m_texture.SetFileName(m_currentTexture);
+    if (m_texture.SetFileName(m_currentTexture))
+      MarkDirtyRegion();
   }
 }
 
@@ -57,7 +57,10 @@ public:
   const CGUIInfoColor &operator=(color_t color);
   operator color_t() const { return m_color; };
 
-  void Update();
+  /*! \brief Update the color from its infolabel
+   \return true if the color has changed
+   */
+  bool Update();
   void Parse(const CStdString &label);
 
 private:
@@ -44,13 +44,15 @@ public:
     scrollSpeed = CScrollInfo::defaultSpeed;
     scrollSuffix = " | ";
   };
-  void UpdateColors()
+  bool UpdateColors()
   {
-    textColor.Update();
-    shadowColor.Update();
-    selectedColor.Update();
-    disabledColor.Update();
-    focusedColor.Update();
+    bool changed = false;
+    changed |= textColor.Update();
+    changed |= shadowColor.Update();
+    changed |= selectedColor.Update();
+    changed |= disabledColor.Update();
+    changed |= focusedColor.Update();
+    return changed;
   };
   
   CGUIInfoColor textColor;
@@ -98,17 +100,19 @@ public:
   /*! \brief Set the maximal extent of the label
    Sets the maximal size and positioning that the label may render in.  Note that <textwidth> can override
    this, and <textoffsetx> and <textoffsety> may also allow the label to be moved outside this rectangle.
+   \return true if the extent changed, false otherwise.
    */
-  void SetMaxRect(float x, float y, float w, float h);
+  bool SetMaxRect(float x, float y, float w, float h);
 
   void SetAlign(uint32_t align);
   
   /*! \brief Set the text to be displayed in the label
    Updates the label control and recomputes final position and size
    \param text CStdString to set as this labels text
+   \return true if the text changed, false otherwise.
    \sa SetTextW
    */
-  void SetText(const CStdString &label);
+  bool SetText(const CStdString &label);
 
   /*! \brief Set the text to be displayed in the label
    Updates the label control and recomputes final position and size
@@ -120,8 +124,9 @@ public:
   /*! \brief Set the color to use for the label
    Sets the color to be used for this label.  Takes effect at the next render
    \param color color to be used for the label
+   \return true if the color changed, false otherwise.
    */
-  void SetColor(COLOR color);
+  bool SetColor(COLOR color);
 
   /*! \brief Set the final layout of the current text
    Overrides the calculated layout of the current text, forcing a particular size and position
@@ -132,16 +137,23 @@ public:
   
   /*! \brief Set whether or not this label control should scroll
    \param scrolling true if this label should scroll.
+   \return true if the scrolling state changed, false otherwise.
    */
-  void SetScrolling(bool scrolling);
+  bool SetScrolling(bool scrolling);
+
+  /*! \brief Whether the label is currently scrolling its text, and so changes every frame.
+   \return true if the text is being scrolled.
+   */
+  bool IsScrolling() const;
 
   /*! \brief Set this label invalid.  Forces an update of the control
    */
   void SetInvalid();
   
   /*! \brief Update this labels colors
+   \return true if any of the colors changed, false otherwise.
    */
-  void UpdateColors();
+  bool UpdateColors();
   
   /*! \brief Returns the precalculated final layout of the current text
    \return CRect containing the extents of the current text
@@ -63,7 +63,8 @@ void CGUILabelControl::SetInfo(const CGUIInfoLabel &infoLabel)
 
 void CGUILabelControl::UpdateColors()
 {
-  m_label.UpdateColors();
+  if (m_label.UpdateColors())
+    MarkDirtyRegion();
   CGUIControl::UpdateColors();
 }
 
@@ -94,14 +95,32 @@ void CGUILabelControl::UpdateInfo(const CGUIListItem *item)
   else if (m_bHasPath)
     label = ShortenPath(label);
 
-  m_label.SetMaxRect(m_posX, m_posY, m_width, m_height);
-  m_label.SetText(label);
+  bool changed = m_label.SetMaxRect(m_posX, m_posY, m_width, m_height);
+  changed |= m_label.SetText(label);
+  // ShortenPath() has already set the text, so we can't tell whether it changed
+  if (changed || m_bHasPath)
+    MarkDirtyRegion();
+}
+
+void CGUILabelControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  bool changed = false;
+  changed |= m_label.SetColor(IsDisabled() ? CGUILabel::COLOR_DISABLED : CGUILabel::COLOR_TEXT);
+  changed |= m_label.SetMaxRect(m_posX, m_posY, m_width, m_height);
+  // scrolling text and the blinking cursor change every frame
+  if (changed || m_label.IsScrolling() || m_bShowCursor)
+    MarkDirtyRegion();
+}
+
+CRect CGUILabelControl::CalcRenderRegion() const
+{
+  // text offsets may place the label outside of our own rectangle
+  CRect region(CGUIControl::CalcRenderRegion());
+  return region.Union(g_graphicsContext.ScaleFinalRect(m_label.GetRenderRect()));
 }
 
 void CGUILabelControl::Render()
 {
-  m_label.SetColor(IsDisabled() ? CGUILabel::COLOR_DISABLED : CGUILabel::COLOR_TEXT);
-  m_label.SetMaxRect(m_posX, m_posY, m_width, m_height);
   m_label.Render();
   CGUIControl::Render();
 }
@@ -122,12 +141,14 @@ void CGUILabelControl::SetLabel(const string &strLabel)
 void CGUILabelControl::SetWidthControl(float minWidth, bool bScroll)
 {
   m_minWidth = minWidth;
-  m_label.SetScrolling(bScroll);
+  if (m_label.SetScrolling(bScroll))
+    MarkDirtyRegion();
 }
 
 void CGUILabelControl::SetAlignment(uint32_t align)
 {
   m_label.GetLabelInfo().align = align;
+  MarkDirtyRegion();
 }
 
 #define CLAMP(x, low, high)  (((x) > (high)) ? (high) : (((x) < (low)) ? (low) : (x)))
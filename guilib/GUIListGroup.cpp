@@ -61,7 +61,7 @@ void CGUIListGroup::AddControl(CGUIControl *control, int position /*= -1*/)
   CGUIControlGroup::AddControl(control, position);
 }
 
-void CGUIListGroup::Render()
+void CGUIListGroup::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   g_graphicsContext.SetOrigin(m_posX, m_posY);
   for (iControls it = m_children.begin(); it != m_children.end(); ++it)
@@ -70,8 +70,16 @@ void CGUIListGroup::Render()
     GUIPROFILER_VISIBILITY_BEGIN(control);
     control->UpdateVisibility(m_item);
     GUIPROFILER_VISIBILITY_END(control);
-    control->DoRender(m_renderTime);
+    control->DoProcess(currentTime, dirtyregions);
   }
+  g_graphicsContext.RestoreOrigin();
+}
+
+void CGUIListGroup::Render()
+{
+  g_graphicsContext.SetOrigin(m_posX, m_posY);
+  for (iControls it = m_children.begin(); it != m_children.end(); ++it)
+    (*it)->DoRender(m_renderTime);
   CGUIControl::Render();
   g_graphicsContext.RestoreOrigin();
   m_item = NULL;
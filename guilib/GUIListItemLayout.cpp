@@ -71,7 +71,7 @@ float CGUIListItemLayout::Size(ORIENTATION orientation) const
   return (orientation == HORIZONTAL) ? m_width : m_height;
 }
 
-void CGUIListItemLayout::Render(CGUIListItem *item, int parentID, unsigned int time)
+void CGUIListItemLayout::Process(CGUIListItem *item, int parentID, unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   if (m_invalidated)
   { // need to update our item
@@ -87,9 +87,14 @@ void CGUIListItemLayout::Render(CGUIListItem *item, int parentID, unsigned int t
       delete fileItem;
   }
 
-  // update visibility, and render
+  // update visibility, and process
   m_group.SetState(item->IsSelected() || m_isPlaying, m_focused);
   m_group.UpdateVisibility(item);
+  m_group.DoProcess(currentTime, dirtyregions);
+}
+
+void CGUIListItemLayout::Render(CGUIListItem *item, int parentID, unsigned int time)
+{
   m_group.DoRender(time);
 }
 
@@ -45,12 +45,14 @@ CGUIListLabel::~CGUIListLabel(void)
 
 void CGUIListLabel::SetScrolling(bool scrolling)
 {
-  m_label.SetScrolling(scrolling || m_alwaysScroll);
+  if (m_label.SetScrolling(scrolling || m_alwaysScroll))
+    MarkDirtyRegion();
 }
 
 void CGUIListLabel::SetSelected(bool selected)
 {
-  m_label.SetColor(selected ? CGUILabel::COLOR_SELECTED : CGUILabel::COLOR_TEXT);
+  if (m_label.SetColor(selected ? CGUILabel::COLOR_SELECTED : CGUILabel::COLOR_TEXT))
+    MarkDirtyRegion();
 }
 
 void CGUIListLabel::SetFocus(bool focus)
@@ -62,10 +64,25 @@ void CGUIListLabel::SetFocus(bool focus)
 
 void CGUIListLabel::UpdateColors()
 {
-  m_label.UpdateColors();
+  if (m_label.UpdateColors())
+    MarkDirtyRegion();
   CGUIControl::UpdateColors();
 }
 
+void CGUIListLabel::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // scrolling labels change every frame
+  if (m_label.IsScrolling())
+    MarkDirtyRegion();
+}
+
+CRect CGUIListLabel::CalcRenderRegion() const
+{
+  // our label may be positioned outside of our rectangle (eg when right aligned)
+  CRect region(CGUIControl::CalcRenderRegion());
+  return region.Union(g_graphicsContext.ScaleFinalRect(m_label.GetRenderRect()));
+}
+
 void CGUIListLabel::Render()
 {
   m_label.Render();
@@ -91,5 +108,6 @@ void CGUIListLabel::SetInvalid()
 
 void CGUIListLabel::SetLabel(const CStdString &label)
 {
-  m_label.SetText(label);
+  if (m_label.SetText(label))
+    MarkDirtyRegion();
 }
@@ -106,10 +106,9 @@ void CGUIMultiImage::UpdateInfo(const CGUIListItem *item)
   }
 }
 
-void CGUIMultiImage::Render()
+void CGUIMultiImage::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
-  // Set a viewport so that we don't render outside the defined area
-  if (!m_files.empty() && g_graphicsContext.SetClipRegion(m_posX, m_posY, m_width, m_height))
+  if (!m_files.empty())
   {
     unsigned int nextImage = m_currentImage + 1;
     if (nextImage >= m_files.size())
@@ -126,10 +125,20 @@ void CGUIMultiImage::Render()
         // grab a new image
         m_currentImage = nextImage;
         m_image.SetFileName(m_files[m_currentImage]);
+        MarkDirtyRegion();
         m_imageTimer.StartZero();
       }
     }
     m_image.SetColorDiffuse(m_diffuseColor);
+    m_image.DoProcess(currentTime, dirtyregions);
+  }
+}
+
+void CGUIMultiImage::Render()
+{
+  // Set a viewport so that we don't render outside the defined area
+  if (!m_files.empty() && g_graphicsContext.SetClipRegion(m_posX, m_posY, m_width, m_height))
+  {
     m_image.Render();
     g_graphicsContext.RestoreClipRegion();
   }
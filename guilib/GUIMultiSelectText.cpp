@@ -70,7 +70,7 @@ void CGUIMultiSelectTextControl::UpdateColors()
   CGUIControl::UpdateColors();
 }
 
-void CGUIMultiSelectTextControl::Render()
+void CGUIMultiSelectTextControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   // check our selected item is in range
   unsigned int numSelectable = GetNumSelectable();
@@ -85,15 +85,29 @@ void CGUIMultiSelectTextControl::Render()
   if (m_offset < 0) m_offset = 0;
 
   // handle scrolling
-  m_scrollOffset += m_scrollSpeed * (m_renderTime - m_scrollLastTime);
+  m_scrollOffset += m_scrollSpeed * (currentTime - m_scrollLastTime);
   if ((m_scrollSpeed < 0 && m_scrollOffset < m_offset) ||
       (m_scrollSpeed > 0 && m_scrollOffset > m_offset))
   {
     m_scrollOffset = m_offset;
     m_scrollSpeed = 0;
   }
-  m_scrollLastTime = m_renderTime;
+  m_scrollLastTime = currentTime;
 
+  // process the buttons - they're scrolled and clipped by us, so we redraw everything below
+  CDirtyRegionList buttonregions;
+  for (unsigned int i = 0; i < m_buttons.size(); i++)
+  {
+    m_buttons[i].SetFocus(HasFocus() && i == m_selectedItem);
+    m_buttons[i].DoProcess(currentTime, buttonregions);
+  }
+
+  // our text isn't tracked, so we redraw every frame
+  CGUIControl::Process(currentTime, dirtyregions);
+}
+
+void CGUIMultiSelectTextControl::Render()
+{
   // clip and set our scrolling origin
   bool clip(m_width < m_totalWidth);
   if (clip)
@@ -105,10 +119,7 @@ void CGUIMultiSelectTextControl::Render()
 
   // render the buttons
   for (unsigned int i = 0; i < m_buttons.size(); i++)
-  {
-    m_buttons[i].SetFocus(HasFocus() && i == m_selectedItem);
     m_buttons[i].DoRender(m_renderTime);
-  }
 
   // position the text - we center vertically if applicable, and use the offsets.
   // all x-alignment is ignored for now (see constructor)
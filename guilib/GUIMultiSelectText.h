@@ -38,6 +38,7 @@ public:
   virtual CGUIMultiSelectTextControl *Clone() const { return new CGUIMultiSelectTextControl(*this); };
 
   virtual void DoRender(unsigned int currentTime);
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
 
   virtual bool OnAction(const CAction &action);
@@ -38,7 +38,7 @@ CGUIPanelContainer::~CGUIPanelContainer(void)
 {
 }
 
-void CGUIPanelContainer::Render()
+void CGUIPanelContainer::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   ValidateOffset();
 
@@ -47,7 +47,7 @@ void CGUIPanelContainer::Render()
 
   if (!m_layout || !m_focusedLayout) return;
 
-  UpdateScrollOffset();
+  UpdateScrollOffset(currentTime);
 
   int offset = (int)(m_scrollOffset / m_layout->Size(m_orientation));
 
@@ -57,6 +57,73 @@ void CGUIPanelContainer::Render()
   // Free memory not used on screen at the moment, do this first so there's more memory for the new items.
   FreeMemory(CorrectOffset(offset - cacheBefore, 0), CorrectOffset(offset + cacheAfter + m_itemsPerPage + 1, 0));
 
+  CPoint origin = CPoint(m_posX, m_posY) + m_renderOffset;
+  float pos = (m_orientation == VERTICAL) ? origin.y : origin.x;
+  float end = (m_orientation == VERTICAL) ? m_posY + m_height : m_posX + m_width;
+  pos += (offset - cacheBefore) * m_layout->Size(m_orientation) - m_scrollOffset;
+  end += cacheAfter * m_layout->Size(m_orientation);
+
+  float focusedPos = 0;
+  int focusedCol = 0;
+  CGUIListItemPtr focusedItem;
+  int current = (offset - cacheBefore) * m_itemsPerRow;
+  int col = 0;
+  while (pos < end && m_items.size())
+  {
+    if (current >= (int)m_items.size())
+      break;
+    if (current >= 0)
+    {
+      CGUIListItemPtr item = m_items[current];
+      bool focused = (current == m_offset * m_itemsPerRow + m_cursor) && m_bHasFocus;
+      // process our item
+      if (focused)
+      {
+        focusedPos = pos;
+        focusedCol = col;
+        focusedItem = item;
+      }
+      else
+      {
+        if (m_orientation == VERTICAL)
+          ProcessItem(origin.x + col * m_layout->Size(HORIZONTAL), pos, item.get(), false, currentTime, dirtyregions);
+        else
+          ProcessItem(pos, origin.y + col * m_layout->Size(VERTICAL), item.get(), false, currentTime, dirtyregions);
+      }
+    }
+    // increment our position
+    if (col < m_itemsPerRow - 1)
+      col++;
+    else
+    {
+      pos += m_layout->Size(m_orientation);
+      col = 0;
+    }
+    current++;
+  }
+  // and process the focused item last (for overlapping purposes)
+  if (focusedItem)
+  {
+    if (m_orientation == VERTICAL)
+      ProcessItem(origin.x + focusedCol * m_layout->Size(HORIZONTAL), focusedPos, focusedItem.get(), true, currentTime, dirtyregions);
+    else
+      ProcessItem(focusedPos, origin.y + focusedCol * m_layout->Size(VERTICAL), focusedItem.get(), true, currentTime, dirtyregions);
+  }
+
+  UpdatePageControl(offset);
+
+  MarkDirtyIfMoved();
+}
+
+void CGUIPanelContainer::Render()
+{
+  if (!m_layout || !m_focusedLayout) return;
+
+  int offset = (int)(m_scrollOffset / m_layout->Size(m_orientation));
+
+  int cacheBefore, cacheAfter;
+  GetCacheOffsets(cacheBefore, cacheAfter);
+
   g_graphicsContext.SetClipRegion(m_posX, m_posY, m_width, m_height);
   CPoint origin = CPoint(m_posX, m_posY) + m_renderOffset;
   float pos = (m_orientation == VERTICAL) ? origin.y : origin.x;
@@ -113,8 +180,6 @@ void CGUIPanelContainer::Render()
 
   g_graphicsContext.RestoreClipRegion();
 
-  UpdatePageControl(offset);
-
   CGUIControl::Render();
 }
 
@@ -54,113 +54,139 @@ void CGUIProgressControl::SetPosition(float posX, float posY)
   m_guiBackground.SetPosition(posX, posY);
 }
 
-void CGUIProgressControl::Render()
+void CGUIProgressControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
+  bool changed = false;
   if (!IsDisabled())
-  {
-    if (m_iInfoCode)
-      m_fPercent = (float)g_infoManager.GetInt(m_iInfoCode);
-    if (m_fPercent < 0.0f) m_fPercent = 0.0f;
-    if (m_fPercent > 100.0f) m_fPercent = 100.0f;
-
-    if (m_width == 0)
-      m_width = m_guiBackground.GetTextureWidth();
-    if (m_height == 0)
-      m_height = m_guiBackground.GetTextureHeight();
-
-    m_guiBackground.SetHeight(m_height);
-    m_guiBackground.SetWidth(m_width);
-    m_guiBackground.Render();
+    changed |= UpdateLayout();
 
-    float fScaleX, fScaleY;
-    fScaleY = m_guiBackground.GetTextureHeight() ? m_height / m_guiBackground.GetTextureHeight() : 1.0f;
-    fScaleX = m_guiBackground.GetTextureWidth() ? m_width / m_guiBackground.GetTextureWidth() : 1.0f;
+  if (changed || m_guiBackground.IsChanging() || m_guiLeft.IsChanging() || m_guiMid.IsChanging() ||
+      m_guiRight.IsChanging() || m_guiOverlay.IsChanging())
+    MarkDirtyRegion();
+}
+
+bool CGUIProgressControl::UpdateLayout()
+{
+  bool changed = false;
 
-    float posX = m_guiBackground.GetXPosition();
-    float posY = m_guiBackground.GetYPosition();
+  float percent = m_fPercent;
+  if (m_iInfoCode)
+    m_fPercent = (float)g_infoManager.GetInt(m_iInfoCode);
+  if (m_fPercent < 0.0f) m_fPercent = 0.0f;
+  if (m_fPercent > 100.0f) m_fPercent = 100.0f;
+  changed |= (m_fPercent != percent);
 
-    if (m_guiLeft.GetFileName().IsEmpty() && m_guiRight.GetFileName().IsEmpty())
-    { // rendering without left and right image - fill the mid image completely
-      float width = m_fPercent * m_width * 0.01f;
-      if (m_fPercent && width > 1)
+  if (m_width == 0)
+    m_width = m_guiBackground.GetTextureWidth();
+  if (m_height == 0)
+    m_height = m_guiBackground.GetTextureHeight();
+
+  changed |= m_guiBackground.SetHeight(m_height);
+  changed |= m_guiBackground.SetWidth(m_width);
+
+  float fScaleX, fScaleY;
+  fScaleY = m_guiBackground.GetTextureHeight() ? m_height / m_guiBackground.GetTextureHeight() : 1.0f;
+  fScaleX = m_guiBackground.GetTextureWidth() ? m_width / m_guiBackground.GetTextureWidth() : 1.0f;
+
+  float posX = m_guiBackground.GetXPosition();
+  float posY = m_guiBackground.GetYPosition();
+
+  if (m_guiLeft.GetFileName().IsEmpty() && m_guiRight.GetFileName().IsEmpty())
+  { // rendering without left and right image - fill the mid image completely
+    float width = m_fPercent * m_width * 0.01f;
+    changed |= m_guiMid.SetVisible(m_fPercent && width > 1);
+    if (m_fPercent && width > 1)
+    {
+      float offset = fabs(fScaleY * 0.5f * (m_guiMid.GetTextureHeight() - m_guiBackground.GetTextureHeight()));
+      if (offset > 0)  //  Center texture to the background if necessary
+        changed |= m_guiMid.SetPosition(posX, posY + offset);
+      else
+        changed |= m_guiMid.SetPosition(posX, posY);
+      changed |= m_guiMid.SetHeight(fScaleY * m_guiMid.GetTextureHeight());
+      if (m_bReveal)
       {
-        float offset = fabs(fScaleY * 0.5f * (m_guiMid.GetTextureHeight() - m_guiBackground.GetTextureHeight()));
-        if (offset > 0)  //  Center texture to the background if necessary
-          m_guiMid.SetPosition(posX, posY + offset);
-        else
-          m_guiMid.SetPosition(posX, posY);
-        m_guiMid.SetHeight(fScaleY * m_guiMid.GetTextureHeight());
-        if (m_bReveal)
-        {
-          m_guiMid.SetWidth(m_width);
-          g_graphicsContext.SetClipRegion(posX, posY+offset, width, fScaleY * m_guiMid.GetTextureHeight());
-          m_guiMid.Render();
-          g_graphicsContext.RestoreClipRegion();
-        }
-        else
-        {
-          m_guiMid.SetWidth(width);
-          m_guiMid.Render();
-        }
+        changed |= m_guiMid.SetWidth(m_width);
+        m_guiMidClipRect = CRect(posX, posY + offset, posX + width, posY + offset + fScaleY * m_guiMid.GetTextureHeight());
       }
+      else
+        changed |= m_guiMid.SetWidth(width);
     }
-    else
-    {
+  }
+  else
+  {
+    float fWidth = m_fPercent;
+    float fFullWidth = m_guiBackground.GetTextureWidth() - m_guiLeft.GetTextureWidth() - m_guiRight.GetTextureWidth();
+    fWidth /= 100.0f;
+    fWidth *= fFullWidth;
 
-      float fWidth = m_fPercent;
-      float fFullWidth = m_guiBackground.GetTextureWidth() - m_guiLeft.GetTextureWidth() - m_guiRight.GetTextureWidth();
-      fWidth /= 100.0f;
-      fWidth *= fFullWidth;
+    float offset = fabs(fScaleY * 0.5f * (m_guiLeft.GetTextureHeight() - m_guiBackground.GetTextureHeight()));
+    if (offset > 0)  //  Center texture to the background if necessary
+      changed |= m_guiLeft.SetPosition(posX, posY + offset);
+    else
+      changed |= m_guiLeft.SetPosition(posX, posY);
+    changed |= m_guiLeft.SetHeight(fScaleY * m_guiLeft.GetTextureHeight());
+    changed |= m_guiLeft.SetWidth(fScaleX * m_guiLeft.GetTextureWidth());
 
-      float offset = fabs(fScaleY * 0.5f * (m_guiLeft.GetTextureHeight() - m_guiBackground.GetTextureHeight()));
+    posX += fScaleX * m_guiLeft.GetTextureWidth();
+    changed |= m_guiMid.SetVisible(m_fPercent && (int)(fScaleX * fWidth) > 1);
+    if (m_fPercent && (int)(fScaleX * fWidth) > 1)
+    {
+      float offset = fabs(fScaleY * 0.5f * (m_guiMid.GetTextureHeight() - m_guiBackground.GetTextureHeight()));
       if (offset > 0)  //  Center texture to the background if necessary
-        m_guiLeft.SetPosition(posX, posY + offset);
+        changed |= m_guiMid.SetPosition(posX, posY + offset);
       else
-        m_guiLeft.SetPosition(posX, posY);
-      m_guiLeft.SetHeight(fScaleY * m_guiLeft.GetTextureHeight());
-      m_guiLeft.SetWidth(fScaleX * m_guiLeft.GetTextureWidth());
-      m_guiLeft.Render();
-
-      posX += fScaleX * m_guiLeft.GetTextureWidth();
-      if (m_fPercent && (int)(fScaleX * fWidth) > 1)
+        changed |= m_guiMid.SetPosition(posX, posY);
+      changed |= m_guiMid.SetHeight(fScaleY * m_guiMid.GetTextureHeight());
+      if (m_bReveal)
       {
-        float offset = fabs(fScaleY * 0.5f * (m_guiMid.GetTextureHeight() - m_guiBackground.GetTextureHeight()));
-        if (offset > 0)  //  Center texture to the background if necessary
-          m_guiMid.SetPosition(posX, posY + offset);
-        else
-          m_guiMid.SetPosition(posX, posY);
-        m_guiMid.SetHeight(fScaleY * m_guiMid.GetTextureHeight());
-        if (m_bReveal)
-        {
-          m_guiMid.SetWidth(fScaleX * fFullWidth);
-          g_graphicsContext.SetClipRegion(posX, posY+offset, fScaleX * fWidth, fScaleY * m_guiMid.GetTextureHeight());
-          m_guiMid.Render();
-          g_graphicsContext.RestoreClipRegion();
-        }
-        else
-        {
-          m_guiMid.SetWidth(fScaleX * fWidth);
-          m_guiMid.Render();
-        }
-        posX += fWidth * fScaleX;
+        changed |= m_guiMid.SetWidth(fScaleX * fFullWidth);
+        m_guiMidClipRect = CRect(posX, posY + offset, posX + fScaleX * fWidth, posY + offset + fScaleY * m_guiMid.GetTextureHeight());
       }
-
-      offset = fabs(fScaleY * 0.5f * (m_guiRight.GetTextureHeight() - m_guiBackground.GetTextureHeight()));
-      if (offset > 0)  //  Center texture to the background if necessary
-        m_guiRight.SetPosition(posX, posY + offset);
       else
-        m_guiRight.SetPosition(posX, posY);
-      m_guiRight.SetHeight(fScaleY * m_guiRight.GetTextureHeight());
-      m_guiRight.SetWidth(fScaleX * m_guiRight.GetTextureWidth());
-      m_guiRight.Render();
+        changed |= m_guiMid.SetWidth(fScaleX * fWidth);
+      posX += fWidth * fScaleX;
     }
-    float offset = fabs(fScaleY * 0.5f * (m_guiOverlay.GetTextureHeight() - m_guiBackground.GetTextureHeight()));
+
+    offset = fabs(fScaleY * 0.5f * (m_guiRight.GetTextureHeight() - m_guiBackground.GetTextureHeight()));
     if (offset > 0)  //  Center texture to the background if necessary
-      m_guiOverlay.SetPosition(m_guiBackground.GetXPosition(), m_guiBackground.GetYPosition() + offset);
+      changed |= m_guiRight.SetPosition(posX, posY + offset);
+    else
+      changed |= m_guiRight.SetPosition(posX, posY);
+    changed |= m_guiRight.SetHeight(fScaleY * m_guiRight.GetTextureHeight());
+    changed |= m_guiRight.SetWidth(fScaleX * m_guiRight.GetTextureWidth());
+  }
+  float offset = fabs(fScaleY * 0.5f * (m_guiOverlay.GetTextureHeight() - m_guiBackground.GetTextureHeight()));
+  if (offset > 0)  //  Center texture to the background if necessary
+    changed |= m_guiOverlay.SetPosition(m_guiBackground.GetXPosition(), m_guiBackground.GetYPosition() + offset);
+  else
+    changed |= m_guiOverlay.SetPosition(m_guiBackground.GetXPosition(), m_guiBackground.GetYPosition());
+  changed |= m_guiOverlay.SetHeight(fScaleY * m_guiOverlay.GetTextureHeight());
+  changed |= m_guiOverlay.SetWidth(fScaleX * m_guiOverlay.GetTextureWidth());
+
+  return changed;
+}
+
+void CGUIProgressControl::Render()
+{
+  if (!IsDisabled())
+  {
+    m_guiBackground.Render();
+
+    bool hasSides = !(m_guiLeft.GetFileName().IsEmpty() && m_guiRight.GetFileName().IsEmpty());
+    if (hasSides)
+      m_guiLeft.Render();
+
+    if (m_bReveal && m_guiMid.IsVisible())
+    {
+      g_graphicsContext.SetClipRegion(m_guiMidClipRect.x1, m_guiMidClipRect.y1, m_guiMidClipRect.Width(), m_guiMidClipRect.Height());
+      m_guiMid.Render();
+      g_graphicsContext.RestoreClipRegion();
+    }
     else
-      m_guiOverlay.SetPosition(m_guiBackground.GetXPosition(), m_guiBackground.GetYPosition());
-    m_guiOverlay.SetHeight(fScaleY * m_guiOverlay.GetTextureHeight());
-    m_guiOverlay.SetWidth(fScaleX * m_guiOverlay.GetTextureWidth());
+      m_guiMid.Render();
+
+    if (hasSides)
+      m_guiRight.Render();
     m_guiOverlay.Render();
   }
   CGUIControl::Render();
@@ -48,6 +48,7 @@ public:
   virtual ~CGUIProgressControl(void);
   virtual CGUIProgressControl *Clone() const { return new CGUIProgressControl(*this); };
 
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
   virtual bool CanFocus() const;
   virtual void AllocResources();
@@ -64,6 +65,7 @@ public:
   CStdString GetDescription() const;
 protected:
   virtual void UpdateColors();
+  bool UpdateLayout();
   CGUITexture m_guiBackground;
   CGUITexture m_guiLeft;
   CGUITexture m_guiMid;
@@ -72,5 +74,6 @@ protected:
   int m_iInfoCode;
   float m_fPercent;
   bool m_bReveal;
+  CRect m_guiMidClipRect; ///< region the mid texture is clipped to when revealing
 };
 #endif
@@ -86,9 +86,9 @@ void CGUIRSSControl::UpdateColors()
   CGUIControl::UpdateColors();
 }
 
-void CGUIRSSControl::Render()
+void CGUIRSSControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
-  // only render the control if they are enabled
+  // only process the control if they are enabled
   if (g_guiSettings.GetBool("lookandfeel.enablerssfeeds") && g_rssManager.IsActive())
   {
     CSingleLock lock(m_criticalSection);
@@ -114,6 +114,23 @@ void CGUIRSSControl::Render()
       }
     }
 
+    if (m_pReader)
+    {
+      m_pReader->CheckForUpdates();
+      m_pReader->m_SavedScrollPos = m_scrollInfo.characterPos;
+    }
+
+    // the feed scrolls continuously
+    MarkDirtyRegion();
+  }
+}
+
+void CGUIRSSControl::Render()
+{
+  // only render the control if they are enabled
+  if (g_guiSettings.GetBool("lookandfeel.enablerssfeeds") && g_rssManager.IsActive())
+  {
+    CSingleLock lock(m_criticalSection);
     if (m_label.font)
     {
       vecColors colors;
@@ -122,12 +139,6 @@ void CGUIRSSControl::Render()
       colors.push_back(m_channelColor);
       m_label.font->DrawScrollingText(m_posX, m_posY, colors, m_label.shadowColor, m_feed, 0, m_width, m_scrollInfo);
     }
-
-    if (m_pReader)
-    {
-      m_pReader->CheckForUpdates();
-      m_pReader->m_SavedScrollPos = m_scrollInfo.characterPos;
-    }
   }
   CGUIControl::Render();
 }
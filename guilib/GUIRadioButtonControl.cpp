@@ -44,13 +44,21 @@ CGUIRadioButtonControl::~CGUIRadioButtonControl(void)
 {}
 
 
-void CGUIRadioButtonControl::Render()
+void CGUIRadioButtonControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
-  CGUIButtonControl::Render();
-
   // ask our infoManager whether we are selected or not...
+  bool selected = m_bSelected;
   if (m_toggleSelect)
     m_bSelected = g_infoManager.GetBool(m_toggleSelect, m_parentID);
+  if (m_bSelected != selected || m_imgRadioOn.IsChanging() || m_imgRadioOff.IsChanging())
+    MarkDirtyRegion();
+
+  CGUIButtonControl::Process(currentTime, dirtyregions);
+}
+
+void CGUIRadioButtonControl::Render()
+{
+  CGUIButtonControl::Render();
 
   if ( IsSelected() && !IsDisabled() )
     m_imgRadioOn.Render();
@@ -63,6 +71,7 @@ bool CGUIRadioButtonControl::OnAction(const CAction &action)
   if (action.GetID() == ACTION_SELECT_ITEM)
   {
     m_bSelected = !m_bSelected;
+    MarkDirtyRegion();
   }
   return CGUIButtonControl::OnAction(action);
 }
@@ -45,15 +45,16 @@ CGUIResizeControl::CGUIResizeControl(int parentID, int controlID, float posX, fl
 CGUIResizeControl::~CGUIResizeControl(void)
 {}
 
-void CGUIResizeControl::Render()
+void CGUIResizeControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
+  bool changed = false;
   if (m_bInvalidated)
   {
-    m_imgFocus.SetWidth(m_width);
-    m_imgFocus.SetHeight(m_height);
+    changed |= m_imgFocus.SetWidth(m_width);
+    changed |= m_imgFocus.SetHeight(m_height);
 
-    m_imgNoFocus.SetWidth(m_width);
-    m_imgNoFocus.SetHeight(m_height);
+    changed |= m_imgNoFocus.SetWidth(m_width);
+    changed |= m_imgNoFocus.SetHeight(m_height);
   }
   if (HasFocus())
   {
@@ -69,13 +70,20 @@ void CGUIResizeControl::Render()
     m_imgFocus.SetVisible(true);
     m_imgNoFocus.SetVisible(false);
     m_frameCounter++;
+    changed = true; // we pulse while focused
   }
   else
   {
     SetAlpha(0xff);
-    m_imgFocus.SetVisible(false);
-    m_imgNoFocus.SetVisible(true);
+    changed |= m_imgFocus.SetVisible(false);
+    changed |= m_imgNoFocus.SetVisible(true);
   }
+  if (changed || m_imgFocus.IsChanging() || m_imgNoFocus.IsChanging())
+    MarkDirtyRegion();
+}
+
+void CGUIResizeControl::Render()
+{
   // render both so the visibility settings cause the frame counter to resetcorrectly
   m_imgFocus.Render();
   m_imgNoFocus.Render();
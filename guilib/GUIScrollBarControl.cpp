@@ -47,11 +47,20 @@ CGUIScrollBar::~CGUIScrollBar(void)
 }
 
 
-void CGUIScrollBar::Render()
+void CGUIScrollBar::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
+  bool changed = false;
+
   if (m_bInvalidated)
-    UpdateBarSize();
+    changed |= UpdateBarSize();
+
+  if (changed || m_guiBackground.IsChanging() || m_guiBarFocus.IsChanging() || m_guiBarNoFocus.IsChanging() ||
+      m_guiNibFocus.IsChanging() || m_guiNibNoFocus.IsChanging())
+    MarkDirtyRegion();
+}
 
+void CGUIScrollBar::Render()
+{
   m_guiBackground.Render();
   if (m_bHasFocus)
   {
@@ -189,8 +198,10 @@ void CGUIScrollBar::SetInvalid()
   m_guiNibFocus.SetInvalid();
 }
 
-void CGUIScrollBar::UpdateBarSize()
+bool CGUIScrollBar::UpdateBarSize()
 {
+  bool changed = false;
+
   // scale our textures to suit
   if (m_orientation == VERTICAL)
   {
@@ -200,10 +211,10 @@ void CGUIScrollBar::UpdateBarSize()
     if (nibSize < m_guiNibFocus.GetTextureHeight() + 2 * MIN_NIB_SIZE) nibSize = m_guiNibFocus.GetTextureHeight() + 2 * MIN_NIB_SIZE;
     if (nibSize > GetHeight()) nibSize = GetHeight();
 
-    m_guiBarNoFocus.SetHeight(nibSize);
-    m_guiBarFocus.SetHeight(nibSize);
-    m_guiNibNoFocus.SetHeight(nibSize);
-    m_guiNibFocus.SetHeight(nibSize);
+    changed |= m_guiBarNoFocus.SetHeight(nibSize);
+    changed |= m_guiBarFocus.SetHeight(nibSize);
+    changed |= m_guiNibNoFocus.SetHeight(nibSize);
+    changed |= m_guiNibFocus.SetHeight(nibSize);
     // nibSize may be altered by the border size of the nib (and bar).
     nibSize = std::max(m_guiBarFocus.GetHeight(), m_guiNibFocus.GetHeight());
 
@@ -212,10 +223,10 @@ void CGUIScrollBar::UpdateBarSize()
     float nibPos = (GetHeight() - nibSize) * percent;
     if (nibPos < 0) nibPos = 0;
     if (nibPos > GetHeight() - nibSize) nibPos = GetHeight() - nibSize;
-    m_guiBarNoFocus.SetPosition(GetXPosition(), GetYPosition() + nibPos);
-    m_guiBarFocus.SetPosition(GetXPosition(), GetYPosition() + nibPos);
-    m_guiNibNoFocus.SetPosition(GetXPosition(), GetYPosition() + nibPos);
-    m_guiNibFocus.SetPosition(GetXPosition(), GetYPosition() + nibPos);
+    changed |= m_guiBarNoFocus.SetPosition(GetXPosition(), GetYPosition() + nibPos);
+    changed |= m_guiBarFocus.SetPosition(GetXPosition(), GetYPosition() + nibPos);
+    changed |= m_guiNibNoFocus.SetPosition(GetXPosition(), GetYPosition() + nibPos);
+    changed |= m_guiNibFocus.SetPosition(GetXPosition(), GetYPosition() + nibPos);
   }
   else
   {
@@ -225,21 +236,23 @@ void CGUIScrollBar::UpdateBarSize()
     if (nibSize < m_guiNibFocus.GetTextureWidth() + 2 * MIN_NIB_SIZE) nibSize = m_guiNibFocus.GetTextureWidth() + 2 * MIN_NIB_SIZE;
     if (nibSize > GetWidth()) nibSize = GetWidth();
 
-    m_guiBarNoFocus.SetWidth(nibSize);
-    m_guiBarFocus.SetWidth(nibSize);
-    m_guiNibNoFocus.SetWidth(nibSize);
-    m_guiNibFocus.SetWidth(nibSize);
+    changed |= m_guiBarNoFocus.SetWidth(nibSize);
+    changed |= m_guiBarFocus.SetWidth(nibSize);
+    changed |= m_guiNibNoFocus.SetWidth(nibSize);
+    changed |= m_guiNibFocus.SetWidth(nibSize);
 
     // and the position
     percent = (m_numItems == m_pageSize) ? 0 : (float)m_offset / (m_numItems - m_pageSize);
     float nibPos = (GetWidth() - nibSize) * percent;
     if (nibPos < 0) nibPos = 0;
     if (nibPos > GetWidth() - nibSize) nibPos = GetWidth() - nibSize;
-    m_guiBarNoFocus.SetPosition(GetXPosition() + nibPos, GetYPosition());
-    m_guiBarFocus.SetPosition(GetXPosition() + nibPos, GetYPosition());
-    m_guiNibNoFocus.SetPosition(GetXPosition() + nibPos, GetYPosition());
-    m_guiNibFocus.SetPosition(GetXPosition() + nibPos, GetYPosition());
+    changed |= m_guiBarNoFocus.SetPosition(GetXPosition() + nibPos, GetYPosition());
+    changed |= m_guiBarFocus.SetPosition(GetXPosition() + nibPos, GetYPosition());
+    changed |= m_guiNibNoFocus.SetPosition(GetXPosition() + nibPos, GetYPosition());
+    changed |= m_guiNibFocus.SetPosition(GetXPosition() + nibPos, GetYPosition());
   }
+
+  return changed;
 }
 
 bool CGUIScrollBar::HitTest(const CPoint &point) const
@@ -60,6 +60,13 @@ CGUISelectButtonControl::CGUISelectButtonControl(int parentID, int controlID,
 CGUISelectButtonControl::~CGUISelectButtonControl(void)
 {}
 
+void CGUISelectButtonControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // the selection state is updated as we render, so we can't tell when we change
+  MarkDirtyRegion();
+  CGUIButtonControl::Process(currentTime, dirtyregions);
+}
+
 void CGUISelectButtonControl::Render()
 {
   if (m_bInvalidated)
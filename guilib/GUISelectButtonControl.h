@@ -99,6 +99,7 @@ public:
   virtual ~CGUISelectButtonControl(void);
   virtual CGUISelectButtonControl *Clone() const { return new CGUISelectButtonControl(*this); };
 
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
   virtual bool OnAction(const CAction &action) ;
   virtual void OnLeft();
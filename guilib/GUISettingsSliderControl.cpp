@@ -35,24 +35,41 @@ CGUISettingsSliderControl::~CGUISettingsSliderControl(void)
 }
 
 
-void CGUISettingsSliderControl::Render()
+void CGUISettingsSliderControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   // make sure the button has focus if it should have...
   m_buttonControl.SetFocus(HasFocus());
   m_buttonControl.SetPulseOnSelect(m_pulseOnSelect);
   m_buttonControl.SetEnabled(m_enabled);
-  m_buttonControl.Render();
-  CGUISliderControl::Render();
+  m_buttonControl.DoProcess(currentTime, dirtyregions);
 
-  // now render our text
-  m_label.SetMaxRect(m_buttonControl.GetXPosition(), m_posY, m_posX - m_buttonControl.GetXPosition(), m_height);
-  m_label.SetText(CGUISliderControl::GetDescription());
+  // and our text
+  bool changed = false;
+  changed |= m_label.SetMaxRect(m_buttonControl.GetXPosition(), m_posY, m_posX - m_buttonControl.GetXPosition(), m_height);
+  changed |= m_label.SetText(CGUISliderControl::GetDescription());
   if (IsDisabled())
-    m_label.SetColor(CGUILabel::COLOR_DISABLED);
+    changed |= m_label.SetColor(CGUILabel::COLOR_DISABLED);
   else if (HasFocus())
-    m_label.SetColor(CGUILabel::COLOR_FOCUSED);
+    changed |= m_label.SetColor(CGUILabel::COLOR_FOCUSED);
   else
-    m_label.SetColor(CGUILabel::COLOR_TEXT);
+    changed |= m_label.SetColor(CGUILabel::COLOR_TEXT);
+  if (changed || m_label.IsScrolling())
+    MarkDirtyRegion();
+
+  CGUISliderControl::Process(currentTime, dirtyregions);
+}
+
+CRect CGUISettingsSliderControl::CalcRenderRegion() const
+{
+  // our text is rendered over the button, to the left of the slider
+  CRect region(CGUISliderControl::CalcRenderRegion());
+  return region.Union(m_buttonControl.GetRenderRegion());
+}
+
+void CGUISettingsSliderControl::Render()
+{
+  m_buttonControl.Render();
+  CGUISliderControl::Render();
   m_label.Render();
 }
 
@@ -48,7 +48,9 @@ public:
   virtual ~CGUISettingsSliderControl(void);
   virtual CGUISettingsSliderControl *Clone() const { return new CGUISettingsSliderControl(*this); };
 
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
+  virtual CRect CalcRenderRegion() const;
   virtual bool OnAction(const CAction &action);
   virtual void AllocResources();
   virtual void FreeResources(bool immediately = false);
@@ -47,40 +47,48 @@ CGUISliderControl::~CGUISliderControl(void)
 {
 }
 
-void CGUISliderControl::Render()
+void CGUISliderControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
-  m_guiBackground.SetPosition( m_posX, m_posY );
+  bool changed = false;
+
+  changed |= m_guiBackground.SetPosition( m_posX, m_posY );
   if (m_iInfoCode)
     SetIntValue(g_infoManager.GetInt(m_iInfoCode));
 
   float fScaleX = m_width == 0 ? 1.0f : m_width / m_guiBackground.GetTextureWidth();
   float fScaleY = m_height == 0 ? 1.0f : m_height / m_guiBackground.GetTextureHeight();
 
-  m_guiBackground.SetHeight(m_height);
-  m_guiBackground.SetWidth(m_width);
-  m_guiBackground.Render();
+  changed |= m_guiBackground.SetHeight(m_height);
+  changed |= m_guiBackground.SetWidth(m_width);
 
   float fWidth = (m_guiBackground.GetTextureWidth() - m_guiMid.GetTextureWidth())*fScaleX;
 
   float fPos = m_guiBackground.GetXPosition() + GetProportion() * fWidth;
 
+  changed |= m_guiMidFocus.SetVisible((int)fWidth > 1);
+  changed |= m_guiMid.SetVisible((int)fWidth > 1);
   if ((int)fWidth > 1)
   {
-    if (m_bHasFocus && !IsDisabled())
-    {
-      m_guiMidFocus.SetPosition(fPos, m_guiBackground.GetYPosition() );
-      m_guiMidFocus.SetWidth(m_guiMidFocus.GetTextureWidth() * fScaleX);
-      m_guiMidFocus.SetHeight(m_guiMidFocus.GetTextureHeight() * fScaleY);
-      m_guiMidFocus.Render();
-    }
-    else
-    {
-      m_guiMid.SetPosition(fPos, m_guiBackground.GetYPosition() );
-      m_guiMid.SetWidth(m_guiMid.GetTextureWidth()*fScaleX);
-      m_guiMid.SetHeight(m_guiMid.GetTextureHeight()*fScaleY);
-      m_guiMid.Render();
-    }
+    changed |= m_guiMidFocus.SetPosition(fPos, m_guiBackground.GetYPosition() );
+    changed |= m_guiMidFocus.SetWidth(m_guiMidFocus.GetTextureWidth() * fScaleX);
+    changed |= m_guiMidFocus.SetHeight(m_guiMidFocus.GetTextureHeight() * fScaleY);
+
+    changed |= m_guiMid.SetPosition(fPos, m_guiBackground.GetYPosition() );
+    changed |= m_guiMid.SetWidth(m_guiMid.GetTextureWidth()*fScaleX);
+    changed |= m_guiMid.SetHeight(m_guiMid.GetTextureHeight()*fScaleY);
   }
+
+  if (changed || m_guiBackground.IsChanging() || m_guiMid.IsChanging() || m_guiMidFocus.IsChanging())
+    MarkDirtyRegion();
+}
+
+void CGUISliderControl::Render()
+{
+  m_guiBackground.Render();
+  if (m_bHasFocus && !IsDisabled())
+    m_guiMidFocus.Render();
+  else
+    m_guiMid.Render();
   CGUIControl::Render();
 }
 
@@ -185,6 +185,7 @@ void CGUISpinControl::OnLeft()
   {
     // select the down button
     m_iSelect = SPIN_BUTTON_DOWN;
+    MarkDirtyRegion();
   }
   else
   { // base class
@@ -198,6 +199,7 @@ void CGUISpinControl::OnRight()
   {
     // select the up button
     m_iSelect = SPIN_BUTTON_UP;
+    MarkDirtyRegion();
   }
   else
   { // base class
@@ -228,7 +230,10 @@ bool CGUISpinControl::OnMessage(CGUIMessage& message)
       }
       SetValue( message.GetParam1());
       if (message.GetParam2() == SPIN_BUTTON_DOWN || message.GetParam2() == SPIN_BUTTON_UP)
+      {
         m_iSelect = message.GetParam2();
+        MarkDirtyRegion();
+      }
       return true;
       break;
 
@@ -347,8 +352,10 @@ void CGUISpinControl::SetInvalid()
   m_imgspinDownFocus.SetInvalid();
 }
 
-void CGUISpinControl::Render()
+void CGUISpinControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
+  bool changed = false;
+
   if (!HasFocus())
   {
     m_iTypedPos = 0;
@@ -405,7 +412,7 @@ void CGUISpinControl::Render()
 
   }
 
-  m_label.SetText(text);
+  changed |= m_label.SetText(text);
 
   const float space = 5;
   float textWidth = m_label.GetTextWidth() + 2 * m_label.GetLabelInfo().offsetX;
@@ -413,12 +420,30 @@ void CGUISpinControl::Render()
   bool arrowsOnRight(0 != (m_label.GetLabelInfo().align & (XBFONT_RIGHT | XBFONT_CENTER_X)));
   if (!arrowsOnRight)
   {
-    m_imgspinDownFocus.SetPosition(m_posX + textWidth + space, m_posY);
-    m_imgspinDown.SetPosition(m_posX + textWidth + space, m_posY);
-    m_imgspinUpFocus.SetPosition(m_posX + textWidth + space + m_imgspinDown.GetWidth(), m_posY);
-    m_imgspinUp.SetPosition(m_posX + textWidth + space + m_imgspinDown.GetWidth(), m_posY);
+    changed |= m_imgspinDownFocus.SetPosition(m_posX + textWidth + space, m_posY);
+    changed |= m_imgspinDown.SetPosition(m_posX + textWidth + space, m_posY);
+    changed |= m_imgspinUpFocus.SetPosition(m_posX + textWidth + space + m_imgspinDown.GetWidth(), m_posY);
+    changed |= m_imgspinUp.SetPosition(m_posX + textWidth + space + m_imgspinDown.GetWidth(), m_posY);
+  }
+
+  if (m_label.GetLabelInfo().font)
+  {
+    if (arrowsOnRight)
+      changed |= ProcessText(m_posX - space - textWidth, textWidth);
+    else
+      changed |= ProcessText(m_posX + m_imgspinDown.GetWidth() + m_imgspinUp.GetWidth() + space, textWidth);
+
+    // set our hit rectangle for MouseOver events
+    m_hitRect = m_label.GetRenderRect();
   }
 
+  if (changed || m_label.IsScrolling() || m_imgspinUp.IsChanging() || m_imgspinUpFocus.IsChanging() ||
+      m_imgspinDown.IsChanging() || m_imgspinDownFocus.IsChanging())
+    MarkDirtyRegion();
+}
+
+void CGUISpinControl::Render()
+{
   if ( HasFocus() )
   {
     if (m_iSelect == SPIN_BUTTON_UP)
@@ -438,23 +463,16 @@ void CGUISpinControl::Render()
   }
 
   if (m_label.GetLabelInfo().font)
-  {
-    if (arrowsOnRight)
-      RenderText(m_posX - space - textWidth, textWidth);
-    else
-      RenderText(m_posX + m_imgspinDown.GetWidth() + m_imgspinUp.GetWidth() + space, textWidth);
-
-    // set our hit rectangle for MouseOver events
-    m_hitRect = m_label.GetRenderRect();
-  }
+    m_label.Render();
   CGUIControl::Render();
 }
 
-void CGUISpinControl::RenderText(float posX, float width)
+bool CGUISpinControl::ProcessText(float posX, float width)
 {
-  m_label.SetMaxRect(posX, m_posY, width, m_height);
-  m_label.SetColor(GetTextColor());
-  m_label.Render();
+  bool changed = false;
+  changed |= m_label.SetMaxRect(posX, m_posY, width, m_height);
+  changed |= m_label.SetColor(GetTextColor());
+  return changed;
 }
 
 CGUILabel::COLOR CGUISpinControl::GetTextColor() const
@@ -858,10 +876,13 @@ bool CGUISpinControl::HitTest(const CPoint &point) const
 
 bool CGUISpinControl::OnMouseOver(const CPoint &point)
 {
+  int select = m_iSelect;
   if (m_imgspinDownFocus.HitTest(point))
     m_iSelect = SPIN_BUTTON_DOWN;
   else
     m_iSelect = SPIN_BUTTON_UP;
+  if (select != m_iSelect)
+    MarkDirtyRegion();
   return CGUIControl::OnMouseOver(point);
 }
 
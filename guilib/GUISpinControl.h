@@ -49,6 +49,7 @@ public:
   virtual ~CGUISpinControl(void);
   virtual CGUISpinControl *Clone() const { return new CGUISpinControl(*this); };
 
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
   virtual bool OnAction(const CAction &action);
   virtual void OnLeft();
@@ -90,11 +91,12 @@ public:
 protected:
   virtual EVENT_RESULT OnMouseEvent(const CPoint &point, const CMouseEvent &event);
   virtual void UpdateColors();
-  /*! \brief Render the spinner text
+  /*! \brief Position the spinner text
    \param posX position of the left edge of the text
    \param width width of the text
+   \return true if the text changed on screen
    */
-  virtual void RenderText(float posX, float width);
+  virtual bool ProcessText(float posX, float width);
   CGUILabel::COLOR GetTextColor() const;
   void PageUp();
   void PageDown();
@@ -62,16 +62,29 @@ void CGUISpinControlEx::SetInvalid()
   m_buttonControl.SetInvalid();
 }
 
-void CGUISpinControlEx::Render()
+void CGUISpinControlEx::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
+  if (m_bInvalidated)
+    SetPosition(GetXPosition(), GetYPosition());
+
   // make sure the button has focus if it should have...
   m_buttonControl.SetFocus(HasFocus());
   m_buttonControl.SetPulseOnSelect(m_pulseOnSelect);
   m_buttonControl.SetEnabled(m_enabled);
-  m_buttonControl.Render();
-  if (m_bInvalidated)
-    SetPosition(GetXPosition(), GetYPosition());
+  m_buttonControl.DoProcess(currentTime, dirtyregions);
+  CGUISpinControl::Process(currentTime, dirtyregions);
+}
+
+CRect CGUISpinControlEx::CalcRenderRegion() const
+{
+  // our text is rendered over the button, outside of the spin arrows
+  CRect region(CGUISpinControl::CalcRenderRegion());
+  return region.Union(m_buttonControl.GetRenderRegion());
+}
 
+void CGUISpinControlEx::Render()
+{
+  m_buttonControl.Render();
   CGUISpinControl::Render();
 }
 
@@ -146,11 +159,12 @@ void CGUISpinControlEx::SetSpinPosition(float spinPosX)
   SetPosition(m_buttonControl.GetXPosition(), m_buttonControl.GetYPosition());
 }
 
-void CGUISpinControlEx::RenderText(float posX, float width)
+bool CGUISpinControlEx::ProcessText(float posX, float width)
 {
   const float spaceWidth = 10;
   // check our limits from the button control
   float x = std::max(m_buttonControl.m_label.GetRenderRect().x2 + spaceWidth, posX);
-  m_label.SetScrolling(HasFocus());
-  CGUISpinControl::RenderText(x, width + posX - x);
+  bool changed = m_label.SetScrolling(HasFocus());
+  changed |= CGUISpinControl::ProcessText(x, width + posX - x);
+  return changed;
 }
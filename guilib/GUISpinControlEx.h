@@ -43,7 +43,9 @@ public:
   virtual ~CGUISpinControlEx(void);
   virtual CGUISpinControlEx *Clone() const { return new CGUISpinControlEx(*this); };
 
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
+  virtual CRect CalcRenderRegion() const;
   virtual void SetPosition(float posX, float posY);
   virtual float GetWidth() const { return m_buttonControl.GetWidth();};
   virtual void SetWidth(float width);
@@ -65,7 +67,7 @@ public:
 
   void SetItemInvalid(bool invalid);
 protected:
-  virtual void RenderText(float posX, float width);
+  virtual bool ProcessText(float posX, float width);
   virtual void UpdateColors();
   CGUIButtonControl m_buttonControl;
   float m_spinPosX;
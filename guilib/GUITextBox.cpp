@@ -38,7 +38,6 @@ CGUITextBox::CGUITextBox(int parentID, int controlID, float posX, float posY, fl
   m_itemHeight = 10;
   ControlType = GUICONTROL_TEXTBOX;
   m_pageControl = 0;
-  m_renderTime = 0;
   m_lastRenderTime = 0;
   m_scrollTime = scrollTime;
   m_autoScrollCondition = 0;
@@ -68,7 +67,6 @@ CGUITextBox::CGUITextBox(const CGUITextBox &from)
   m_scrollSpeed = 0;
   m_itemsPerPage = 10;
   m_itemHeight = 10;
-  m_renderTime = 0;
   m_lastRenderTime = 0;
   m_autoScrollDelayTime = 0;
   ControlType = GUICONTROL_TEXTBOX;
@@ -80,20 +78,19 @@ CGUITextBox::~CGUITextBox(void)
   m_autoScrollRepeatAnim = NULL;
 }
 
-void CGUITextBox::DoRender(unsigned int currentTime)
+void CGUITextBox::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
-  m_renderTime = currentTime;
-
-  // render the repeat anim as appropriate
+  // process the repeat anim as appropriate
   if (m_autoScrollRepeatAnim)
   {
-    m_autoScrollRepeatAnim->Animate(m_renderTime, true);
-    TransformMatrix matrix;
-    m_autoScrollRepeatAnim->RenderAnimation(matrix);
-    g_graphicsContext.AddTransform(matrix);
+    m_autoScrollRepeatAnim->Animate(currentTime, true);
+    m_cachedTextMatrix.Reset();
+    m_autoScrollRepeatAnim->RenderAnimation(m_cachedTextMatrix);
+    g_graphicsContext.AddTransform(m_cachedTextMatrix);
   }
 
-  CGUIControl::DoRender(currentTime);
+  CGUIControl::DoProcess(currentTime, dirtyregions);
+
   // if not visible, we reset the autoscroll timer and positioning
   if (!IsVisible() && m_autoScrollTime)
   {
@@ -107,9 +104,26 @@ void CGUITextBox::DoRender(unsigned int currentTime)
     g_graphicsContext.RemoveTransform();
 }
 
+void CGUITextBox::DoRender(unsigned int currentTime)
+{
+  if (!m_hasProcessed)
+  { // process first, so that our repeat anim is up to date
+    CDirtyRegionList dirtyregions;
+    DoProcess(currentTime, dirtyregions);
+  }
+
+  // render the repeat anim as appropriate
+  if (m_autoScrollRepeatAnim)
+    g_graphicsContext.AddTransform(m_cachedTextMatrix);
+  CGUIControl::DoRender(currentTime);
+  if (m_autoScrollRepeatAnim)
+    g_graphicsContext.RemoveTransform();
+}
+
 void CGUITextBox::UpdateColors()
 {
-  m_label.UpdateColors();
+  if (m_label.UpdateColors())
+    MarkDirtyRegion();
   CGUIControl::UpdateColors();
 }
 
@@ -120,6 +134,7 @@ void CGUITextBox::UpdateInfo(const CGUIListItem *item)
     return; // nothing changed
 
   // needed update, so reset to the top of the textbox and update our sizing/page control
+  MarkDirtyRegion();
   m_offset = 0;
   m_scrollOffset = 0;
   ResetAutoScrolling();
@@ -130,7 +145,7 @@ void CGUITextBox::UpdateInfo(const CGUIListItem *item)
   UpdatePageControl();
 }
 
-void CGUITextBox::Render()
+void CGUITextBox::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   // update our auto-scrolling as necessary
   if (m_autoScrollTime && m_lines.size() > m_itemsPerPage)
@@ -138,7 +153,7 @@ void CGUITextBox::Render()
     if (!m_autoScrollCondition || g_infoManager.GetBool(m_autoScrollCondition, m_parentID))
     {
       if (m_lastRenderTime)
-        m_autoScrollDelayTime += m_renderTime - m_lastRenderTime;
+        m_autoScrollDelayTime += currentTime - m_lastRenderTime;
       if (m_autoScrollDelayTime > (unsigned int)m_autoScrollDelay && m_scrollSpeed == 0)
       { // delay is finished - start scrolling
         if (m_offset < (int)m_lines.size() - m_itemsPerPage)
@@ -154,6 +169,7 @@ void CGUITextBox::Render()
               m_offset = 0;
               m_scrollOffset = 0;
               ResetAutoScrolling();
+              MarkDirtyRegion();
             }
           }
         }
@@ -164,16 +180,29 @@ void CGUITextBox::Render()
   }
 
   // update our scroll position as necessary
+  float scrollOffset = m_scrollOffset;
   if (m_lastRenderTime)
-    m_scrollOffset += m_scrollSpeed * (m_renderTime - m_lastRenderTime);
+    m_scrollOffset += m_scrollSpeed * (currentTime - m_lastRenderTime);
   if ((m_scrollSpeed < 0 && m_scrollOffset < m_offset * m_itemHeight) ||
       (m_scrollSpeed > 0 && m_scrollOffset > m_offset * m_itemHeight))
   {
     m_scrollOffset = m_offset * m_itemHeight;
     m_scrollSpeed = 0;
   }
-  m_lastRenderTime = m_renderTime;
+  m_lastRenderTime = currentTime;
+
+  if (m_scrollOffset != scrollOffset || (m_autoScrollRepeatAnim && m_autoScrollRepeatAnim->GetState() != ANIM_STATE_NONE))
+    MarkDirtyRegion();
+
+  if (m_pageControl)
+  {
+    CGUIMessage msg(GUI_MSG_ITEM_SELECT, GetID(), m_pageControl, (int)(m_scrollOffset / m_itemHeight));
+    SendWindowMessage(msg);
+  }
+}
 
+void CGUITextBox::Render()
+{
   int offset = (int)(m_scrollOffset / m_itemHeight);
 
   if (g_graphicsContext.SetClipRegion(m_posX, m_posY, m_width, m_height))
@@ -207,12 +236,6 @@ void CGUITextBox::Render()
 
     g_graphicsContext.RestoreClipRegion();
   }
-
-  if (m_pageControl)
-  {
-    CGUIMessage msg(GUI_MSG_ITEM_SELECT, GetID(), m_pageControl, offset);
-    SendWindowMessage(msg);
-  }
   CGUIControl::Render();
 }
 
@@ -295,6 +318,7 @@ void CGUITextBox::ScrollToOffset(int offset, bool autoScroll)
   int timeToScroll = autoScroll ? m_autoScrollTime : m_scrollTime;
   m_scrollSpeed = (offset * m_itemHeight - m_scrollOffset) / timeToScroll;
   m_offset = offset;
+  MarkDirtyRegion();
 }
 
 void CGUITextBox::SetAutoScrolling(const TiXmlNode *node)
@@ -49,7 +49,9 @@ public:
   virtual ~CGUITextBox(void);
   virtual CGUITextBox *Clone() const { return new CGUITextBox(*this); };
 
+  virtual void DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void DoRender(unsigned int currentTime);
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
   virtual bool OnMessage(CGUIMessage& message);
 
@@ -79,8 +81,8 @@ protected:
   int   m_scrollTime;
   unsigned int m_itemsPerPage;
   float m_itemHeight;
-  unsigned int m_renderTime;
   unsigned int m_lastRenderTime;
+  TransformMatrix m_cachedTextMatrix; ///< transform of the repeat anim, worked out in DoProcess()
 
   CLabelInfo m_label;
 
@@ -83,6 +83,8 @@ CGUITextureBase::CGUITextureBase(float posX, float posY, float width, float heig
 
   m_allocateDynamically = false;
   m_isAllocated = NO;
+  m_largeWidth = 0;
+  m_largeHeight = 0;
   m_invalid = true;
 }
 
@@ -119,6 +121,8 @@ CGUITextureBase::CGUITextureBase(const CGUITextureBase &right)
   m_currentLoop = 0;
 
   m_isAllocated = NO;
+  m_largeWidth = 0;
+  m_largeHeight = 0;
   m_invalid = true;
 }
 
@@ -302,8 +306,10 @@ void CGUITextureBase::AllocResources()
     }
     if (m_isAllocated != NORMAL)
     { // use our large image background loader
+      if (!IsAllocated())
+        GetLargeTextureSize(m_largeWidth, m_largeHeight);
       CTextureArray texture;
-      if (g_largeTextureManager.GetImage(m_info.filename, texture, !IsAllocated()))
+      if (g_largeTextureManager.GetImage(m_info.filename, m_largeWidth, m_largeHeight, texture, !IsAllocated()))
       {
         m_isAllocated = LARGE;
 
@@ -436,10 +442,27 @@ void CGUITextureBase::CalculateSize()
   m_invalid = false;
 }
 
+void CGUITextureBase::GetLargeTextureSize(unsigned int &width, unsigned int &height) const
+{
+  // large images are decoded at the size we display them at (0 meaning the screen size)
+  width = height = 0;
+  if (m_width <= 0 || m_height <= 0 || m_aspect.ratio == CAspectRatio::AR_CENTER)
+    return; // we're either autosized or render the image at its own size
+
+  float w = m_width * g_graphicsContext.GetGUIScaleX();
+  float h = m_height * g_graphicsContext.GetGUIScaleY();
+  if (m_aspect.ratio != CAspectRatio::AR_KEEP)
+  { // the image has to cover our frame, so whichever dimension limits it isn't known until it's decoded
+    w = h = max(w, h);
+  }
+  width = (unsigned int)ceilf(w);
+  height = (unsigned int)ceilf(h);
+}
+
 void CGUITextureBase::FreeResources(bool immediately /* = false */)
 {
   if (m_isAllocated == LARGE || m_isAllocated == LARGE_FAILED)
-    g_largeTextureManager.ReleaseImage(m_info.filename, immediately || (m_isAllocated == LARGE_FAILED));
+    g_largeTextureManager.ReleaseImage(m_info.filename, m_largeWidth, m_largeHeight, immediately || (m_isAllocated == LARGE_FAILED));
   else if (m_isAllocated == NORMAL && m_texture.size())
     g_TextureManager.ReleaseTexture(m_info.filename);
 
@@ -501,19 +524,25 @@ void CGUITextureBase::UpdateAnimFrame()
   }
 }
 
-void CGUITextureBase::SetVisible(bool visible)
+bool CGUITextureBase::SetVisible(bool visible)
 {
+  bool changed = m_visible != visible;
   m_visible = visible;
+  return changed;
 }
 
-void CGUITextureBase::SetAlpha(unsigned char alpha)
+bool CGUITextureBase::SetAlpha(unsigned char alpha)
 {
+  bool changed = m_alpha != alpha;
   m_alpha = alpha;
+  return changed;
 }
 
-void CGUITextureBase::SetDiffuseColor(color_t color)
+bool CGUITextureBase::SetDiffuseColor(color_t color)
 {
+  bool changed = m_diffuseColor != color;
   m_diffuseColor = color;
+  return changed;
 }
 
 bool CGUITextureBase::ReadyToRender() const
@@ -521,6 +550,15 @@ bool CGUITextureBase::ReadyToRender() const
   return m_texture.size() > 0;
 }
 
+bool CGUITextureBase::IsChanging() const
+{
+  if (!m_visible)
+    return false;
+  if (m_texture.size() > 1)
+    return true; // animated
+  return !ReadyToRender() && !FailedToAlloc() && !m_info.filename.IsEmpty(); // still loading
+}
+
 void CGUITextureBase::OrientateTexture(CRect &rect, float width, float height, int orientation)
 {
   switch (orientation & 3)
@@ -558,7 +596,7 @@ void CGUITextureBase::OrientateTexture(CRect &rect, float width, float height, i
   }
 }
 
-void CGUITextureBase::SetWidth(float width)
+bool CGUITextureBase::SetWidth(float width)
 {
   if (width < m_info.border.x1 + m_info.border.x2)
     width = m_info.border.x1 + m_info.border.x2;
@@ -566,10 +604,12 @@ void CGUITextureBase::SetWidth(float width)
   {
     m_width = width;
     m_invalid = true;
+    return true;
   }
+  return false;
 }
 
-void CGUITextureBase::SetHeight(float height)
+bool CGUITextureBase::SetHeight(float height)
 {
   if (height < m_info.border.y1 + m_info.border.y2)
     height = m_info.border.y1 + m_info.border.y2;
@@ -577,36 +617,43 @@ void CGUITextureBase::SetHeight(float height)
   {
     m_height = height;
     m_invalid = true;
+    return true;
   }
+  return false;
 }
 
-void CGUITextureBase::SetPosition(float posX, float posY)
+bool CGUITextureBase::SetPosition(float posX, float posY)
 {
   if (m_posX != posX || m_posY != posY)
   {
     m_posX = posX;
     m_posY = posY;
     m_invalid = true;
+    return true;
   }
+  return false;
 }
 
-void CGUITextureBase::SetAspectRatio(const CAspectRatio &aspect)
+bool CGUITextureBase::SetAspectRatio(const CAspectRatio &aspect)
 {
   if (m_aspect != aspect)
   {
     m_aspect = aspect;
     m_invalid = true;
+    return true;
   }
+  return false;
 }
 
-void CGUITextureBase::SetFileName(const CStdString& filename)
+bool CGUITextureBase::SetFileName(const CStdString& filename)
 {
-  if (m_info.filename.Equals(filename)) return;
+  if (m_info.filename.Equals(filename)) return false;
   // Don't completely free resources here - we may be just changing
   // filenames mid-animation
   FreeResources();
   m_info.filename = filename;
   // Don't allocate resources here as this is done at render time
+  return true;
 }
 
 int CGUITextureBase::GetOrientation() const
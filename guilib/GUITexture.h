@@ -95,14 +95,15 @@ public:
   void FreeResources(bool immediately = false);
   void SetInvalid();
 
-  void SetVisible(bool visible);
-  void SetAlpha(unsigned char alpha);
-  void SetDiffuseColor(color_t color);
-  void SetPosition(float x, float y);
-  void SetWidth(float width);
-  void SetHeight(float height);
-  void SetFileName(const CStdString &filename);
-  void SetAspectRatio(const CAspectRatio &aspect);
+  // the setters return true if the texture changed on screen
+  bool SetVisible(bool visible);
+  bool SetAlpha(unsigned char alpha);
+  bool SetDiffuseColor(color_t color);
+  bool SetPosition(float x, float y);
+  bool SetWidth(float width);
+  bool SetHeight(float height);
+  bool SetFileName(const CStdString &filename);
+  bool SetAspectRatio(const CAspectRatio &aspect);
 
   const CStdString& GetFileName() const { return m_info.filename; };
   float GetTextureWidth() const { return m_frameWidth; };
@@ -114,15 +115,23 @@ public:
   int GetOrientation() const;
   const CRect &GetRenderRect() const { return m_vertex; };
   bool IsLazyLoaded() const { return m_info.useLarge; };
+  bool IsVisible() const { return m_visible; };
 
   bool HitTest(const CPoint &point) const { return CRect(m_posX, m_posY, m_posX + m_width, m_posY + m_height).PtInRect(point); };
   bool IsAllocated() const { return m_isAllocated != NO; };
   bool FailedToAlloc() const { return m_isAllocated == NORMAL_FAILED || m_isAllocated == LARGE_FAILED; };
   bool ReadyToRender() const;
+
+  /*! \brief Whether the texture will change on screen without any of its properties changing
+   This is the case for animated textures, and for textures that are still being loaded.
+   \return true if the texture needs redrawing every frame.
+   */
+  bool IsChanging() const;
 protected:
   void CalculateSize();
   void LoadDiffuseImage();
   void AllocateOnDemand();
+  void GetLargeTextureSize(unsigned int &width, unsigned int &height) const;
   void UpdateAnimFrame();
   void Render(float left, float top, float bottom, float right, float u1, float v1, float u2, float v2, float u3, float v3);
   void OrientateTexture(CRect &rect, float width, float height, int orientation);
@@ -162,6 +171,8 @@ protected:
   bool m_allocateDynamically;
   enum ALLOCATE_TYPE { NO = 0, NORMAL, LARGE, NORMAL_FAILED, LARGE_FAILED };
   ALLOCATE_TYPE m_isAllocated;
+  unsigned int m_largeWidth;  // size (in pixels) we requested our large texture at
+  unsigned int m_largeHeight;
 
   CTextureInfo m_info;
   CAspectRatio m_aspect;
@@ -39,19 +39,32 @@ CGUIToggleButtonControl::~CGUIToggleButtonControl(void)
 {
 }
 
-void CGUIToggleButtonControl::Render()
+void CGUIToggleButtonControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   // ask our infoManager whether we are selected or not...
+  bool selected = m_bSelected;
   if (m_toggleSelect)
     m_bSelected = g_infoManager.GetBool(m_toggleSelect, m_parentID);
+  if (m_bSelected != selected)
+    MarkDirtyRegion();
 
   if (m_bSelected)
   {
-    // render our Alternate textures...
+    // process our Alternate textures...
     m_selectButton.SetFocus(HasFocus());
     m_selectButton.SetVisible(IsVisible());
     m_selectButton.SetEnabled(!IsDisabled());
     m_selectButton.SetPulseOnSelect(m_pulseOnSelect);
+    m_selectButton.DoProcess(currentTime, dirtyregions);
+  }
+  CGUIButtonControl::Process(currentTime, dirtyregions);
+}
+
+void CGUIToggleButtonControl::Render()
+{
+  if (m_bSelected)
+  {
+    // render our Alternate textures...
     m_selectButton.Render();
     CGUIControl::Render();
   }
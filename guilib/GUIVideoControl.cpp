@@ -39,6 +39,16 @@ CGUIVideoControl::~CGUIVideoControl(void)
 {}
 
 
+void CGUIVideoControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // playing video keeps the screensaver at bay
+  if (g_application.IsPlayingVideo() && !g_application.m_pPlayer->IsPaused())
+    g_application.ResetScreenSaver();
+
+  // the video changes every frame
+  MarkDirtyRegion();
+}
+
 void CGUIVideoControl::Render()
 {
 #ifdef HAS_VIDEO_PLAYBACK
@@ -51,9 +61,6 @@ void CGUIVideoControl::Render()
   if (g_application.IsPlayingVideo())
   {
 #endif
-    if (!g_application.m_pPlayer->IsPaused())
-      g_application.ResetScreenSaver();
-
     g_graphicsContext.SetViewWindow(m_posX, m_posY, m_posX + m_width, m_posY + m_height);
 
 #ifdef HAS_VIDEO_PLAYBACK
@@ -311,6 +311,13 @@ void CGUIWindow::Render()
   // to occur.
   if (!m_bAllocated) return;
 
+  if (!m_hasProcessed)
+  { // not processed by the window manager this frame (eg rendered from another thread)
+    CDirtyRegionList dirtyregions;
+    DoProcess(CTimeUtils::GetFrameTime(), dirtyregions);
+  }
+  m_hasProcessed = false;
+
   g_graphicsContext.SetRenderingResolution(m_coordsRes, m_needsScaling);
 
   m_renderTime = CTimeUtils::GetFrameTime();
@@ -326,6 +333,16 @@ void CGUIWindow::Render()
   if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().EndFrame();
 }
 
+void CGUIWindow::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  if (!m_bAllocated) return;
+
+  g_graphicsContext.SetRenderingResolution(m_coordsRes, m_needsScaling);
+  g_graphicsContext.ResetWindowTransform();
+
+  CGUIControlGroup::DoProcess(currentTime, dirtyregions);
+}
+
 void CGUIWindow::Close(bool forceClose)
 {
   CLog::Log(LOGERROR,"%s - should never be called on the base class!", __FUNCTION__);
@@ -683,13 +700,22 @@ bool CGUIWindow::IsAnimating(ANIMATION_TYPE animType)
   return CGUIControlGroup::IsAnimating(animType);
 }
 
-bool CGUIWindow::RenderAnimation(unsigned int time)
+void CGUIWindow::Animate(unsigned int currentTime)
 {
-  g_graphicsContext.ResetWindowTransform();
   if (m_animationsEnabled)
-    CGUIControlGroup::Animate(time);
+    CGUIControlGroup::Animate(currentTime);
   else
+  {
     m_transform.Reset();
+    g_graphicsContext.AddTransform(m_transform);
+  }
+}
+
+bool CGUIWindow::RenderAnimation(unsigned int time)
+{
+  // our animation has been computed in DoProcess(), so just apply it
+  g_graphicsContext.ResetWindowTransform();
+  g_graphicsContext.AddTransform(m_transform);
   return true;
 }
 
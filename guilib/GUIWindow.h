@@ -93,6 +93,15 @@ public:
    \sa FrameMove
    */
   virtual void Render();
+
+  /*! \brief Main processing function, called every frame prior to rendering
+   Sets up the window's coordinate system and animation, then processes the controls,
+   accumulating the regions of the screen that have changed since the last frame.
+   Windows that draw themselves (rather than via their controls) should override Process()
+   and mark themselves dirty.
+   \sa Render, CGUIControl::DoProcess
+   */
+  virtual void DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   
   /*! \brief Main update function, called every frame prior to rendering
    Any window that requires updating on a frame by frame basis (such as to maintain
@@ -218,6 +227,7 @@ protected:
   virtual void OnInitWindow();
   virtual void OnDeinitWindow(int nextWindowID);
   EVENT_RESULT OnMouseAction(const CAction &action);
+  virtual void Animate(unsigned int currentTime);
   virtual bool RenderAnimation(unsigned int time);
   virtual bool CheckAnimation(ANIMATION_TYPE animType);
 
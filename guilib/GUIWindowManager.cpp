@@ -30,6 +30,8 @@
 #include "GUISettings.h"
 #include "Settings.h"
 #include "addons/Skin.h"
+#include "AdvancedSettings.h"
+#include "GUITexture.h"
 
 using namespace std;
 
@@ -39,6 +41,7 @@ CGUIWindowManager::CGUIWindowManager(void)
   m_bShowOverlay = true;
   m_iNested = 0;
   m_initialized = false;
+  m_redrawAll = true;
 }
 
 CGUIWindowManager::~CGUIWindowManager(void)
@@ -490,10 +493,89 @@ bool RenderOrderSortFunction(CGUIWindow *first, CGUIWindow *second)
   return first->GetRenderOrder() < second->GetRenderOrder();
 }
 
+void CGUIWindowManager::ProcessWindows(unsigned int currentTime)
+{
+  assert(g_application.IsCurrentThread());
+  CSingleLock lock(g_graphicsContext);
+
+  CDirtyRegionList dirtyregions;
+  vector<CGUIWindow *> windows;
+  CGUIWindow* pWindow = GetWindow(GetActiveWindow());
+  if (pWindow)
+  {
+    pWindow->DoProcess(currentTime, dirtyregions);
+    windows.push_back(pWindow);
+  }
+
+  // process the running dialogs - we take a copy of the vector as some dialogs may close themselves
+  vector<CGUIWindow *> dialogs = m_activeDialogs;
+  for (iDialog it = dialogs.begin(); it != dialogs.end(); ++it)
+  {
+    if ((*it)->IsDialogRunning())
+    {
+      (*it)->DoProcess(currentTime, dirtyregions);
+      windows.push_back(*it);
+    }
+  }
+
+  // a window opening or closing uncovers parts of the screen that its controls knew nothing about
+  if (windows != m_processedWindows)
+  {
+    m_processedWindows = windows;
+    MarkDirty();
+  }
+  for (CDirtyRegionList::const_iterator i = dirtyregions.begin(); i != dirtyregions.end(); ++i)
+    MarkDirty(*i);
+}
+
+void CGUIWindowManager::MarkDirty()
+{
+  m_redrawAll = true;
+}
+
+void CGUIWindowManager::MarkDirty(const CRect &rect)
+{
+  m_dirtyRegions.push_back(rect);
+}
+
+bool CGUIWindowManager::NeedsRender() const
+{
+  return m_redrawAll || !m_dirtyRegions.empty() || g_advancedSettings.m_guiDirtyRegionMode == DIRTYREGION_MODE_OFF;
+}
+
 void CGUIWindowManager::Render()
 {
   assert(g_application.IsCurrentThread());
   CSingleLock lock(g_graphicsContext);
+
+  // work out the region that has changed since the last frame, padded to whole pixels to
+  // allow for antialiased edges
+  CRect screen(0, 0, (float)g_graphicsContext.GetWidth(), (float)g_graphicsContext.GetHeight());
+  CRect dirty;
+  if (m_redrawAll)
+    dirty = screen;
+  else
+  {
+    for (CDirtyRegionList::const_iterator i = m_dirtyRegions.begin(); i != m_dirtyRegions.end(); ++i)
+      dirty.Union(*i);
+    if (!dirty.IsEmpty())
+    {
+      dirty = CRect(floorf(dirty.x1) - 1, floorf(dirty.y1) - 1, ceilf(dirty.x2) + 1, ceilf(dirty.y2) + 1);
+      dirty.Intersect(screen);
+    }
+  }
+
+  // the back buffer was last drawn the frame before last, so we redraw what changed
+  // in the last rendered frame as well as in this one
+  bool scissor = g_advancedSettings.m_guiDirtyRegionMode == DIRTYREGION_MODE_PARTIAL &&
+                 !g_advancedSettings.m_guiVisualizeDirtyRegions && !m_redrawAll;
+  if (scissor)
+  {
+    CRect redraw(dirty);
+    redraw.Union(m_lastDirtyRegion);
+    g_graphicsContext.SetScissors(redraw);
+  }
+
   CGUIWindow* pWindow = GetWindow(GetActiveWindow());
   if (pWindow)
   {
@@ -510,6 +592,24 @@ void CGUIWindowManager::Render()
     if ((*it)->IsDialogRunning())
       (*it)->Render();
   }
+
+  if (scissor)
+    g_graphicsContext.ResetScissors();
+
+  if (g_advancedSettings.m_guiVisualizeDirtyRegions)
+    RenderDirtyRegions();
+
+  m_lastDirtyRegion = dirty;
+  m_dirtyRegions.clear();
+  m_redrawAll = false;
+}
+
+void CGUIWindowManager::RenderDirtyRegions() const
+{
+  // the screen is redrawn in full while visualizing, so the overlay doesn't linger
+  g_graphicsContext.SetRenderingResolution(g_graphicsContext.GetVideoResolution(), false);
+  for (CDirtyRegionList::const_iterator i = m_dirtyRegions.begin(); i != m_dirtyRegions.end(); ++i)
+    CGUITexture::DrawQuad(*i, 0x4cff00ff);
 }
 
 void CGUIWindowManager::FrameMove()
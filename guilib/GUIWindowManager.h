@@ -67,12 +67,39 @@ public:
   // currently focused window(s).  Returns true only if the message is handled.
   bool OnAction(const CAction &action);
 
+  /*! \brief Processing of the current window and any dialogs prior to rendering
+   ProcessWindows is called every frame to update the controls of the current window
+   and any dialogs, and to determine which regions of the screen have changed.
+   It should only be called from the application thread.
+   \param currentTime the frame time in ms.
+   \sa Render, NeedsRender
+   */
+  void ProcessWindows(unsigned int currentTime);
+
   /*! \brief Rendering of the current window and any dialogs
    Render is called every frame to draw the current window and any dialogs.
+   Depending on the <gui><algorithmdirtyregions> advanced setting, only the regions
+   that have changed since they were last drawn into the back buffer are redrawn.
    It should only be called from the application thread.
+   \sa ProcessWindows
    */
   void Render();
 
+  /*! \brief Mark the whole screen as needing redrawing this frame
+   Used for anything not drawn via a window's controls, such as fullscreen video or overlays.
+   */
+  void MarkDirty();
+
+  /*! \brief Mark a region of the screen as needing redrawing this frame
+   \param rect the region in screen coordinates.
+   */
+  void MarkDirty(const CRect &rect);
+
+  /*! \brief Whether anything on screen has changed, and so the frame needs rendering.
+   \return true if the frame needs rendering, false if the last rendered frame is still current.
+   */
+  bool NeedsRender() const;
+
   /*! \brief Per-frame updating of the current window and any dialogs
    FrameMove is called every frame to update the current window and any dialogs
    on screen. It should only be called from the application thread.
@@ -124,6 +151,7 @@ private:
   void AddToWindowHistory(int newWindowID);
   void ClearWindowHistory();
   CGUIWindow *GetTopMostDialog() const;
+  void RenderDirtyRegions() const;
 
   friend class CApplicationMessenger;
   void ActivateWindow_Internal(int windowID, const std::vector<CStdString> &params, bool swappingWindows);
@@ -148,6 +176,11 @@ private:
   bool m_bShowOverlay;
   int  m_iNested;
   bool m_initialized;
+
+  CDirtyRegionList          m_dirtyRegions;     ///< regions of the screen that have changed this frame
+  bool                      m_redrawAll;        ///< whether the whole screen has changed this frame
+  CRect                     m_lastDirtyRegion;  ///< the region that changed in the last rendered frame
+  std::vector<CGUIWindow *> m_processedWindows; ///< the windows processed in the last frame
 };
 
 /*!
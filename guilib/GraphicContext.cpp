@@ -51,6 +51,7 @@ CGraphicContext::CGraphicContext(void)
   m_guiScaleX = m_guiScaleY = 1.0f;
   m_windowResolution = RES_INVALID;
   m_bFullScreenRoot = false;
+  m_scissorsActive = false;
 }
 
 CGraphicContext::~CGraphicContext(void)
@@ -207,6 +208,7 @@ bool CGraphicContext::SetViewPort(float fx, float fy, float fwidth, float fheigh
 
   CRect newviewport((float)newLeft, (float)newTop, (float)newRight, (float)newBottom);
   g_Windowing.SetViewPort(newviewport);
+  ApplyScissors(newviewport);
 
   m_viewStack.push(oldviewport);
 
@@ -220,12 +222,38 @@ void CGraphicContext::RestoreViewPort()
 
   CRect oldviewport = m_viewStack.top();
   g_Windowing.SetViewPort(oldviewport);
+  ApplyScissors(oldviewport);
 
   m_viewStack.pop();
 
   UpdateCameraPosition(m_cameras.top());
 }
 
+void CGraphicContext::SetScissors(const CRect &rect)
+{
+  m_scissors = rect;
+  m_scissors.Intersect(CRect(0, 0, (float)m_iScreenWidth, (float)m_iScreenHeight));
+  m_scissorsActive = true;
+  CRect viewport;
+  g_Windowing.GetViewPort(viewport);
+  ApplyScissors(viewport);
+}
+
+void CGraphicContext::ResetScissors()
+{
+  m_scissorsActive = false;
+  g_Windowing.ResetScissors();
+}
+
+void CGraphicContext::ApplyScissors(const CRect &viewport)
+{
+  if (!m_scissorsActive)
+    return;
+  CRect scissors(m_scissors);
+  scissors.Intersect(viewport);
+  g_Windowing.SetScissors(scissors);
+}
+
 const CRect& CGraphicContext::GetViewWindow() const
 {
   return m_videoRect;
@@ -615,6 +643,24 @@ void CGraphicContext::UpdateFinalTransform(const TransformMatrix &matrix)
   // the nearest pixel (vertex shader perhaps?)
 }
 
+CRect CGraphicContext::ScaleFinalRect(const CRect &rect) const
+{
+  // transform the corners of the rectangle, and take their bounding box
+  float x[4] = { rect.x1, rect.x2, rect.x2, rect.x1 };
+  float y[4] = { rect.y1, rect.y1, rect.y2, rect.y2 };
+  CRect result;
+  for (unsigned int i = 0; i < 4; i++)
+  {
+    float screenX = ScaleFinalXCoord(x[i], y[i]);
+    float screenY = ScaleFinalYCoord(x[i], y[i]);
+    if (!i || screenX < result.x1) result.x1 = screenX;
+    if (!i || screenX > result.x2) result.x2 = screenX;
+    if (!i || screenY < result.y1) result.y1 = screenY;
+    if (!i || screenY > result.y2) result.y2 = screenY;
+  }
+  return result;
+}
+
 void CGraphicContext::InvertFinalCoords(float &x, float &y) const
 {
   m_finalTransform.InverseTransformPosition(x, y);
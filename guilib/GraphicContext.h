@@ -79,6 +79,14 @@ public:
   bool IsWidescreen() const { return m_bWidescreen; }
   bool SetViewPort(float fx, float fy , float fwidth, float fheight, bool intersectPrevious = false);
   void RestoreViewPort();
+
+  /*! \brief Restrict all drawing to a region of the screen, such as the part of the GUI that has changed
+   The region applies in addition to any viewport set while it is active.
+   \param rect the region in screen coordinates.
+   \sa ResetScissors
+   */
+  void SetScissors(const CRect &rect);
+  void ResetScissors();
   const CRect& GetViewWindow() const;
   void SetViewWindow(float left, float top, float right, float bottom);
   bool IsFullScreenRoot() const;
@@ -111,6 +119,7 @@ public:
   inline float ScaleFinalYCoord(float x, float y) const XBMC_FORCE_INLINE { return m_finalTransform.TransformYCoord(x, y, 0); }
   inline float ScaleFinalZCoord(float x, float y) const XBMC_FORCE_INLINE { return m_finalTransform.TransformZCoord(x, y, 0); }
   inline void ScaleFinalCoords(float &x, float &y, float &z) const XBMC_FORCE_INLINE { m_finalTransform.TransformPosition(x, y, z); }
+  CRect ScaleFinalRect(const CRect &rect) const; ///< screen space bounding box of a transformed rectangle
   bool RectIsAngled(float x1, float y1, float x2, float y2) const;
 
   inline float GetGUIScaleX() const XBMC_FORCE_INLINE { return m_guiScaleX; }
@@ -190,8 +199,11 @@ public:
 
 protected:
   void SetFullScreenViewWindow(RESOLUTION &res);
+  void ApplyScissors(const CRect &viewport);
 
   std::stack<CRect> m_viewStack;
+  CRect m_scissors;     ///< region drawing is restricted to
+  bool m_scissorsActive; ///< whether drawing is restricted to m_scissors
 
   int m_iScreenHeight;
   int m_iScreenWidth;
@@ -27,6 +27,7 @@
 #include "utils/log.h"
 #include "addons/Skin.h"
 #include "GUISettings.h"
+#include "AdvancedSettings.h"
 #include "Util.h"
 #include "FileSystem/SpecialProtocol.h"
 #include "utils/EndianSwap.h"
@@ -82,8 +83,8 @@ bool CTextureBundleXBT::OpenBundle()
 
   strPath = PTH_IC(strPath);
 
-  // Load the texture file
-  if (!m_XBTFReader.Open(strPath))
+  // Load the texture file, mapping it only if asked to, as for the player's files
+  if (!m_XBTFReader.Open(strPath, g_advancedSettings.m_memoryMapFiles))
   {
     return false;
   }
@@ -196,50 +197,79 @@ int CTextureBundleXBT::LoadAnim(const CStdString& Filename, CBaseTexture*** ppTe
 
 bool CTextureBundleXBT::ConvertFrameToTexture(const CStdString& name, CXBTFFrame& frame, CBaseTexture** ppTexture)
 {
-  // found texture - allocate the necessary buffers
-  squish::u8 *buffer = new squish::u8[(size_t)frame.GetPackedSize()];
-  if (buffer == NULL)
+  // found texture - use the data straight from the mapped bundle if we can, else read it into a buffer
+  squish::u8 *buffer = NULL;
+  const squish::u8 *data = m_XBTFReader.GetFrameData(frame);
+  if (!data)
   {
-    CLog::Log(LOGERROR, "Out of memory loading texture: %s (need %"PRIu64" bytes)", name.c_str(), frame.GetPackedSize());
-    return false;
-  }
+    buffer = new squish::u8[(size_t)frame.GetPackedSize()];
+    if (buffer == NULL)
+    {
+      CLog::Log(LOGERROR, "Out of memory loading texture: %s (need %"PRIu64" bytes)", name.c_str(), frame.GetPackedSize());
+      return false;
+    }
 
-  // load the compressed texture
-  if (!m_XBTFReader.Load(frame, buffer))
-  {
-    CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
-    delete[] buffer;
-    return false;
+    // load the compressed texture
+    if (!m_XBTFReader.Load(frame, buffer))
+    {
+      CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
+      delete[] buffer;
+      return false;
+    }
+    data = buffer;
   }
 
+  // create an xbmc texture
+  CBaseTexture *texture = new CTexture();
+
   // check if it's packed with lzo
   if (frame.IsPacked())
-  { // unpack
-    squish::u8 *unpacked = new squish::u8[(size_t)frame.GetUnpackedSize()];
+  {
+    // unpack straight into the texture's pixels if their layout matches the unpacked frame
+    // (no padding or format conversion needed), else unpack into a buffer first
+    bool direct = !((frame.GetFormat() & XB_FMT_DXT_MASK) && !g_Windowing.SupportsDXT());
+    if (direct)
+    {
+      texture->Allocate(frame.GetWidth(), frame.GetHeight(), frame.GetFormat());
+      direct = texture->GetPixels() &&
+               texture->GetWidth() == frame.GetWidth() && texture->GetTextureWidth() == frame.GetWidth() &&
+               texture->GetHeight() == frame.GetHeight() &&
+               (uint64_t)texture->GetPitch() * texture->GetRows() >= frame.GetUnpackedSize();
+    }
+
+    squish::u8 *unpacked = direct ? texture->GetPixels() : new squish::u8[(size_t)frame.GetUnpackedSize()];
     if (unpacked == NULL)
     {
       CLog::Log(LOGERROR, "Out of memory unpacking texture: %s (need %"PRIu64" bytes)", name.c_str(), frame.GetUnpackedSize());
       delete[] buffer;
+      delete texture;
       return false;
     }
     lzo_uint s = (lzo_uint)frame.GetUnpackedSize();
-    if (lzo1x_decompress(buffer, (lzo_uint)frame.GetPackedSize(), unpacked, &s, NULL) != LZO_E_OK ||
+    if (lzo1x_decompress(data, (lzo_uint)frame.GetPackedSize(), unpacked, &s, NULL) != LZO_E_OK ||
         s != frame.GetUnpackedSize())
     {
       CLog::Log(LOGERROR, "Error loading texture: %s: Decompression error", name.c_str());
       delete[] buffer;
-      delete[] unpacked;
+      if (!direct)
+        delete[] unpacked;
+      delete texture;
       return false;
     }
-    delete[] buffer;
-    buffer = unpacked;
-  }
 
-  // create an xbmc texture
-  *ppTexture = new CTexture();
-  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), buffer);
+    if (direct)
+      texture->ClampToEdge();
+    else
+    {
+      texture->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), unpacked);
+      delete[] unpacked;
+    }
+  }
+  else
+    texture->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), data);
 
   delete[] buffer;
+  *ppTexture = texture;
 
   return true;
 }
@@ -20,12 +20,16 @@
  */
 
 #include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
 #include "XBTFReader.h"
 #include "EndianSwap.h"
 #include "CharsetConverter.h"
 #ifdef _WIN32
 #include "FileSystem/SpecialProtocol.h"
 #include "PlatformDefs.h" //for PRIdS, PRId64
+#include <io.h>
 #endif
 
 #define READ_STR(str, size, file) \
@@ -45,6 +49,9 @@
 CXBTFReader::CXBTFReader()
 {
   m_file = NULL;
+  m_map = NULL;
+  m_mapSize = 0;
+  m_mapTime = 0;
 }
 
 bool CXBTFReader::IsOpen() const
@@ -52,7 +59,7 @@ bool CXBTFReader::IsOpen() const
   return m_file != NULL;
 }
 
-bool CXBTFReader::Open(const CStdString& fileName)
+bool CXBTFReader::Open(const CStdString& fileName, bool mapFile)
 {
   m_fileName = fileName;
 
@@ -134,11 +141,54 @@ bool CXBTFReader::Open(const CStdString& fileName)
     return false;
   }
 
+  // map the bundle into memory so that the frames can be accessed without seeking and copying.
+  // if that fails we fall back to reading the frames from the file
+  if (mapFile)
+    MapFile();
+
   return true;
 }
 
+void CXBTFReader::MapFile()
+{
+  struct stat fileStat;
+  if (fstat(fileno(m_file), &fileStat) == -1 || fileStat.st_size <= 0 || (uint64_t)fileStat.st_size != (size_t)fileStat.st_size)
+    return;
+
+#ifdef _WIN32
+  HANDLE mapping = CreateFileMapping((HANDLE)_get_osfhandle(_fileno(m_file)), NULL, PAGE_READONLY, 0, 0, NULL);
+  if (!mapping)
+    return;
+  m_map = (unsigned char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping); // the view keeps the mapping alive
+#else
+  void *map = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_SHARED, fileno(m_file), 0);
+  m_map = (map == MAP_FAILED) ? NULL : (unsigned char *)map;
+#endif
+  if (m_map)
+  {
+    m_mapSize = fileStat.st_size;
+    m_mapTime = fileStat.st_mtime;
+  }
+}
+
+void CXBTFReader::UnmapFile()
+{
+  if (m_map)
+  {
+#ifdef _WIN32
+    UnmapViewOfFile(m_map);
+#else
+    munmap(m_map, (size_t)m_mapSize);
+#endif
+    m_map = NULL;
+    m_mapSize = 0;
+  }
+}
+
 void CXBTFReader::Close()
 {
+  UnmapFile();
   if (m_file)
   {
     fclose(m_file);
@@ -181,12 +231,37 @@ CXBTFFile* CXBTFReader::Find(const CStdString& name)
   return &(iter->second);
 }
 
+const unsigned char* CXBTFReader::GetFrameData(const CXBTFFrame& frame) const
+{
+  if (!m_map || frame.GetOffset() > m_mapSize || frame.GetPackedSize() > m_mapSize - frame.GetOffset())
+  {
+    return NULL;
+  }
+
+  // touching pages past the end of a mapped file that was truncated raises SIGBUS, so only use
+  // the mapping while the bundle is unchanged, eg. not while a skin update is rewriting it
+  struct stat fileStat;
+  if (fstat(fileno(m_file), &fileStat) == -1 || (uint64_t)fileStat.st_size != m_mapSize || fileStat.st_mtime != m_mapTime)
+  {
+    return NULL;
+  }
+
+  return m_map + frame.GetOffset();
+}
+
 bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer)
 {
   if (!m_file)
   {
     return false;
   }
+
+  const unsigned char* data = GetFrameData(frame);
+  if (data)
+  {
+    memcpy(buffer, data, (size_t)frame.GetPackedSize());
+    return true;
+  }
 #if defined(__APPLE__)
     if (fseeko(m_file, (off_t)frame.GetOffset(), SEEK_SET) == -1)
 #else
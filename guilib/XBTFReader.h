@@ -32,18 +32,37 @@ class CXBTFReader
 public:
   CXBTFReader();
   bool IsOpen() const;
-  bool Open(const CStdString& fileName);
+  /*! \brief Open a texture bundle.
+   \param fileName the bundle to open.
+   \param mapFile whether to map the bundle into memory, so that GetFrameData() can hand out the
+   frames without copying them. Rewriting a mapped file in place may raise SIGBUS, so this is opt-in.
+   */
+  bool Open(const CStdString& fileName, bool mapFile = false);
   void Close();
   time_t GetLastModificationTimestamp();
   bool Exists(const CStdString& name);
   CXBTFFile* Find(const CStdString& name);
   bool Load(const CXBTFFrame& frame, unsigned char* buffer);
+
+  /*! \brief Get a read-only view of the (packed) data of a frame, without copying it.
+   The view is only valid until the reader is closed.
+   \param frame the frame to get the data of.
+   \return a pointer into the memory mapped bundle, or NULL if the bundle isn't mapped or has changed
+   since it was mapped, in which case the data should be read via Load().
+   */
+  const unsigned char* GetFrameData(const CXBTFFrame& frame) const;
   std::vector<CXBTFFile>&  GetFiles();
 
 private:
+  void MapFile();
+  void UnmapFile();
+
   CXBTF      m_xbtf;
   CStdString m_fileName;
   FILE*      m_file;
+  unsigned char* m_map;     ///< the whole bundle mapped read-only into memory, or NULL
+  uint64_t   m_mapSize;
+  time_t     m_mapTime;     ///< modification time of the bundle when it was mapped
   std::map<CStdString, CXBTFFile> m_filesMap;
 };
 
@@ -0,0 +1,277 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+// Times loading a cached listing of movies the way CFileItemList::Load() does, through CArchive:
+// with a read per field, as CArchive loaded before it buffered its reads, then buffered, and then
+// buffered with the strings in a string table, as the disc cache is now stored.  The items stand in
+// for a CFileItem with a video info tag: a few dozen strings, many of them shared across the
+// library (genres, studios, cast, paths), and some numbers.  Checks that each load gives back the
+// items that were stored.
+//
+// usage: ArchiveBenchmark [items] [folder for the cache file]
+
+#include "Archive.h"
+#include "FileSystem/File.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using namespace XFILE;
+
+static double Now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+// the loading of CArchive before it buffered its reads: a CFile::Read() per field
+class COldArchive
+{
+public:
+  COldArchive(CFile *file) : m_file(file) {}
+  COldArchive& operator>>(int& i)         { m_file->Read(&i, sizeof(i)); return *this; }
+  COldArchive& operator>>(float& f)       { m_file->Read(&f, sizeof(f)); return *this; }
+  COldArchive& operator>>(int64_t& i64)   { m_file->Read(&i64, sizeof(i64)); return *this; }
+  COldArchive& operator>>(SYSTEMTIME& st) { m_file->Read(&st, sizeof(st)); return *this; }
+  COldArchive& operator>>(CStdString& str)
+  {
+    int length = 0;
+    *this >> length;
+    m_file->Read(str.GetBufferSetLength(length), length);
+    str.ReleaseBuffer();
+    return *this;
+  }
+private:
+  CFile *m_file;
+};
+
+#define ITEM_STRINGS 32
+
+// a movie of the listing, in the order CFileItem::Archive() and CVideoInfoTag::Archive() go
+struct SItem
+{
+  CStdString strings[ITEM_STRINGS];
+  int        ints[6];
+  float      rating;
+  int64_t    size;
+  SYSTEMTIME date;
+
+  template<class A> void Save(A &ar)
+  {
+    for (int i = 0; i < ITEM_STRINGS; i++)
+      ar << strings[i];
+    for (int i = 0; i < 6; i++)
+      ar << ints[i];
+    ar << rating;
+    ar << size;
+    ar << date;
+  }
+  template<class A> void Load(A &ar)
+  {
+    for (int i = 0; i < ITEM_STRINGS; i++)
+      ar >> strings[i];
+    for (int i = 0; i < 6; i++)
+      ar >> ints[i];
+    ar >> rating;
+    ar >> size;
+    ar >> date;
+  }
+  bool operator==(const SItem &right) const
+  {
+    for (int i = 0; i < ITEM_STRINGS; i++)
+    {
+      if (strings[i] != right.strings[i])
+        return false;
+    }
+    return !memcmp(ints, right.ints, sizeof(ints)) && rating == right.rating && size == right.size &&
+           !memcmp(&date, &right.date, sizeof(date));
+  }
+};
+
+static const char *genres[] = { "Action", "Comedy", "Drama", "Thriller", "Animation", "Documentary", "Horror", "Romance" };
+static const char *studios[] = { "Warner Bros. Pictures", "Universal Pictures", "Paramount Pictures", "20th Century Fox", "Columbia Pictures" };
+static const char *countries[] = { "USA", "United Kingdom", "France", "Germany" };
+static const char *ratings[] = { "Rated G", "Rated PG", "Rated PG-13", "Rated R" };
+
+static vector<SItem> MakeItems(int count)
+{
+  vector<SItem> items(count);
+  char text[256];
+  for (int i = 0; i < count; i++)
+  {
+    SItem &item = items[i];
+    int s = 0;
+    sprintf(text, "/media/movies/Movie %d (%d)/Movie %d.mkv", i, 1950 + i % 60, i);
+    item.strings[s++] = text;                               // path
+    sprintf(text, "Movie %d", i);
+    item.strings[s++] = text;                               // label
+    item.strings[s++] = "";                                 // label2
+    sprintf(text, "special://masterprofile/Thumbnails/Video/%x/%08x.tbn", i % 16, i * 2654435761u);
+    item.strings[s++] = text;                               // thumbnail
+    item.strings[s++] = item.strings[1];                    // title
+    item.strings[s++] = item.strings[1];                    // original title
+    sprintf(text, "Plot of movie %d, which goes on for a while to describe what happens in it without giving away the ending.", i);
+    item.strings[s++] = text;                               // plot
+    item.strings[s++] = "";                                 // plot outline
+    item.strings[s++] = "";                                 // tagline
+    item.strings[s++] = CStdString(genres[i % 8]) + " / " + genres[(i / 8) % 8]; // genre
+    sprintf(text, "Director %d", i % 500);
+    item.strings[s++] = text;                               // director
+    sprintf(text, "Writer %d", i % 700);
+    item.strings[s++] = text;                               // writer
+    item.strings[s++] = studios[i % 5];                     // studio
+    item.strings[s++] = countries[i % 4];                   // country
+    item.strings[s++] = ratings[i % 4];                     // mpaa
+    item.strings[s++] = "";                                 // trailer
+    sprintf(text, "Movie %d.mkv", i);
+    item.strings[s++] = text;                               // file name
+    sprintf(text, "/media/movies/Movie %d (%d)/", i, 1950 + i % 60);
+    item.strings[s++] = text;                               // folder
+    sprintf(text, "tt%07d", 100000 + i);
+    item.strings[s++] = text;                               // imdb number
+    sprintf(text, "%d-01-01", 1950 + i % 60);
+    item.strings[s++] = text;                               // premiered
+    for (int c = 0; c < 5; c++)
+    {                                                       // cast and roles
+      sprintf(text, "Actor %d", (i * 7 + c * 131) % 3000);
+      item.strings[s++] = text;
+      sprintf(text, "Role %d", (i + c) % 40);
+      item.strings[s++] = text;
+    }
+    item.strings[s++] = "overlay";                          // a property
+    item.strings[s++] = "6";
+    for (int n = 0; n < 6; n++)
+      item.ints[n] = i * 6 + n;
+    item.rating = (i % 100) / 10.0f;
+    item.size = (int64_t)i * 1000000007;
+    memset(&item.date, 0, sizeof(item.date));
+    item.date.wYear = 2000 + i % 10;
+    item.date.wDay = 1 + i % 28;
+  }
+  return items;
+}
+
+static void Save(const vector<SItem> &items, const CStdString &file, bool stringTable)
+{
+  CFile out;
+  if (!out.OpenForWrite(file, true))
+  {
+    printf("can't create %s\n", file.c_str());
+    exit(1);
+  }
+  CArchive ar(&out, CArchive::store);
+  if (stringTable)
+    ar.UseStringTable();
+  ar << (int)items.size();
+  for (unsigned int i = 0; i < items.size(); i++)
+    const_cast<SItem &>(items[i]).Save(ar);
+  ar.Close();
+}
+
+enum Method { PER_FIELD, BUFFERED, STRING_TABLE };
+
+static const char *methods[] = { "a read per field", "buffered", "buffered, string table" };
+
+static unsigned int Load(Method method, const CStdString &file, vector<SItem> &items)
+{
+  CFile in;
+  if (!in.Open(file))
+  {
+    printf("can't open %s\n", file.c_str());
+    exit(1);
+  }
+  int count = 0;
+  if (method == PER_FIELD)
+  {
+    COldArchive ar(&in);
+    ar >> count;
+    items.resize(count);
+    for (int i = 0; i < count; i++)
+      items[i].Load(ar);
+  }
+  else
+  {
+    CArchive ar(&in, CArchive::load);
+    if (method == STRING_TABLE && !ar.UseStringTable())
+      printf("no string table in %s\n", file.c_str());
+    ar >> count;
+    items.resize(count);
+    for (int i = 0; i < count; i++)
+      items[i].Load(ar);
+    ar.Close();
+  }
+  return in.m_reads;
+}
+
+int main(int argc, char *argv[])
+{
+  int count = argc > 1 ? atoi(argv[1]) : 20000;
+  CStdString folder = argc > 2 ? argv[2] : ".";
+  CStdString plainFile, tableFile;
+  plainFile.Format("%s/ArchiveBenchmark%d.fi", folder.c_str(), (int)getpid());
+  tableFile.Format("%s/ArchiveBenchmark%d-table.fi", folder.c_str(), (int)getpid());
+
+  vector<SItem> items = MakeItems(count);
+  Save(items, plainFile, false);
+  Save(items, tableFile, true);
+  CFile file;
+  file.Open(plainFile);
+  int64_t plainSize = file.GetLength();
+  file.Open(tableFile);
+  int64_t tableSize = file.GetLength();
+  file.Close();
+  printf("loading %d movies, %.1f MB cached (%.1f MB with a string table):\n", count, plainSize / 1048576.0, tableSize / 1048576.0);
+
+  int errors = 0;
+  for (int method = PER_FIELD; method <= STRING_TABLE; method++)
+  {
+    // the best of a few runs, as the file is in the page cache after the first anyway
+    double best = 0;
+    unsigned int reads = 0;
+    bool same = true;
+    for (int run = 0; run < 3; run++)
+    {
+      vector<SItem> loaded;
+      double start = Now();
+      reads = Load((Method)method, method == STRING_TABLE ? tableFile : plainFile, loaded);
+      double elapsed = Now() - start;
+      if (!run || elapsed < best)
+        best = elapsed;
+      same = loaded.size() == items.size();
+      for (unsigned int i = 0; same && i < items.size(); i++)
+        same = loaded[i] == items[i];
+    }
+    printf("  %-24s %8.1f ms, %8u reads\n", methods[method], best * 1000, reads);
+    if (!same)
+    {
+      printf("  %s gave back different items\n", methods[method]);
+      errors++;
+    }
+  }
+  unlink(plainFile.c_str());
+  unlink(tableFile.c_str());
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+// Times the writes of a library scan to a sqlite database on disk: each item is a file and the
+// streams of it, as CVideoDatabase::SetStreamDetailsForFileId() writes them.  The items are
+// written with a transaction each, as the scanners did before batching, then with the
+// transactions of several items committed at once, as CDatabase::BatchItemDone() does, and
+// then also with the stream rows inserted through the prepared statements of
+// Database::insert_rows().  Checks that all three leave the same rows behind.
+//
+// usage: DatabaseBenchmark [items] [items per transaction] [folder for the database]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "sqlitedataset.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dbiplus;
+
+static double Now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+enum Method { ONE_PER_ITEM, BATCHED, BATCHED_PREPARED };
+
+static const char *methods[] = { "a transaction per item", "batched", "batched and prepared" };
+
+static const char *codecs[] = { "h264", "ac3", "dca", "aac" };
+static const char *languages[] = { "eng", "fre", "ger", "spa" };
+
+// writes the items and returns a checksum of the rows left in the database
+static double Scan(Method method, int items, int batchSize, const string &folder, string &rows)
+{
+  char name[64];
+  sprintf(name, "DatabaseBenchmark%d", (int)getpid());
+  string file = folder + "/" + name + ".db";
+  unlink(file.c_str());
+
+  SqliteDatabase db;
+  db.setHostName(folder.c_str());
+  db.setDatabase(name);
+  if (db.connect() != DB_CONNECTION_OK)
+  {
+    printf("can't create %s\n", file.c_str());
+    exit(1);
+  }
+  Dataset *ds = db.CreateDataset();
+  ds->exec("CREATE TABLE files (idFile integer primary key, strFilename text)");
+  ds->exec("CREATE TABLE streamdetails (idFile integer, iStreamType integer, strCodec text, iChannels integer, strLanguage text)");
+
+  double start = Now();
+  int pending = 0;
+  for (int item = 0; item < items; item++)
+  {
+    if (!pending)
+      db.start_transaction();
+
+    char filename[64];
+    sprintf(filename, "movie %d.mkv", item);
+    ds->exec(db.prepare("INSERT INTO files (idFile, strFilename) VALUES (NULL, '%s')", filename));
+    int idFile = (int)ds->lastinsertid();
+
+    // a video stream, a couple of audio streams and a subtitle
+    vector< vector<string> > streams;
+    for (int stream = 0; stream < 4; stream++)
+    {
+      vector<string> row;
+      row.push_back(db.prepare("%i", idFile));
+      row.push_back(db.prepare("%i", stream == 0 ? 0 : (stream == 3 ? 2 : 1)));
+      row.push_back(codecs[stream]);
+      row.push_back(db.prepare("%i", stream == 0 ? 0 : 2 + 4 * (item % 2)));
+      row.push_back(languages[(item + stream) % 4]);
+      streams.push_back(row);
+    }
+    if (method == BATCHED_PREPARED)
+      db.insert_rows("streamdetails", "idFile, iStreamType, strCodec, iChannels, strLanguage", streams);
+    else
+    {
+      for (unsigned int i = 0; i < streams.size(); i++)
+        ds->exec(db.prepare("INSERT INTO streamdetails (idFile, iStreamType, strCodec, iChannels, strLanguage) VALUES (%s,%s,'%s',%s,'%s')",
+                            streams[i][0].c_str(), streams[i][1].c_str(), streams[i][2].c_str(), streams[i][3].c_str(), streams[i][4].c_str()));
+    }
+
+    if (++pending >= (method == ONE_PER_ITEM ? 1 : batchSize))
+    {
+      db.commit_transaction();
+      pending = 0;
+    }
+  }
+  if (pending)
+    db.commit_transaction();
+  double elapsed = Now() - start;
+
+  // everything that was written, to compare the methods
+  ds->query("SELECT files.idFile, strFilename, iStreamType, strCodec, iChannels, strLanguage, typeof(iChannels) FROM files JOIN streamdetails ON files.idFile = streamdetails.idFile ORDER BY files.idFile, iStreamType, strCodec");
+  rows.clear();
+  while (!ds->eof())
+  {
+    for (int field = 0; field < 7; field++)
+    {
+      rows += ds->fv(field).get_asString();
+      rows += "|";
+    }
+    rows += "\n";
+    ds->next();
+  }
+  ds->close();
+  delete ds;
+  db.disconnect();
+  unlink(file.c_str());
+  return elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+  int items = argc > 1 ? atoi(argv[1]) : 1000;
+  int batchSize = argc > 2 ? atoi(argv[2]) : 100;
+  string folder = argc > 3 ? argv[3] : ".";
+
+  printf("writing %d items of a file and 4 streams, %d items per batch:\n", items, batchSize);
+  string expected;
+  int errors = 0;
+  for (int method = ONE_PER_ITEM; method <= BATCHED_PREPARED; method++)
+  {
+    string rows;
+    double elapsed = Scan((Method)method, items, batchSize, folder, rows);
+    printf("  %-24s %8.1f ms, %6.3f ms per item\n", methods[method], elapsed * 1000, elapsed * 1000 / items);
+    if (method == ONE_PER_ITEM)
+      expected = rows;
+    else if (rows != expected)
+    {
+      printf("  %s left different rows behind\n", methods[method]);
+      errors++;
+    }
+  }
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,191 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+// Measures the gap at the change between the tracks of a gapless album, as CAudioDecoder plays
+// them.  A stereo sine is split into tracks, and each is "encoded" the way AAC encoders do, with
+// the 2112 samples of delay of iTunes at the start and padding up to a whole frame at the end.
+// The tracks are decoded in blocks of random size, as the codecs return them, and played one after
+// the other, without and with CEncoderTrim.  Checks that the trimmed tracks join up into exactly
+// the sine we started with, also when a track is seeked into, then times the trimming.
+//
+// usage: GaplessBenchmark [seconds of audio to time]
+
+#include "EncoderTrim.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace std;
+
+static const unsigned int channels   = 2;
+static const unsigned int sampleRate = 44100;
+static const unsigned int delay      = 2112;  // per channel, as iTunes AAC
+static const unsigned int frameSize  = 1024;  // AAC frame, the encoded length is a multiple of this
+
+static double Now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+struct STrack
+{
+  vector<float> encoded;  // what the decoder gives, delay and padding included
+  unsigned int  padding;  // per channel
+};
+
+// splits the source into tracks at the given frames, and adds the delay and padding to each
+static vector<STrack> Encode(const vector<float> &source, const vector<unsigned int> &splits)
+{
+  vector<STrack> tracks;
+  unsigned int start = 0;
+  for (unsigned int i = 0; i <= splits.size(); ++i)
+  {
+    unsigned int end = i < splits.size() ? splits[i] : source.size() / channels;
+    STrack track;
+    unsigned int frames = delay + end - start;
+    track.padding = (frameSize - frames % frameSize) % frameSize + frameSize;
+    track.encoded.assign(delay * channels, 0.0f);
+    track.encoded.insert(track.encoded.end(), source.begin() + start * channels, source.begin() + end * channels);
+    track.encoded.insert(track.encoded.end(), track.padding * channels, 0.0f);
+    tracks.push_back(track);
+    start = end;
+  }
+  return tracks;
+}
+
+// decodes a track in blocks, from the given frame, as CAudioDecoder::ReadSamples() does
+static void Play(const STrack &track, bool trim, unsigned int seekFrame, vector<float> &output)
+{
+  CEncoderTrim trimmer;
+  trimmer.Reset(trim ? delay * channels : 0, trim ? track.padding * channels : 0);
+  unsigned int pos = 0;
+  if (seekFrame)
+  {
+    trimmer.Flush();
+    pos = (delay + seekFrame) * channels;
+  }
+
+  float block[3840];
+  while (pos < track.encoded.size())
+  {
+    unsigned int samples = channels * (1 + rand() % (sizeof(block) / sizeof(float) / channels));
+    if (samples > track.encoded.size() - pos)
+      samples = track.encoded.size() - pos;
+    for (unsigned int i = 0; i < samples; ++i)
+      block[i] = track.encoded[pos + i];
+    pos += samples;
+    samples = trimmer.Trim(block, samples, pos == track.encoded.size());
+    output.insert(output.end(), block, block + samples);
+  }
+}
+
+// the frames between the end of the audio of one track and the start of the next
+static unsigned int Gap(const vector<STrack> &tracks, unsigned int track)
+{
+  return tracks[track].padding + delay;
+}
+
+int main(int argc, char *argv[])
+{
+  int seconds = argc > 1 ? atoi(argv[1]) : 600;
+  srand(1);
+
+  // a minute of a sine, in tracks of awkward lengths
+  vector<float> source(60 * sampleRate * channels);
+  for (unsigned int i = 0; i < source.size() / channels; ++i)
+    source[channels * i] = source[channels * i + 1] = 0.5 * sin(2 * M_PI * 440 * i / sampleRate);
+  vector<unsigned int> splits;
+  splits.push_back(12 * sampleRate + 17);
+  splits.push_back(31 * sampleRate + 1023);
+  splits.push_back(47 * sampleRate + 1);
+  vector<STrack> tracks = Encode(source, splits);
+
+  int errors = 0;
+  printf("the change between %u tracks of a sine, with %u samples of encoder delay:\n", (unsigned int)tracks.size(), delay);
+  for (int trim = 0; trim < 2; ++trim)
+  {
+    vector<float> output;
+    for (unsigned int t = 0; t < tracks.size(); ++t)
+      Play(tracks[t], trim != 0, 0, output);
+
+    if (!trim)
+    {
+      for (unsigned int t = 0; t + 1 < tracks.size(); ++t)
+        printf("  untrimmed: %4u samples of silence (%5.1f ms) between tracks %u and %u\n", Gap(tracks, t), Gap(tracks, t) * 1000.0 / sampleRate, t + 1, t + 2);
+      printf("  untrimmed: %u samples more than the source\n", (unsigned int)((output.size() - source.size()) / channels));
+    }
+    else
+    {
+      unsigned int differ = output.size() == source.size() ? 0 : 1;
+      for (unsigned int i = 0; !differ && i < source.size(); ++i)
+        differ += output[i] != source[i];
+      printf("  trimmed:   %s\n", differ ? "doesn't match the source" : "0 samples of silence, matches the source exactly");
+      errors += differ;
+    }
+  }
+
+  // seeking into a track: nothing is dropped at the new position, and the padding still is at the end
+  unsigned int seekFrame = 5 * sampleRate;
+  vector<float> output;
+  Play(tracks[1], true, seekFrame, output);
+  unsigned int first = splits[0] + seekFrame;
+  unsigned int expected = splits[1] - first;
+  bool seekOk = output.size() == expected * channels;
+  for (unsigned int i = 0; seekOk && i < output.size(); ++i)
+    seekOk = output[i] == source[first * channels + i];
+  printf("  seeked:    %s\n", seekOk ? "plays on from the new position to the end of the audio exactly" : "doesn't match the source");
+  errors += !seekOk;
+
+  // time the trimming of a track in 3840 sample blocks, as CAudioDecoder reads them (with the copy
+  // into the block, which the codec does there)
+  vector<float> track(sampleRate * channels);
+  for (unsigned int i = 0; i < track.size(); ++i)
+    track[i] = source[i];
+  float block[3840];
+  unsigned int played = 0;
+  double start = Now();
+  for (int second = 0; second < seconds; ++second)
+  {
+    CEncoderTrim trimmer;
+    trimmer.Reset(delay * channels, frameSize * channels);
+    for (unsigned int pos = 0; pos < track.size(); pos += 3840)
+    {
+      unsigned int samples = min(3840u, (unsigned int)track.size() - pos);
+      for (unsigned int i = 0; i < samples; ++i)
+        block[i] = track[pos + i];
+      played += trimmer.Trim(block, samples, pos + samples == track.size());
+    }
+  }
+  double elapsed = Now() - start;
+  printf("trimming %d s of stereo 44.1kHz: %7.1f ms, %.2f ns per sample, %u samples played\n",
+         seconds, elapsed * 1000, elapsed * 1e9 / ((double)seconds * track.size()), played);
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,227 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+// Checks that the CPCMRemap mixing kernels give exactly the output of the per sample loop that
+// CPCMRemap::Remap() used before them, on rounding edge cases and on random maps and input, then
+// times the old loop against the kernels on a 5.1 to stereo downmix.
+//
+// usage: PCMRemapBenchmark [seconds of audio to time]
+
+#include "PCMRemapKernels.h"
+#include "PCMRemap.h"
+#include "MathUtils.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <vector>
+
+using namespace std;
+
+// an output channel of a map: the inputs mixed into it and their levels, in map order
+struct SOutput
+{
+  int   count;
+  int   input[PCM_MAX_CH];
+  float level[PCM_MAX_CH];
+};
+
+// the loop of CPCMRemap::Remap() before the kernels, on interleaved input
+static void RemapOld(const int16_t *in, int inChannels, int16_t *out, const vector<SOutput> &map, int frames)
+{
+  for (int i = 0; i < frames; ++i)
+  {
+    for (unsigned int ch = 0; ch < map.size(); ++ch)
+    {
+      float value = 0;
+      for (int j = 0; j < map[ch].count; ++j)
+        value += (float)in[map[ch].input[j]] * map[ch].level[j];
+
+      //convert to signed int and clamp to 16 bit
+      int outvalue = MathUtils::round_int(value);
+      if (outvalue > INT16_MAX)
+        outvalue = INT16_MAX;
+      else if (outvalue < INT16_MIN)
+        outvalue = INT16_MIN;
+
+      out[ch] = outvalue;
+    }
+    in  += inChannels;
+    out += map.size();
+  }
+}
+
+// the way CPCMRemap::Remap() uses the kernels: split the input into float planes a block at a time,
+// then mix each output channel from those
+static void RemapNew(PCMMixFunc mix, const int16_t *in, int inChannels, int16_t *out, const vector<SOutput> &map, int frames)
+{
+  static float planes[PCM_MAX_CH][PCM_REMAP_BLOCK];
+  while (frames)
+  {
+    int block = frames < PCM_REMAP_BLOCK ? frames : PCM_REMAP_BLOCK;
+    for (int ch = 0; ch < inChannels; ++ch)
+    {
+      for (int i = 0; i < block; ++i)
+        planes[ch][i] = (float)in[i * inChannels + ch];
+    }
+    for (unsigned int ch = 0; ch < map.size(); ++ch)
+    {
+      const float *inputs[PCM_MAX_CH];
+      for (int j = 0; j < map[ch].count; ++j)
+        inputs[j] = planes[map[ch].input[j]];
+      mix(out + ch, map.size(), inputs, map[ch].level, map[ch].count, block);
+    }
+    in     += block * inChannels;
+    out    += block * map.size();
+    frames -= block;
+  }
+}
+
+struct SKernel
+{
+  const char *name;
+  PCMMixFunc  mix;
+};
+
+static vector<SKernel> GetKernels()
+{
+  vector<SKernel> kernels;
+  SKernel c = { "C", PCMMix_C };
+  kernels.push_back(c);
+#if defined(HAS_PCM_MIX_SSE2)
+  SKernel sse2 = { "SSE2", PCMMix_SSE2 };
+  kernels.push_back(sse2);
+#endif
+#if defined(HAS_PCM_MIX_NEON)
+  SKernel neon = { "NEON", PCMMix_NEON };
+  kernels.push_back(neon);
+#endif
+  return kernels;
+}
+
+// runs the old loop and each kernel on the same input, returning the number of samples that differ
+static unsigned int Compare(const vector<SKernel> &kernels, const vector<int16_t> &in, int inChannels, const vector<SOutput> &map, int frames, const char *what)
+{
+  vector<int16_t> expected(frames * map.size()), actual(frames * map.size());
+  RemapOld(&in[0], inChannels, &expected[0], map, frames);
+
+  unsigned int errors = 0;
+  for (unsigned int k = 0; k < kernels.size(); ++k)
+  {
+    RemapNew(kernels[k].mix, &in[0], inChannels, &actual[0], map, frames);
+    for (unsigned int i = 0; i < expected.size(); ++i)
+    {
+      if (expected[i] != actual[i])
+      {
+        if (!errors)
+          printf("%s: %s kernel gives %d at sample %u, expected %d\n", what, kernels[k].name, actual[i], i, expected[i]);
+        errors++;
+      }
+    }
+  }
+  return errors;
+}
+
+static double Now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+int main(int argc, char *argv[])
+{
+  double seconds = argc > 1 ? atof(argv[1]) : 60;
+  vector<SKernel> kernels = GetKernels();
+  unsigned int errors = 0;
+
+  // values at and around the halves that round_int() rounds up, and beyond the 16 bit range
+  static const float edges[] = { 0.49999997f, 0.5f, 0.50000006f, 1.5f, 2.5f, -0.5f, -0.49999997f, -0.50000006f,
+                                 -1.5f, -2.5f, 0.0f, -0.0f, 32766.5f, 32767.5f, -32767.5f, -32768.5f, 65534.0f, -65536.0f,
+                                 8388607.5f, -8388607.5f };
+  for (unsigned int e = 0; e < sizeof(edges) / sizeof(edges[0]); ++e)
+  {
+    // a single input of 1 or 2 scaled to the value, over 7 frames to cover both the simd loop and its tail
+    vector<SOutput> map(1);
+    map[0].count = 1;
+    map[0].input[0] = 0;
+    map[0].level[0] = fabsf(edges[e]) > 32768.0f ? edges[e] / 2 : edges[e];
+    vector<int16_t> in(7, fabsf(edges[e]) > 32768.0f ? 2 : 1);
+    char what[64];
+    sprintf(what, "edge %.8g", edges[e]);
+    errors += Compare(kernels, in, 1, map, 7, what);
+  }
+
+  // random maps and input
+  srand(1);
+  for (int test = 0; test < 2000; ++test)
+  {
+    int inChannels = 1 + rand() % 8;
+    vector<SOutput> map(1 + rand() % 8);
+    for (unsigned int ch = 0; ch < map.size(); ++ch)
+    {
+      map[ch].count = 1 + rand() % inChannels;
+      for (int j = 0; j < map[ch].count; ++j)
+      {
+        map[ch].input[j] = rand() % inChannels;
+        map[ch].level[j] = (rand() % 3 == 0) ? 1.0f / (1 + rand() % 4) : (float)rand() / RAND_MAX * 1.5f;
+      }
+    }
+    int frames = 1 + rand() % (3 * PCM_REMAP_BLOCK);
+    vector<int16_t> in(frames * inChannels);
+    for (unsigned int i = 0; i < in.size(); ++i)
+      in[i] = (rand() % 8 == 0) ? (rand() % 2 ? INT16_MAX : INT16_MIN) : (int16_t)(rand() - RAND_MAX / 2);
+    errors += Compare(kernels, in, inChannels, map, frames, "random");
+  }
+  printf("bit exactness: %u samples differ from the old loop\n", errors);
+
+  // time a 5.1 to stereo downmix of 48kHz audio: FL FR FC LFE BL BR
+  vector<SOutput> downmix(2);
+  for (int ch = 0; ch < 2; ++ch)
+  {
+    SOutput &out = downmix[ch];
+    out.count = 4;
+    out.input[0] = ch;     out.level[0] = 0.4142f;
+    out.input[1] = 2;      out.level[1] = 0.2929f;
+    out.input[2] = 3;      out.level[2] = 0.2929f;
+    out.input[3] = 4 + ch; out.level[3] = 0.4142f;
+  }
+  const int frames = 48000;
+  const int runs = (int)(seconds < 1 ? 1 : seconds);
+  vector<int16_t> in(frames * 6), out(frames * 2);
+  for (unsigned int i = 0; i < in.size(); ++i)
+    in[i] = (int16_t)(rand() - RAND_MAX / 2);
+
+  double start = Now();
+  for (int run = 0; run < runs; ++run)
+    RemapOld(&in[0], 6, &out[0], downmix, frames);
+  printf("%d s of 5.1 downmixed by the old loop: %7.1f ms\n", runs, (Now() - start) * 1000);
+  for (unsigned int k = 0; k < kernels.size(); ++k)
+  {
+    start = Now();
+    for (int run = 0; run < runs; ++run)
+      RemapNew(kernels[k].mix, &in[0], 6, &out[0], downmix, frames);
+    printf("%d s of 5.1 downmixed by the %-4s kernel: %7.1f ms\n", runs, kernels[k].name, (Now() - start) * 1000);
+  }
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,204 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+// Checks the CDVDCodecUtils picture kernels of each instruction set this cpu has against the C
+// ones, for every row width up to 150 and every alignment of the destination, then times them on
+// 1920x1080 YV12 frames with padded lines, as the players hand them over.  Picture copies are
+// timed through CopyPlane(), and through fast_memcpy(), which CDVDCodecUtils copied rows with
+// before.
+//
+// usage: PictureBenchmark [frames to time]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <vector>
+
+#include "PictureKernels.h"
+#include "utils/CPUInfo.h"
+#include "utils/fastmemcpy.h"
+
+using namespace std;
+
+CCPUInfo g_cpuInfo;
+
+struct SKernels
+{
+  const char     *name;
+  CPictureKernels kernels;
+};
+
+static vector<SKernels> GetKernels()
+{
+  vector<SKernels> sets;
+  SKernels c = { "C", CPictureKernels(0) };
+  sets.push_back(c);
+#if defined(__i386__) || defined(__x86_64__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2"))
+  {
+    SKernels sse2 = { "SSE2", CPictureKernels(CPU_FEATURE_SSE2) };
+    sets.push_back(sse2);
+  }
+  if (__builtin_cpu_supports("ssse3"))
+  {
+    SKernels ssse3 = { "SSSE3", CPictureKernels(CPU_FEATURE_SSE2 | CPU_FEATURE_SSSE3) };
+    sets.push_back(ssse3);
+  }
+  if (__builtin_cpu_supports("avx2"))
+  {
+    SKernels avx2 = { "AVX2", CPictureKernels(CPU_FEATURE_SSE2 | CPU_FEATURE_SSSE3 | CPU_FEATURE_AVX2) };
+    sets.push_back(avx2);
+  }
+#elif defined(__ARM_NEON__)
+  SKernels neon = { "NEON", CPictureKernels(CPU_FEATURE_NEON) };
+  sets.push_back(neon);
+#endif
+  return sets;
+}
+
+static double Now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static void Fill(vector<uint8_t> &buffer)
+{
+  for (unsigned int i = 0; i < buffer.size(); ++i)
+    buffer[i] = rand();
+}
+
+// runs each kernel of a set against the C one, returning the number of rows that differ
+static unsigned int Compare(const CPictureKernels &c, const SKernels &set)
+{
+  const CPictureKernels &k = set.kernels;
+  unsigned int errors = 0;
+  vector<uint8_t> y(400), u(200), v(200), uv(400);
+  vector<uint8_t> expected(700), actual(700), expected2(200), actual2(200);
+  for (int width = 0; width <= 150; ++width)
+  {
+    for (int offset = 0; offset < 32; ++offset)
+    {
+      Fill(y); Fill(u); Fill(v); Fill(uv);
+      // fill both outputs alike, so that writes past the row are caught too
+      Fill(expected); actual = expected;
+      Fill(expected2); actual2 = expected2;
+
+      c.InterleaveUV(&expected[offset], &u[1], &v[2], width);
+      k.InterleaveUV(&actual[offset], &u[1], &v[2], width);
+      errors += expected != actual;
+
+      c.DeinterleaveUV(&expected[offset], &expected2[offset], &uv[1], width);
+      k.DeinterleaveUV(&actual[offset], &actual2[offset], &uv[1], width);
+      errors += expected != actual || expected2 != actual2;
+
+      for (int uyvy = 0; uyvy < 2; ++uyvy)
+      {
+        c.Pack422(&expected[offset], &y[3], &u[1], &v[2], width, uyvy != 0);
+        k.Pack422(&actual[offset], &y[3], &u[1], &v[2], width, uyvy != 0);
+        errors += expected != actual;
+      }
+    }
+  }
+  if (errors)
+    printf("%s kernels differ from the C ones in %u rows\n", set.name, errors);
+  return errors;
+}
+
+// a 1920x1080 YV12 picture, with lines padded as the decoders and renderer do
+struct SPicture
+{
+  SPicture(int width, int height, int padding)
+  {
+    for (int p = 0; p < 3; ++p)
+    {
+      stride[p] = (p ? width / 2 : width) + padding;
+      plane[p].resize(stride[p] * (p ? height / 2 : height));
+      Fill(plane[p]);
+    }
+  }
+  vector<uint8_t> plane[3];
+  int stride[3];
+};
+
+int main(int argc, char *argv[])
+{
+  int frames = argc > 1 ? atoi(argv[1]) : 500;
+  vector<SKernels> sets = GetKernels();
+
+  unsigned int errors = 0;
+  for (unsigned int s = 1; s < sets.size(); ++s)
+    errors += Compare(sets[0].kernels, sets[s]);
+  printf("correctness: %u rows differ from the C kernels\n", errors);
+
+  const int width = 1920, height = 1080;
+  SPicture src(width, height, 64), dst(width, height, 128);
+  vector<uint8_t> packed(width * 2 * height);
+
+  printf("per 1920x1080 frame, over %d frames:\n", frames);
+  double start = Now();
+  for (int f = 0; f < frames; ++f)
+  {
+    for (int p = 0; p < 3; ++p)
+    {
+      int w = p ? width / 2 : width;
+      int h = p ? height / 2 : height;
+      for (int y = 0; y < h; ++y)
+        fast_memcpy(&dst.plane[p][y * dst.stride[p]], &src.plane[p][y * src.stride[p]], w);
+    }
+  }
+  printf("  copy through fast_memcpy %6.3f ms\n", (Now() - start) * 1000 / frames);
+
+  start = Now();
+  for (int f = 0; f < frames; ++f)
+  {
+    for (int p = 0; p < 3; ++p)
+      CopyPlane(&dst.plane[p][0], dst.stride[p], &src.plane[p][0], src.stride[p], p ? width / 2 : width, p ? height / 2 : height);
+  }
+  printf("  copy through CopyPlane   %6.3f ms\n", (Now() - start) * 1000 / frames);
+
+  for (unsigned int s = 0; s < sets.size(); ++s)
+  {
+    const CPictureKernels &k = sets[s].kernels;
+
+    start = Now();
+    for (int f = 0; f < frames; ++f)
+    {
+      for (int y = 0; y < height / 2; ++y)
+        k.InterleaveUV(&dst.plane[0][y * dst.stride[0]], &src.plane[1][y * src.stride[1]], &src.plane[2][y * src.stride[2]], width / 2);
+    }
+    double interleave = (Now() - start) * 1000 / frames;
+
+    start = Now();
+    for (int f = 0; f < frames; ++f)
+    {
+      for (int y = 0; y < height; ++y)
+        k.Pack422(&packed[y * width * 2], &src.plane[0][y * src.stride[0]], &src.plane[1][(y / 2) * src.stride[1]], &src.plane[2][(y / 2) * src.stride[2]], width / 2, false);
+    }
+    double pack = (Now() - start) * 1000 / frames;
+
+    printf("  %-5s kernels: nv12 chroma %6.3f ms, yuy2 %6.3f ms\n", sets[s].name, interleave, pack);
+  }
+  return errors ? 1 : 0;
+}
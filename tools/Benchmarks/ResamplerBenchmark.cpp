@@ -0,0 +1,145 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+// Measures the accuracy of CPolyphaseResampler on sine waves, as the largest error against the ideal
+// output, for each quality preset and for fixed and variable ratios, then times the conversion of
+// stereo 44.1kHz to 48kHz through the packet interface PAPlayer uses.
+//
+// The kernels are picked once per process, so run it with "c" to measure the scalar ones.
+//
+// usage: ResamplerBenchmark [c|simd] [seconds of audio to time]
+
+#include "PolyphaseResampler.h"
+#include "utils/CPUInfo.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace std;
+
+CCPUInfo g_cpuInfo;
+
+static const char *qualities[] = { "low", "medium", "high", "best" };
+
+static double Now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+// converts a second of a stereo sine, fed in chunks, returning the largest error in dB
+static double Accuracy(unsigned int inRate, unsigned int outRate, CPolyphaseResampler::Quality quality, double freq, bool variable)
+{
+  CPolyphaseResampler resampler;
+  if (variable)
+    resampler.InitVariableRatio(2, (double)outRate / inRate, quality);
+  else
+    resampler.Init(2, inRate, outRate, quality);
+
+  vector<float> in(2 * inRate);
+  for (unsigned int i = 0; i < inRate; ++i)
+    in[2 * i] = in[2 * i + 1] = 0.5 * sin(2 * M_PI * freq * i / inRate);
+
+  vector<float> out(2 * outRate + 200);
+  unsigned int got = 0;
+  for (unsigned int i = 0; i < inRate; i += 1000)
+  {
+    unsigned int chunk = min(1000u, inRate - i);
+    resampler.PutFrames(&in[2 * i], chunk);
+    got += resampler.GetFrames(&out[2 * got], outRate + 100 - got);
+  }
+
+  // skip the start and end, where the filter runs over the edges of the input
+  double error = 0;
+  for (unsigned int j = 1000; j + 1000 < got; ++j)
+  {
+    double expected = 0.5 * sin(2 * M_PI * freq * j / outRate);
+    error = max(error, fabs(out[2 * j] - expected));
+    if (out[2 * j] != out[2 * j + 1])
+      printf("  channels differ at frame %u\n", j);
+  }
+  return 20 * log10(max(error, 1e-12));
+}
+
+int main(int argc, char *argv[])
+{
+  bool simd = !(argc > 1 && !strcmp(argv[1], "c"));
+  int seconds = argc > 2 ? atoi(argv[2]) : 60;
+  if (simd)
+    g_cpuInfo.m_features = CPU_FEATURE_SSE2 | CPU_FEATURE_NEON; // only those built for this cpu are used
+  printf("%s kernels\n", simd ? "simd" : "scalar");
+
+  printf("largest error on a sine, in dB below full scale:\n");
+  printf("  %-7s %16s %16s %16s %16s\n", "quality", "44.1->48 1kHz", "48->44.1 5kHz", "44.1->48 var", "96->44.1 3kHz");
+  for (int q = CPolyphaseResampler::QUALITY_LOW; q <= CPolyphaseResampler::QUALITY_BEST; ++q)
+  {
+    CPolyphaseResampler::Quality quality = (CPolyphaseResampler::Quality)q;
+    printf("  %-7s %16.1f %16.1f %16.1f %16.1f\n", qualities[q],
+           Accuracy(44100, 48000, quality, 1000, false),
+           Accuracy(48000, 44100, quality, 5000, false),
+           Accuracy(44100, 48000, quality, 1000, true),
+           Accuracy(96000, 44100, quality, 3000, false));
+  }
+
+  // time the packet interface, as PAPlayer drives it
+  printf("converting %d s of stereo 44.1kHz to 48kHz 16 bit:\n", seconds);
+  vector<float> source(44100 * 2);
+  for (unsigned int i = 0; i < source.size() / 2; ++i)
+    source[2 * i] = source[2 * i + 1] = 0.5 * sin(2 * M_PI * 440 * i / 44100.0);
+  for (int q = CPolyphaseResampler::QUALITY_LOW; q <= CPolyphaseResampler::QUALITY_BEST; ++q)
+  {
+    CPolyphaseResampler resampler;
+    resampler.InitConverter(44100, 2, 48000, 16, 3840, (CPolyphaseResampler::Quality)q);
+    unsigned char packet[3840];
+    long samples = 0;
+    double start = Now();
+    for (int second = 0; second < seconds; ++second)
+    {
+      size_t pos = 0;
+      while (pos < source.size())
+      {
+        int wanted = resampler.GetInputSamples();
+        if (wanted > 0)
+        {
+          wanted = min(wanted, (int)(source.size() - pos));
+          resampler.PutFloatData(&source[pos], wanted);
+          pos += wanted;
+        }
+        else if (resampler.GetData(packet))
+          samples += sizeof(packet) / 2;
+        else
+          break;
+      }
+    }
+    printf("  %-7s %7.1f ms, %ld samples out\n", qualities[q], (Now() - start) * 1000, samples);
+  }
+  return 0;
+}
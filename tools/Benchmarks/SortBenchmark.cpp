@@ -0,0 +1,218 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+// Sorts a list of labels the way SSortFileItem::Sort() does, using sort keys built by
+// CCollationRanks, and the way it used to, calling AlphaNumericCompare() for each comparison.
+// Reports the time taken by each and whether they produce the same order.
+//
+// usage: SortBenchmark [items] [locale]
+
+#include "CollationRanks.h"
+
+#include <algorithm>
+#include <locale>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+using namespace std;
+
+// StringUtils::AlphaNumericCompare(), as the sort used before the keys were precomputed
+static int64_t AlphaNumericCompare(const wchar_t *left, const wchar_t *right)
+{
+  wchar_t *l = (wchar_t *)left;
+  wchar_t *r = (wchar_t *)right;
+  wchar_t *ld, *rd;
+  wchar_t lc, rc;
+  int64_t lnum, rnum;
+  const collate<wchar_t>& coll = use_facet< collate<wchar_t> >( locale() );
+  int cmp_res = 0;
+  while (*l != 0 && *r != 0)
+  {
+    // check if we have a numerical value
+    if (*l >= L'0' && *l <= L'9' && *r >= L'0' && *r <= L'9')
+    {
+      ld = l;
+      lnum = 0;
+      while (*ld >= L'0' && *ld <= L'9' && ld < l + 15)
+      { // compare only up to 15 digits
+        lnum *= 10;
+        lnum += *ld++ - '0';
+      }
+      rd = r;
+      rnum = 0;
+      while (*rd >= L'0' && *rd <= L'9' && rd < r + 15)
+      { // compare only up to 15 digits
+        rnum *= 10;
+        rnum += *rd++ - L'0';
+      }
+      // do we have numbers?
+      if (lnum != rnum)
+      { // yes - and they're different!
+        return lnum - rnum;
+      }
+      l = ld;
+      r = rd;
+      continue;
+    }
+    // do case less comparison
+    lc = *l;
+    if (lc >= L'A' && lc <= L'Z')
+      lc += L'a'-L'A';
+    rc = *r;
+    if (rc >= L'A' && rc <= L'Z')
+      rc += L'a'- L'A';
+
+    // ok, do a normal comparison, taking current locale into account. Add special case stuff (eg '(' characters)) in here later
+    if ((cmp_res = coll.compare(&lc, &lc + 1, &rc, &rc + 1)) != 0)
+    {
+      return cmp_res;
+    }
+    l++; r++;
+  }
+  if (*r)
+  { // r is longer
+    return -1;
+  }
+  else if (*l)
+  { // l is longer
+    return 1;
+  }
+  return 0; // files are the same
+}
+
+struct SLabelCompare
+{
+  bool operator()(const CStdStringW *left, const CStdStringW *right) const
+  {
+    return AlphaNumericCompare(left->c_str(), right->c_str()) < 0;
+  }
+};
+
+struct SItem
+{
+  const CStdStringW *label;
+  vector<uint32_t> key;
+};
+
+struct SKeyCompare
+{
+  bool operator()(const SItem *left, const SItem *right) const
+  {
+    return lexicographical_compare(left->key.begin(), left->key.end(), right->key.begin(), right->key.end());
+  }
+};
+
+static double Now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+// labels resembling those of a large library: words in mixed case, numbered tracks and episodes,
+// some zero padded, and a few non-ASCII characters
+static void MakeLabels(unsigned int count, vector<CStdStringW> &labels)
+{
+  static const wchar_t *words[] = { L"The", L"love", L"Night", L"of", L"a", L"Dream", L"Étoile", L"world", L"BLUE",
+                                    L"song", L"Live", L"at", L"Ωmega", L"river", L"(Remix)", L"Señor", L"-", L"Part" };
+  const unsigned int numWords = sizeof(words) / sizeof(words[0]);
+  srand(1);
+  labels.resize(count);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    CStdStringW &label = labels[i];
+    int parts = 1 + rand() % 5;
+    for (int j = 0; j < parts; ++j)
+    {
+      if (j)
+        label += L" ";
+      if (rand() % 4 == 0)
+      {
+        CStdStringW number;
+        number.Format(rand() % 3 ? L"%d" : L"%03d", rand() % 1000);
+        label += number;
+      }
+      else
+        label += words[rand() % numWords];
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int count = argc > 1 ? atoi(argv[1]) : 100000;
+  const char *name = argc > 2 ? argv[2] : "";
+  try
+  {
+    locale::global(locale(name));
+  }
+  catch (...)
+  {
+    fprintf(stderr, "locale \"%s\" isn't available, using \"C\"\n", name);
+  }
+  printf("sorting %u labels, locale \"%s\"\n", count, locale().name().c_str());
+
+  vector<CStdStringW> labels;
+  MakeLabels(count, labels);
+
+  // the old sort: collate the labels on each comparison
+  vector<const CStdStringW *> before(count);
+  for (unsigned int i = 0; i < count; ++i)
+    before[i] = &labels[i];
+  double start = Now();
+  stable_sort(before.begin(), before.end(), SLabelCompare());
+  double oldTime = Now() - start;
+
+  // the new sort: rank the characters in use, build a key per label and compare those
+  start = Now();
+  vector<const CStdStringW *> used(count);
+  for (unsigned int i = 0; i < count; ++i)
+    used[i] = &labels[i];
+  CCollationRanks ranks(used);
+  vector<SItem> items(count);
+  vector<SItem *> after(count);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    items[i].label = &labels[i];
+    ranks.MakeSortKey(labels[i], items[i].key);
+    after[i] = &items[i];
+  }
+  double keyTime = Now() - start;
+  stable_sort(after.begin(), after.end(), SKeyCompare());
+  double newTime = Now() - start;
+
+  unsigned int mismatches = 0;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    if (before[i] != after[i]->label)
+    {
+      if (!mismatches)
+        printf("first mismatch at %u: \"%ls\" vs \"%ls\"\n", i, before[i]->c_str(), after[i]->label->c_str());
+      mismatches++;
+    }
+  }
+
+  printf("AlphaNumericCompare sort: %8.1f ms\n", oldTime * 1000);
+  printf("sort key sort:            %8.1f ms (of which %.1f ms building keys)\n", newTime * 1000, keyTime * 1000);
+  printf("%u of %u items in a different position\n", mismatches, count);
+  return mismatches ? 1 : 0;
+}
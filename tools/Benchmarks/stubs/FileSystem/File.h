@@ -0,0 +1,58 @@
+#pragma once
+// Stand-in for xbmc/FileSystem/File.h: local files only, unbuffered, as CFileHD reads them.
+
+#include "StdString.h"
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace XFILE
+{
+  class CFile
+  {
+  public:
+    CFile() : m_reads(0), m_fd(-1) {}
+    ~CFile() { Close(); }
+
+    bool Open(const CStdString& strFileName, unsigned int flags = 0)
+    {
+      Close();
+      m_fd = open(strFileName.c_str(), O_RDONLY);
+      return m_fd >= 0;
+    }
+    bool OpenForWrite(const CStdString& strFileName, bool bOverWrite = false)
+    {
+      Close();
+      m_fd = open(strFileName.c_str(), O_RDWR | O_CREAT | (bOverWrite ? O_TRUNC : 0), 0644);
+      return m_fd >= 0;
+    }
+    unsigned int Read(void* lpBuf, int64_t uiBufSize)
+    {
+      m_reads++;
+      ssize_t got = read(m_fd, lpBuf, (size_t)uiBufSize);
+      return got < 0 ? 0 : (unsigned int)got;
+    }
+    int Write(const void* lpBuf, int64_t uiBufSize) { return (int)write(m_fd, lpBuf, (size_t)uiBufSize); }
+    int64_t Seek(int64_t iFilePosition, int iWhence = SEEK_SET) { return lseek(m_fd, iFilePosition, iWhence); }
+    int64_t GetPosition() { return lseek(m_fd, 0, SEEK_CUR); }
+    int64_t GetLength()
+    {
+      struct stat buffer;
+      return fstat(m_fd, &buffer) == 0 ? buffer.st_size : 0;
+    }
+    void Close()
+    {
+      if (m_fd >= 0)
+        close(m_fd);
+      m_fd = -1;
+    }
+
+    unsigned int m_reads; ///< number of Read() calls, for the benchmarks to report
+
+  private:
+    int m_fd;
+  };
+}
@@ -0,0 +1,28 @@
+#pragma once
+// Stand-in for guilib/system.h, with just the platform bits the database layer and CArchive use.
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+inline void Sleep(unsigned int milliseconds) { usleep(milliseconds * 1000); }
+inline unsigned int GetLastError() { return 0; }
+#define OutputDebugString(x)
+#define _atoi64(x) atoll(x)
+
+typedef unsigned char  BYTE;
+typedef unsigned short WORD;
+
+typedef struct _SYSTEMTIME
+{
+  WORD wYear;
+  WORD wMonth;
+  WORD wDayOfWeek;
+  WORD wDay;
+  WORD wHour;
+  WORD wMinute;
+  WORD wSecond;
+  WORD wMilliseconds;
+} SYSTEMTIME;
@@ -0,0 +1,18 @@
+#pragma once
+// Stand-in for xbmc/utils/CPUInfo.h, so that code picking simd kernels from the cpu features
+// builds without the rest of XBMC.  The benchmark sets the features to test each kernel.
+
+#define CPU_FEATURE_SSE2     (1 << 3)
+#define CPU_FEATURE_SSSE3    (1 << 5)
+#define CPU_FEATURE_AVX2     (1 << 9)
+#define CPU_FEATURE_NEON     (1 << 10)
+
+class CCPUInfo
+{
+public:
+  CCPUInfo() : m_features(0) {}
+  int GetCPUFeatures() const { return m_features; }
+  int m_features;
+};
+
+extern CCPUInfo g_cpuInfo;
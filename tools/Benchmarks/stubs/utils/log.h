@@ -0,0 +1,14 @@
+#pragma once
+// Stand-in for xbmc/utils/log.h, so that code logging its setup builds without the rest of XBMC.
+
+#define LOGDEBUG   0
+#define LOGINFO    1
+#define LOGNOTICE  2
+#define LOGWARNING 3
+#define LOGERROR   4
+
+class CLog
+{
+public:
+  static void Log(int loglevel, const char *format, ...) {}
+};
@@ -35,6 +35,7 @@
 #include "SystemInfo.h"
 #include "XMLUtils.h"
 #include "utils/log.h"
+#include "utils/JobManager.h"
 
 using namespace XFILE;
 
@@ -103,6 +104,9 @@ void CAdvancedSettings::Initialize()
   m_musicPercentSeekForwardBig = 10;
   m_musicPercentSeekBackwardBig = -10;
   m_musicResample = 0;
+  m_musicResampleQuality = 1;
+  m_musicNextTrackLookahead = 15;
+  m_musicNextTrackBuffer = 5;
 
   m_slideshowPanAmount = 2.5f;
   m_slideshowZoomAmount = 5.0f;
@@ -190,6 +194,8 @@ void CAdvancedSettings::Initialize()
   m_bMusicLibraryHideAllItems = false;
   m_bMusicLibraryAllItemsOnBottom = false;
   m_bMusicLibraryAlbumsSortByArtistThenYear = false;
+  m_bMusicLibraryQuickRescan = false;
+  m_bMusicLibraryMonitor = false;
   m_iMusicLibraryRecentlyAddedItems = 25;
   m_strMusicLibraryAlbumFormat = "";
   m_strMusicLibraryAlbumFormatRight = "";
@@ -205,6 +211,8 @@ void CAdvancedSettings::Initialize()
   m_bVideoLibraryCleanOnUpdate = false;
   m_bVideoLibraryExportAutoThumbs = false;
   m_bVideoLibraryImportWatchedState = false;
+  m_bVideoLibraryQuickRescan = false;
+  m_bVideoLibraryMonitor = false;
   m_bVideoScannerIgnoreErrors = false;
 
   m_bUseEvilB = true;
@@ -268,10 +276,20 @@ void CAdvancedSettings::Initialize()
 #endif
 
   m_bgInfoLoaderMaxThreads = 5;
+  m_jobManagerMaxWorkers = 0;
 
   m_measureRefreshrate = false;
 
+  m_databaseBatchSize = 100;
+
+  m_guiDirtyRegionMode = DIRTYREGION_MODE_OFF;
+  m_guiVisualizeDirtyRegions = false;
+  m_guiLargeTextureCacheSize = 64 * 1048576;
+
   m_cacheMemBufferSize = (1048576 * 5);
+  m_dirCachePersistentSize = 0;
+  m_cacheSegmented = false;
+  m_memoryMapFiles = false;
 }
 
 bool CAdvancedSettings::Load()
@@ -333,6 +351,9 @@ bool CAdvancedSettings::Load()
     XMLUtils::GetInt(pElement, "percentseekbackwardbig", m_musicPercentSeekBackwardBig, -100, 0);
 
     XMLUtils::GetInt(pElement, "resample", m_musicResample, 0, 192000);
+    XMLUtils::GetInt(pElement, "resamplequality", m_musicResampleQuality, 0, 3);
+    XMLUtils::GetInt(pElement, "nexttracklookahead", m_musicNextTrackLookahead, 1, 600);
+    XMLUtils::GetInt(pElement, "nexttrackbuffer", m_musicNextTrackBuffer, 2, 30);
 
     TiXmlElement* pAudioExcludes = pElement->FirstChildElement("excludefromlisting");
     if (pAudioExcludes)
@@ -521,6 +542,8 @@ bool CAdvancedSettings::Load()
     XMLUtils::GetString(pElement, "albumformat", m_strMusicLibraryAlbumFormat);
     XMLUtils::GetString(pElement, "albumformatright", m_strMusicLibraryAlbumFormatRight);
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
+    XMLUtils::GetBoolean(pElement, "quickrescan", m_bMusicLibraryQuickRescan);
+    XMLUtils::GetBoolean(pElement, "monitor", m_bMusicLibraryMonitor);
   }
 
   pElement = pRootElement->FirstChildElement("videolibrary");
@@ -535,6 +558,8 @@ bool CAdvancedSettings::Load()
     XMLUtils::GetString(pElement, "itemseparator", m_videoItemSeparator);
     XMLUtils::GetBoolean(pElement, "exportautothumbs", m_bVideoLibraryExportAutoThumbs);
     XMLUtils::GetBoolean(pElement, "importwatchedstate", m_bVideoLibraryImportWatchedState);
+    XMLUtils::GetBoolean(pElement, "quickrescan", m_bVideoLibraryQuickRescan);
+    XMLUtils::GetBoolean(pElement, "monitor", m_bVideoLibraryMonitor);
   }
 
   pElement = pRootElement->FirstChildElement("videoscanner");
@@ -580,6 +605,8 @@ bool CAdvancedSettings::Load()
     XMLUtils::GetInt(pElement, "curlretries", m_curlretries, 0, 10);
     XMLUtils::GetBoolean(pElement,"disableipv6", m_curlDisableIPV6);
     XMLUtils::GetUInt(pElement, "cachemembuffersize", m_cacheMemBufferSize);
+    XMLUtils::GetUInt(pElement, "dircachesize", m_dirCachePersistentSize);
+    XMLUtils::GetBoolean(pElement, "segmentedcache", m_cacheSegmented);
   }
 
   pElement = pRootElement->FirstChildElement("samba");
@@ -617,6 +644,7 @@ bool CAdvancedSettings::Load()
   XMLUtils::GetString(pRootElement, "cddbaddress", m_cddbAddress);
 
   XMLUtils::GetBoolean(pRootElement, "handlemounting", m_handleMounting);
+  XMLUtils::GetBoolean(pRootElement, "memorymapfiles", m_memoryMapFiles);
 
   XMLUtils::GetBoolean(pRootElement, "nodvdrom", m_noDVDROM);
   XMLUtils::GetBoolean(pRootElement, "usemultipaths", m_useMultipaths);
@@ -831,8 +859,22 @@ bool CAdvancedSettings::Load()
   XMLUtils::GetInt(pRootElement, "bginfoloadermaxthreads", m_bgInfoLoaderMaxThreads);
   m_bgInfoLoaderMaxThreads = std::max(1, m_bgInfoLoaderMaxThreads);
 
+  pElement = pRootElement->FirstChildElement("jobmanager");
+  if (pElement)
+    XMLUtils::GetInt(pElement, "maxworkers", m_jobManagerMaxWorkers, 0, JOBMANAGER_MAX_WORKERS);
+
   XMLUtils::GetBoolean(pRootElement, "measurerefreshrate", m_measureRefreshrate);
 
+  XMLUtils::GetInt(pRootElement, "databasebatchsize", m_databaseBatchSize, 1, 10000);
+
+  pElement = pRootElement->FirstChildElement("gui");
+  if (pElement)
+  {
+    XMLUtils::GetInt(pElement, "algorithmdirtyregions", m_guiDirtyRegionMode, DIRTYREGION_MODE_OFF, DIRTYREGION_MODE_PARTIAL);
+    XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
+    XMLUtils::GetUInt(pElement, "largetexturecachesize", m_guiLargeTextureCacheSize);
+  }
+
   TiXmlElement* pDatabase = pRootElement->FirstChildElement("videodatabase");
   if (pDatabase)
   {
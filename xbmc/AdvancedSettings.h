@@ -59,6 +59,11 @@ struct RefreshOverride
 
 typedef std::vector<TVShowRegexp> SETTINGS_TVSHOWLIST;
 
+// GUI redraw algorithms, set via <gui><algorithmdirtyregions>
+#define DIRTYREGION_MODE_OFF     0 ///< redraw the whole screen every frame
+#define DIRTYREGION_MODE_FULL    1 ///< redraw the whole screen, but only on frames where something changed
+#define DIRTYREGION_MODE_PARTIAL 2 ///< redraw only the regions that changed
+
 class CAdvancedSettings
 {
   public:
@@ -109,6 +114,9 @@ class CAdvancedSettings
     int m_musicPercentSeekForwardBig;
     int m_musicPercentSeekBackwardBig;
     int m_musicResample;
+    int m_musicResampleQuality;
+    int m_musicNextTrackLookahead;
+    int m_musicNextTrackBuffer;
     int m_videoBlackBarColour;
     int m_videoIgnoreSecondsAtStart;
     float m_videoIgnorePercentAtEnd;
@@ -195,6 +203,8 @@ class CAdvancedSettings
     int m_iMusicLibraryRecentlyAddedItems;
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryAlbumsSortByArtistThenYear;
+    bool m_bMusicLibraryQuickRescan; ///< only list the folders whose modification time changed since the last scan
+    bool m_bMusicLibraryMonitor;     ///< watch the local sources for changes, updating the library as they happen
     CStdString m_strMusicLibraryAlbumFormat;
     CStdString m_strMusicLibraryAlbumFormatRight;
     bool m_prioritiseAPEv2tags;
@@ -210,6 +220,8 @@ class CAdvancedSettings
     bool m_bVideoLibraryCleanOnUpdate;
     bool m_bVideoLibraryExportAutoThumbs;
     bool m_bVideoLibraryImportWatchedState;
+    bool m_bVideoLibraryQuickRescan; ///< only list the folders whose modification time changed since the last scan
+    bool m_bVideoLibraryMonitor;     ///< watch the local sources for changes, updating the library as they happen
 
     bool m_bVideoScannerIgnoreErrors;
 
@@ -274,14 +286,23 @@ class CAdvancedSettings
     CStdString m_cpuTempCmd;
     CStdString m_gpuTempCmd;
     int m_bgInfoLoaderMaxThreads;
+    int m_jobManagerMaxWorkers; ///< maximum number of job workers over all priorities, 0 for one per CPU core (minimum 5)
 
     bool m_measureRefreshrate; //when true the videoreferenceclock will measure the refreshrate when direct3d is used
                                //otherwise it will use the windows refreshrate
 
     DatabaseSettings m_databaseMusic; // advanced music database setup
     DatabaseSettings m_databaseVideo; // advanced video database setup
+    int m_databaseBatchSize; ///< number of rows the library scanners write per transaction, 1 to commit every item
+
+    int m_guiDirtyRegionMode;        ///< how the GUI is redrawn, one of the DIRTYREGION_MODE values
+    bool m_guiVisualizeDirtyRegions; ///< highlight the regions of the GUI that are redrawn
+    unsigned int m_guiLargeTextureCacheSize; ///< size (in bytes) of the decoded large images (eg fanart) kept once no longer in use
 
     unsigned int m_cacheMemBufferSize;
+    bool m_cacheSegmented; ///< keep several ranges of network files cached, so seeking back doesn't refetch the data
+    unsigned int m_dirCachePersistentSize; ///< size (in bytes) of the on disk cache of network share listings, 0 to disable
+    bool m_memoryMapFiles; ///< have the player read files on local fixed disks, and the skin its texture bundles, through a memory mapping rather than read() calls. Off by default, as truncating a mapped file kills the process with SIGBUS.
 };
 
 extern CAdvancedSettings g_advancedSettings;
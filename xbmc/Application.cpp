@@ -329,6 +329,7 @@ CApplication::CApplication(void) : m_itemCurrentFile(new CFileItem), m_progressT
 #endif
 
   m_bPresentFrame = false;
+  m_skipGuiRender = false;
   m_bPlatformDirectories = true;
 
   m_bStandalone = false;
@@ -1779,8 +1780,6 @@ void CApplication::RenderNoPresent()
 
   g_graphicsContext.Lock();
 
-  g_windowManager.UpdateModelessVisibility();
-
   // dont show GUI when playing full screen video
   if (g_graphicsContext.IsFullScreenVideo())
   {
@@ -2003,8 +2002,8 @@ void CApplication::Render()
     }
     else
     {
-      // engage the frame limiter as needed
-      bool limitFrames = lowfps || extPlayerActive;
+      // engage the frame limiter as needed - if we skipped the last frame, vsync didn't hold us back
+      bool limitFrames = lowfps || extPlayerActive || m_skipGuiRender;
       // DXMERGE - we checked for g_videoConfig.GetVSyncMode() before this
       //           perhaps allowing it to be set differently than the UI option??
       if (g_guiSettings.GetInt("videoscreen.vsync") == VSYNC_DISABLED ||
@@ -2037,14 +2036,45 @@ void CApplication::Render()
   CTimeUtils::UpdateFrameTime();
   g_infoManager.UpdateFPS();
 
-  if(!g_Windowing.BeginRender())
-    return;
+  // process the GUI, so we know which parts of the screen have changed
+  unsigned int frameTime = CTimeUtils::GetFrameTime();
+  g_windowManager.UpdateModelessVisibility();
+  g_windowManager.ProcessWindows(frameTime);
+
+  // the pointer is rendered over the windows, so we track its movements as well
+  m_guiPointer.SetVisible(g_Mouse.IsActive());
+  CDirtyRegionList pointerRegions;
+  m_guiPointer.DoProcess(frameTime, pointerRegions);
+  for (CDirtyRegionList::const_iterator i = pointerRegions.begin(); i != pointerRegions.end(); ++i)
+    g_windowManager.MarkDirty(*i);
+
+  // video and the overlays we render over the whole screen need redrawing every frame
+  if (g_graphicsContext.IsFullScreenVideo() || (m_pPlayer && m_pPlayer->IsRecording()) ||
+      (m_screenSaver && (m_bScreenSave || screenSaverFadeAmount > 0)) ||
+      LOG_LEVEL_DEBUG_FREEMEM <= g_advancedSettings.m_logLevel || g_SkinInfo->IsDebugging())
+    g_windowManager.MarkDirty();
+
+  m_skipGuiRender = !g_windowManager.NeedsRender();
+  if (m_skipGuiRender)
+  { // nothing has changed, so the last frame stays on screen
+    g_infoManager.ResetCache();
+    lock.Leave();
+  }
+  else
+  {
+    // the pointer is drawn over whatever is redrawn beneath it, so must be redrawn too
+    if (g_Mouse.IsActive())
+      g_windowManager.MarkDirty(m_guiPointer.GetRenderRegion());
 
-  RenderNoPresent();
-  g_Windowing.EndRender();
-  lock.Leave();
+    if(!g_Windowing.BeginRender())
+      return;
 
-  g_graphicsContext.Flip();
+    RenderNoPresent();
+    g_Windowing.EndRender();
+    lock.Leave();
+
+    g_graphicsContext.Flip();
+  }
 
   g_renderManager.UpdateResolution();
 
@@ -2109,6 +2139,11 @@ void CApplication::RenderMemoryStatus()
     info.Format("LOG: %sxbmc.log\nMEM: %"PRIu64"/%"PRIu64" KB - FPS: %2.1f fps\nCPU: %s (CPU-XBMC %4.2f%%%s)", g_settings.m_logFolder.c_str(),
               stat.dwAvailPhys/1024, stat.dwTotalPhys/1024, g_infoManager.GetFPS(), strCores.c_str(), dCPU, profiling.c_str());
 #endif
+    unsigned int evaluated, cached;
+    g_infoManager.GetBoolStats(evaluated, cached);
+    CStdString conditions;
+    conditions.Format("\nCONDITIONS: %u evaluated, %u cached per frame", evaluated, cached);
+    info += conditions;
 
 
     float x = xShift + 0.04f * g_graphicsContext.GetWidth() + g_settings.m_ResInfo[res].Overscan.left;
@@ -3256,6 +3291,9 @@ void CApplication::Stop()
     CLog::Log(LOGNOTICE, "stop all");
 
     // stop scanning before we kill the network and so on
+#if defined(_LINUX) && !defined(__APPLE__)
+    m_libraryMonitor.Stop();
+#endif
     CGUIDialogMusicScan *musicScan = (CGUIDialogMusicScan *)g_windowManager.GetWindow(WINDOW_DIALOG_MUSIC_SCAN);
     if (musicScan)
       musicScan->StopScanning();
@@ -3858,6 +3896,13 @@ void CApplication::OnQueueNextItem()
   g_windowManager.SendThreadMessage(msg);
 }
 
+void CApplication::OnQueueNextItemFailed()
+{
+  // the player accepted the next item, but couldn't open it after all
+  CGUIMessage msg(GUI_MSG_QUEUE_NEXT_ITEM_FAILED, 0, 0);
+  g_windowManager.SendThreadMessage(msg);
+}
+
 void CApplication::OnPlayBackStopped()
 {
   if(m_bPlaybackStarting)
@@ -4472,6 +4517,15 @@ bool CApplication::OnMessage(CGUIMessage& message)
     }
     break;
 
+  case GUI_MSG_QUEUE_NEXT_ITEM_FAILED:
+    {
+      // the player won't be moving on to the item it was given, so it's played
+      // (or skipped) as usual once the current one has ended
+      m_nextPlaylistItem = -1;
+      return true;
+    }
+    break;
+
   case GUI_MSG_PLAYBACK_STOPPED:
   case GUI_MSG_PLAYBACK_ENDED:
   case GUI_MSG_PLAYLISTPLAYER_STOPPED:
@@ -4726,6 +4780,11 @@ void CApplication::ProcessSlow()
   // check for any idle curl connections
   g_curlInterface.CheckIdle();
 
+#if defined(_LINUX) && !defined(__APPLE__)
+  // update the library folders that have changed
+  m_libraryMonitor.UpdateLibraries();
+#endif
+
   // check for any idle myth sessions
   CMythSession::CheckIdle();
 
@@ -5222,6 +5281,11 @@ void CApplication::UpdateLibraries()
     if (scanner && !scanner->IsScanning())
       scanner->StartScanning("");
   }
+
+#if defined(_LINUX) && !defined(__APPLE__)
+  // keep the libraries up to date as files are added or removed
+  m_libraryMonitor.Start();
+#endif
 }
 
 void CApplication::CheckPlayingProgress()
@@ -62,6 +62,9 @@ namespace ADDON
 #ifdef _LINUX
 #include "linux/LinuxResourceCounter.h"
 #endif
+#if defined(_LINUX) && !defined(__APPLE__)
+#include "linux/LibraryMonitor.h"
+#endif
 #include "XBMC_events.h"
 #include "utils/Thread.h"
 
@@ -139,6 +142,7 @@ public:
   virtual void OnPlayBackResumed();
   virtual void OnPlayBackStopped();
   virtual void OnQueueNextItem();
+  virtual void OnQueueNextItemFailed();
   virtual void OnPlayBackSeek(int iTime, int seekOffset);
   virtual void OnPlayBackSeekChapter(int iChapter);
   virtual void OnPlayBackSpeedChanged(int iSpeed);
@@ -340,6 +344,7 @@ protected:
   int m_nextPlaylistItem;
 
   bool m_bPresentFrame;
+  bool m_skipGuiRender;     ///< whether the last frame was skipped as nothing on screen had changed
 
   bool m_bStandalone;
   bool m_bEnableLegacyRes;
@@ -392,6 +397,9 @@ protected:
 #ifdef _LINUX
   CLinuxResourceCounter m_resourceCounter;
 #endif
+#if defined(_LINUX) && !defined(__APPLE__)
+  CLibraryMonitor m_libraryMonitor;
+#endif
 
 #ifdef HAS_EVENT_SERVER
   std::map<std::string, std::map<int, float> > m_lastAxisMap;
@@ -23,12 +23,35 @@
 #include "FileItem.h"
 #include "AdvancedSettings.h"
 #include "utils/SingleLock.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 
 using namespace std;
 
 #define ITEMS_PER_THREAD 5
 
+/*!
+ \brief Job loading the items of a CBackgroundInfoLoader until none are left or the loader is stopped.
+ The loader waits for its jobs to be deleted before it goes away, so the pointer stays valid.
+ The job manager may delete a job while holding its own locks, so the destructor only counts it down.
+ */
+class CBackgroundInfoLoaderJob : public CJob
+{
+public:
+  CBackgroundInfoLoaderJob(CBackgroundInfoLoader *loader) : m_loader(loader) {};
+  virtual ~CBackgroundInfoLoaderJob() { m_loader->OnJobDeleted(); };
+
+  virtual bool DoWork()
+  {
+    m_loader->Run();
+    return true;
+  }
+  virtual const char *GetType() const { return "backgroundinfoloader"; };
+
+private:
+  CBackgroundInfoLoader *m_loader;
+};
+
 CBackgroundInfoLoader::CBackgroundInfoLoader(int nThreads)
 {
   m_bStop = true;
@@ -37,6 +60,8 @@ CBackgroundInfoLoader::CBackgroundInfoLoader(int nThreads)
   m_pVecItems = NULL;
   m_nRequestedThreads = nThreads;
   m_bStartCalled = false;
+  m_bFinishCalled = false;
+  m_nRunning = 0;
   m_nActiveThreads = 0;
 }
 
@@ -52,6 +77,11 @@ void CBackgroundInfoLoader::SetNumOfWorkers(int nThreads)
 
 void CBackgroundInfoLoader::Run()
 {
+  {
+    CSingleLock lock(m_lock);
+    m_nRunning++;
+  }
+
   try
   {
     if (m_vecItems.size() > 0)
@@ -95,18 +125,31 @@ void CBackgroundInfoLoader::Run()
         }
       }
     }
-
-    CSingleLock lock(m_lock);
-    if (m_nActiveThreads == 1)
-      OnLoaderFinish();
-    m_nActiveThreads--;
-
   }
   catch (...)
   {
-    m_nActiveThreads--;
     CLog::Log(LOGERROR, "%s - Unhandled exception", __FUNCTION__);
   }
+
+  // a job only leaves the loop once the items are done or we've been stopped, so the last one
+  // still running finishes the load.  Jobs that start later find nothing left to do.
+  CSingleLock lock(m_lock);
+  bool finish = --m_nRunning == 0 && m_bStartCalled && !m_bFinishCalled;
+  if (finish)
+    m_bFinishCalled = true;
+  lock.Leave();
+
+  if (finish)
+  {
+    try
+    {
+      OnLoaderFinish();
+    }
+    catch (...)
+    {
+      CLog::Log(LOGERROR, "%s - Unhandled exception in OnLoaderFinish", __FUNCTION__);
+    }
+  }
 }
 
 void CBackgroundInfoLoader::Load(CFileItemList& items)
@@ -124,6 +167,7 @@ void CBackgroundInfoLoader::Load(CFileItemList& items)
   m_pVecItems = &items;
   m_bStop = false;
   m_bStartCalled = false;
+  m_bFinishCalled = false;
 
   int nThreads = m_nRequestedThreads;
   if (nThreads == -1)
@@ -132,45 +176,53 @@ void CBackgroundInfoLoader::Load(CFileItemList& items)
   if (nThreads > g_advancedSettings.m_bgInfoLoaderMaxThreads)
     nThreads = g_advancedSettings.m_bgInfoLoaderMaxThreads;
 
-  m_nActiveThreads = nThreads;
-  for (int i=0; i < nThreads; i++)
+  LeaveCriticalSection(m_lock);
+
   {
-    CThread *pThread = new CThread(this);
-    pThread->Create();
-#ifndef _LINUX
-    pThread->SetPriority(THREAD_PRIORITY_BELOW_NORMAL);
-#endif
-    pThread->SetName("Background Loader");
-    m_workers.push_back(pThread);
+    CSingleLock lock(m_jobsLock);
+    m_nActiveThreads = nThreads;
+    m_jobsDone.Reset();
   }
 
-  LeaveCriticalSection(m_lock);
+  // added without holding our locks, as the job manager takes its own
+  for (int i=0; i < nThreads; i++)
+    m_jobs.push_back(CJobManager::GetInstance().AddJob(new CBackgroundInfoLoaderJob(this), NULL, CJob::PRIORITY_LOW));
 }
 
 void CBackgroundInfoLoader::StopAsync()
 {
   m_bStop = true;
-}
 
+  // drop the jobs that haven't started yet - those in progress will notice we've stopped
+  for (unsigned int i = 0; i < m_jobs.size(); i++)
+    CJobManager::GetInstance().CancelJob(m_jobs[i]);
+  m_jobs.clear();
+}
 
 void CBackgroundInfoLoader::StopThread()
 {
   StopAsync();
 
-  for (int i=0; i<(int)m_workers.size(); i++)
-  {
-    m_workers[i]->StopThread();
-    delete m_workers[i];
-  }
+  // wait for the jobs loading an item to finish it
+  while (IsLoading())
+    m_jobsDone.WaitMSec(1000);
 
-  m_workers.clear();
   m_vecItems.clear();
   m_pVecItems = NULL;
-  m_nActiveThreads = 0;
+}
+
+void CBackgroundInfoLoader::OnJobDeleted()
+{
+  // called both for jobs that ran and for those cancelled before they started, possibly with the
+  // job manager's locks held, so it only counts the job down
+  CSingleLock lock(m_jobsLock);
+  if (--m_nActiveThreads == 0)
+    m_jobsDone.Set();
 }
 
 bool CBackgroundInfoLoader::IsLoading()
 {
+  CSingleLock lock(m_jobsLock);
   return m_nActiveThreads > 0;
 }
 
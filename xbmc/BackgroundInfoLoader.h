@@ -21,9 +21,9 @@
  *
  */
 
-#include "utils/Thread.h"
 #include "IProgressCallback.h"
 #include "utils/CriticalSection.h"
+#include "utils/Event.h"
 
 #include <vector>
 #include "boost/shared_ptr.hpp"
@@ -38,7 +38,21 @@ public:
   virtual void OnItemLoaded(CFileItem* pItem) = 0;
 };
 
-class CBackgroundInfoLoader : public IRunnable
+/*!
+ \ingroup jobs
+ \brief Base class for loading the details of a listing's items in the background.
+
+ The items are loaded by a few jobs at low priority in the CJobManager, which pull items off a
+ shared list until it's empty, so no threads are kept around per listing.  Running at low priority
+ keeps these long running jobs from filling the normal pool and delaying short jobs such as image
+ loads.  Stopping the loader cancels the jobs that haven't started, and those loading an item
+ finish it and return.  OnLoaderFinish() is called by the last job to stop running, on its worker.
+ The loader counts as active until the job manager has deleted all of its jobs, whether they ran or
+ were cancelled.
+
+ \sa CJobManager
+ */
+class CBackgroundInfoLoader
 {
 public:
   CBackgroundInfoLoader(int nThreads=-1);
@@ -46,15 +60,14 @@ public:
 
   void Load(CFileItemList& items);
   bool IsLoading();
-  virtual void Run();
   void SetObserver(IBackgroundLoaderObserver* pObserver);
   void SetProgressCallback(IProgressCallback* pCallback);
   virtual bool LoadItem(CFileItem* pItem) { return false; };
 
-  void StopThread(); // will actually stop all worker threads.
+  void StopThread(); // will stop loading, and wait for the items being loaded to finish.
   void StopAsync();  // will ask loader to stop as soon as possible, but not block
 
-  void SetNumOfWorkers(int nThreads); // -1 means auto compute num of required threads
+  void SetNumOfWorkers(int nThreads); // -1 means auto compute num of required jobs
 
 protected:
   virtual void OnLoaderStart() {};
@@ -65,13 +78,22 @@ protected:
   CCriticalSection m_lock;
 
   bool m_bStartCalled;
+  bool m_bFinishCalled;
   volatile bool m_bStop;
   int  m_nRequestedThreads;
-  int  m_nActiveThreads;
+  int  m_nRunning;       ///< number of our jobs inside Run(), protected by m_lock
+  int  m_nActiveThreads; ///< number of our jobs the job manager hasn't deleted yet, protected by m_jobsLock
 
   IBackgroundLoaderObserver* m_pObserver;
   IProgressCallback* m_pProgressCallback;
 
-  std::vector<CThread *> m_workers;
+private:
+  friend class CBackgroundInfoLoaderJob;
+  void Run();
+  void OnJobDeleted();
+
+  std::vector<unsigned int> m_jobs; ///< ids of the jobs loading our items
+  CCriticalSection m_jobsLock;      ///< taken under the job manager's locks, so nothing else is taken while holding it
+  CEvent m_jobsDone;                ///< set once the last of our jobs has been deleted
 };
 
@@ -27,17 +27,24 @@
 #include "FileSystem/SpecialProtocol.h"
 #include "AutoPtrHandle.h"
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
 
 using namespace AUTOPTR;
 using namespace dbiplus;
 
 #define MAX_COMPRESS_COUNT 20
+#define MAX_BATCH_TIME 1000 // ms
 
 CDatabase::CDatabase(void)
 {
   m_bOpen = false;
   m_iRefCount = 0;
   m_sqlite = true;
+  m_batchDepth = 0;
+  m_batchOpen = false;
+  m_batchRows = 0;
+  m_batchStart = 0;
+  m_nestedTransactions = 0;
 }
 
 CDatabase::~CDatabase(void)
@@ -260,6 +267,14 @@ void CDatabase::Close()
   m_bOpen = false;
 
   if (NULL == m_pDB.get() ) return ;
+  if (m_batchOpen)
+  {
+    CLog::Log(LOGWARNING, "%s - closing database with a batch in progress", __FUNCTION__);
+    m_pDB->commit_transaction();
+  }
+  m_batchDepth = 0;
+  m_batchOpen = false;
+  m_nestedTransactions = 0;
   if (NULL != m_pDS.get()) m_pDS->close();
   m_pDB->disconnect();
   m_pDB.reset();
@@ -313,7 +328,22 @@ void CDatabase::BeginTransaction()
   try
   {
     if (NULL != m_pDB.get())
-      m_pDB->start_transaction();
+    {
+      if (m_batchDepth && m_sqlite)
+      { // transactions within a batch are savepoints of the batch transaction
+        if (!m_batchOpen)
+        {
+          m_pDB->start_transaction();
+          m_batchOpen = true;
+          m_batchRows = 0;
+          m_batchStart = CTimeUtils::GetTimeMS();
+        }
+        m_pDS->exec("SAVEPOINT batchitem");
+        m_nestedTransactions++;
+      }
+      else
+        m_pDB->start_transaction();
+    }
   }
   catch (...)
   {
@@ -326,7 +356,18 @@ bool CDatabase::CommitTransaction()
   try
   {
     if (NULL != m_pDB.get())
-      m_pDB->commit_transaction();
+    {
+      if (m_nestedTransactions)
+      { // the items are committed along with the rest of the batch
+        m_nestedTransactions--;
+        m_pDS->exec("RELEASE SAVEPOINT batchitem");
+      }
+      else
+      {
+        m_batchOpen = false;
+        m_pDB->commit_transaction();
+      }
+    }
   }
   catch (...)
   {
@@ -341,7 +382,19 @@ void CDatabase::RollbackTransaction()
   try
   {
     if (NULL != m_pDB.get())
-      m_pDB->rollback_transaction();
+    {
+      if (m_nestedTransactions)
+      { // only undo this item, keeping the rest of the batch
+        m_nestedTransactions--;
+        m_pDS->exec("ROLLBACK TO SAVEPOINT batchitem");
+        m_pDS->exec("RELEASE SAVEPOINT batchitem");
+      }
+      else
+      {
+        m_batchOpen = false;
+        m_pDB->rollback_transaction();
+      }
+    }
   }
   catch (...)
   {
@@ -349,6 +402,68 @@ void CDatabase::RollbackTransaction()
   }
 }
 
+void CDatabase::BeginBatch()
+{
+  if (m_batchDepth++)
+    return;
+
+  m_batchOpen = false;
+  m_nestedTransactions = 0;
+}
+
+void CDatabase::BatchItemDone(unsigned int rows)
+{
+  if (!m_batchOpen)
+    return;
+
+  m_batchRows += rows;
+  if (m_batchRows >= (unsigned int)g_advancedSettings.m_databaseBatchSize ||
+      CTimeUtils::GetTimeMS() - m_batchStart >= MAX_BATCH_TIME)
+    FlushBatch();
+}
+
+bool CDatabase::FlushBatch()
+{
+  // can't commit while an item is still being written
+  if (!m_batchOpen || m_nestedTransactions || NULL == m_pDB.get())
+    return true;
+
+  bool success = true;
+  try
+  {
+    m_pDB->commit_transaction();
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - commit failed", __FUNCTION__);
+    success = false;
+  }
+  m_batchOpen = false;
+  return success;
+}
+
+bool CDatabase::EndBatch()
+{
+  if (!m_batchDepth || --m_batchDepth)
+    return true;
+
+  if (m_nestedTransactions)
+    CLog::Log(LOGWARNING, "%s - %i transactions still pending", __FUNCTION__, m_nestedTransactions);
+  m_nestedTransactions = 0;
+
+  // there's only something to commit if writes were made since the last flush
+  bool success = FlushBatch();
+  OnBatchEnd();
+  return success;
+}
+
+int CDatabase::InsertRows(const CStdString &table, const CStdString &columns, const std::vector< std::vector<std::string> > &rows)
+{
+  if (NULL == m_pDB.get())
+    throw dbiplus::DbErrors("No Database Connection");
+  return m_pDB->insert_rows(table, columns, rows);
+}
+
 bool CDatabase::InTransaction()
 {
   if (NULL != m_pDB.get()) return false;
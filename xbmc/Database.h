@@ -26,6 +26,7 @@
 #include "lib/sqLite/sqlitedataset.h"
 
 #include <memory>
+#include <vector>
 
 struct DatabaseSettings; // forward
 
@@ -46,6 +47,50 @@ public:
   void RollbackTransaction();
   bool InTransaction();
 
+  /*! \brief Start a batch of writes, as used by the library scanners.
+   While a batch is active, transactions become savepoints of a single batch transaction, so the
+   writes of several items are committed at once, and rolling back one item doesn't lose the
+   others. The batch transaction is started by the first write, and committed via BatchItemDone()
+   once enough rows are written, or via FlushBatch() before a lengthy operation such as an online
+   lookup, so that the database isn't kept locked meanwhile.
+   Batches may be nested, only the outermost EndBatch() commits.
+   \sa BatchItemDone(), FlushBatch(), EndBatch()
+   */
+  void BeginBatch();
+
+  /*! \brief Notify the batch that an item has been written.
+   Commits the batch once <databasebatchsize> rows have been written since the last commit, or once
+   the batch transaction has been open for a second, whichever comes first.
+   \param rows the number of rows written for the item, eg. the songs of a folder.
+   \sa BeginBatch()
+   */
+  void BatchItemDone(unsigned int rows = 1);
+
+  /*! \brief Commit the writes made so far, eg prior to a lengthy operation.
+   The batch stays active, and the next write starts a new transaction.
+   \return true if the writes were committed successfully, or there were none.
+   \sa BeginBatch()
+   */
+  bool FlushBatch();
+
+  /*! \brief End a batch of writes, committing any outstanding items.
+   \return true if the outstanding items were committed successfully.
+   \sa BeginBatch()
+   */
+  bool EndBatch();
+  bool InBatch() const { return m_batchDepth > 0; };
+
+  /*! \brief Insert several rows into a table at once.
+   On sqlite the INSERT is compiled once and reused for every row, and for later calls with the
+   same table and columns. On MySQL the rows are sent several per statement.
+   Throws on failure, as m_pDS->exec() does.
+   \param table the table to insert into.
+   \param columns the comma separated columns the values are for.
+   \param rows the values of each row, as text.
+   \return the number of rows inserted.
+   */
+  int InsertRows(const CStdString &table, const CStdString &columns, const std::vector< std::vector<std::string> > &rows);
+
   static CStdString FormatSQL(CStdString strStmt, ...);
   CStdString PrepareSQL(CStdString strStmt, ...) const;
 
@@ -60,6 +105,12 @@ protected:
   virtual int GetMinVersion() const=0;
   virtual const char *GetDefaultDBName() const=0;
 
+  /*! \brief Called once the outermost batch has ended, so that derived classes may update
+   state depending on the contents of the database once for the whole batch.
+   \sa EndBatch()
+   */
+  virtual void OnBatchEnd() {};
+
   bool m_bOpen;
   bool m_sqlite; ///< \brief whether we use sqlite (defaults to true)
 
@@ -71,4 +122,10 @@ private:
   bool UpdateVersionNumber();
 
   int m_iRefCount;
+
+  int          m_batchDepth;         ///< number of BeginBatch() calls without matching EndBatch()
+  bool         m_batchOpen;          ///< whether the batch transaction has been started
+  unsigned int m_batchRows;          ///< number of rows written in the batch transaction
+  unsigned int m_batchStart;         ///< time (in ms) at which the batch transaction was started
+  int          m_nestedTransactions; ///< number of savepoints open within the batch transaction
 };
@@ -53,6 +53,7 @@
 #include "Settings.h"
 #include "utils/RegExp.h"
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
 #include "utils/Variant.h"
 #include "karaoke/karaokelyricsfactory.h"
 
@@ -61,6 +62,10 @@ using namespace XFILE;
 using namespace PLAYLIST;
 using namespace MUSIC_INFO;
 
+// identifies the disc cache files of CFileItemList ("XBFI"), and the version of their format
+#define FILEITEMLIST_CACHE_MAGIC   0x49464258
+#define FILEITEMLIST_CACHE_VERSION 1
+
 CFileItem::CFileItem(const CSong& song)
 {
   m_musicInfoTag = NULL;
@@ -1570,13 +1575,15 @@ void CFileItemList::Sort(SORT_METHOD sortMethod, SORT_ORDER sortOrder)
   default:
     break;
   }
-  if (sortMethod == SORT_METHOD_FILE        ||
-      sortMethod == SORT_METHOD_VIDEO_SORT_TITLE ||
-      sortMethod == SORT_METHOD_VIDEO_SORT_TITLE_IGNORE_THE ||
-      sortMethod == SORT_METHOD_LABEL_IGNORE_FOLDERS)
-    Sort(sortOrder==SORT_ORDER_ASC ? SSortFileItem::IgnoreFoldersAscending : SSortFileItem::IgnoreFoldersDescending);
-  else if (sortMethod != SORT_METHOD_NONE && sortMethod != SORT_METHOD_UNSORTED)
-    Sort(sortOrder==SORT_ORDER_ASC ? SSortFileItem::Ascending : SSortFileItem::Descending);
+  if (sortMethod != SORT_METHOD_NONE && sortMethod != SORT_METHOD_UNSORTED)
+  {
+    bool ignoreFolders = sortMethod == SORT_METHOD_FILE        ||
+                         sortMethod == SORT_METHOD_VIDEO_SORT_TITLE ||
+                         sortMethod == SORT_METHOD_VIDEO_SORT_TITLE_IGNORE_THE ||
+                         sortMethod == SORT_METHOD_LABEL_IGNORE_FOLDERS;
+    CSingleLock lock(m_lock);
+    SSortFileItem::Sort(m_items, sortOrder==SORT_ORDER_ASC, ignoreFolders);
+  }
 
   m_sortMethod=sortMethod;
   m_sortOrder=sortOrder;
@@ -2221,9 +2228,20 @@ bool CFileItemList::Load(int windowID)
   if (file.Open(GetDiscCacheFile(windowID)))
   {
     CLog::Log(LOGDEBUG,"Loading fileitems [%s]",m_strPath.c_str());
+    unsigned int start = CTimeUtils::GetTimeMS();
     CArchive ar(&file, CArchive::load);
+    int magic = 0, version = 0;
+    ar >> magic;
+    ar >> version;
+    if (magic != FILEITEMLIST_CACHE_MAGIC || version != FILEITEMLIST_CACHE_VERSION || !ar.UseStringTable())
+    {
+      CLog::Log(LOGDEBUG,"  -- discarding outdated cache file");
+      ar.Close();
+      file.Close();
+      return false;
+    }
     ar >> *this;
-    CLog::Log(LOGDEBUG,"  -- items: %i, directory: %s sort method: %i, ascending: %s",Size(),m_strPath.c_str(), m_sortMethod, m_sortOrder ? "true" : "false");
+    CLog::Log(LOGDEBUG,"  -- items: %i, directory: %s sort method: %i, ascending: %s, loaded in %u ms",Size(),m_strPath.c_str(), m_sortMethod, m_sortOrder ? "true" : "false", CTimeUtils::GetTimeMS() - start);
     ar.Close();
     file.Close();
     return true;
@@ -2244,6 +2262,9 @@ bool CFileItemList::Save(int windowID)
   if (file.OpenForWrite(GetDiscCacheFile(windowID), true)) // overwrite always
   {
     CArchive ar(&file, CArchive::store);
+    ar << (int)FILEITEMLIST_CACHE_MAGIC;
+    ar << (int)FILEITEMLIST_CACHE_VERSION;
+    ar.UseStringTable();
     ar << *this;
     CLog::Log(LOGDEBUG,"  -- items: %i, sort method: %i, ascending: %s",iSize,m_sortMethod, m_sortOrder ? "true" : "false");
     ar.Close();
@@ -385,6 +385,9 @@ public:
    The file list may be cached based on which window we're viewing in, as different
    windows will be listing different portions of the same URL (eg viewing music files
    versus viewing video files)
+
+   All the items are created as the list is loaded, as sorting, filtering and the views work on
+   the whole list.  tools/Benchmarks/ArchiveBenchmark times loading a cached listing of 20000 movies.
    
    \param windowID id of the window that's loading this list (defaults to 0)
    \return true if we loaded from the cache, false otherwise.
@@ -137,9 +137,11 @@ int64_t CacheMemBuffer::WaitForData(unsigned int iMinAvail, unsigned int millis)
   if (millis == 0 || IsEndOfInput())
     return m_buffer.getMaxReadSize();
 
+  // every write and the end of input set m_written, so just wait for it until the deadline
   unsigned int time = CTimeUtils::GetTimeMS() + millis;
-  while (!IsEndOfInput() && (unsigned int) m_buffer.getMaxReadSize() < iMinAvail && CTimeUtils::GetTimeMS() < time )
-    m_written.WaitMSec(50); // may miss the deadline. shouldn't be a problem.
+  unsigned int now;
+  while (!IsEndOfInput() && (unsigned int) m_buffer.getMaxReadSize() < iMinAvail && (now = CTimeUtils::GetTimeMS()) < time )
+    m_written.WaitMSec(time - now);
 
   return m_buffer.getMaxReadSize();
 }
@@ -217,6 +219,12 @@ int64_t CacheMemBuffer::Seek(int64_t iFilePosition, int iWhence)
   return CACHE_RC_ERROR;
 }
 
+void CacheMemBuffer::EndOfInput()
+{
+  CCacheStrategy::EndOfInput();
+  m_written.Set();
+}
+
 void CacheMemBuffer::Reset(int64_t iSourcePosition)
 {
   CSingleLock lock(m_sync);
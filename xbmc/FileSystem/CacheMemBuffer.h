@@ -47,6 +47,7 @@ public:
 
     virtual int64_t Seek(int64_t iFilePosition, int iWhence) ;
     virtual void Reset(int64_t iSourcePosition) ;
+    virtual void EndOfInput();
 
 protected:
     int64_t m_nStartPosition;
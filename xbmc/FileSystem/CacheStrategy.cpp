@@ -24,6 +24,7 @@
 #include "PlatformInclude.h"
 #endif
 #include "Util.h"
+#include "AdvancedSettings.h"
 #include "utils/log.h"
 #include "utils/SingleLock.h"
 #include "utils/TimeUtils.h"
@@ -33,6 +34,12 @@
 
 namespace XFILE {
 
+#define SEGMENT_BLOCK_SIZE        (128*1024)
+#define SEGMENT_MIN_BLOCKS        16
+#define SEGMENT_SEEK_POINTS       8  // number of recent seek positions to keep data around
+#define SEGMENT_PROTECT_BLOCKS    4  // number of blocks kept following each seek position
+#define SEGMENT_READAHEAD_SECONDS 10 // amount of data to read ahead, in seconds of source throughput
+
 CCacheStrategy::CCacheStrategy() : m_bEndOfInput(false)
 {
 }
@@ -261,4 +268,308 @@ void CSimpleFileCache::EndOfInput()
   SetEvent(m_hDataAvailEvent);
 }
 
+CSegmentCache::CSegmentCache()
+{
+  m_maxBlocks = std::max(3 * g_advancedSettings.m_cacheMemBufferSize / SEGMENT_BLOCK_SIZE, (unsigned int)SEGMENT_MIN_BLOCKS);
+  m_accessCounter = 0;
+  m_readPos = 0;
+  m_writePos = 0;
+  m_readAhead = 0;
+  m_throughput = 0;
+  m_lastWrite = 0;
+  m_measureTime = 0;
+  m_measureBytes = 0;
+}
+
+CSegmentCache::~CSegmentCache()
+{
+  FreeBlocks();
+}
+
+int CSegmentCache::Open()
+{
+  CSingleLock lock(m_sync);
+  FreeBlocks();
+  m_seekPoints.clear();
+  m_readPos = 0;
+  m_writePos = 0;
+  m_readAhead = std::min(g_advancedSettings.m_cacheMemBufferSize, m_maxBlocks * SEGMENT_BLOCK_SIZE * 3 / 4);
+  m_throughput = 0;
+  m_lastWrite = 0;
+  m_measureTime = 0;
+  m_measureBytes = 0;
+  return CACHE_RC_OK;
+}
+
+int CSegmentCache::Close()
+{
+  CSingleLock lock(m_sync);
+  FreeBlocks();
+  return CACHE_RC_OK;
+}
+
+void CSegmentCache::FreeBlocks()
+{
+  for (Blocks::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+    delete[] it->second.m_data;
+  m_blocks.clear();
+}
+
+int64_t CSegmentCache::GetCachedEnd(int64_t iFilePosition)
+{
+  int64_t pos = iFilePosition;
+  while (true)
+  {
+    Blocks::const_iterator it = m_blocks.find(pos / SEGMENT_BLOCK_SIZE);
+    unsigned int offset = (unsigned int)(pos % SEGMENT_BLOCK_SIZE);
+    if (it == m_blocks.end() || offset < it->second.m_begin || offset >= it->second.m_end)
+      return pos;
+    pos += it->second.m_end - offset;
+    if (it->second.m_end < SEGMENT_BLOCK_SIZE)
+      return pos;
+  }
+}
+
+int64_t CSegmentCache::GetAvailableRead()
+{
+  CSingleLock lock(m_sync);
+  return GetCachedEnd(m_readPos) - m_readPos;
+}
+
+bool CSegmentCache::IsAtEndOfInput()
+{
+  // the end of the input only applies to the range the source is filling
+  CSingleLock lock(m_sync);
+  return IsEndOfInput() && GetCachedEnd(m_readPos) == m_writePos;
+}
+
+bool CSegmentCache::IsProtected(int64_t index) const
+{
+  for (std::deque<int64_t>::const_iterator it = m_seekPoints.begin(); it != m_seekPoints.end(); ++it)
+  {
+    int64_t first = *it / SEGMENT_BLOCK_SIZE;
+    if (index >= first && index < first + SEGMENT_PROTECT_BLOCKS)
+      return true;
+  }
+  return false;
+}
+
+CSegmentCache::CBlock* CSegmentCache::GetBlock(int64_t index)
+{
+  Blocks::iterator it = m_blocks.find(index);
+  if (it != m_blocks.end())
+    return &it->second;
+
+  char *data = NULL;
+  if (m_blocks.size() >= m_maxBlocks)
+  {
+    // reuse the least recently used block outside of the range between the reader and the writer,
+    // preferring those that don't follow a recent seek position
+    int64_t first = std::min(m_readPos, m_writePos) / SEGMENT_BLOCK_SIZE;
+    int64_t last  = std::max(m_readPos, m_writePos) / SEGMENT_BLOCK_SIZE;
+    Blocks::iterator oldest = m_blocks.end();
+    bool oldestProtected = true;
+    for (Blocks::iterator i = m_blocks.begin(); i != m_blocks.end(); ++i)
+    {
+      if (i->first >= first && i->first <= last)
+        continue;
+      bool isProtected = IsProtected(i->first);
+      if (oldest == m_blocks.end() || (oldestProtected && !isProtected) ||
+          (oldestProtected == isProtected && i->second.m_lastAccess < oldest->second.m_lastAccess))
+      {
+        oldest = i;
+        oldestProtected = isProtected;
+      }
+    }
+    if (oldest == m_blocks.end())
+      return NULL;
+    data = oldest->second.m_data;
+    m_blocks.erase(oldest);
+  }
+  else
+    data = new char[SEGMENT_BLOCK_SIZE];
+
+  CBlock &block = m_blocks[index];
+  block.m_data = data;
+  return &block;
+}
+
+void CSegmentCache::UpdateThroughput(unsigned int iWritten)
+{
+  unsigned int now = CTimeUtils::GetTimeMS();
+
+  // only measure while the source is streaming, not the time the writer was held up
+  if (m_lastWrite)
+  {
+    m_measureTime += now - m_lastWrite;
+    m_measureBytes += iWritten;
+  }
+  m_lastWrite = now;
+
+  if (m_measureTime < 500)
+    return;
+
+  unsigned int throughput = (unsigned int)((uint64_t)m_measureBytes * 1000 / m_measureTime);
+  m_throughput = m_throughput ? (3 * m_throughput + throughput) / 4 : throughput;
+  m_measureTime = 0;
+  m_measureBytes = 0;
+
+  uint64_t readAhead = (uint64_t)m_throughput * SEGMENT_READAHEAD_SECONDS;
+  readAhead = std::max(readAhead, (uint64_t)SEGMENT_PROTECT_BLOCKS * SEGMENT_BLOCK_SIZE);
+  readAhead = std::min(readAhead, (uint64_t)m_maxBlocks * SEGMENT_BLOCK_SIZE * 3 / 4);
+  m_readAhead = (unsigned int)readAhead;
+}
+
+int CSegmentCache::WriteToCache(const char *pBuffer, size_t iSize)
+{
+  CSingleLock lock(m_sync);
+
+  size_t iWritten = 0;
+  while (iWritten < iSize && m_writePos - m_readPos < (int64_t)m_readAhead)
+  {
+    CBlock *block = GetBlock(m_writePos / SEGMENT_BLOCK_SIZE);
+    if (!block)
+      break;
+
+    unsigned int offset = (unsigned int)(m_writePos % SEGMENT_BLOCK_SIZE);
+    unsigned int size = std::min((unsigned int)(iSize - iWritten), SEGMENT_BLOCK_SIZE - offset);
+    memcpy(block->m_data + offset, pBuffer + iWritten, size);
+
+    // merge with the valid range of the block, or replace it if we're not adjacent
+    if (block->m_end > block->m_begin && offset <= block->m_end && offset + size >= block->m_begin)
+    {
+      block->m_begin = std::min(block->m_begin, offset);
+      block->m_end = std::max(block->m_end, offset + size);
+    }
+    else
+    {
+      block->m_begin = offset;
+      block->m_end = offset + size;
+    }
+    block->m_lastAccess = m_accessCounter++;
+
+    m_writePos += size;
+    iWritten += size;
+  }
+
+  if (iWritten > 0)
+  {
+    UpdateThroughput(iWritten);
+    m_written.Set();
+  }
+  else
+    m_lastWrite = 0;
+
+  return iWritten;
+}
+
+int CSegmentCache::ReadFromCache(char *pBuffer, size_t iMaxSize)
+{
+  CSingleLock lock(m_sync);
+
+  size_t iRead = 0;
+  while (iRead < iMaxSize)
+  {
+    Blocks::iterator it = m_blocks.find(m_readPos / SEGMENT_BLOCK_SIZE);
+    unsigned int offset = (unsigned int)(m_readPos % SEGMENT_BLOCK_SIZE);
+    if (it == m_blocks.end() || offset < it->second.m_begin || offset >= it->second.m_end)
+      break;
+
+    CBlock &block = it->second;
+    unsigned int size = std::min((unsigned int)(iMaxSize - iRead), block.m_end - offset);
+    memcpy(pBuffer + iRead, block.m_data + offset, size);
+    block.m_lastAccess = m_accessCounter++;
+
+    m_readPos += size;
+    iRead += size;
+  }
+
+  if (iRead == 0)
+    return IsAtEndOfInput() ? CACHE_RC_EOF : CACHE_RC_WOULD_BLOCK;
+
+  m_space.Set();
+  return iRead;
+}
+
+int64_t CSegmentCache::WaitForData(unsigned int iMinAvail, unsigned int iMillis)
+{
+  unsigned int timeout = CTimeUtils::GetTimeMS() + iMillis;
+  int64_t iAvail = GetAvailableRead();
+  while (iAvail < iMinAvail && !IsAtEndOfInput() && CTimeUtils::GetTimeMS() < timeout)
+  {
+    m_written.WaitMSec(50);
+    iAvail = GetAvailableRead();
+  }
+  return iAvail;
+}
+
+int64_t CSegmentCache::Seek(int64_t iFilePosition, int iWhence)
+{
+  if (iWhence != SEEK_SET)
+  {
+    // sanity. we should always get here with SEEK_SET
+    CLog::Log(LOGERROR, "%s, only SEEK_SET supported.", __FUNCTION__);
+    return CACHE_RC_ERROR;
+  }
+
+  CSingleLock lock(m_sync);
+
+  // if seek is a bit over what the source is filling, wait for it rather than seeking the source
+  if (iFilePosition > m_writePos && iFilePosition < m_writePos + 100000 && GetCachedEnd(m_readPos) == m_writePos)
+  {
+    lock.Leave();
+    WaitForData((unsigned int)(iFilePosition - m_readPos) + 1, 5000);
+    lock.Enter();
+  }
+
+  if (GetCachedEnd(iFilePosition) == iFilePosition && iFilePosition != m_writePos)
+    return CACHE_RC_ERROR;
+
+  m_readPos = iFilePosition;
+
+  // only keep data around seek points once the source has seeked. Otherwise (for sources that
+  // can't seek) the least recently used blocks are evicted in order, and the cached range always
+  // runs on to the data the source is filling
+  if (!m_seekPoints.empty())
+  {
+    m_seekPoints.push_back(iFilePosition);
+    if (m_seekPoints.size() > SEGMENT_SEEK_POINTS)
+      m_seekPoints.pop_front();
+  }
+  m_space.Set();
+  return m_readPos;
+}
+
+void CSegmentCache::Reset(int64_t iSourcePosition)
+{
+  CSingleLock lock(m_sync);
+
+  // keep the cached data, the source simply continues at the new position
+  m_readPos = iSourcePosition;
+  m_writePos = iSourcePosition;
+  m_lastWrite = 0;
+  m_seekPoints.push_back(iSourcePosition);
+  if (m_seekPoints.size() > SEGMENT_SEEK_POINTS)
+    m_seekPoints.pop_front();
+}
+
+void CSegmentCache::EndOfInput()
+{
+  CCacheStrategy::EndOfInput();
+  m_written.Set();
+}
+
+int64_t CSegmentCache::CachedDataEndPos(int64_t iFilePosition)
+{
+  CSingleLock lock(m_sync);
+  return GetCachedEnd(iFilePosition);
+}
+
+void CSegmentCache::SetWritePosition(int64_t iSourcePosition)
+{
+  CSingleLock lock(m_sync);
+  m_writePos = iSourcePosition;
+  m_lastWrite = 0;
+}
+
 }
@@ -24,6 +24,8 @@
 #define XFILECACHESTRATEGY_H
 
 #include <stdint.h>
+#include <map>
+#include <deque>
 #ifdef _LINUX
 #include "PlatformDefs.h"
 #include "XHandlePublic.h"
@@ -72,6 +74,20 @@ public:
 
   virtual ICacheInterface* GetInterface() { return NULL; }
 
+  /*!
+   \brief Get the end of the data cached contiguously from the given position.
+   Strategies that keep more than one range of the file use this to have the source
+   continue filling right after the data the reader gets to next.
+   \return the end of the cached data, -1 if the strategy doesn't track it.
+   */
+  virtual int64_t CachedDataEndPos(int64_t iFilePosition) { return -1; }
+
+  /*!
+   \brief The source continues filling the cache at the given position, without moving
+   the read position (used along with CachedDataEndPos()).
+   */
+  virtual void SetWritePosition(int64_t iSourcePosition) { }
+
   CEvent m_space;
 protected:
   bool  m_bEndOfInput;
@@ -107,6 +123,68 @@ protected:
   volatile int64_t m_nReadPosition;
 };
 
+/**
+  Memory cache holding several ranges of the file, in fixed size blocks.
+  Blocks following recent seek points are kept in preference to others, so that
+  seeking back and forth between positions doesn't refetch the data, and the read
+  ahead is sized from the measured throughput of the source.
+*/
+class CSegmentCache : public CCacheStrategy
+{
+  class CBlock
+  {
+  public:
+    CBlock() { m_data = NULL; m_begin = 0; m_end = 0; m_lastAccess = 0; };
+
+    char        *m_data;
+    unsigned int m_begin;      ///< offset of the first valid byte
+    unsigned int m_end;        ///< offset past the last valid byte
+    unsigned int m_lastAccess;
+  };
+  typedef std::map<int64_t, CBlock> Blocks; ///< blocks keyed by index (file position / block size)
+
+public:
+  CSegmentCache();
+  virtual ~CSegmentCache();
+
+  virtual int Open();
+  virtual int Close();
+
+  virtual int WriteToCache(const char *pBuffer, size_t iSize);
+  virtual int ReadFromCache(char *pBuffer, size_t iMaxSize);
+  virtual int64_t WaitForData(unsigned int iMinAvail, unsigned int iMillis);
+
+  virtual int64_t Seek(int64_t iFilePosition, int iWhence);
+  virtual void Reset(int64_t iSourcePosition);
+  virtual void EndOfInput();
+
+  virtual int64_t CachedDataEndPos(int64_t iFilePosition);
+  virtual void SetWritePosition(int64_t iSourcePosition);
+
+protected:
+  int64_t GetCachedEnd(int64_t iFilePosition);
+  int64_t GetAvailableRead();
+  bool    IsAtEndOfInput();
+  CBlock* GetBlock(int64_t index);
+  bool    IsProtected(int64_t index) const;
+  void    UpdateThroughput(unsigned int iWritten);
+  void    FreeBlocks();
+
+  Blocks              m_blocks;
+  std::deque<int64_t> m_seekPoints;     ///< most recent seek positions
+  unsigned int        m_maxBlocks;
+  unsigned int        m_accessCounter;
+  int64_t             m_readPos;
+  int64_t             m_writePos;
+  unsigned int        m_readAhead;      ///< max amount of data (in bytes) to cache ahead of the read position
+  unsigned int        m_throughput;     ///< measured throughput of the source, in bytes per second
+  unsigned int        m_lastWrite;      ///< time of the last write, 0 if the writer was held up
+  unsigned int        m_measureTime;
+  unsigned int        m_measureBytes;
+  CCriticalSection    m_sync;
+  CEvent              m_written;
+};
+
 }
 
 #endif
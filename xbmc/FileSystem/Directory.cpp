@@ -129,14 +129,15 @@ bool CDirectory::GetDirectory(const CStdString& strPath, CFileItemList &items, C
       return false;
 
     // check our cache for this path
-    if (g_directoryCache.GetDirectory(strPath, items, cacheDirectory == DIR_CACHE_ALWAYS))
+    if (g_directoryCache.GetDirectory(strPath, items, cacheDirectory == DIR_CACHE_ALWAYS, cacheDirectory))
       items.m_strPath = strPath;
     else
     {
       // need to clear the cache (in case the directory fetch fails)
-      // and (re)fetch the folder
+      // and (re)fetch the folder.  a persistent listing is kept, it's
+      // replaced when the gui thread fetches the folder, and checked when read
       if (cacheDirectory != DIR_CACHE_NEVER)
-        g_directoryCache.ClearDirectory(strPath);
+        g_directoryCache.ClearDirectory(strPath, false);
 
       pDirectory->SetAllowPrompting(allowPrompting);
       pDirectory->SetCacheDirectory(cacheDirectory);
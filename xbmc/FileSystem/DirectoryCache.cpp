@@ -23,12 +23,25 @@
 #include "Util.h"
 #include "Settings.h"
 #include "FileItem.h"
+#include "AdvancedSettings.h"
+#include "Application.h"
+#include "GUIUserMessages.h"
+#include "GUIWindowManager.h"
+#include "FactoryDirectory.h"
+#include "File.h"
+#include "URL.h"
+#include "Crc32.h"
+#include "utils/Archive.h"
+#include "utils/JobManager.h"
 #include "utils/SingleLock.h"
 #include "utils/log.h"
 
 using namespace std;
 using namespace XFILE;
 
+#define PERSISTENT_CACHE_FOLDER  "special://temp/dircache/"
+#define PERSISTENT_CACHE_VERSION 2
+
 CDirectoryCache::CDir::CDir(DIR_CACHE_TYPE cacheType)
 {
   m_cacheType = cacheType;
@@ -47,11 +60,41 @@ void CDirectoryCache::CDir::SetLastAccess(unsigned int &accessCounter)
   m_lastAccess = accessCounter++;
 }
 
+CDirectoryCache::CPersistJob::CPersistJob(CDirectoryCache *cache, const CStdString &path, const CFileItemList &items, DIR_CACHE_TYPE cacheType, bool revalidate, int64_t mtime)
+{
+  m_cache = cache;
+  m_path = path;
+  m_items = new CFileItemList;
+  m_items->Copy(items);
+  m_cacheType = cacheType;
+  m_revalidate = revalidate;
+  m_mtime = mtime;
+}
+
+CDirectoryCache::CPersistJob::~CPersistJob()
+{
+  delete m_items;
+}
+
+bool CDirectoryCache::CPersistJob::DoWork()
+{
+  if (m_revalidate)
+  {
+    m_cache->RevalidatePersistentDirectory(m_path, *m_items, m_cacheType, m_mtime);
+    m_cache->OnPersistJobDone(m_path);
+  }
+  else
+    m_cache->StorePersistentDirectory(m_path, *m_items, m_cacheType);
+  return true;
+}
+
 CDirectoryCache::CDirectoryCache(void)
 {
   m_iThumbCacheRefCount = 0;
   m_iMusicThumbCacheRefCount = 0;
   m_accessCounter = 0;
+  m_persistentInit = false;
+  m_persistentSize = 0;
 #ifdef _DEBUG
   m_cacheHits = 0;
   m_cacheMisses = 0;
@@ -62,7 +105,7 @@ CDirectoryCache::~CDirectoryCache(void)
 {
 }
 
-bool CDirectoryCache::GetDirectory(const CStdString& strPath, CFileItemList &items, bool retrieveAll)
+bool CDirectoryCache::GetDirectory(const CStdString& strPath, CFileItemList &items, bool retrieveAll, DIR_CACHE_TYPE cacheType)
 {
   CSingleLock lock (m_cs);
 
@@ -84,7 +127,14 @@ bool CDirectoryCache::GetDirectory(const CStdString& strPath, CFileItemList &ite
       return true;
     }
   }
-  return false;
+  lock.Leave();
+
+  // only the gui thread is served from the persistent cache, with the listing revalidated
+  // in the background.  other threads (eg scanners) want the current listing
+  if (cacheType == DIR_CACHE_NEVER || !g_application.IsCurrentThread())
+    return false;
+
+  return GetPersistentDirectory(strPath, items);
 }
 
 void CDirectoryCache::SetDirectory(const CStdString& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType)
@@ -108,7 +158,21 @@ void CDirectoryCache::SetDirectory(const CStdString& strPath, const CFileItemLis
   CStdString storedPath = strPath;
   CUtil::RemoveSlashAtEnd(storedPath);
 
-  ClearDirectory(storedPath);
+  CacheDirectory(storedPath, items, cacheType);
+
+  // only listings fetched by the gui thread are read back from the persistent cache, a
+  // listing stored there by it is otherwise left alone, as it's validated when it's read
+  if (IsPersistable(strPath) && g_application.IsCurrentThread())
+    QueuePersistJob(strPath, items, cacheType, false);
+}
+
+void CDirectoryCache::CacheDirectory(const CStdString& storedPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType)
+{
+  CSingleLock lock (m_cs);
+
+  iCache i = m_cache.find(storedPath);
+  if (i != m_cache.end())
+    Delete(i);
 
   CheckIfFull();
 
@@ -125,7 +189,7 @@ void CDirectoryCache::ClearFile(const CStdString& strFile)
   ClearDirectory(strPath);
 }
 
-void CDirectoryCache::ClearDirectory(const CStdString& strPath)
+void CDirectoryCache::ClearDirectory(const CStdString& strPath, bool persistent)
 {
   CSingleLock lock (m_cs);
 
@@ -135,6 +199,9 @@ void CDirectoryCache::ClearDirectory(const CStdString& strPath)
   iCache i = m_cache.find(storedPath);
   if (i != m_cache.end())
     Delete(i);
+
+  if (persistent)
+    ClearPersistentDirectory(storedPath);
 }
 
 void CDirectoryCache::ClearSubPaths(const CStdString& strPath)
@@ -153,6 +220,17 @@ void CDirectoryCache::ClearSubPaths(const CStdString& strPath)
     else
       i++;
   }
+
+  // persistent listings not used this session are left to be validated when next retrieved
+  vector<CStdString> paths;
+  for (PersistentCache::const_iterator it = m_persistent.begin(); it != m_persistent.end(); ++it)
+  {
+    const CStdString &path = it->second.m_path;
+    if (!path.IsEmpty() && strncmp(path.c_str(), storedPath.c_str(), storedPath.GetLength()) == 0)
+      paths.push_back(path);
+  }
+  for (unsigned int j = 0; j < paths.size(); j++)
+    ClearPersistentDirectory(paths[j]);
 }
 
 void CDirectoryCache::AddFile(const CStdString& strFile)
@@ -171,6 +249,8 @@ void CDirectoryCache::AddFile(const CStdString& strFile)
     dir->m_Items->Add(item);
     dir->SetLastAccess(m_accessCounter);
   }
+
+  ClearPersistentDirectory(strPath);
 }
 
 bool CDirectoryCache::FileExists(const CStdString& strFile, bool& bInCache)
@@ -359,6 +439,283 @@ void CDirectoryCache::Delete(iCache it)
   m_cache.erase(it);
 }
 
+bool CDirectoryCache::GetPersistentDirectory(const CStdString& strPath, CFileItemList &items)
+{
+  if (!IsPersistable(strPath))
+    return false;
+
+  CStdString storedPath = strPath;
+  CUtil::RemoveSlashAtEnd(storedPath);
+  CStdString cacheFile = GetPersistentFile(storedPath);
+
+  {
+    CSingleLock lock (m_cs);
+    InitPersistentCache();
+    if (m_persistent.find(cacheFile) == m_persistent.end())
+      return false;
+  }
+
+  int version = 0;
+  CStdString path;
+  int64_t mtime = 0;
+  int cacheType = DIR_CACHE_NEVER;
+
+  CFile file;
+  if (!file.Open(cacheFile))
+    return false;
+  CArchive ar(&file, CArchive::load);
+  ar >> version;
+  if (version == PERSISTENT_CACHE_VERSION && ar.UseStringTable())
+    ar >> path;
+  if (path == storedPath)
+  {
+    ar >> mtime;
+    ar >> cacheType;
+    ar >> items;
+  }
+  ar.Close();
+  file.Close();
+
+  if (path != storedPath)
+  {
+    CLog::Log(LOGDEBUG, "%s - discarding outdated cache file %s for %s", __FUNCTION__, cacheFile.c_str(), strPath.c_str());
+    CSingleLock lock (m_cs);
+    ClearPersistentDirectory(storedPath);
+    return false;
+  }
+
+  if (cacheType == DIR_CACHE_NEVER)
+  {
+    items.Clear();
+    return false;
+  }
+
+  // serve the cached listing so the user isn't waiting on the share, and check it in the background
+  QueuePersistJob(strPath, items, (DIR_CACHE_TYPE)cacheType, true, mtime);
+
+  CSingleLock lock (m_cs);
+  CacheDirectory(storedPath, items, (DIR_CACHE_TYPE)cacheType);
+  PersistentCache::iterator it = m_persistent.find(cacheFile);
+  if (it != m_persistent.end())
+  {
+    it->second.m_path = storedPath;
+    it->second.m_lastAccess = m_accessCounter++;
+  }
+  return true;
+}
+
+void CDirectoryCache::QueuePersistJob(const CStdString& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType, bool revalidate, int64_t mtime)
+{
+  CSingleLock lock (m_cs);
+  // a pending refetch of this path will update the listing anyway
+  if (revalidate && !m_persistJobs.insert(strPath).second)
+    return;
+  CJobManager::GetInstance().AddJob(new CPersistJob(this, strPath, items, cacheType, revalidate, mtime), NULL);
+}
+
+void CDirectoryCache::OnPersistJobDone(const CStdString& strPath)
+{
+  CSingleLock lock (m_cs);
+  m_persistJobs.erase(strPath);
+}
+
+void CDirectoryCache::StorePersistentDirectory(const CStdString& strPath, CFileItemList &items, DIR_CACHE_TYPE cacheType)
+{
+  CStdString storedPath = strPath;
+  CUtil::RemoveSlashAtEnd(storedPath);
+  CStdString cacheFile = GetPersistentFile(storedPath);
+  CStdString tempFile = cacheFile + ".tmp";
+
+  // the modification time is taken after the listing, so a change in between goes unnoticed until the next change
+  int64_t mtime = GetModificationTime(strPath);
+
+  {
+    CSingleLock lock (m_cs);
+    InitPersistentCache();
+  }
+
+  // only one listing is written at a time, so writes of the same path don't collide
+  CSingleLock writeLock (m_persistentWrite);
+
+  // write to a temporary file, so a listing is never read while partially written
+  CFile file;
+  if (!file.OpenForWrite(tempFile, true))
+    return;
+  CArchive ar(&file, CArchive::store);
+  ar << (int)PERSISTENT_CACHE_VERSION;
+  ar.UseStringTable();
+  ar << storedPath;
+  ar << mtime;
+  ar << (int)cacheType;
+  ar << items;
+  ar.Close();
+  unsigned int size = (unsigned int)file.GetLength();
+  file.Close();
+
+  CSingleLock lock (m_cs);
+  ClearPersistentDirectory(storedPath);
+  if (!CFile::Rename(tempFile, cacheFile))
+  {
+    CLog::Log(LOGERROR, "%s - unable to write %s for %s", __FUNCTION__, cacheFile.c_str(), strPath.c_str());
+    CFile::Delete(tempFile);
+    return;
+  }
+
+  CPersistentDir dir(size);
+  dir.m_path = storedPath;
+  dir.m_lastAccess = m_accessCounter++;
+  m_persistent[cacheFile] = dir;
+  m_persistentSize += size;
+  CheckIfPersistentFull();
+}
+
+static bool IsSameListing(const CFileItemList &items1, const CFileItemList &items2)
+{
+  if (items1.Size() != items2.Size())
+    return false;
+  for (int i = 0; i < items1.Size(); i++)
+  {
+    const CFileItemPtr item1 = items1[i];
+    const CFileItemPtr item2 = items2[i];
+    if (item1->m_strPath != item2->m_strPath || item1->m_bIsFolder != item2->m_bIsFolder ||
+        item1->m_dwSize != item2->m_dwSize || item1->m_dateTime != item2->m_dateTime ||
+        item1->GetLabel() != item2->GetLabel())
+      return false;
+  }
+  return true;
+}
+
+void CDirectoryCache::RevalidatePersistentDirectory(const CStdString& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType, int64_t mtime)
+{
+  // where the share reports the modification time of the directory, an unchanged one means an unchanged listing
+  if (mtime && GetModificationTime(strPath) == mtime)
+    return;
+
+  auto_ptr<IDirectory> pDirectory(CFactoryDirectory::Create(strPath));
+  if (!pDirectory.get())
+    return;
+
+  CFileItemList newItems;
+  newItems.m_strPath = strPath;
+  if (!pDirectory->GetDirectory(strPath, newItems))
+    return; // keep the cached listing while the share is unavailable
+
+  if (IsSameListing(items, newItems))
+    return;
+
+  CLog::Log(LOGDEBUG, "%s - %s has changed, refreshing", __FUNCTION__, strPath.c_str());
+  CStdString storedPath = strPath;
+  CUtil::RemoveSlashAtEnd(storedPath);
+  CacheDirectory(storedPath, newItems, cacheType);
+  StorePersistentDirectory(strPath, newItems, cacheType);
+
+  CGUIMessage message(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_UPDATE_PATH);
+  message.SetStringParam(strPath);
+  g_windowManager.SendThreadMessage(message);
+}
+
+void CDirectoryCache::ClearPersistentDirectory(const CStdString& storedPath)
+{
+  CSingleLock lock (m_cs);
+  if (!IsPersistable(storedPath))
+    return;
+
+  InitPersistentCache();
+  CStdString cacheFile = GetPersistentFile(storedPath);
+  PersistentCache::iterator it = m_persistent.find(cacheFile);
+  if (it == m_persistent.end())
+    return;
+
+  m_persistentSize -= it->second.m_size;
+  m_persistent.erase(it);
+  CFile::Delete(cacheFile);
+}
+
+bool CDirectoryCache::IsPersistable(const CStdString& strPath) const
+{
+  if (!g_advancedSettings.m_dirCachePersistentSize)
+    return false;
+
+  // network shares that are slow to list
+  CStdString protocol = CURL(strPath).GetProtocol();
+  return protocol.Equals("smb")  || protocol.Equals("sftp") ||
+         protocol.Equals("ftp")  || protocol.Equals("ftps") || protocol.Equals("ftpx") ||
+         protocol.Equals("dav")  || protocol.Equals("davs") ||
+         protocol.Equals("upnp") || protocol.Equals("daap");
+}
+
+void CDirectoryCache::InitPersistentCache()
+{
+  CSingleLock lock (m_cs);
+  if (m_persistentInit)
+    return;
+  m_persistentInit = true;
+
+  if (!CDirectory::Exists(PERSISTENT_CACHE_FOLDER))
+    CDirectory::Create(PERSISTENT_CACHE_FOLDER);
+
+  // the oldest cache files are the first to go
+  CFileItemList items;
+  CDirectory::GetDirectory(PERSISTENT_CACHE_FOLDER, items, ".fi|.tmp", false, false, DIR_CACHE_NEVER, false);
+  items.Sort(SORT_METHOD_DATE, SORT_ORDER_ASC);
+  for (int i = 0; i < items.Size(); i++)
+  {
+    CFileItemPtr item = items[i];
+    if (item->m_bIsFolder)
+      continue;
+    if (CUtil::GetExtension(item->m_strPath).Equals(".tmp"))
+    { // left over from an interrupted write
+      CFile::Delete(item->m_strPath);
+      continue;
+    }
+    CPersistentDir dir((unsigned int)item->m_dwSize);
+    dir.m_lastAccess = m_accessCounter++;
+    m_persistent[item->m_strPath] = dir;
+    m_persistentSize += dir.m_size;
+  }
+  CLog::Log(LOGDEBUG, "%s - %u listings cached, %"PRIu64" bytes", __FUNCTION__, (unsigned int)m_persistent.size(), m_persistentSize);
+
+  CheckIfPersistentFull();
+}
+
+void CDirectoryCache::CheckIfPersistentFull()
+{
+  CSingleLock lock (m_cs);
+
+  // remove the least recently used listings until we're within budget
+  while (m_persistentSize > g_advancedSettings.m_dirCachePersistentSize && !m_persistent.empty())
+  {
+    PersistentCache::iterator lastAccessed = m_persistent.begin();
+    for (PersistentCache::iterator i = m_persistent.begin(); i != m_persistent.end(); i++)
+    {
+      if (i->second.m_lastAccess < lastAccessed->second.m_lastAccess)
+        lastAccessed = i;
+    }
+    CStdString cacheFile = lastAccessed->first;
+    m_persistentSize -= lastAccessed->second.m_size;
+    m_persistent.erase(lastAccessed);
+    CFile::Delete(cacheFile);
+  }
+}
+
+CStdString CDirectoryCache::GetPersistentFile(const CStdString& storedPath)
+{
+  Crc32 crc;
+  crc.ComputeFromLowerCase(storedPath);
+
+  CStdString cacheFile;
+  cacheFile.Format(PERSISTENT_CACHE_FOLDER "%08x.fi", (unsigned __int32)crc);
+  return cacheFile;
+}
+
+int64_t CDirectoryCache::GetModificationTime(const CStdString& strPath)
+{
+  struct __stat64 buffer;
+  if (CFile::Stat(strPath, &buffer) == 0)
+    return buffer.st_mtime;
+  return 0;
+}
+
 #ifdef _DEBUG
 void CDirectoryCache::PrintStats() const
 {
@@ -23,6 +23,7 @@
 #include "IDirectory.h"
 #include "Directory.h"
 #include "utils/CriticalSection.h"
+#include "utils/Job.h"
 
 #include <map>
 #include <set>
@@ -47,12 +48,48 @@ namespace XFILE
     private:
       unsigned int m_lastAccess;
     };
+
+    /*! \brief A directory listing held in the persistent (on disk) cache.
+     */
+    class CPersistentDir
+    {
+    public:
+      CPersistentDir(unsigned int size = 0) { m_size = size; m_lastAccess = 0; };
+
+      CStdString   m_path;       ///< path of the directory, empty if not yet known this session
+      unsigned int m_size;       ///< size of the cache file in bytes
+      unsigned int m_lastAccess;
+    };
+
+    /*! \brief Job for writing a listing to the persistent cache, or for validating
+     a listing that was served from it.
+     */
+    class CPersistJob : public CJob
+    {
+    public:
+      CPersistJob(CDirectoryCache *cache, const CStdString &path, const CFileItemList &items, DIR_CACHE_TYPE cacheType, bool revalidate, int64_t mtime);
+      virtual ~CPersistJob();
+
+      virtual const char* GetType() const { return "dircache"; };
+      virtual bool DoWork();
+
+      CDirectoryCache *m_cache;
+      CStdString       m_path;
+      CFileItemList   *m_items;
+      DIR_CACHE_TYPE   m_cacheType;
+      bool             m_revalidate;
+      int64_t          m_mtime;      ///< modification time the listing was stored with, 0 if unknown
+    };
+
   public:
     CDirectoryCache(void);
     virtual ~CDirectoryCache(void);
-    bool GetDirectory(const CStdString& strPath, CFileItemList &items, bool retrieveAll = false);
+    bool GetDirectory(const CStdString& strPath, CFileItemList &items, bool retrieveAll = false, DIR_CACHE_TYPE cacheType = DIR_CACHE_ONCE);
     void SetDirectory(const CStdString& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType);
-    void ClearDirectory(const CStdString& strPath);
+    /*! \brief Drop a listing from the cache.
+     \param persistent whether to drop it from the persistent cache as well, rather than only from memory.
+     */
+    void ClearDirectory(const CStdString& strPath, bool persistent = true);
     void ClearFile(const CStdString& strFile);
     void ClearSubPaths(const CStdString& strPath);
     void Clear();
@@ -70,6 +107,31 @@ namespace XFILE
     void ClearCache(std::set<CStdString>& dirs);
     bool IsCacheDir(const CStdString &strPath) const;
     void CheckIfFull();
+    void CacheDirectory(const CStdString& storedPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType);
+
+    /*! \brief Retrieve a listing of a network share from the persistent cache, for the gui thread.
+     The listing is served straight away, and validated in the background: against the
+     modification time of the directory if the share reports one, otherwise by fetching
+     it again.  The window is refreshed if the listing has changed.
+     */
+    bool GetPersistentDirectory(const CStdString& strPath, CFileItemList &items);
+    void QueuePersistJob(const CStdString& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType, bool revalidate, int64_t mtime = 0);
+    void StorePersistentDirectory(const CStdString& strPath, CFileItemList &items, DIR_CACHE_TYPE cacheType);
+    void RevalidatePersistentDirectory(const CStdString& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType, int64_t mtime);
+    void ClearPersistentDirectory(const CStdString& storedPath);
+    void OnPersistJobDone(const CStdString& strPath);
+    bool IsPersistable(const CStdString& strPath) const;
+    void InitPersistentCache();
+    void CheckIfPersistentFull();
+    static CStdString GetPersistentFile(const CStdString& storedPath);
+    static int64_t GetModificationTime(const CStdString& strPath);
+
+    typedef std::map<CStdString, CPersistentDir> PersistentCache;
+    PersistentCache      m_persistent;     ///< persistent cache files, keyed by file name
+    std::set<CStdString> m_persistJobs;    ///< paths with a pending refetch
+    CCriticalSection     m_persistentWrite;
+    bool                 m_persistentInit;
+    uint64_t             m_persistentSize; ///< total size of the persistent cache files
 
     std::map<CStdString, CDir*> m_cache;
     typedef std::map<CStdString, CDir*>::iterator iCache;
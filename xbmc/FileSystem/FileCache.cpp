@@ -26,6 +26,7 @@
 #include "URL.h"
 
 #include "CacheMemBuffer.h"
+#include "AdvancedSettings.h"
 #include "utils/SingleLock.h"
 #include "utils/log.h"
 
@@ -40,7 +41,10 @@ CFileCache::CFileCache()
    m_nSeekResult = 0;
    m_seekPos = 0;
    m_readPos = 0;
-   m_pCache = new CacheMemBuffer();
+   if (g_advancedSettings.m_cacheSegmented)
+     m_pCache = new CSegmentCache();
+   else
+     m_pCache = new CacheMemBuffer();
    m_seekPossible = 0;
 }
 
@@ -135,6 +139,7 @@ void CFileCache::Process()
     return;
   }
 
+  int64_t writePos = 0;
   while(!m_bStop)
   {
     // check for seek events
@@ -149,11 +154,34 @@ void CFileCache::Process()
         m_seekPossible = m_source.Seek(0, SEEK_POSSIBLE);
       }
       else
+      {
         m_pCache->Reset(m_seekPos);
+        writePos = m_seekPos;
+      }
 
       m_seekEnded.Set();
     }
 
+    // continue filling right after the data cached from the read position on, which skips data
+    // the cache already holds, and follows the reader when it seeks into a cached range
+    int64_t fillPos = GetFillPosition(writePos);
+    if (fillPos >= 0)
+    {
+      CLog::Log(LOGDEBUG,"%s, continue filling the cache at %"PRId64, __FUNCTION__, fillPos);
+      if (m_source.Seek(fillPos, SEEK_SET) == fillPos)
+      {
+        m_pCache->ClearEndOfInput();
+        m_pCache->SetWritePosition(fillPos);
+        writePos = fillPos;
+      }
+      else
+      {
+        CLog::Log(LOGERROR,"%s, error %d seeking source to %"PRId64, __FUNCTION__, (int)GetLastError(), fillPos);
+        m_seekPossible = m_source.Seek(0, SEEK_POSSIBLE);
+        m_source.Seek(writePos, SEEK_SET);
+      }
+    }
+
     int iRead = m_source.Read(buffer.get(), chunksize);
     if(iRead == 0)
     {
@@ -161,16 +189,25 @@ void CFileCache::Process()
       m_pCache->EndOfInput();
 
       // since there is no more to read - wait either for seek or close
-      // WaitForSingleObject is CThread::WaitForSingleObject that will also listen to the
-      // end thread event.
-      int nRet = CThread::WaitForSingleObject(m_seekEvent.GetHandle(), INFINITE);
+      // WaitForMultipleObjects is CThread::WaitForMultipleObjects that will also listen to the
+      // end thread event.  Strategies that keep several ranges may also need us to fill
+      // in elsewhere once the reader moves on, which only happens when it reads or seeks,
+      // both of which signal m_space.
+      HANDLE handles[2] = { m_seekEvent.GetHandle(), m_pCache->m_space.GetHandle() };
+      DWORD nRet;
+      do
+      {
+        nRet = CThread::WaitForMultipleObjects(2, handles, false, INFINITE);
+      } while (nRet == WAIT_OBJECT_0 + 1 && GetFillPosition(writePos) < 0);
+
       if (nRet == WAIT_OBJECT_0)
       {
         m_pCache->ClearEndOfInput();
         m_seekEvent.Set(); // hack so that later we realize seek is needed
       }
-      else
+      else if (nRet != WAIT_OBJECT_0 + 1)
         break;
+      continue;
     }
     else if (iRead < 0)
       m_bStop = true;
@@ -190,9 +227,15 @@ void CFileCache::Process()
         break;
       }
       else if (iWrite == 0)
-        m_pCache->m_space.WaitMSec(5);
+      {
+        // the cache is full, wait for the reader to make room or for a seek or close
+        HANDLE handles[2] = { m_pCache->m_space.GetHandle(), m_seekEvent.GetHandle() };
+        if (CThread::WaitForMultipleObjects(2, handles, false, INFINITE) == WAIT_OBJECT_0 + 1)
+          m_seekEvent.Set(); // picked up below
+      }
 
       iTotalWrite += iWrite;
+      writePos += iWrite;
 
       // check if seek was asked. otherwise if cache is full we'll freeze.
       if (m_seekEvent.WaitMSec(0))
@@ -200,10 +243,26 @@ void CFileCache::Process()
         m_seekEvent.Set(); // make sure we get the seek event later.
         break;
       }
+
+      // likewise if the reader moved on to another cached range
+      if (iWrite == 0 && GetFillPosition(writePos) >= 0)
+        break;
     }
   }
 }
 
+int64_t CFileCache::GetFillPosition(int64_t writePos)
+{
+  if (m_seekPossible <= 0)
+    return -1;
+
+  int64_t cachedEnd = m_pCache->CachedDataEndPos(m_readPos);
+  if (cachedEnd < 0 || cachedEnd == writePos)
+    return -1;
+
+  return cachedEnd;
+}
+
 void CFileCache::OnExit()
 {
   m_bStop = true;
@@ -61,6 +61,12 @@ namespace XFILE
     virtual CStdString GetContent();
 
   private:
+    /*! \brief Get the position the source should continue filling the cache at, if the
+     cache strategy holds more than one range of the file.
+     \return the new position, -1 if the source should continue at writePos.
+     */
+    int64_t GetFillPosition(int64_t writePos);
+
     CCacheStrategy *m_pCache;
     bool      m_bDeleteCache;
     int64_t    m_seekPossible;
@@ -0,0 +1,261 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "FingerprintDatabase.h"
+#include "FileSystem/File.h"
+#include "StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+using namespace std;
+
+// subfolders are stored as a single field, one path per line
+#define SUBFOLDER_SEPARATOR "\n"
+
+// escape character for the wildcards of LIKE patterns.  Not a backslash, which mysql escapes again.
+#define LIKE_ESCAPE '!'
+
+// returns a pattern matching the path and everything beneath it, with any wildcards in the path escaped
+static CStdString LikePrefix(const CStdString &path)
+{
+  CStdString pattern;
+  for (unsigned int i = 0; i < path.size(); ++i)
+  {
+    if (path[i] == '%' || path[i] == '_' || path[i] == LIKE_ESCAPE)
+      pattern += LIKE_ESCAPE;
+    pattern += path[i];
+  }
+  return pattern + "%";
+}
+
+CDirectoryFingerprint::CDirectoryFingerprint()
+{
+  m_modified = 0;
+  m_count = 0;
+}
+
+void CDirectoryFingerprint::Set(int64_t modified, int count)
+{
+  m_modified = modified;
+  m_count = count;
+}
+
+int64_t CDirectoryFingerprint::GetModificationTime(const CStdString &directory)
+{
+  struct __stat64 buffer;
+  if (XFILE::CFile::Stat(directory, &buffer) == 0)
+  {
+    int64_t time = buffer.st_mtime;
+    if (!time)
+      time = buffer.st_ctime;
+    return time;
+  }
+  return 0;
+}
+
+CFingerprintDatabase::CFingerprintDatabase()
+{
+}
+
+CFingerprintDatabase::~CFingerprintDatabase()
+{
+}
+
+bool CFingerprintDatabase::Open()
+{
+  return CDatabase::Open();
+}
+
+bool CFingerprintDatabase::CreateTables()
+{
+  try
+  {
+    CDatabase::CreateTables();
+
+    CLog::Log(LOGINFO, "create fingerprint table");
+    m_pDS->exec("CREATE TABLE fingerprint (id integer primary key, scanner text, pathhash integer, path text, modified integer, count integer, subfolders text)\n");
+
+    CLog::Log(LOGINFO, "create fingerprint index");
+    m_pDS->exec("CREATE INDEX idxFingerprint ON fingerprint(pathhash)");
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s unable to create tables", __FUNCTION__);
+    return false;
+  }
+
+  return true;
+}
+
+bool CFingerprintDatabase::GetFingerprint(const CStdString &scanner, const CStdString &path, CDirectoryFingerprint &fingerprint)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    CStdString sql = PrepareSQL("select path, modified, count from fingerprint where pathhash=%u and scanner='%s'", ComputeCRC(path), scanner.c_str());
+    m_pDS->query(sql.c_str());
+
+    // the hash ignores case, so check the path as well
+    while (!m_pDS->eof())
+    {
+      if (m_pDS->fv(0).get_asString() == path)
+      {
+        fingerprint.m_modified = m_pDS->fv(1).get_asInt64();
+        fingerprint.m_count = m_pDS->fv(2).get_asInt();
+        m_pDS->close();
+        return true;
+      }
+      m_pDS->next();
+    }
+    m_pDS->close();
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on path '%s'", __FUNCTION__, path.c_str());
+  }
+  return false;
+}
+
+bool CFingerprintDatabase::SetFingerprint(const CStdString &scanner, const CStdString &path, const CDirectoryFingerprint &fingerprint, const vector<CStdString> &subFolders)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    // forget the subfolders that have gone
+    vector<CStdString> oldFolders;
+    GetSubFolders(scanner, path, oldFolders);
+    for (vector<CStdString>::const_iterator i = oldFolders.begin(); i != oldFolders.end(); ++i)
+    {
+      if (find(subFolders.begin(), subFolders.end(), *i) == subFolders.end())
+        RemoveFingerprints(scanner, *i);
+    }
+
+    CStdString folders;
+    for (vector<CStdString>::const_iterator i = subFolders.begin(); i != subFolders.end(); ++i)
+    {
+      if (!folders.IsEmpty())
+        folders += SUBFOLDER_SEPARATOR;
+      folders += *i;
+    }
+
+    unsigned int hash = ComputeCRC(path);
+    CStdString sql = PrepareSQL("delete from fingerprint where pathhash=%u and scanner='%s' and path='%s'", hash, scanner.c_str(), path.c_str());
+    m_pDS->exec(sql.c_str());
+    sql = PrepareSQL("insert into fingerprint (id, scanner, pathhash, path, modified, count, subfolders) values(NULL, '%s', %u, '%s', %I64d, %i, '%s')",
+                     scanner.c_str(), hash, path.c_str(), fingerprint.m_modified, fingerprint.m_count, folders.c_str());
+    m_pDS->exec(sql.c_str());
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on path '%s'", __FUNCTION__, path.c_str());
+  }
+  return false;
+}
+
+bool CFingerprintDatabase::GetSubFolders(const CStdString &scanner, const CStdString &path, vector<CStdString> &subFolders)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    CStdString sql = PrepareSQL("select path, subfolders from fingerprint where pathhash=%u and scanner='%s'", ComputeCRC(path), scanner.c_str());
+    m_pDS->query(sql.c_str());
+
+    while (!m_pDS->eof())
+    {
+      if (m_pDS->fv(0).get_asString() == path)
+      {
+        CStdStringArray folders;
+        StringUtils::SplitString(m_pDS->fv(1).get_asString(), SUBFOLDER_SEPARATOR, folders);
+        for (unsigned int i = 0; i < folders.size(); ++i)
+        {
+          if (!folders[i].IsEmpty())
+            subFolders.push_back(folders[i]);
+        }
+        break;
+      }
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on path '%s'", __FUNCTION__, path.c_str());
+  }
+  return false;
+}
+
+int CFingerprintDatabase::RemoveFingerprints(const CStdString &scanner, const CStdString &path)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return 0;
+    if (NULL == m_pDS.get()) return 0;
+
+    CStdString where = PrepareSQL("where scanner='%s' and path like '%s' escape '%c'", scanner.c_str(), LikePrefix(path).c_str(), LIKE_ESCAPE);
+    CStdString sql = "select count(*) from fingerprint " + where;
+    m_pDS->query(sql.c_str());
+    int count = m_pDS->eof() ? 0 : m_pDS->fv(0).get_asInt();
+    m_pDS->close();
+
+    if (count)
+    {
+      sql = "delete from fingerprint " + where;
+      m_pDS->exec(sql.c_str());
+    }
+    return count;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on path '%s'", __FUNCTION__, path.c_str());
+  }
+  return 0;
+}
+
+int CFingerprintDatabase::GetFileCount(const CStdString &scanner, const CStdString &path)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return -1;
+    if (NULL == m_pDS.get()) return -1;
+
+    CStdString sql = PrepareSQL("select count(*), sum(count) from fingerprint where scanner='%s' and path like '%s' escape '%c'", scanner.c_str(), LikePrefix(path).c_str(), LIKE_ESCAPE);
+    m_pDS->query(sql.c_str());
+    int count = -1;
+    if (!m_pDS->eof() && m_pDS->fv(0).get_asInt() > 0)
+      count = m_pDS->fv(1).get_asInt();
+    m_pDS->close();
+    return count;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on path '%s'", __FUNCTION__, path.c_str());
+  }
+  return -1;
+}
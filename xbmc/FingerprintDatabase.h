@@ -0,0 +1,110 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#pragma once
+
+#include "Database.h"
+
+#include <vector>
+
+/*! \brief Fingerprint of a directory as last seen by one of the library scanners
+ The modification time of a directory changes whenever an entry is added, removed or renamed,
+ so a directory whose modification time is unchanged needn't be listed again.  Files that are
+ modified in place don't change the modification time of their directory.
+ */
+class CDirectoryFingerprint
+{
+public:
+  CDirectoryFingerprint();
+
+  /*! \brief Fingerprint a directory after listing it
+   \param modified modification time of the directory, as retrieved prior to listing it
+   \param count the number of media files in the listing, as counted by the scanner
+   */
+  void Set(int64_t modified, int count);
+
+  /*! \brief Retrieve the modification time of a directory
+   \param directory the directory to stat
+   \return the modification time of the directory, 0 if unavailable.
+   */
+  static int64_t GetModificationTime(const CStdString &directory);
+
+  int64_t m_modified; ///< modification time of the directory
+  int     m_count;    ///< number of media files in the directory
+};
+
+/*! \brief Store of the directory fingerprints of the music and video scanners
+ Allows the scanners to skip listing directories that haven't changed since the last scan,
+ descending straight into their known subfolders instead.
+ \sa CDirectoryFingerprint
+ */
+class CFingerprintDatabase : public CDatabase
+{
+public:
+  CFingerprintDatabase();
+  virtual ~CFingerprintDatabase();
+  virtual bool Open();
+
+  /*! \brief Retrieve the fingerprint of a directory
+   \param scanner name of the scanner, eg "music" or "video"
+   \param path the directory
+   \param fingerprint [out] the fingerprint of the directory
+   \return true if the directory has a fingerprint, false otherwise.
+   */
+  bool GetFingerprint(const CStdString &scanner, const CStdString &path, CDirectoryFingerprint &fingerprint);
+
+  /*! \brief Store the fingerprint of a directory and its current subfolders
+   The fingerprints of subfolders that are no longer present are removed.
+   \param scanner name of the scanner
+   \param path the directory
+   \param fingerprint the fingerprint of the directory
+   \param subFolders the subfolders currently within the directory
+   \return true if the fingerprint was stored, false otherwise.
+   */
+  bool SetFingerprint(const CStdString &scanner, const CStdString &path, const CDirectoryFingerprint &fingerprint, const std::vector<CStdString> &subFolders);
+
+  /*! \brief Retrieve the subfolders of a directory that have fingerprints
+   \param scanner name of the scanner
+   \param path the directory
+   \param subFolders [out] the subfolders of the directory
+   \return true if the subfolders were retrieved, false otherwise.
+   */
+  bool GetSubFolders(const CStdString &scanner, const CStdString &path, std::vector<CStdString> &subFolders);
+
+  /*! \brief Remove the fingerprints of a directory and everything beneath it
+   \param scanner name of the scanner
+   \param path the directory
+   \return the number of fingerprints removed.
+   */
+  int RemoveFingerprints(const CStdString &scanner, const CStdString &path);
+
+  /*! \brief Retrieve the number of media files known to be within a directory and its subfolders
+   \param scanner name of the scanner
+   \param path the directory
+   \return the number of media files, -1 if unknown.
+   */
+  int GetFileCount(const CStdString &scanner, const CStdString &path);
+
+protected:
+  virtual bool CreateTables();
+  virtual int GetMinVersion() const { return 1; };
+  const char *GetDefaultDBName() const { return "Fingerprints"; };
+};
@@ -46,6 +46,7 @@
 #include "GUIInfoManager.h"
 #include "GUIDialogSelect.h"
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
 
 using namespace std;
 using namespace ADDON;
@@ -987,6 +988,11 @@ void CGUIDialogAddonSettings::Render()
       alphaFaded = true;
     }
   }
+  if (alphaFaded)
+  { // the button has already been processed this frame, so update it for its new state
+    CDirtyRegionList dirtyregions;
+    control->Process(CTimeUtils::GetFrameTime(), dirtyregions);
+  }
   CGUIDialogBoxBase::Render();
   if (alphaFaded && m_bRunning) // dialog may close during Render()
   {
@@ -112,6 +112,16 @@ void CGUIDialogMusicScan::StartScanning(const CStdString& strDirectory)
   m_musicInfoScanner.Start(strDirectory);
 }
 
+void CGUIDialogMusicScan::UpdateDirectories(const std::set<CStdString>& directories)
+{
+  m_ScanState = PREPARING;
+
+  // save settings
+  g_application.SaveMusicScanSettings();
+
+  m_musicInfoScanner.Update(directories);
+}
+
 void CGUIDialogMusicScan::StartAlbumScan(const CStdString& strDirectory)
 {
   m_ScanState = PREPARING;
@@ -34,6 +34,7 @@ public:
   virtual void FrameMove();
 
   void StartScanning(const CStdString& strDirectory);
+  void UpdateDirectories(const std::set<CStdString>& directories); ///< update the given folders in the background, without showing the dialog
   void StartAlbumScan(const CStdString& strDirectory);
   void StartArtistScan(const CStdString& strDirectory);
   bool IsScanning();
@@ -73,6 +73,13 @@ bool CGUIDialogTeletext::OnMessage(CGUIMessage& message)
   return CGUIDialog::OnMessage(message);
 }
 
+void CGUIDialogTeletext::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // the teletext page is rendered directly rather than via our controls
+  g_windowManager.MarkDirty();
+  CGUIDialog::Process(currentTime, dirtyregions);
+}
+
 void CGUIDialogTeletext::Render()
 {
   // Do not render if we have no texture
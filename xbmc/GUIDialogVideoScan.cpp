@@ -127,6 +127,13 @@ void CGUIDialogVideoScan::StartScanning(const CStdString& strDirectory, bool sca
   m_videoInfoScanner.Start(strDirectory,scanAll);
 }
 
+void CGUIDialogVideoScan::UpdateDirectories(const std::set<CStdString>& directories)
+{
+  m_ScanState = PREPARING;
+
+  m_videoInfoScanner.Update(directories);
+}
+
 void CGUIDialogVideoScan::StopScanning()
 {
   if (m_videoInfoScanner.IsScanning())
@@ -34,6 +34,7 @@ public:
   virtual void FrameMove();
 
   void StartScanning(const CStdString& strDirectory, bool scanAll = false);
+  void UpdateDirectories(const std::set<CStdString>& directories); ///< update the given folders in the background, without showing the dialog
   bool IsScanning();
   void StopScanning();
 
@@ -30,13 +30,16 @@
 #include "GraphicContext.h"
 #include "utils/log.h"
 #include "TextureCache.h"
+#include "AdvancedSettings.h"
 
 using namespace std;
 
 
-CImageLoader::CImageLoader(const CStdString &path)
+CImageLoader::CImageLoader(const CStdString &path, unsigned int maxWidth, unsigned int maxHeight)
 {
   m_path = path;
+  m_maxWidth = maxWidth;
+  m_maxHeight = maxHeight;
   m_texture = NULL;
 }
 
@@ -57,9 +60,17 @@ bool CImageLoader::DoWork()
     if (loadPath.IsEmpty())
       return false;
 
+    // decode at the size we're displayed at, but no larger than the screen
+    unsigned int width = min(g_graphicsContext.GetWidth(), 2048);
+    unsigned int height = min(g_graphicsContext.GetHeight(), 1080);
+    if (m_maxWidth)
+      width = min(width, m_maxWidth);
+    if (m_maxHeight)
+      height = min(height, m_maxHeight);
+
     m_texture = new CTexture();
     DWORD start = CTimeUtils::GetTimeMS();
-    if (!m_texture->LoadFromFile(loadPath, min(g_graphicsContext.GetWidth(), 2048), min(g_graphicsContext.GetHeight(), 1080), g_guiSettings.GetBool("pictures.useexifrotation")))
+    if (!m_texture->LoadFromFile(loadPath, width, height, g_guiSettings.GetBool("pictures.useexifrotation")))
     {
       delete m_texture;
       m_texture = NULL;
@@ -71,11 +82,13 @@ bool CImageLoader::DoWork()
   return true;
 }
 
-CGUILargeTextureManager::CLargeTexture::CLargeTexture(const CStdString &path)
+CGUILargeTextureManager::CLargeTexture::CLargeTexture(const CStdString &path, unsigned int width, unsigned int height)
 {
   m_path = path;
+  m_width = width;
+  m_height = height;
   m_refCount = 1;
-  m_timeToDelete = 0;
+  m_lastUsed = 0;
 }
 
 CGUILargeTextureManager::CLargeTexture::~CLargeTexture()
@@ -98,20 +111,22 @@ bool CGUILargeTextureManager::CLargeTexture::DecrRef(bool deleteImmediately)
     if (deleteImmediately)
       delete this;
     else
-      m_timeToDelete = CTimeUtils::GetFrameTime() + TIME_TO_DELETE;
+      m_lastUsed = CTimeUtils::GetFrameTime();
     return true;
   }
   return false;
 }
 
-bool CGUILargeTextureManager::CLargeTexture::DeleteIfRequired(bool deleteImmediately)
+unsigned int CGUILargeTextureManager::CLargeTexture::GetMemoryUsage() const
 {
-  if (m_refCount == 0 && (deleteImmediately || m_timeToDelete < CTimeUtils::GetFrameTime()))
+  unsigned int size = 0;
+  for (unsigned int i = 0; i < m_texture.m_textures.size(); i++)
   {
-    delete this;
-    return true;
+    const CBaseTexture *texture = m_texture.m_textures[i];
+    if (texture)
+      size += texture->GetPitch() * texture->GetRows();
   }
-  return false;
+  return size;
 }
 
 void CGUILargeTextureManager::CLargeTexture::SetTexture(CBaseTexture* texture)
@@ -132,28 +147,43 @@ CGUILargeTextureManager::~CGUILargeTextureManager()
 void CGUILargeTextureManager::CleanupUnusedImages(bool immediately)
 {
   CSingleLock lock(m_listSection);
-  // check for items to remove from allocated list, and remove
-  listIterator it = m_allocated.begin();
-  while (it != m_allocated.end())
+  TrimCache(immediately);
+}
+
+void CGUILargeTextureManager::TrimCache(bool immediately)
+{
+  unsigned int size = 0;
+  for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
+    size += (*it)->GetMemoryUsage();
+
+  // unload the least recently used images until we fit (images in use can't be unloaded)
+  while (immediately || size > g_advancedSettings.m_guiLargeTextureCacheSize)
   {
-    CLargeTexture *image = *it;
-    if (image->DeleteIfRequired(immediately))
-      it = m_allocated.erase(it);
-    else
-      ++it;
+    listIterator oldest = m_allocated.end();
+    for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
+    {
+      if ((*it)->IsUnused() && (oldest == m_allocated.end() || (*it)->GetLastUsed() < (*oldest)->GetLastUsed()))
+        oldest = it;
+    }
+    if (oldest == m_allocated.end())
+      break; // nothing left to unload
+
+    CLargeTexture *image = *oldest;
+    size -= image->GetMemoryUsage();
+    m_allocated.erase(oldest);
+    delete image;
   }
 }
 
 // if available, increment reference count, and return the image.
 // else, add to the queue list if appropriate.
-bool CGUILargeTextureManager::GetImage(const CStdString &path, CTextureArray &texture, bool firstRequest)
+bool CGUILargeTextureManager::GetImage(const CStdString &path, unsigned int width, unsigned int height, CTextureArray &texture, bool firstRequest)
 {
-  // note: max size to load images: 2048x1024? (8MB)
   CSingleLock lock(m_listSection);
   for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
   {
     CLargeTexture *image = *it;
-    if (image->GetPath() == path)
+    if (image->Matches(path, width, height))
     {
       if (firstRequest)
         image->AddRef();
@@ -163,21 +193,49 @@ bool CGUILargeTextureManager::GetImage(const CStdString &path, CTextureArray &te
   }
 
   if (firstRequest)
-    QueueImage(path);
+    QueueImage(path, width, height);
+  else
+  { // still waiting - move it to the front of the queue, as it's still wanted
+    for (listIterator it = m_pending.begin(); it != m_pending.end(); ++it)
+    {
+      CLargeTexture *image = *it;
+      if (image->Matches(path, width, height))
+      {
+        m_pending.erase(it);
+        m_pending.push_back(image);
+        break;
+      }
+    }
+  }
 
   return true;
 }
 
-void CGUILargeTextureManager::ReleaseImage(const CStdString &path, bool immediately)
+void CGUILargeTextureManager::ReleaseImage(const CStdString &path, unsigned int width, unsigned int height, bool immediately)
 {
   CSingleLock lock(m_listSection);
   for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
   {
     CLargeTexture *image = *it;
-    if (image->GetPath() == path)
+    if (image->Matches(path, width, height))
     {
-      if (image->DecrRef(immediately) && immediately)
-        m_allocated.erase(it);
+      if (image->DecrRef(immediately))
+      {
+        if (immediately)
+          m_allocated.erase(it);
+        else
+          TrimCache(false);
+      }
+      return;
+    }
+  }
+  for (listIterator it = m_pending.begin(); it != m_pending.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->Matches(path, width, height))
+    {
+      if (image->DecrRef(true))
+        m_pending.erase(it);
       return;
     }
   }
@@ -185,34 +243,60 @@ void CGUILargeTextureManager::ReleaseImage(const CStdString &path, bool immediat
   {
     unsigned int id = it->first;
     CLargeTexture *image = it->second;
-    if (image->GetPath() == path && image->DecrRef(true))
+    if (image->Matches(path, width, height))
     {
-      // cancel this job
-      CJobManager::GetInstance().CancelJob(id);
-      m_queued.erase(it);
+      if (image->DecrRef(true))
+      {
+        // cancel this job
+        CJobManager::GetInstance().CancelJob(id);
+        m_queued.erase(it);
+        LoadNextImages();
+      }
       return;
     }
   }
 }
 
 // queue the image, and start the background loader if necessary
-void CGUILargeTextureManager::QueueImage(const CStdString &path)
+void CGUILargeTextureManager::QueueImage(const CStdString &path, unsigned int width, unsigned int height)
 {
   CSingleLock lock(m_listSection);
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
     CLargeTexture *image = it->second;
-    if (image->GetPath() == path)
+    if (image->Matches(path, width, height))
+    {
+      image->AddRef();
+      return; // already loading
+    }
+  }
+  for (listIterator it = m_pending.begin(); it != m_pending.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->Matches(path, width, height))
     {
       image->AddRef();
+      m_pending.erase(it);
+      m_pending.push_back(image);
       return; // already queued
     }
   }
 
   // queue the item
-  CLargeTexture *image = new CLargeTexture(path);
-  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path), this, CJob::PRIORITY_NORMAL);
-  m_queued.push_back(make_pair(jobID, image));
+  m_pending.push_back(new CLargeTexture(path, width, height));
+  LoadNextImages();
+}
+
+void CGUILargeTextureManager::LoadNextImages()
+{
+  // load the most recently requested images first, as they're most likely to be on screen
+  while (m_queued.size() < MAX_LOADING && !m_pending.empty())
+  {
+    CLargeTexture *image = m_pending.back();
+    m_pending.pop_back();
+    unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(image->GetPath(), image->GetWidth(), image->GetHeight()), this, CJob::PRIORITY_NORMAL);
+    m_queued.push_back(make_pair(jobID, image));
+  }
 }
 
 void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJob *job)
@@ -229,10 +313,8 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
       m_queued.erase(it);
       m_allocated.push_back(image);
+      LoadNextImages();
       return;
     }
   }
 }
-
-
-
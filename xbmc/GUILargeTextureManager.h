@@ -36,7 +36,7 @@
 class CImageLoader : public CJob
 {
 public:
-  CImageLoader(const CStdString &path);
+  CImageLoader(const CStdString &path, unsigned int maxWidth = 0, unsigned int maxHeight = 0);
   virtual ~CImageLoader();
 
   /*!
@@ -45,6 +45,8 @@ public:
   virtual bool DoWork();
 
   CStdString    m_path; ///< path of image to load
+  unsigned int  m_maxWidth; ///< maximal width (in pixels) to decode the image at, 0 for the screen width
+  unsigned int  m_maxHeight; ///< maximal height (in pixels) to decode the image at, 0 for the screen height
   CBaseTexture *m_texture; ///< Texture object to load the image into \sa CBaseTexture.
 };
 
@@ -55,6 +57,12 @@ public:
  Used to load textures for the user interface asynchronously, allowing fluid framerates
  while background loading textures.
 
+ Images are decoded at the size they are displayed at, and are kept once no longer in use
+ until the decoded images exceed the <gui><largetexturecachesize> advanced setting, at which
+ point the least recently used are unloaded.  Only a couple of images are decoded at a time,
+ the most recently requested first, so the images currently on screen (the focused item
+ being processed last) are loaded ahead of those that have scrolled past.
+
  \sa IJobCallback, CGUITexture
  */
 class CGUILargeTextureManager : public IJobCallback
@@ -77,38 +85,43 @@ public:
 
    Loaded textures are reference counted, hence this call may immediately return with the texture
    object filled if the texture has been previously loaded, else will return with an empty texture
-   object if it is being loaded.
+   object if it is being loaded.  Repeated requests for an image that is still waiting to be loaded
+   move it to the front of the queue.
 
    \param path path of the image to load.
+   \param width maximal width (in pixels) the image is displayed at, 0 for the screen width.
+   \param height maximal height (in pixels) the image is displayed at, 0 for the screen height.
    \param texture texture object to hold the resulting texture
-   \param orientation orientation of resulting texture
    \param firstRequest true if this is the first time we are requesting this texture
    \return true if the image exists, else false.
    \sa CGUITextureArray and CGUITexture
    */
-  bool GetImage(const CStdString &path, CTextureArray &texture, bool firstRequest);
+  bool GetImage(const CStdString &path, unsigned int width, unsigned int height, CTextureArray &texture, bool firstRequest);
 
   /*!
    \brief Request a texture to be unloaded.
 
    When textures are finished with, this function should be called.  This decrements the texture's
-   reference count, and schedules it to be unloaded once the reference count reaches zero.  If the
-   texture is still queued for loading, or is in the process of loading, the image load is cancelled.
+   reference count, and makes it a candidate for unloading once the reference count reaches zero.
+   If the texture is still queued for loading, or is in the process of loading, the image load is cancelled.
 
    \param path path of the image to release.
+   \param width width the image was requested at \sa GetImage()
+   \param height height the image was requested at \sa GetImage()
    \param immediately if set true the image is immediately unloaded once its reference count reaches zero
-                      rather than being unloaded after a delay.
+                      rather than being kept in the cache of unused images.
    */
-  void ReleaseImage(const CStdString &path, bool immediately = false);
+  void ReleaseImage(const CStdString &path, unsigned int width, unsigned int height, bool immediately = false);
 
   /*!
    \brief Cleanup images that are no longer in use.
 
    Loaded textures are reference counted, and upon reaching reference count 0 through ReleaseImage()
-   they are flagged as unused with the current time.  After a delay they may be unloaded, hence
-   CleanupUnusedImages() should be called periodically to ensure this occurs.
+   they are flagged as unused with the current time.  Once the loaded textures exceed the cache size
+   the least recently used of them are unloaded, hence CleanupUnusedImages() should be called
+   periodically to ensure this occurs.
 
-   \param immediately set to true to cleanup images regardless of whether the delay has passed
+   \param immediately set to true to unload all unused images regardless of the cache size
    */
   void CleanupUnusedImages(bool immediately = false);
 
@@ -116,29 +129,50 @@ private:
   class CLargeTexture
   {
   public:
-    CLargeTexture(const CStdString &path);
+    CLargeTexture(const CStdString &path, unsigned int width, unsigned int height);
     virtual ~CLargeTexture();
 
     void AddRef();
     bool DecrRef(bool deleteImmediately);
-    bool DeleteIfRequired(bool deleteImmediately = false);
     void SetTexture(CBaseTexture* texture);
 
+    bool Matches(const CStdString &path, unsigned int width, unsigned int height) const
+    {
+      return m_width == width && m_height == height && m_path == path;
+    };
+    bool IsUnused() const { return m_refCount == 0; };
+    unsigned int GetLastUsed() const { return m_lastUsed; };
+    unsigned int GetMemoryUsage() const;
+
     const CStdString &GetPath() const { return m_path; };
+    unsigned int GetWidth() const { return m_width; };
+    unsigned int GetHeight() const { return m_height; };
     const CTextureArray &GetTexture() const { return m_texture; };
 
   private:
-    static const unsigned int TIME_TO_DELETE = 2000;
-
     unsigned int m_refCount;
     CStdString m_path;
+    unsigned int m_width;    ///< maximal width requested
+    unsigned int m_height;   ///< maximal height requested
     CTextureArray m_texture;
-    unsigned int m_timeToDelete;
+    unsigned int m_lastUsed; ///< time at which the reference count reached zero
   };
 
-  void QueueImage(const CStdString &path);
+  void QueueImage(const CStdString &path, unsigned int width, unsigned int height);
+
+  /*! \brief Start loading the most recently requested images, keeping at most MAX_LOADING images in progress.
+   */
+  void LoadNextImages();
+
+  /*! \brief Unload the least recently used unused images until we're within the cache size.
+   \param immediately set to true to unload all unused images.
+   */
+  void TrimCache(bool immediately);
+
+  static const unsigned int MAX_LOADING = 2;
 
-  std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
+  std::vector<CLargeTexture *> m_pending;  ///< images waiting to be loaded, most recently requested last
+  std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued; ///< images being loaded, with the id of their job
   std::vector<CLargeTexture *> m_allocated;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
   typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
@@ -128,3 +128,6 @@
 
 // Sent from filesystem if a path is known to have changed
 #define GUI_MSG_UPDATE_PATH           GUI_MSG_USER + 33
+
+// Player couldn't open the item it accepted after GUI_MSG_QUEUE_NEXT_ITEM (PAPlayer)
+#define GUI_MSG_QUEUE_NEXT_ITEM_FAILED GUI_MSG_USER + 34
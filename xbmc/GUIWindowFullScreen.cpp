@@ -815,6 +815,13 @@ void CGUIWindowFullScreen::FrameMove()
   }
 }
 
+void CGUIWindowFullScreen::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // the video and its overlays are rendered directly, every frame
+  g_windowManager.MarkDirty();
+  CGUIWindow::Process(currentTime, dirtyregions);
+}
+
 void CGUIWindowFullScreen::Render()
 {
   if (g_application.m_pPlayer)
@@ -64,9 +64,9 @@ void CGUIWindowPointer::OnWindowLoaded()
   m_pointer = 0;
 }
 
-void CGUIWindowPointer::Render()
+void CGUIWindowPointer::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
 {
   SetPointer(g_Mouse.GetState());
-  CGUIWindow::Render();
+  CGUIWindow::Process(currentTime, dirtyregions);
 }
 
@@ -29,7 +29,7 @@ class CGUIWindowPointer :
 public:
   CGUIWindowPointer(void);
   virtual ~CGUIWindowPointer(void);
-  virtual void Render();
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
 protected:
   void SetPointer(int pointer);
   virtual void OnWindowLoaded();
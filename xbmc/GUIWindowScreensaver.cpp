@@ -40,6 +40,13 @@ CGUIWindowScreensaver::~CGUIWindowScreensaver(void)
 {
 }
 
+void CGUIWindowScreensaver::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // the screensaver renders itself every frame
+  g_windowManager.MarkDirty();
+  CGUIWindow::Process(currentTime, dirtyregions);
+}
+
 void CGUIWindowScreensaver::Render()
 {
   CSingleLock lock (m_critSection);
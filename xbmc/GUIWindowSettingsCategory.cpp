@@ -101,6 +101,7 @@
 #include "LangInfo.h"
 #include "StringUtils.h"
 #include "WindowingFactory.h"
+#include "utils/TimeUtils.h"
 
 #if defined(HAVE_LIBCRYSTALHD)
 #include "cores/dvdplayer/DVDCodecs/Video/CrystalHD.h"
@@ -1982,6 +1983,14 @@ void CGUIWindowSettingsCategory::FrameMove()
   CGUIWindow::FrameMove();
 }
 
+void CGUIWindowSettingsCategory::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // our error message is drawn directly, outside of our controls
+  if (m_strErrorMessage.size())
+    g_windowManager.MarkDirty();
+  CGUIWindow::Process(currentTime, dirtyregions);
+}
+
 void CGUIWindowSettingsCategory::Render()
 {
   // update alpha status of current button
@@ -2002,6 +2011,11 @@ void CGUIWindowSettingsCategory::Render()
       bAlphaFaded = true;
     }
   }
+  if (bAlphaFaded)
+  { // the button has already been processed this frame, so update it for its new state
+    CDirtyRegionList dirtyregions;
+    control->Process(CTimeUtils::GetFrameTime(), dirtyregions);
+  }
   CGUIWindow::Render();
   if (bAlphaFaded)
   {
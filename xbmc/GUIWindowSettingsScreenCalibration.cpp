@@ -375,6 +375,13 @@ void CGUIWindowSettingsScreenCalibration::FrameMove()
   CGUIWindow::FrameMove();
 }
 
+void CGUIWindowSettingsScreenCalibration::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // the calibration markers are drawn directly rather than via our controls
+  g_windowManager.MarkDirty();
+  CGUIWindow::Process(currentTime, dirtyregions);
+}
+
 void CGUIWindowSettingsScreenCalibration::Render()
 {
   SET_CONTROL_HIDDEN(CONTROL_TOP_LEFT);
@@ -268,6 +268,13 @@ void CGUIWindowSlideShow::StartSlideShow(bool screensaver)
   m_bScreensaver = screensaver;
 }
 
+void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // the slides are rendered directly, and transition or zoom from frame to frame
+  g_windowManager.MarkDirty();
+  CGUIWindow::Process(currentTime, dirtyregions);
+}
+
 void CGUIWindowSlideShow::Render()
 {
   // reset the screensaver if we're in a slideshow
@@ -77,6 +77,13 @@ bool CGUIWindowTestPattern::OnMessage(CGUIMessage& message)
   return CGUIWindow::OnMessage(message);
 }
 
+void CGUIWindowTestPattern::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // the pattern is drawn directly rather than via our controls
+  g_windowManager.MarkDirty();
+  CGUIWindow::Process(currentTime, dirtyregions);
+}
+
 void CGUIWindowTestPattern::Render()
 {
   BeginRender();
@@ -36,6 +36,7 @@ public:
   virtual ~CGUIWindowTestPattern(void);
   virtual bool OnMessage(CGUIMessage& message);
   virtual bool OnAction(const CAction &action);
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
 
 protected:
@@ -1775,11 +1775,16 @@ int CMusicDatabase::SetArtistInfo(int idArtist, const CArtist& artist)
                   artist.fanart.m_xml.c_str());
     m_pDS->exec(strSQL.c_str());
     int idArtistInfo = (int)m_pDS->lastinsertid();
+    vector< vector<string> > rows;
     for (unsigned int i=0;i<artist.discography.size();++i)
     {
-      strSQL=PrepareSQL("insert into discography (idArtist,strAlbum,strYear) values (%i,'%s','%s')",idArtist,artist.discography[i].first.c_str(),artist.discography[i].second.c_str());
-      m_pDS->exec(strSQL.c_str());
+      vector<string> row;
+      row.push_back(PrepareSQL("%i", idArtist));
+      row.push_back(artist.discography[i].first);
+      row.push_back(artist.discography[i].second);
+      rows.push_back(row);
     }
+    InsertRows("discography", "idArtist,strAlbum,strYear", rows);
 
     return idArtistInfo;
   }
@@ -1803,16 +1808,18 @@ bool CMusicDatabase::SetAlbumInfoSongs(int idAlbumInfo, const VECSONGS& songs)
     strSQL=PrepareSQL("delete from albuminfosong where idAlbumInfo=%i", idAlbumInfo);
     m_pDS->exec(strSQL.c_str());
 
+    vector< vector<string> > rows;
     for (int i = 0; i < (int)songs.size(); i++)
     {
-      CSong song = songs[i];
-      strSQL=PrepareSQL("insert into albuminfosong (idAlbumInfoSong,idAlbumInfo,iTrack,strTitle,iDuration) values(NULL,%i,%i,'%s',%i)",
-                    idAlbumInfo,
-                    song.iTrack,
-                    song.strTitle.c_str(),
-                    song.iDuration);
-      m_pDS->exec(strSQL.c_str());
+      const CSong &song = songs[i];
+      vector<string> row;
+      row.push_back(PrepareSQL("%i", idAlbumInfo));
+      row.push_back(PrepareSQL("%i", song.iTrack));
+      row.push_back(song.strTitle);
+      row.push_back(PrepareSQL("%i", song.iDuration));
+      rows.push_back(row);
     }
+    InsertRows("albuminfosong", "idAlbumInfo,iTrack,strTitle,iDuration", rows);
     return true;
   }
   catch (...)
@@ -3903,12 +3910,19 @@ bool CMusicDatabase::CommitTransaction()
 {
   if (CDatabase::CommitTransaction())
   { // number of items in the db has likely changed, so reset the infomanager cache
-    g_infoManager.SetLibraryBool(LIBRARY_HAS_MUSIC, GetSongsCount("") > 0);
+    // (once the batch is done, if we're in one)
+    if (!InBatch())
+      g_infoManager.SetLibraryBool(LIBRARY_HAS_MUSIC, GetSongsCount("") > 0);
     return true;
   }
   return false;
 }
 
+void CMusicDatabase::OnBatchEnd()
+{
+  g_infoManager.SetLibraryBool(LIBRARY_HAS_MUSIC, GetSongsCount("") > 0);
+}
+
 bool CMusicDatabase::SetScraperForPath(const CStdString& strPath, const ADDON::ScraperPtr& scraper)
 {
   try
@@ -46,6 +46,8 @@
 #include "LocalizeStrings.h"
 #include "StringUtils.h"
 #include "utils/TimeUtils.h"
+#include "utils/JobManager.h"
+#include "utils/SingleLock.h"
 #include "utils/log.h"
 
 #include <algorithm>
@@ -55,6 +57,8 @@ using namespace MUSIC_INFO;
 using namespace XFILE;
 using namespace MUSIC_GRABBER;
 
+#define FINGERPRINT_SCANNER "music"
+
 CMusicInfoScanner::CMusicInfoScanner()
 {
   m_bRunning = false;
@@ -62,6 +66,10 @@ CMusicInfoScanner::CMusicInfoScanner()
   m_bCanInterrupt = false;
   m_currentItem=0;
   m_itemCount=0;
+  m_quickRescan=false;
+  m_foldersListed=0;
+  m_foldersSkipped=0;
+  m_foldersRemoved=0;
 }
 
 CMusicInfoScanner::~CMusicInfoScanner()
@@ -94,11 +102,28 @@ void CMusicInfoScanner::Process()
       // Reset progress vars
       m_currentItem=0;
       m_itemCount=-1;
+      m_foldersListed=0;
+      m_foldersSkipped=0;
+      m_foldersRemoved=0;
+
+      m_fingerprints.Open();
+
+      // the fingerprints know the number of files to expect, so only count them if we have none
+      if (m_pObserver && m_quickRescan)
+      {
+        int count = 0;
+        for (set<CStdString>::iterator it = m_pathsToScan.begin(); it != m_pathsToScan.end() && count >= 0; ++it)
+        {
+          int pathCount = m_fingerprints.GetFileCount(FINGERPRINT_SCANNER, *it);
+          count = pathCount < 0 ? -1 : count + pathCount;
+        }
+        m_itemCount = count;
+      }
 
       // Create the thread to count all files to be scanned
       SetPriority( GetMinPriority() );
       CThread fileCountReader(this);
-      if (m_pObserver)
+      if (m_pObserver && m_itemCount < 0)
         fileCountReader.Create();
 
       // Database operations should not be canceled
@@ -107,6 +132,10 @@ void CMusicInfoScanner::Process()
       m_bCanInterrupt = false;
       m_needsCleanup = false;
 
+      // write the songs of several folders per transaction, and only check
+      // the library for songs once all folders are written
+      m_musicDatabase.BeginBatch();
+
       bool commit = false;
       bool cancelled = false;
       while (!cancelled && m_pathsToScan.size())
@@ -122,6 +151,7 @@ void CMusicInfoScanner::Process()
           cancelled = true;
         commit = !cancelled;
       }
+      m_musicDatabase.EndBatch();
 
       if (commit)
       {
@@ -148,8 +178,10 @@ void CMusicInfoScanner::Process()
       CUtil::ThumbCacheClear();
       g_directoryCache.ClearMusicThumbCache();
 
+      m_fingerprints.Close();
       m_musicDatabase.Close();
-      CLog::Log(LOGDEBUG, "%s - Finished scan", __FUNCTION__);
+      CLog::Log(LOGDEBUG, "%s - Finished scan: %u folders listed, %u skipped as unchanged, %u fingerprints removed",
+                __FUNCTION__, m_foldersListed, m_foldersSkipped, m_foldersRemoved);
 
       tick = CTimeUtils::GetTimeMS() - tick;
       CLog::Log(LOGNOTICE, "My Music: Scanning for music info using worker thread, operation took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
@@ -209,20 +241,32 @@ void CMusicInfoScanner::Process()
 
 void CMusicInfoScanner::Start(const CStdString& strDirectory)
 {
-  m_pathsToScan.clear();
-  m_albumsScanned.clear();
-  m_artistsScanned.clear();
-
+  set<CStdString> paths;
   if (strDirectory.IsEmpty())
   { // scan all paths in the database.  We do this by scanning all paths in the db, and crossing them off the list as
     // we go.
     m_musicDatabase.Open();
-    m_musicDatabase.GetPaths(m_pathsToScan);
+    m_musicDatabase.GetPaths(paths);
     m_musicDatabase.Close();
   }
   else
-    m_pathsToScan.insert(strDirectory);
+    paths.insert(strDirectory);
+  Scan(paths, g_advancedSettings.m_bMusicLibraryQuickRescan);
+}
+
+void CMusicInfoScanner::Update(const set<CStdString>& directories)
+{
+  // files changed in place (eg retagged) leave the folder's modification time alone
+  Scan(directories, false);
+}
+
+void CMusicInfoScanner::Scan(const set<CStdString>& directories, bool quickRescan)
+{
+  m_pathsToScan = directories;
+  m_albumsScanned.clear();
+  m_artistsScanned.clear();
   m_pathsToCount = m_pathsToScan;
+  m_quickRescan = quickRescan;
   m_scanType = 0;
   StopThread();
   Create();
@@ -349,7 +393,37 @@ bool CMusicInfoScanner::DoScan(const CStdString& strDirectory)
   if (CUtil::ExcludeFileOrFolder(strDirectory, regexps))
     return true;
 
+  // retrieve the modification time prior to listing the folder, so that changes made while
+  // we're scanning it show up next time
+  int64_t modified = CDirectoryFingerprint::GetModificationTime(strDirectory);
+  if (!modified)
+    m_foldersRemoved += m_fingerprints.RemoveFingerprints(FINGERPRINT_SCANNER, strDirectory);
+
+  CDirectoryFingerprint fingerprint;
+  if (m_quickRescan && modified && m_fingerprints.GetFingerprint(FINGERPRINT_SCANNER, strDirectory, fingerprint) && fingerprint.m_modified == modified)
+  { // no files were added, removed or renamed - no need to list the folder, just check its subfolders
+    CLog::Log(LOGDEBUG, "%s Skipping dir '%s' due to unchanged fingerprint", __FUNCTION__, strDirectory.c_str());
+    m_foldersSkipped++;
+    m_currentItem += fingerprint.m_count;
+    if (m_pObserver)
+    {
+      if (m_itemCount>0)
+        m_pObserver->OnSetProgress(m_currentItem, m_itemCount);
+      m_pObserver->OnDirectoryScanned(strDirectory);
+    }
+
+    vector<CStdString> subFolders;
+    m_fingerprints.GetSubFolders(FINGERPRINT_SCANNER, strDirectory, subFolders);
+    for (vector<CStdString>::const_iterator i = subFolders.begin(); i != subFolders.end() && !m_bStop; ++i)
+    {
+      if (!DoScan(*i))
+        m_bStop = true;
+    }
+    return !m_bStop;
+  }
+
   // load subfolder
+  m_foldersListed++;
   CFileItemList items;
   CDirectory::GetDirectory(strDirectory, items, g_settings.m_musicExtensions + "|.jpg|.tbn|.lrc|.cdg");
 
@@ -418,9 +492,94 @@ bool CMusicInfoScanner::DoScan(const CStdString& strDirectory)
     }
   }
 
+  // the fingerprint is only stored once all subfolders are scanned, as a quick rescan won't list the folder again
+  if (!m_bStop && modified)
+    SetFingerprint(strDirectory, modified, items);
+
   return !m_bStop;
 }
 
+void CMusicInfoScanner::SetFingerprint(const CStdString& strDirectory, int64_t modified, const CFileItemList& items)
+{
+  vector<CStdString> subFolders;
+  for (int i = 0; i < items.Size(); ++i)
+  {
+    CFileItemPtr pItem = items[i];
+    if (pItem->m_bIsFolder && !pItem->IsParentFolder() && !pItem->IsPlayList())
+      subFolders.push_back(pItem->m_strPath);
+  }
+
+  CDirectoryFingerprint fingerprint;
+  fingerprint.Set(modified, CountFiles(items, false));
+  m_fingerprints.SetFingerprint(FINGERPRINT_SCANNER, strDirectory, fingerprint, subFolders);
+}
+
+// dont try reading id3tags for folders, playlists or shoutcast streams
+static bool IsSongItem(const CFileItemPtr &item)
+{
+  return !item->m_bIsFolder && !item->IsPlayList() && !item->IsPicture() && !item->IsLyrics();
+}
+
+CMusicInfoScanner::CTagLoaderJob::CTagLoaderJob(const CFileItemPtr &item)
+{
+  m_item = item;
+}
+
+bool CMusicInfoScanner::CTagLoaderJob::DoWork()
+{
+  auto_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(m_item->m_strPath));
+  if (NULL == pLoader.get())
+    return false;
+  return pLoader->Load(m_item->m_strPath, *m_item->GetMusicInfoTag());
+}
+
+void CMusicInfoScanner::QueueTagJobs(CFileItemList& items, map<int, unsigned int> &jobs, int &next, int current)
+{
+  // read at most <bginfoloadermaxthreads> tags ahead of the item being processed
+  for (; next < items.Size() && next <= current + g_advancedSettings.m_bgInfoLoaderMaxThreads; ++next)
+  {
+    CFileItemPtr item = items[next];
+    if (!IsSongItem(item) || (item->HasMusicInfoTag() && item->GetMusicInfoTag()->Loaded()))
+      continue;
+    if (CUtil::ExcludeFileOrFolder(item->m_strPath, g_advancedSettings.m_audioExcludeFromScanRegExps))
+      continue;
+    jobs[next] = CJobManager::GetInstance().AddJob(new CTagLoaderJob(item), this, CJob::PRIORITY_LOW);
+  }
+}
+
+bool CMusicInfoScanner::WaitForTagJob(unsigned int jobID)
+{
+  while (!m_bStop)
+  {
+    {
+      CSingleLock lock(m_tagSection);
+      set<unsigned int>::iterator it = m_tagJobsDone.find(jobID);
+      if (it != m_tagJobsDone.end())
+      {
+        m_tagJobsDone.erase(it);
+        return true;
+      }
+    }
+    m_tagEvent.WaitMSec(100);
+  }
+  return false;
+}
+
+void CMusicInfoScanner::CancelTagJobs(const map<int, unsigned int> &jobs)
+{
+  for (map<int, unsigned int>::const_iterator i = jobs.begin(); i != jobs.end(); ++i)
+    CJobManager::GetInstance().CancelJob(i->second);
+  CSingleLock lock(m_tagSection);
+  m_tagJobsDone.clear();
+}
+
+void CMusicInfoScanner::OnJobComplete(unsigned int jobID, bool success, CJob *job)
+{
+  CSingleLock lock(m_tagSection);
+  m_tagJobsDone.insert(jobID);
+  m_tagEvent.Set();
+}
+
 int CMusicInfoScanner::RetrieveMusicInfo(CFileItemList& items, const CStdString& strDirectory)
 {
   CSongMap songsMap;
@@ -433,6 +592,11 @@ int CMusicInfoScanner::RetrieveMusicInfo(CFileItemList& items, const CStdString&
 
   CStdStringArray regexps = g_advancedSettings.m_audioExcludeFromScanRegExps;
 
+  // the tags are read in parallel by tag loader jobs a few items ahead of the one we're processing,
+  // so that we're not waiting on the (network) filesystem for each file in turn
+  map<int, unsigned int> tagJobs;
+  int nextTagJob = 0;
+
   // for every file found, but skip folder
   for (int i = 0; i < items.Size(); ++i)
   {
@@ -441,14 +605,16 @@ int CMusicInfoScanner::RetrieveMusicInfo(CFileItemList& items, const CStdString&
     CUtil::GetExtension(pItem->m_strPath, strExtension);
 
     if (m_bStop)
+    {
+      CancelTagJobs(tagJobs);
       return 0;
+    }
 
     // Discard all excluded files defined by m_musicExcludeRegExps
     if (CUtil::ExcludeFileOrFolder(pItem->m_strPath, regexps))
       continue;
 
-    // dont try reading id3tags for folders, playlists or shoutcast streams
-    if (!pItem->m_bIsFolder && !pItem->IsPlayList() && !pItem->IsPicture() && !pItem->IsLyrics() )
+    if (IsSongItem(pItem))
     {
       m_currentItem++;
 //      CLog::Log(LOGDEBUG, "%s - Reading tag for: %s", __FUNCTION__, pItem->m_strPath.c_str());
@@ -456,14 +622,21 @@ int CMusicInfoScanner::RetrieveMusicInfo(CFileItemList& items, const CStdString&
       // grab info from the song
       CSong *dbSong = songsMap.Find(pItem->m_strPath);
 
-      CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-      if (!tag.Loaded() )
-      { // read the tag from a file
-        auto_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(pItem->m_strPath));
-        if (NULL != pLoader.get())
-          pLoader->Load(pItem->m_strPath, tag);
+      // wait for our tag to be read
+      QueueTagJobs(items, tagJobs, nextTagJob, i);
+      map<int, unsigned int>::iterator job = tagJobs.find(i);
+      if (job != tagJobs.end())
+      {
+        if (!WaitForTagJob(job->second))
+        {
+          CancelTagJobs(tagJobs);
+          return 0;
+        }
+        tagJobs.erase(job);
       }
 
+      CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
+
       // if we have the itemcount, notify our
       // observer with the progress we made
       if (m_pObserver && m_itemCount>0)
@@ -531,6 +704,12 @@ int CMusicInfoScanner::RetrieveMusicInfo(CFileItemList& items, const CStdString&
   }
   m_musicDatabase.CommitTransaction();
 
+  // commit the songs of several folders at once, unless info is looked up online next
+  if (g_guiSettings.GetBool("musiclibrary.downloadinfo"))
+    m_musicDatabase.FlushBatch();
+  else
+    m_musicDatabase.BatchItemDone(songsToAdd.size());
+
   bool bCanceled;
   for (set<CStdString>::iterator i = artistsToScan.begin(); i != artistsToScan.end(); ++i)
   {
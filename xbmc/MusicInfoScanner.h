@@ -20,8 +20,15 @@
  *
  */
 #include "utils/Thread.h"
+#include "utils/Job.h"
+#include "utils/CriticalSection.h"
+#include "utils/Event.h"
 #include "MusicDatabase.h"
+#include "FingerprintDatabase.h"
 #include "MusicAlbumInfo.h"
+#include "FileItem.h"
+
+#include <map>
 
 class CAlbum;
 class CArtist;
@@ -41,13 +48,19 @@ public:
   virtual void OnFinished() = 0;
 };
 
-class CMusicInfoScanner : CThread, public IRunnable
+class CMusicInfoScanner : CThread, public IRunnable, public IJobCallback
 {
 public:
   CMusicInfoScanner();
   virtual ~CMusicInfoScanner();
 
   void Start(const CStdString& strDirectory);
+
+  /*! \brief Update a set of folders, eg as they have changed on disk
+   The folders are always rescanned, as quick rescans miss files that are changed in place.
+   \param directories the folders to update
+   */
+  void Update(const std::set<CStdString>& directories);
   void FetchAlbumInfo(const CStdString& strDirectory);
   void FetchArtistInfo(const CStdString& strDirectory);
   bool IsScanning();
@@ -59,7 +72,45 @@ public:
 
   bool DownloadAlbumInfo(const CStdString& strPath, const CStdString& strArtist, const CStdString& strAlbum, bool& bCanceled, MUSIC_GRABBER::CMusicAlbumInfo& album, CGUIDialogProgress* pDialog=NULL);
   bool DownloadArtistInfo(const CStdString& strPath, const CStdString& strArtist, bool& bCanceled, CGUIDialogProgress* pDialog=NULL);
+
+  virtual void OnJobComplete(unsigned int jobID, bool success, CJob *job);
 protected:
+  /*! \brief Job class for reading the tag of a song, so that the tags of a folder are read in parallel
+   */
+  class CTagLoaderJob : public CJob
+  {
+  public:
+    CTagLoaderJob(const CFileItemPtr &item);
+
+    virtual const char* GetType() const { return "musictag"; };
+    virtual bool DoWork();
+
+    CFileItemPtr m_item;
+  };
+
+  /*! \brief Queue tag reading jobs for the items that need them, up to the read ahead limit
+   \param items the items of the folder being scanned
+   \param jobs [in/out] the job ids of the items that have a job queued, by item index
+   \param next [in/out] the index of the next item to queue a job for
+   \param current the index of the item currently being processed
+   */
+  void QueueTagJobs(CFileItemList& items, std::map<int, unsigned int> &jobs, int &next, int current);
+
+  /*! \brief Wait for a tag reading job to finish
+   \return true if the job is done, false if the scan was stopped.
+   */
+  bool WaitForTagJob(unsigned int jobID);
+
+  /*! \brief Cancel any tag reading jobs still outstanding
+   */
+  void CancelTagJobs(const std::map<int, unsigned int> &jobs);
+
+  /*! \brief Start the scan thread on a set of folders
+   \param directories the folders to scan
+   \param quickRescan whether folders with unchanged fingerprints are skipped
+   */
+  void Scan(const std::set<CStdString>& directories, bool quickRescan);
+
   virtual void Process();
   int RetrieveMusicInfo(CFileItemList& items, const CStdString& strDirectory);
   void UpdateFolderThumb(const VECSONGS &songs, const CStdString &folderPath);
@@ -69,6 +120,13 @@ protected:
 
   bool DoScan(const CStdString& strDirectory);
 
+  /*! \brief Store the fingerprint of a scanned folder, so that a quick rescan may skip it while it's unchanged
+   \param strDirectory the folder that was scanned
+   \param modified modification time of the folder, as retrieved prior to listing it
+   \param items the listing of the folder
+   */
+  void SetFingerprint(const CStdString& strDirectory, int64_t modified, const CFileItemList& items);
+
   virtual void Run();
   int CountFiles(const CFileItemList& items, bool recursive);
   int CountFilesRecursively(const CStdString& strPath);
@@ -82,6 +140,11 @@ protected:
   bool m_needsCleanup;
   int m_scanType; // 0 - load from files, 1 - albums, 2 - artists
   CMusicDatabase m_musicDatabase;
+  CFingerprintDatabase m_fingerprints;
+  bool m_quickRescan;                      ///< whether folders with unchanged fingerprints are skipped
+  unsigned int m_foldersListed;            ///< number of folders listed during this scan
+  unsigned int m_foldersSkipped;           ///< number of folders skipped as their fingerprint was unchanged
+  unsigned int m_foldersRemoved;           ///< number of fingerprints removed as their folder has gone
 
   std::set<CStdString> m_pathsToScan;
   std::set<CAlbum> m_albumsToScan;
@@ -89,5 +152,9 @@ protected:
   std::set<CStdString> m_pathsToCount;
   std::vector<long> m_artistsScanned;
   std::vector<long> m_albumsScanned;
+
+  CCriticalSection m_tagSection;
+  CEvent m_tagEvent;                       ///< set whenever a tag reading job finishes
+  std::set<unsigned int> m_tagJobsDone;    ///< finished tag reading jobs, guarded by m_tagSection
 };
 }
@@ -40,6 +40,11 @@ using namespace MUSIC_INFO;
 static const unsigned int g_MetaAtomName        = MAKE_ATOM_NAME( 'm', 'e', 't', 'a' );   // 'meta'
 static const unsigned int g_IlstAtomName        = MAKE_ATOM_NAME(  'i', 'l', 's', 't' );  // 'ilst'
 static const unsigned int g_MdhdAtomName        = MAKE_ATOM_NAME(  'm', 'd', 'h', 'd' );  // 'mdhd'
+static const unsigned int g_MoovAtomName        = MAKE_ATOM_NAME(  'm', 'o', 'o', 'v' );  // 'moov'
+static const unsigned int g_UdtaAtomName        = MAKE_ATOM_NAME(  'u', 'd', 't', 'a' );  // 'udta'
+static const unsigned int g_FreeformAtomName    = MAKE_ATOM_NAME(  '-', '-', '-', '-' );  // '----'
+static const unsigned int g_NameAtomName        = MAKE_ATOM_NAME(  'n', 'a', 'm', 'e' );  // 'name'
+static const unsigned int g_DataAtomName        = MAKE_ATOM_NAME(  'd', 'a', 't', 'a' );  // 'data'
 
 static const unsigned int g_TitleAtomName       = MAKE_ATOM_NAME( 0xa9, 'n', 'a', 'm' );  // 'nam'
 static const unsigned int g_ArtistAtomName      = MAKE_ATOM_NAME( 0xa9, 'A', 'R', 'T' );  // 'ART'
@@ -346,6 +351,94 @@ int CMusicInfoTagLoaderMP4::ParseAtom( int64_t startOffset, int64_t stopOffset,
   return 1;
 }
 
+// Looks for the value of the iTunSMPB tag, a freeform ('----') atom of moov/udta/meta/ilst made up
+// of 'mean', 'name' and 'data' atoms.
+
+bool CMusicInfoTagLoaderMP4::FindGaplessTag( CFile &file, int64_t startOffset, int64_t stopOffset, CStdString &value )
+{
+  int64_t currentOffset = startOffset;
+  while ( currentOffset + 8 <= stopOffset )
+  {
+    char atomHeader[ 16 ];
+    if ( file.Seek( currentOffset, SEEK_SET ) != currentOffset || file.Read( atomHeader, 8 ) != 8 )
+      return false;
+
+    int64_t      atomSize   = ReadUnsignedInt( &atomHeader[ 0 ] );
+    unsigned int atomName   = ReadUnsignedInt( &atomHeader[ 4 ] );
+    int          headerSize = 8;
+    if ( atomSize == 1 )
+    { // a 64 bit size follows, as a large 'mdat' ahead of the 'moov' may have
+      if ( file.Read( atomHeader + 8, 8 ) != 8 )
+        return false;
+      atomSize   = ( (int64_t)ReadUnsignedInt( &atomHeader[ 8 ] ) << 32 ) | ReadUnsignedInt( &atomHeader[ 12 ] );
+      headerSize = 16;
+    }
+    else if ( atomSize == 0 )
+      atomSize = stopOffset - currentOffset;
+    if ( atomSize < headerSize )
+      return false;
+
+    int64_t atomEnd = currentOffset + atomSize;
+    if ( atomName == g_MoovAtomName || atomName == g_UdtaAtomName || atomName == g_IlstAtomName )
+    {
+      if ( FindGaplessTag( file, currentOffset + headerSize, atomEnd, value ) )
+        return true;
+    }
+    else if ( atomName == g_MetaAtomName )
+    { // 'meta' has a version and flags ahead of its atoms
+      if ( FindGaplessTag( file, currentOffset + headerSize + 4, atomEnd, value ) )
+        return true;
+    }
+    else if ( atomName == g_FreeformAtomName && atomSize < 4096 )
+    {
+      int size = (int)atomSize - headerSize;
+      auto_aptr<char> atomBuffer( new char[ size ] );
+      if ( file.Read( atomBuffer.get(), size ) != (unsigned int)size )
+        return false;
+
+      // 'name' and 'data' have 4 and 8 bytes of flags (and type) ahead of their value
+      CStdString name, data;
+      int offset = 0;
+      while ( offset + 8 <= size )
+      {
+        int          childSize = (int)ReadUnsignedInt( atomBuffer.get() + offset );
+        unsigned int childName = ReadUnsignedInt( atomBuffer.get() + offset + 4 );
+        if ( childSize < 8 || offset + childSize > size )
+          break;
+        if ( childName == g_NameAtomName && childSize > 12 )
+          name.assign( atomBuffer.get() + offset + 12, childSize - 12 );
+        else if ( childName == g_DataAtomName && childSize > 16 )
+          data.assign( atomBuffer.get() + offset + 16, childSize - 16 );
+        offset += childSize;
+      }
+      if ( name == "iTunSMPB" )
+      {
+        value = data;
+        return true;
+      }
+    }
+    currentOffset = atomEnd;
+  }
+  return false;
+}
+
+bool CMusicInfoTagLoaderMP4::GetGaplessInfo(const CStdString& strFileName, unsigned int &delay, unsigned int &padding)
+{
+  CFile file;
+  if ( !file.Open( strFileName ) )
+    return false;
+
+  CStdString value;
+  bool found = FindGaplessTag( file, 0, file.GetLength(), value );
+  file.Close();
+
+  // the value is a list of hex numbers, of which the 2nd and 3rd are the delay and padding
+  unsigned int reserved;
+  if ( !found || sscanf( value.c_str(), "%x %x %x", &reserved, &delay, &padding ) != 3 )
+    return false;
+  return true;
+}
+
 // -------------------------------------------------------------------------------------------------
 
 CMusicInfoTagLoaderMP4::CMusicInfoTagLoaderMP4(void)
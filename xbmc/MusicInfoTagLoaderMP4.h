@@ -34,8 +34,17 @@ public:
 
   virtual bool Load(const CStdString& strFileName, CMusicInfoTag& tag);
 
+  /*! \brief Read the encoder delay and padding that iTunes and Nero store in an iTunSMPB tag
+   \param strFileName the file to read
+   \param delay [out] samples (per channel) that the encoder added at the start
+   \param padding [out] samples (per channel) that the encoder added at the end
+   \return true if the file has the tag, false otherwise.
+   */
+  static bool GetGaplessInfo(const CStdString& strFileName, unsigned int &delay, unsigned int &padding);
+
 private:
-  unsigned int ReadUnsignedInt( const char* pData );
+  static unsigned int ReadUnsignedInt( const char* pData );
+  static bool FindGaplessTag( XFILE::CFile &file, int64_t startOffset, int64_t stopOffset, CStdString &value );
   void ParseTag( unsigned int metaKey, const char* pMetaData, int metaSize, CMusicInfoTag& tag);
   int GetILSTOffset( const char* pBuffer, int bufferSize );
   int ParseAtom( int64_t startOffset, int64_t stopOffset, CMusicInfoTag& tag );
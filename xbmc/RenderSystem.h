@@ -77,6 +77,17 @@ public:
   virtual void SetViewPort(CRect& viewPort) = 0;
   virtual void GetViewPort(CRect& viewPort) = 0;
 
+  /*! \brief Restrict drawing (including clearing) to a rectangle of the screen
+   \param rect the rectangle, in screen coordinates.
+   \sa ResetScissors
+   */
+  virtual void SetScissors(const CRect &rect) = 0;
+
+  /*! \brief Remove the restriction set by SetScissors, allowing drawing over the whole viewport
+   \sa SetScissors
+   */
+  virtual void ResetScissors() = 0;
+
   virtual void CaptureStateBlock() = 0;
   virtual void ApplyStateBlock() = 0;
 
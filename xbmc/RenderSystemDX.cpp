@@ -714,9 +714,23 @@ bool CRenderSystemDX::ClearBuffers(color_t color)
   if (!m_bRenderCreated)
     return false;
 
+  // Clear() ignores the scissor test, so pass it the scissor rect instead
+  DWORD scissorEnabled = FALSE;
+  D3DRECT clearRect;
+  m_pD3DDevice->GetRenderState(D3DRS_SCISSORTESTENABLE, &scissorEnabled);
+  if (scissorEnabled)
+  {
+    RECT scissor;
+    m_pD3DDevice->GetScissorRect(&scissor);
+    clearRect.x1 = scissor.left;
+    clearRect.y1 = scissor.top;
+    clearRect.x2 = scissor.right;
+    clearRect.y2 = scissor.bottom;
+  }
+
   if( FAILED( hr = m_pD3DDevice->Clear(
-    0,
-    NULL,
+    scissorEnabled ? 1 : 0,
+    scissorEnabled ? &clearRect : NULL,
     D3DCLEAR_TARGET,
     color,
     1.0,
@@ -914,6 +928,28 @@ void CRenderSystemDX::SetViewPort(CRect& viewPort)
   m_pD3DDevice->SetViewport(&newviewport);
 }
 
+void CRenderSystemDX::SetScissors(const CRect &rect)
+{
+  if (!m_bRenderCreated)
+    return;
+
+  RECT scissor;
+  scissor.left   = (LONG)rect.x1;
+  scissor.top    = (LONG)rect.y1;
+  scissor.right  = (LONG)rect.x2;
+  scissor.bottom = (LONG)rect.y2;
+  m_pD3DDevice->SetScissorRect(&scissor);
+  m_pD3DDevice->SetRenderState(D3DRS_SCISSORTESTENABLE, TRUE);
+}
+
+void CRenderSystemDX::ResetScissors()
+{
+  if (!m_bRenderCreated)
+    return;
+
+  m_pD3DDevice->SetRenderState(D3DRS_SCISSORTESTENABLE, FALSE);
+}
+
 void CRenderSystemDX::Register(ID3DResource *resource)
 {
   CSingleLock lock(m_resourceSection);
@@ -531,7 +531,7 @@ void CRenderSystemGL::GetViewPort(CRect& viewPort)
     return;
 
   GLint glvp[4];
-  glGetIntegerv(GL_SCISSOR_BOX, glvp);
+  glGetIntegerv(GL_VIEWPORT, glvp);
 
   viewPort.x1 = glvp[0];
   viewPort.y1 = m_height - glvp[1] - glvp[3];
@@ -548,6 +548,27 @@ void CRenderSystemGL::SetViewPort(CRect& viewPort)
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
 }
 
+void CRenderSystemGL::SetScissors(const CRect &rect)
+{
+  if (!m_bRenderCreated)
+    return;
+  GLint x1 = (GLint)rect.x1;
+  GLint y1 = (GLint)rect.y1;
+  GLint x2 = (GLint)rect.x2;
+  GLint y2 = (GLint)rect.y2;
+  glScissor(x1, m_height - y2, x2 - x1, y2 - y1);
+}
+
+void CRenderSystemGL::ResetScissors()
+{
+  if (!m_bRenderCreated)
+    return;
+  // the scissor box otherwise matches the viewport
+  GLint glvp[4];
+  glGetIntegerv(GL_VIEWPORT, glvp);
+  glScissor(glvp[0], glvp[1], glvp[2], glvp[3]);
+}
+
 void CRenderSystemGL::GetGLSLVersion(int& major, int& minor)
 {
   major = m_glslMajor;
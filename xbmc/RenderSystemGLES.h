@@ -58,6 +58,9 @@ public:
   virtual void SetViewPort(CRect& viewPort);
   virtual void GetViewPort(CRect& viewPort);
 
+  virtual void SetScissors(const CRect &rect);
+  virtual void ResetScissors();
+
   virtual void CaptureStateBlock();
   virtual void ApplyStateBlock();
 
@@ -1378,6 +1378,7 @@ void CSettings::LoadSkinSettings(const TiXmlElement* pRootElement)
       }
       pChild = pChild->NextSiblingElement("setting");
     }
+    g_infoManager.InvalidateCache(CGUIInfoManager::CACHE_SKIN);
   }
 }
 
@@ -1456,6 +1457,7 @@ void CSettings::SetSkinString(int setting, const CStdString &label)
   if (it != m_skinStrings.end())
   {
     (*it).second.value = label;
+    g_infoManager.InvalidateCache(CGUIInfoManager::CACHE_SKIN);
     return;
   }
   assert(false);
@@ -1472,6 +1474,7 @@ void CSettings::ResetSkinSetting(const CStdString &setting)
     if (settingName.Equals((*it).second.name))
     {
       (*it).second.value = "";
+      g_infoManager.InvalidateCache(CGUIInfoManager::CACHE_SKIN);
       return;
     }
   }
@@ -1481,6 +1484,7 @@ void CSettings::ResetSkinSetting(const CStdString &setting)
     if (settingName.Equals((*it).second.name))
     {
       (*it).second.value = false;
+      g_infoManager.InvalidateCache(CGUIInfoManager::CACHE_SKIN);
       return;
     }
   }
@@ -1521,6 +1525,7 @@ void CSettings::SetSkinBool(int setting, bool set)
   if (it != m_skinBools.end())
   {
     (*it).second.value = set;
+    g_infoManager.InvalidateCache(CGUIInfoManager::CACHE_SKIN);
     return;
   }
   assert(false);
@@ -1550,6 +1555,7 @@ void CSettings::ResetSkinSettings()
     it2++;
   }
   g_infoManager.ResetCache();
+  g_infoManager.InvalidateCache(CGUIInfoManager::CACHE_SKIN);
 }
 
 static CStdString ToWatchContent(const CStdString &content)
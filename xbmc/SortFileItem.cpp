@@ -27,6 +27,13 @@
 #include "FileItem.h"
 #include "URL.h"
 #include "utils/log.h"
+#include "utils/CPUInfo.h"
+#include "utils/CollationRanks.h"
+#include "utils/JobManager.h"
+#include "utils/SingleLock.h"
+#include "utils/Event.h"
+
+#include <algorithm>
 
 #define RETURN_IF_NULL(x,y) if ((x) == NULL) { CLog::Log(LOGWARNING, "%s, sort item is null", __FUNCTION__); return y; }
 
@@ -105,6 +112,154 @@ bool SSortFileItem::IgnoreFoldersDescending(const CFileItemPtr &left, const CFil
   return StringUtils::AlphaNumericCompare(left->GetSortLabel().c_str(),right->GetSortLabel().c_str()) > 0;
 }
 
+// lists of at least this many items are sorted on two threads
+#define PARALLEL_SORT_MIN_ITEMS 20000
+
+namespace
+{
+  /*! \brief An item along with its precomputed sort key
+   The key orders as AlphaNumericCompare() does on the sort label.
+   \sa CCollationRanks::MakeSortKey()
+   */
+  struct SSortKey
+  {
+    enum GROUP { GROUP_TOP = 0, GROUP_FOLDER, GROUP_FILE, GROUP_BOTTOM };
+
+    CFileItemPtr item;
+    int group;
+    std::vector<uint32_t> key;
+  };
+
+  typedef std::vector<SSortKey *>::iterator SORTKEYITERATOR;
+
+  class CSortKeyCompare
+  {
+  public:
+    CSortKeyCompare(bool ascending) : m_ascending(ascending) {};
+
+    bool operator()(const SSortKey *left, const SSortKey *right) const
+    {
+      if (left->group != right->group)
+        return left->group < right->group;
+      if (left->group == SSortKey::GROUP_TOP || left->group == SSortKey::GROUP_BOTTOM)
+        return false; // both sort on top or on bottom -> leave as-is
+      if (m_ascending)
+        return std::lexicographical_compare(left->key.begin(), left->key.end(), right->key.begin(), right->key.end());
+      return std::lexicographical_compare(right->key.begin(), right->key.end(), left->key.begin(), left->key.end());
+    }
+
+  private:
+    bool m_ascending;
+  };
+
+  /*! \brief State shared by a sort job and the thread waiting on it
+   The waiting thread sorts the items itself if the job hasn't started by the time it's needed, so that
+   sorting from within a job can't stall on a job manager whose workers are all busy.
+   */
+  struct SSortJobState
+  {
+    enum STATE { STATE_PENDING = 0, STATE_RUNNING, STATE_CANCELLED };
+
+    SSortJobState() : state(STATE_PENDING) {};
+
+    CCriticalSection lock;
+    CEvent done;
+    STATE state;
+  };
+
+  class CSortJob : public CJob
+  {
+  public:
+    CSortJob(SORTKEYITERATOR begin, SORTKEYITERATOR end, const CSortKeyCompare &compare, const boost::shared_ptr<SSortJobState> &state)
+      : m_begin(begin), m_end(end), m_compare(compare), m_state(state) {};
+
+    virtual bool DoWork()
+    {
+      {
+        CSingleLock lock(m_state->lock);
+        if (m_state->state == SSortJobState::STATE_CANCELLED)
+          return false;
+        m_state->state = SSortJobState::STATE_RUNNING;
+      }
+      std::stable_sort(m_begin, m_end, m_compare);
+      m_state->done.Set();
+      return true;
+    }
+
+  private:
+    SORTKEYITERATOR m_begin;
+    SORTKEYITERATOR m_end;
+    CSortKeyCompare m_compare;
+    boost::shared_ptr<SSortJobState> m_state;
+  };
+}
+
+void SSortFileItem::Sort(std::vector<CFileItemPtr> &items, bool ascending, bool ignoreFolders)
+{
+  if (items.size() < 2)
+    return;
+
+  std::vector<SSortKey> keys(items.size());
+  std::vector<const CStdStringW *> labels;
+  labels.reserve(items.size());
+  for (unsigned int i = 0; i < items.size(); ++i)
+  {
+    SSortKey &key = keys[i];
+    key.item = items[i];
+    if (!key.item)
+    {
+      CLog::Log(LOGWARNING, "%s, sort item is null", __FUNCTION__);
+      key.group = SSortKey::GROUP_BOTTOM;
+    }
+    else if (key.item->SortsOnTop())
+      key.group = SSortKey::GROUP_TOP;
+    else if (key.item->SortsOnBottom())
+      key.group = SSortKey::GROUP_BOTTOM;
+    else
+    {
+      key.group = (key.item->m_bIsFolder && !ignoreFolders) ? SSortKey::GROUP_FOLDER : SSortKey::GROUP_FILE;
+      labels.push_back(&key.item->GetSortLabel());
+    }
+  }
+
+  CCollationRanks ranks(labels);
+  std::vector<SSortKey *> sorted(keys.size());
+  for (unsigned int i = 0; i < keys.size(); ++i)
+  {
+    SSortKey &key = keys[i];
+    if (key.group == SSortKey::GROUP_FOLDER || key.group == SSortKey::GROUP_FILE)
+      ranks.MakeSortKey(key.item->GetSortLabel(), key.key);
+    sorted[i] = &key;
+  }
+
+  CSortKeyCompare compare(ascending);
+  if (sorted.size() >= PARALLEL_SORT_MIN_ITEMS && g_cpuInfo.getCPUCount() > 1)
+  { // sort the first half in a job while we sort the second, then merge them
+    SORTKEYITERATOR middle = sorted.begin() + sorted.size() / 2;
+    boost::shared_ptr<SSortJobState> state(new SSortJobState);
+    CJobManager::GetInstance().AddJob(new CSortJob(sorted.begin(), middle, compare, state), NULL, CJob::PRIORITY_HIGH);
+    std::stable_sort(middle, sorted.end(), compare);
+
+    bool started;
+    {
+      CSingleLock lock(state->lock);
+      started = state->state == SSortJobState::STATE_RUNNING;
+      if (!started)
+        state->state = SSortJobState::STATE_CANCELLED;
+    }
+    if (started)
+      state->done.Wait();
+    else
+      std::stable_sort(sorted.begin(), middle, compare);
+    std::inplace_merge(sorted.begin(), middle, sorted.end(), compare);
+  }
+  else
+    std::stable_sort(sorted.begin(), sorted.end(), compare);
+
+  for (unsigned int i = 0; i < sorted.size(); ++i)
+    items[i] = sorted[i]->item;
+}
+
 void SSortFileItem::ByLabel(CFileItemPtr &item)
 {
   if (!item) return;
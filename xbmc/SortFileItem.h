@@ -22,6 +22,7 @@
 
 #include "utils/LabelFormatter.h"
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 class CFileItem; typedef boost::shared_ptr<CFileItem> CFileItemPtr;
 
@@ -39,6 +40,16 @@ struct SSortFileItem
   static bool IgnoreFoldersAscending(const CFileItemPtr &left, const CFileItemPtr &right);
   static bool IgnoreFoldersDescending(const CFileItemPtr &left, const CFileItemPtr &right);
 
+  /*! \brief Sort items by the sort labels filled in by one of the By*() functions
+   Orders the items as a stable sort using Ascending() or Descending() (or their IgnoreFolders variants) would,
+   but each sort label is turned into a collation key once up front, so that comparing two items is a plain
+   comparison of integers rather than a locale aware AlphaNumericCompare().  Large lists are sorted on two threads.
+   \param items the items to sort
+   \param ascending true to sort in ascending order, false for descending order
+   \param ignoreFolders true to sort folders along with files, false to keep them ahead of the files
+   */
+  static void Sort(std::vector<CFileItemPtr> &items, bool ascending, bool ignoreFolders);
+
   // Fill in sort field
   static void ByLabel(CFileItemPtr &item);
   static void ByLabelNoThe(CFileItemPtr &item);
@@ -21,12 +21,15 @@
 
 #include "TextureCache.h"
 #include "FileSystem/File.h"
+#include "FileSystem/Directory.h"
+#include "FileItem.h"
 #include "utils/SingleLock.h"
 #include "Crc32.h"
 #include "Util.h"
 #include "Settings.h"
 #include "AdvancedSettings.h"
 #include "utils/log.h"
+#include "utils/md5.h"
 
 #include "Texture.h"
 #include "DDSImage.h"
@@ -120,6 +123,31 @@ bool CTextureCache::CDDSJob::DoWork()
   return false;
 }
 
+bool CTextureCache::CCompactJob::DoWork()
+{
+  // list the shared files first - any file we find was added to the database before it was
+  // moved in place, so it's either in use, or no longer used.
+  CFileItemList files;
+  for (unsigned int hex = 0; hex < 16; hex++)
+  {
+    CStdString folder;
+    folder.Format("%x", hex);
+    CFileItemList items;
+    CDirectory::GetDirectory(GetCachedPath(folder), items, "", false);
+    for (int i = 0; i < items.Size(); i++)
+    {
+      CStdString file = CUtil::AddFileToFolder(folder, CUtil::GetFileName(items[i]->m_strPath));
+      if (!items[i]->m_bIsFolder && IsContentFile(file))
+      {
+        items[i]->m_strPath = file;
+        files.Add(items[i]);
+      }
+    }
+  }
+  CTextureCache::Get().CompactCachedContent(files);
+  return true;
+}
+
 CTextureCache &CTextureCache::Get()
 {
   static CTextureCache s_cache;
@@ -137,8 +165,8 @@ CTextureCache::~CTextureCache()
 void CTextureCache::Initialize()
 {
   CSingleLock lock(m_databaseSection);
-  if (!m_database.IsOpen())
-    m_database.Open();
+  if (!m_database.IsOpen() && m_database.Open())
+    CJobManager::GetInstance().AddJob(new CCompactJob, NULL, CJob::PRIORITY_LOW);
 }
 
 void CTextureCache::Deinitialize()
@@ -240,10 +268,15 @@ CStdString CTextureCache::CheckAndCacheImage(const CStdString &url, bool returnD
   CStdString hash = CCacheJob::CacheImage(url, originalFile);
   if (!hash.IsEmpty())
   {
-    AddCachedTexture(url, originalFile, hash);
-    if (g_advancedSettings.m_useDDSFanart)
-      AddJob(new CDDSJob(GetCachedPath(originalFile)));
-    return GetCachedPath(originalFile);
+    CStdString cachedFile = AddCachedTexture(url, originalFile, hash);
+    if (!cachedFile.IsEmpty())
+    {
+      path = GetCachedPath(cachedFile);
+      // an identical image may have been cached (and converted) already
+      if (g_advancedSettings.m_useDDSFanart && !CFile::Exists(CUtil::ReplaceExtension(path, ".dds")))
+        AddJob(new CDDSJob(path));
+      return path;
+    }
   }
   return "";
 }
@@ -254,7 +287,13 @@ void CTextureCache::ClearCachedImage(const CStdString &url, bool deleteSource /*
   CStdString path = deleteSource ? url : "";
   CStdString cachedFile;
   if (ClearCachedTexture(url, cachedFile))
+  { // shared files are only deleted once no other image uses them
+    if (cachedFile.IsEmpty())
+      return;
     path = GetCachedPath(cachedFile);
+  }
+  if (path.IsEmpty())
+    return;
   if (CFile::Exists(path))
     CFile::Delete(path);
   path = CUtil::ReplaceExtension(path, ".dds");
@@ -275,10 +314,36 @@ bool CTextureCache::GetCachedTexture(const CStdString &url, CStdString &cachedUR
   return false;
 }
 
-bool CTextureCache::AddCachedTexture(const CStdString &url, const CStdString &cachedURL, const CStdString &hash)
+CStdString CTextureCache::AddCachedTexture(const CStdString &url, const CStdString &cachedURL, const CStdString &hash)
 {
+  CStdString contentHash = GetContentHash(GetCachedPath(cachedURL));
+
   CSingleLock lock(m_databaseSection);
-  return m_database.AddCachedTexture(url, cachedURL, hash);
+  CStdString cachedFile(cachedURL);
+  if (!contentHash.IsEmpty())
+  { // share the file with any identical image we have cached already
+    CStdString contentFile = m_database.AddCachedContent(contentHash, GetContentFile(contentHash, cachedURL));
+    if (!contentFile.IsEmpty())
+    { // the content file is in the database before it exists, so it's never taken for an unused file
+      CStdString contentPath = GetCachedPath(contentFile);
+      if (!CFile::Exists(contentPath) && !CFile::Rename(GetCachedPath(cachedURL), contentPath))
+      { // couldn't move it in place, so keep it where it is
+        m_database.ReleaseCachedContent(contentFile);
+      }
+      else
+      { // remove our copy (if we didn't move it) and any outdated .dds version
+        DeleteCachedFile(cachedURL);
+        cachedFile = contentFile;
+      }
+    }
+  }
+
+  CStdString unusedFile;
+  if (!m_database.AddCachedTexture(url, cachedFile, hash, unusedFile))
+    return "";
+  if (!unusedFile.IsEmpty())
+    DeleteCachedFile(unusedFile);
+  return cachedFile;
 }
 
 bool CTextureCache::ClearCachedTexture(const CStdString &url, CStdString &cachedURL)
@@ -287,6 +352,77 @@ bool CTextureCache::ClearCachedTexture(const CStdString &url, CStdString &cached
   return m_database.ClearCachedTexture(url, cachedURL);
 }
 
+void CTextureCache::CompactCachedContent(const CFileItemList &files)
+{
+  // we delete while holding the database, so the files can't be shared again meanwhile
+  CSingleLock lock(m_databaseSection);
+  std::vector<CStdString> unused;
+  std::set<CStdString> used;
+  if (!m_database.CompactCachedContent(unused, used))
+    return;
+
+  for (unsigned int i = 0; i < unused.size(); i++)
+    DeleteCachedFile(unused[i]);
+
+  // and any files the database doesn't know about (eg left behind by a crash)
+  std::set<CStdString> usedNames;
+  for (std::set<CStdString>::const_iterator i = used.begin(); i != used.end(); ++i)
+    usedNames.insert(CUtil::ReplaceExtension(*i, ""));
+  unsigned int orphans = 0;
+  for (int i = 0; i < files.Size(); i++)
+  {
+    const CStdString &file = files[i]->m_strPath;
+    if (usedNames.find(CUtil::ReplaceExtension(file, "")) == usedNames.end())
+    {
+      CFile::Delete(GetCachedPath(file));
+      orphans++;
+    }
+  }
+  CLog::Log(LOGDEBUG, "%s - %u shared images in use, removed %u unused and %u orphaned files", __FUNCTION__, (unsigned int)used.size(), (unsigned int)unused.size(), orphans);
+}
+
+CStdString CTextureCache::GetContentHash(const CStdString &path)
+{
+  CFile file;
+  if (!file.Open(path))
+    return "";
+
+  XBMC::XBMC_MD5 md5;
+  char buffer[16384];
+  int read;
+  while ((read = file.Read(buffer, sizeof(buffer))) > 0)
+    md5.append(buffer, read);
+  file.Close();
+
+  CStdString hash;
+  md5.getDigest(hash);
+  hash.ToLower();
+  return hash;
+}
+
+CStdString CTextureCache::GetContentFile(const CStdString &contentHash, const CStdString &cacheFile)
+{
+  CStdString file;
+  file.Format("%c/%s%s", contentHash[0], contentHash.c_str(), CUtil::GetExtension(cacheFile).c_str());
+  return file;
+}
+
+bool CTextureCache::IsContentFile(const CStdString &cacheFile)
+{
+  CStdString name = CUtil::ReplaceExtension(CUtil::GetFileName(cacheFile), "");
+  return name.size() == 32 && name.find_first_not_of("0123456789abcdef") == CStdString::npos;
+}
+
+void CTextureCache::DeleteCachedFile(const CStdString &cacheFile)
+{
+  CStdString path = GetCachedPath(cacheFile);
+  if (CFile::Exists(path))
+    CFile::Delete(path);
+  path = CUtil::ReplaceExtension(path, ".dds");
+  if (CFile::Exists(path))
+    CFile::Delete(path);
+}
+
 CStdString CTextureCache::GetImageHash(const CStdString &url) const
 {
   struct __stat64 st;
@@ -327,10 +463,17 @@ void CTextureCache::OnJobComplete(unsigned int jobID, bool success, CJob *job)
   if (strcmp(job->GetType(), "cacheimage") == 0 && success)
   {
     CCacheJob *cacheJob = (CCacheJob *)job;
-    AddCachedTexture(cacheJob->m_url, cacheJob->m_original, cacheJob->m_hash);
+    if (cacheJob->m_hash == cacheJob->m_oldHash)
+    { // image is unchanged, so our cached file is up to date
+      CSingleLock lock(m_databaseSection);
+      m_database.SetCachedTextureValid(cacheJob->m_url, cacheJob->m_hash);
+      return CJobQueue::OnJobComplete(jobID, success, job);
+    }
+    CStdString cachedFile = AddCachedTexture(cacheJob->m_url, cacheJob->m_original, cacheJob->m_hash);
     // TODO: call back to the UI indicating that it can update it's image...
-    if (g_advancedSettings.m_useDDSFanart)
-      AddJob(new CDDSJob(GetCachedPath(cacheJob->m_original)));
+    if (!cachedFile.IsEmpty() && g_advancedSettings.m_useDDSFanart &&
+        !CFile::Exists(CUtil::ReplaceExtension(GetCachedPath(cachedFile), ".dds")))
+      AddJob(new CDDSJob(GetCachedPath(cachedFile)));
   }
   return CJobQueue::OnJobComplete(jobID, success, job);
 }
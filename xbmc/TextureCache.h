@@ -25,6 +25,8 @@
 #include "utils/JobManager.h"
 #include "TextureDatabase.h"
 
+class CFileItemList;
+
 /*!
  \ingroup textures
  \brief Texture cache class for handling the caching of images.
@@ -34,6 +36,11 @@
  may be periodically checked for updates and may be purged from the cache if
  unused for a set period of time.
 
+ Cached images are stored under the MD5 of their contents, so identical images
+ fetched from different urls (eg the same poster for every episode) share a single
+ cached file, reference counted in the texture database.  Cached files no longer
+ used by any image are removed by a background job at startup.
+
  */
 class CTextureCache : public CJobQueue
 {
@@ -119,6 +126,15 @@ private:
     CStdString m_original;
   };
 
+  /*! \brief Job class for removing shared cached files that are no longer used
+   */
+  class CCompactJob : public CJob
+  {
+  public:
+    virtual const char* GetType() const { return "compactcache"; };
+    virtual bool DoWork();
+  };
+
   /*! \brief Job class for caching textures
    */
   class CCacheJob : public CJob
@@ -157,13 +173,14 @@ private:
   bool IsCachedImage(const CStdString &image) const;
 
   /*! \brief Add this image to the database
-   Thread-safe wrapper of CTextureDatabase::AddCachedTexture
+   Thread-safe wrapper of CTextureDatabase::AddCachedTexture.  The cached file is moved to
+   its content addressed location, or removed if an identical image is cached already.
    \param image url of the original image
-   \param cacheFile url of the cached image
+   \param cacheFile url of the freshly cached image
    \param hash hash of the original image
-   \return true if we successfully added to the database, false otherwise.
+   \return url of the cached image to use, empty on failure.
    */
-  bool AddCachedTexture(const CStdString &image, const CStdString &cacheFile, const CStdString &hash);
+  CStdString AddCachedTexture(const CStdString &image, const CStdString &cacheFile, const CStdString &hash);
 
   /*! \brief Get an image from the database
    Thread-safe wrapper of CTextureDatabase::GetCachedTexture
@@ -176,11 +193,41 @@ private:
   /*! \brief Clear an image from the database
    Thread-safe wrapper of CTextureDatabase::ClearCachedTexture
    \param image url of the original image
-   \param cacheFile [out] url of the cached original (if available)
+   \param cacheFile [out] url of the cached original (if available and not used by other images)
    \return true if we had a cached version of this image, false otherwise.
    */
   bool ClearCachedTexture(const CStdString &url, CStdString &cacheFile);
 
+  /*! \brief Remove the shared cached files no longer used by any image
+   Thread-safe wrapper of CTextureDatabase::CompactCachedContent
+   \param files the content addressed files found in the cache, those not in use are deleted
+   */
+  void CompactCachedContent(const CFileItemList &files);
+
+  /*! \brief retrieve a hash of the contents of the given file
+   \param path location of the file
+   \return MD5 of the file contents, empty on failure
+   */
+  static CStdString GetContentHash(const CStdString &path);
+
+  /*! \brief retrieve the content addressed cache file for the given contents
+   \param contentHash hash of the contents of the file \sa GetContentHash
+   \param cacheFile cache file the contents are currently stored in
+   \return the cache file to store the contents in
+   */
+  static CStdString GetContentFile(const CStdString &contentHash, const CStdString &cacheFile);
+
+  /*! \brief check whether the given cache file is content addressed
+   \param cacheFile the cache file to check
+   \return true if the file name is a content hash \sa GetContentFile
+   */
+  static bool IsContentFile(const CStdString &cacheFile);
+
+  /*! \brief delete a cache file along with its .dds version
+   \param cacheFile the cache file to delete
+   */
+  static void DeleteCachedFile(const CStdString &cacheFile);
+
   /*! \brief retrieve a hash for the given image
    Combines the size, ctime and mtime of the image file into a "unique" hash
    \param url location of the image
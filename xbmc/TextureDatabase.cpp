@@ -54,6 +54,8 @@ bool CTextureDatabase::CreateTables()
 
     CLog::Log(LOGINFO, "create path index");
     m_pDS->exec("CREATE INDEX idxPath ON path(urlhash)");
+
+    CreateContentTable();
   }
   catch (...)
   {
@@ -83,9 +85,24 @@ bool CTextureDatabase::UpdateOldVersion(int version)
   {
     m_pDS->exec("ALTER TABLE texture ADD lasthashcheck text");
   }
+  if (version < 7)
+  {
+    CreateContentTable();
+  }
   return true;
 }
 
+void CTextureDatabase::CreateContentTable()
+{
+  CLog::Log(LOGINFO, "create content table");
+  m_pDS->exec("CREATE TABLE content (id integer primary key, contenthash text, cachedurl text, refcount integer)\n");
+
+  CLog::Log(LOGINFO, "create content indices");
+  m_pDS->exec("CREATE INDEX idxContent ON content(contenthash)");
+  m_pDS->exec("CREATE INDEX idxContentCachedUrl ON content(cachedurl)");
+  m_pDS->exec("CREATE INDEX idxTextureCachedUrl ON texture(cachedurl)");
+}
+
 bool CTextureDatabase::GetCachedTexture(const CStdString &url, CStdString &cacheFile, CStdString &imageHash)
 {
   try
@@ -121,7 +138,7 @@ bool CTextureDatabase::GetCachedTexture(const CStdString &url, CStdString &cache
   return false;
 }
 
-bool CTextureDatabase::AddCachedTexture(const CStdString &url, const CStdString &cacheFile, const CStdString &imageHash)
+bool CTextureDatabase::AddCachedTexture(const CStdString &url, const CStdString &cacheFile, const CStdString &imageHash, CStdString &unusedFile)
 {
   try
   {
@@ -131,12 +148,16 @@ bool CTextureDatabase::AddCachedTexture(const CStdString &url, const CStdString
     unsigned int hash = GetURLHash(url);
     CStdString date = CDateTime::GetCurrentDateTime().GetAsDBDateTime();
 
-    CStdString sql = PrepareSQL("select id from texture where urlhash=%u", hash);
+    CStdString sql = PrepareSQL("select id, cachedurl from texture where urlhash=%u", hash);
     m_pDS->query(sql.c_str());
     if (!m_pDS->eof())
     { // update
       int textureID = m_pDS->fv(0).get_asInt();
+      CStdString oldFile = m_pDS->fv(1).get_asString();
       m_pDS->close();
+      // we hold a reference to our previous file (which may well be the same one)
+      if (ReleaseCachedContent(oldFile) && oldFile != cacheFile)
+        unusedFile = oldFile;
       if (!imageHash.IsEmpty())
         sql = PrepareSQL("update texture set cachedurl='%s', usecount=1, lastusetime=CURRENT_TIMESTAMP, imagehash='%s', lasthashcheck='%s' where id=%u", cacheFile.c_str(), imageHash.c_str(), date.c_str(), textureID);
       else
@@ -153,10 +174,32 @@ bool CTextureDatabase::AddCachedTexture(const CStdString &url, const CStdString
   catch (...)
   {
     CLog::Log(LOGERROR, "%s failed on url '%s'", __FUNCTION__, url.c_str());
+    return false;
   }
   return true;
 }
 
+bool CTextureDatabase::SetCachedTextureValid(const CStdString &url, const CStdString &imageHash)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    unsigned int hash = GetURLHash(url);
+    CStdString date = CDateTime::GetCurrentDateTime().GetAsDBDateTime();
+
+    CStdString sql = PrepareSQL("update texture set imagehash='%s', lasthashcheck='%s' where urlhash=%u", imageHash.c_str(), date.c_str(), hash);
+    m_pDS->exec(sql.c_str());
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on url '%s'", __FUNCTION__, url.c_str());
+  }
+  return false;
+}
+
 bool CTextureDatabase::ClearCachedTexture(const CStdString &url, CStdString &cacheFile)
 {
   try
@@ -177,6 +220,8 @@ bool CTextureDatabase::ClearCachedTexture(const CStdString &url, CStdString &cac
       // remove it
       sql = PrepareSQL("delete from texture where id=%u", textureID);
       m_pDS->exec(sql.c_str());
+      if (!ReleaseCachedContent(cacheFile))
+        cacheFile.Empty(); // still used by other textures
       return true;
     }
     m_pDS->close();
@@ -188,6 +233,98 @@ bool CTextureDatabase::ClearCachedTexture(const CStdString &url, CStdString &cac
   return false;
 }
 
+CStdString CTextureDatabase::AddCachedContent(const CStdString &contentHash, const CStdString &cachedFile)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return "";
+    if (NULL == m_pDS.get()) return "";
+
+    CStdString sql = PrepareSQL("select id, cachedurl from content where contenthash='%s'", contentHash.c_str());
+    m_pDS->query(sql.c_str());
+    if (!m_pDS->eof())
+    { // share the existing file
+      int contentID = m_pDS->fv(0).get_asInt();
+      CStdString existingFile = m_pDS->fv(1).get_asString();
+      m_pDS->close();
+      sql = PrepareSQL("update content set refcount=refcount+1 where id=%u", contentID);
+      m_pDS->exec(sql.c_str());
+      return existingFile;
+    }
+    m_pDS->close();
+    sql = PrepareSQL("insert into content (id, contenthash, cachedurl, refcount) values(NULL, '%s', '%s', 1)", contentHash.c_str(), cachedFile.c_str());
+    m_pDS->exec(sql.c_str());
+    return cachedFile;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on file '%s'", __FUNCTION__, cachedFile.c_str());
+  }
+  return "";
+}
+
+bool CTextureDatabase::ReleaseCachedContent(const CStdString &cachedFile)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    CStdString sql = PrepareSQL("select id, refcount from content where cachedurl='%s'", cachedFile.c_str());
+    m_pDS->query(sql.c_str());
+    if (m_pDS->eof())
+    { // not a shared file (cached prior to sharing), so it's only ever used by a single texture
+      m_pDS->close();
+      return true;
+    }
+    int contentID = m_pDS->fv(0).get_asInt();
+    int refCount = m_pDS->fv(1).get_asInt();
+    m_pDS->close();
+    if (refCount > 1)
+      sql = PrepareSQL("update content set refcount=refcount-1 where id=%u", contentID);
+    else
+      sql = PrepareSQL("delete from content where id=%u", contentID);
+    m_pDS->exec(sql.c_str());
+    return refCount <= 1;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on file '%s'", __FUNCTION__, cachedFile.c_str());
+  }
+  return false;
+}
+
+bool CTextureDatabase::CompactCachedContent(std::vector<CStdString> &unused, std::set<CStdString> &used)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    // bring the reference counts in line with the textures using the files
+    m_pDS->exec("update content set refcount=(select count(*) from texture where texture.cachedurl=content.cachedurl)");
+
+    m_pDS->query("select cachedurl, refcount from content");
+    while (!m_pDS->eof())
+    {
+      if (m_pDS->fv(1).get_asInt() > 0)
+        used.insert(m_pDS->fv(0).get_asString());
+      else
+        unused.push_back(m_pDS->fv(0).get_asString());
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    m_pDS->exec("delete from content where refcount <= 0");
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return false;
+}
+
 unsigned int CTextureDatabase::GetURLHash(const CStdString &url) const
 {
   Crc32 crc;
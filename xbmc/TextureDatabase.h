@@ -23,6 +23,9 @@
 
 #include "Database.h"
 
+#include <set>
+#include <vector>
+
 class CTextureDatabase : public CDatabase
 {
 public:
@@ -31,9 +34,53 @@ public:
   virtual bool Open();
 
   bool GetCachedTexture(const CStdString &originalURL, CStdString &cacheFile, CStdString &imageHash);
-  bool AddCachedTexture(const CStdString &originalURL, const CStdString &cachedFile, const CStdString &imageHash = "");
+
+  /*! \brief Add or update the cached file of a texture
+   \param originalURL url of the original image
+   \param cachedFile the cached file of the image, as added via AddCachedContent()
+   \param imageHash hash of the original image
+   \param unusedFile [out] a previously cached file of the image that is no longer used by any texture, and may be deleted
+   \return true if the texture was added, false otherwise.
+   */
+  bool AddCachedTexture(const CStdString &originalURL, const CStdString &cachedFile, const CStdString &imageHash, CStdString &unusedFile);
+
+  /*! \brief Mark a texture as checked for updates, as its original image is unchanged
+   \param originalURL url of the original image
+   \param imageHash hash of the original image
+   \return true if the texture was updated, false otherwise.
+   */
+  bool SetCachedTextureValid(const CStdString &originalURL, const CStdString &imageHash);
+
+  /*! \brief Remove a texture
+   \param originalURL url of the original image
+   \param cacheFile [out] the cached file of the image if no other texture uses it, and it may be deleted
+   \return true if we had this texture, false otherwise.
+   */
   bool ClearCachedTexture(const CStdString &originalURL, CStdString &cacheFile);
 
+  /*! \brief Add a reference to a cached file with the given contents
+   Identical images fetched from different urls share a single cached file.
+   \param contentHash hash of the contents of the cached file
+   \param cachedFile the cached file to use if we don't have these contents yet
+   \return the cached file holding these contents, empty on failure.
+   \sa ReleaseCachedContent
+   */
+  CStdString AddCachedContent(const CStdString &contentHash, const CStdString &cachedFile);
+
+  /*! \brief Release a reference to a cached file
+   \param cachedFile the cached file that a texture no longer uses
+   \return true if no texture uses the cached file anymore, so that it may be deleted.
+   \sa AddCachedContent
+   */
+  bool ReleaseCachedContent(const CStdString &cachedFile);
+
+  /*! \brief Recount the references to the shared cached files, removing those no longer used
+   \param unused [out] cached files no longer used by any texture, which may be deleted
+   \param used [out] cached files still in use
+   \return true if the cached files were compacted, false otherwise.
+   */
+  bool CompactCachedContent(std::vector<CStdString> &unused, std::set<CStdString> &used);
+
   /*! \brief Get a texture associated with the given path
    Used for retrieval of previously discovered (and cached) images to save
    stat() on the filesystem all the time
@@ -60,6 +107,7 @@ protected:
 
   virtual bool CreateTables();
   virtual bool UpdateOldVersion(int version);
-  virtual int GetMinVersion() const { return 6; };
+  void CreateContentTable();
+  virtual int GetMinVersion() const { return 7; };
   const char *GetDefaultDBName() const { return "Textures"; };
 };
@@ -2030,6 +2030,8 @@ void CUtil::TakeScreenshot(const CStdString &filename, bool sync)
     g_renderManager.SetupScreenshot();
 #endif
   }
+  g_windowManager.UpdateModelessVisibility(); // as CApplication::Render() does before rendering
+  g_windowManager.MarkDirty(); // the screenshot needs the whole screen
   g_application.RenderNoPresent();
 
   if (FAILED(g_Windowing.Get3DDevice()->CreateOffscreenPlainSurface(g_Windowing.GetWidth(), g_Windowing.GetHeight(), D3DFMT_X8R8G8B8, D3DPOOL_SYSTEMMEM, &lpSurface, NULL)))
@@ -2076,6 +2078,8 @@ void CUtil::TakeScreenshot(const CStdString &filename, bool sync)
     g_renderManager.SetupScreenshot();
 #endif
   }
+  g_windowManager.UpdateModelessVisibility(); // as CApplication::Render() does before rendering
+  g_windowManager.MarkDirty(); // the screenshot needs the whole screen
   g_application.RenderNoPresent();
 #ifndef HAS_GLES
   glReadBuffer(GL_BACK);
@@ -1952,32 +1952,45 @@ void CVideoDatabase::SetStreamDetailsForFileId(const CStreamDetails& details, in
     BeginTransaction();
     m_pDS->exec(PrepareSQL("DELETE FROM streamdetails WHERE idFile = %i", idFile));
 
+    // the inserts of each stream type are prepared once and reused for every file scanned
+    vector< vector<string> > rows;
     for (int i=1; i<=details.GetVideoStreamCount(); i++)
     {
-      m_pDS->exec(PrepareSQL("INSERT INTO streamdetails "
-        "(idFile, iStreamType, strVideoCodec, fVideoAspect, iVideoWidth, iVideoHeight, iVideoDuration) "
-        "VALUES (%i,%i,'%s',%f,%i,%i,%i)",
-        idFile, (int)CStreamDetail::VIDEO,
-        details.GetVideoCodec(i).c_str(), details.GetVideoAspect(i),
-        details.GetVideoWidth(i), details.GetVideoHeight(i), details.GetVideoDuration(i)));
+      vector<string> row;
+      row.push_back(PrepareSQL("%i", idFile));
+      row.push_back(PrepareSQL("%i", (int)CStreamDetail::VIDEO));
+      row.push_back(details.GetVideoCodec(i));
+      row.push_back(PrepareSQL("%f", details.GetVideoAspect(i)));
+      row.push_back(PrepareSQL("%i", details.GetVideoWidth(i)));
+      row.push_back(PrepareSQL("%i", details.GetVideoHeight(i)));
+      row.push_back(PrepareSQL("%i", details.GetVideoDuration(i)));
+      rows.push_back(row);
     }
+    InsertRows("streamdetails", "idFile, iStreamType, strVideoCodec, fVideoAspect, iVideoWidth, iVideoHeight, iVideoDuration", rows);
+
+    rows.clear();
     for (int i=1; i<=details.GetAudioStreamCount(); i++)
     {
-      m_pDS->exec(PrepareSQL("INSERT INTO streamdetails "
-        "(idFile, iStreamType, strAudioCodec, iAudioChannels, strAudioLanguage) "
-        "VALUES (%i,%i,'%s',%i,'%s')",
-        idFile, (int)CStreamDetail::AUDIO,
-        details.GetAudioCodec(i).c_str(), details.GetAudioChannels(i),
-        details.GetAudioLanguage(i).c_str()));
+      vector<string> row;
+      row.push_back(PrepareSQL("%i", idFile));
+      row.push_back(PrepareSQL("%i", (int)CStreamDetail::AUDIO));
+      row.push_back(details.GetAudioCodec(i));
+      row.push_back(PrepareSQL("%i", details.GetAudioChannels(i)));
+      row.push_back(details.GetAudioLanguage(i));
+      rows.push_back(row);
     }
+    InsertRows("streamdetails", "idFile, iStreamType, strAudioCodec, iAudioChannels, strAudioLanguage", rows);
+
+    rows.clear();
     for (int i=1; i<=details.GetSubtitleStreamCount(); i++)
     {
-      m_pDS->exec(PrepareSQL("INSERT INTO streamdetails "
-        "(idFile, iStreamType, strSubtitleLanguage) "
-        "VALUES (%i,%i,'%s')",
-        idFile, (int)CStreamDetail::SUBTITLE,
-        details.GetSubtitleLanguage(i).c_str()));
+      vector<string> row;
+      row.push_back(PrepareSQL("%i", idFile));
+      row.push_back(PrepareSQL("%i", (int)CStreamDetail::SUBTITLE));
+      row.push_back(details.GetSubtitleLanguage(i));
+      rows.push_back(row);
     }
+    InsertRows("streamdetails", "idFile, iStreamType, strSubtitleLanguage", rows);
 
     CommitTransaction();
   }
@@ -48,6 +48,8 @@ using namespace std;
 using namespace XFILE;
 using namespace ADDON;
 
+#define FINGERPRINT_SCANNER "video"
+
 namespace VIDEO
 {
 
@@ -60,6 +62,10 @@ namespace VIDEO
     m_itemCount = 0;
     m_bClean = false;
     m_scanAll = false;
+    m_quickRescan = false;
+    m_foldersListed = 0;
+    m_foldersSkipped = 0;
+    m_foldersRemoved = 0;
   }
 
   CVideoInfoScanner::~CVideoInfoScanner()
@@ -84,6 +90,11 @@ namespace VIDEO
       // Reset progress vars
       m_currentItem = 0;
       m_itemCount = -1;
+      m_foldersListed = 0;
+      m_foldersSkipped = 0;
+      m_foldersRemoved = 0;
+
+      m_fingerprints.Open();
 
       SetPriority(GetMinPriority());
 
@@ -118,10 +129,12 @@ namespace VIDEO
         }
       }
 
+      m_fingerprints.Close();
       m_database.Close();
 
       tick = CTimeUtils::GetTimeMS() - tick;
       CLog::Log(LOGNOTICE, "VideoInfoScanner: Finished scan. Scanning for video info took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
+      CLog::Log(LOGDEBUG, "VideoInfoScanner: %u folders listed, %u skipped as unchanged, %u fingerprints removed", m_foldersListed, m_foldersSkipped, m_foldersRemoved);
 
       m_bRunning = false;
       if (m_pObserver)
@@ -152,6 +165,24 @@ namespace VIDEO
       m_pathsToScan.insert(strDirectory);
     }
     m_bClean = g_advancedSettings.m_bVideoLibraryCleanOnUpdate;
+    m_quickRescan = g_advancedSettings.m_bVideoLibraryQuickRescan;
+
+    StopThread();
+    Create();
+    m_bRunning = true;
+  }
+
+  void CVideoInfoScanner::Update(const set<CStdString>& directories)
+  {
+    m_strStartDir.Empty();
+    m_scanAll = false;
+    m_pathsToScan = directories;
+    m_pathsToClean.clear();
+
+    // only the updated folders are cleaned, so this is cheap
+    m_bClean = true;
+    // files changed in place leave the folder's modification time alone
+    m_quickRescan = false;
 
     StopThread();
     Create();
@@ -214,20 +245,46 @@ namespace VIDEO
       return true;
 
     CStdString hash, dbHash;
+    int64_t modified = 0;
+    bool listed = false;
     if (content == CONTENT_MOVIES ||content == CONTENT_MUSICVIDEOS)
     {
       if (m_pObserver)
         m_pObserver->OnStateChanged(content == CONTENT_MOVIES ? FETCHING_MOVIE_INFO : FETCHING_MUSICVIDEO_INFO);
 
-      CStdString fastHash = GetFastHash(strDirectory);
-      if (m_database.GetPathHash(strDirectory, dbHash) && !fastHash.IsEmpty() && fastHash == dbHash)
+      // retrieve the modification time prior to listing the folder, so that changes made while
+      // we're scanning it show up next time
+      modified = CDirectoryFingerprint::GetModificationTime(strDirectory);
+      if (!modified)
+        m_foldersRemoved += m_fingerprints.RemoveFingerprints(FINGERPRINT_SCANNER, strDirectory);
+
+      CDirectoryFingerprint fingerprint;
+      if (m_quickRescan && modified && m_fingerprints.GetFingerprint(FINGERPRINT_SCANNER, strDirectory, fingerprint) && fingerprint.m_modified == modified)
+      { // no files were added, removed or renamed - no need to list the folder, just check its subfolders
+        CLog::Log(LOGDEBUG, "VideoInfoScanner: Skipping dir '%s' due to no change (fingerprint)", strDirectory.c_str());
+        m_foldersSkipped++;
+        vector<CStdString> subFolders;
+        m_fingerprints.GetSubFolders(FINGERPRINT_SCANNER, strDirectory, subFolders);
+        for (vector<CStdString>::const_iterator i = subFolders.begin(); i != subFolders.end(); ++i)
+        {
+          CFileItemPtr item(new CFileItem(*i, true));
+          items.Add(item);
+        }
+        bSkip = true;
+      }
+
+      CStdString fastHash = GetFastHash(modified);
+      if (!bSkip && m_database.GetPathHash(strDirectory, dbHash) && !fastHash.IsEmpty() && fastHash == dbHash)
       { // fast hashes match - no need to process anything
         CLog::Log(LOGDEBUG, "VideoInfoScanner: Skipping dir '%s' due to no change (fasthash)", strDirectory.c_str());
         hash = fastHash;
+        m_foldersSkipped++;
         bSkip = true;
       }
       if (!bSkip)
       { // need to fetch the folder
+        m_foldersListed++;
+        listed = true;
         CDirectory::GetDirectory(strDirectory, items, g_settings.m_videoExtensions);
         if (content == CONTENT_MOVIES)
           items.Stack();
@@ -329,9 +386,32 @@ namespace VIDEO
         }
       }
     }
+
+    // the fingerprint is only stored once all subfolders are scanned, as a quick rescan won't list the folder again
+    if (!m_bStop && listed && modified)
+      SetFingerprint(strDirectory, modified, items);
+
     return !m_bStop;
   }
 
+  void CVideoInfoScanner::SetFingerprint(const CStdString& strDirectory, int64_t modified, const CFileItemList& items)
+  {
+    vector<CStdString> subFolders;
+    int count = 0;
+    for (int i = 0; i < items.Size(); ++i)
+    {
+      const CFileItemPtr pItem = items[i];
+      if (pItem->m_bIsFolder && !pItem->IsParentFolder() && !pItem->IsPlayList())
+        subFolders.push_back(pItem->m_strPath);
+      else if (pItem->IsVideo() && !pItem->IsPlayList() && !pItem->IsNFO())
+        count++;
+    }
+
+    CDirectoryFingerprint fingerprint;
+    fingerprint.Set(modified, count);
+    m_fingerprints.SetFingerprint(FINGERPRINT_SCANNER, strDirectory, fingerprint, subFolders);
+  }
+
   bool CVideoInfoScanner::RetrieveVideoInfo(CFileItemList& items, bool bDirNames, CONTENT_TYPE content, bool useLocal, CScraperUrl* pURL, bool fetchEpisodes, CGUIDialogProgress* pDlgProgress)
   {
     if (pDlgProgress)
@@ -352,6 +432,10 @@ namespace VIDEO
     for (int i=LIBRARY_HAS_VIDEO;i<LIBRARY_HAS_MUSICVIDEOS+1;++i)
       g_infoManager.GetBool(i);
 
+    // write several items per transaction.  The batch is flushed prior to any online
+    // lookups, so the database isn't locked meanwhile.
+    m_database.BeginBatch();
+
     bool FoundSomeInfo = false;
     for (int i = 0; i < (int)items.Size(); ++i)
     {
@@ -403,8 +487,10 @@ namespace VIDEO
       if (ret == INFO_ADDED || ret == INFO_HAVE_ALREADY)
         FoundSomeInfo = true;
 
+      m_database.BatchItemDone();
       pURL = NULL;
     }
+    m_database.EndBatch();
 
     if(pDlgProgress)
       pDlgProgress->ShowProgressBar(false);
@@ -636,6 +722,7 @@ namespace VIDEO
         progress->Progress();
       }
 
+      m_database.FlushBatch();
       CIMDB imdb(scraper);
       if (!imdb.GetEpisodeList(url, episodes))
         return INFO_NOT_FOUND;
@@ -1315,6 +1402,7 @@ namespace VIDEO
 
       if (bFound)
       {
+        m_database.FlushBatch();
         CIMDB imdb(scraper);
         CFileItem item;
         item.m_strPath = file->strPath;
@@ -1469,6 +1557,7 @@ namespace VIDEO
     CVideoInfoTag movieDetails;
     movieDetails.m_strFileNameAndPath = pItem->m_strPath;
 
+    m_database.FlushBatch();
     CIMDB imdb(scraper);
     if ( imdb.GetDetails(url, movieDetails, pDialog) )
     {
@@ -1531,20 +1620,13 @@ namespace VIDEO
     return items.GetFolderCount() == 0;
   }
 
-  CStdString CVideoInfoScanner::GetFastHash(const CStdString &directory) const
+  CStdString CVideoInfoScanner::GetFastHash(int64_t modified) const
   {
-    struct __stat64 buffer;
-    if (XFILE::CFile::Stat(directory, &buffer) == 0)
+    if (modified)
     {
-      int64_t time = buffer.st_mtime;
-      if (!time)
-        time = buffer.st_ctime;
-      if (time)
-      {
-        CStdString hash;
-        hash.Format("fast%"PRId64, time);
-        return hash;
-      }
+      CStdString hash;
+      hash.Format("fast%"PRId64, modified);
+      return hash;
     }
     return "";
   }
@@ -1718,6 +1800,7 @@ namespace VIDEO
   int CVideoInfoScanner::FindVideo(const CStdString &videoName, const ScraperPtr &scraper, CScraperUrl &url, CGUIDialogProgress *progress)
   {
     IMDB_MOVIELIST movielist;
+    m_database.FlushBatch();
     CIMDB imdb(scraper);
     int returncode = imdb.FindMovie(videoName, movielist, progress);
     if (returncode < 0 || (returncode == 0 && !DownloadFailed(progress)))
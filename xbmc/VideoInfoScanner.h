@@ -21,6 +21,7 @@
  */
 #include "utils/Thread.h"
 #include "VideoDatabase.h"
+#include "FingerprintDatabase.h"
 #include "addons/Scraper.h"
 #include "NfoFile.h"
 #include "IMDB.h"
@@ -87,6 +88,13 @@ namespace VIDEO
      \param scanAll whether to scan everything not already scanned (regardless of whether the user normally doesn't want a folder scanned.) Defaults to false.
      */
     void Start(const CStdString& strDirectory, bool scanAll = false);
+
+    /*! \brief Update a set of folders using the background scanner, eg as they have changed on disk
+     Items that have gone from the folders are removed from the library.  The folders are always
+     rescanned, as quick rescans miss files that are changed in place.
+     \param directories the folders to update
+     */
+    void Update(const std::set<CStdString>& directories);
     bool IsScanning();
     void Stop();
     void SetObserver(IVideoInfoScannerObserver* pObserver);
@@ -180,14 +188,20 @@ namespace VIDEO
     void FetchActorThumbs(const std::vector<SActorInfo>& actors, const CStdString& strPath);
     static int GetPathHash(const CFileItemList &items, CStdString &hash);
 
-    /*! \brief Retrieve a "fast" hash of the given directory (if available)
-     Performs a stat() on the directory, and uses modified time to create a "fast"
-     hash of the folder. If no modified time is available, the create time is used,
-     and if neither are available, an empty hash is returned.
-     \param directory folder to hash
+    /*! \brief Retrieve a "fast" hash of a directory (if available)
+     Uses the modified time of the directory to create a "fast" hash of the folder.
+     If no modified time is available, an empty hash is returned.
+     \param modified modification time of the folder, as retrieved by CDirectoryFingerprint::GetModificationTime()
      \return the hash of the folder of the form "fast<datetime>"
      */
-    CStdString GetFastHash(const CStdString &directory) const;
+    CStdString GetFastHash(int64_t modified) const;
+
+    /*! \brief Store the fingerprint of a scanned folder, so that a quick rescan may skip it while it's unchanged
+     \param strDirectory the folder that was scanned
+     \param modified modification time of the folder, as retrieved prior to listing it
+     \param items the listing of the folder
+     */
+    void SetFingerprint(const CStdString& strDirectory, int64_t modified, const CFileItemList& items);
 
     /*! \brief Decide whether a folder listing could use the "fast" hash
      Fast hashing can be done whenever the folder contains no scannable subfolders, as the
@@ -244,6 +258,11 @@ namespace VIDEO
     bool m_scanAll;
     CStdString m_strStartDir;
     CVideoDatabase m_database;
+    CFingerprintDatabase m_fingerprints;
+    bool m_quickRescan;            ///< whether folders with unchanged fingerprints are skipped
+    unsigned int m_foldersListed;  ///< number of folders listed during this scan
+    unsigned int m_foldersSkipped; ///< number of folders skipped as their fingerprint was unchanged
+    unsigned int m_foldersRemoved; ///< number of fingerprints removed as their folder has gone
     std::set<CStdString> m_pathsToScan;
     std::set<CStdString> m_pathsToCount;
     std::vector<int> m_pathsToClean;
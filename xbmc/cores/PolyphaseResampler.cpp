@@ -0,0 +1,558 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "PolyphaseResampler.h"
+#include "MathUtils.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+#ifndef M_PI
+#define M_PI 3.1415926535897932384626433832795028842
+#endif
+
+// the largest number of phases computed exactly, rates with a larger common ratio interpolate
+#define RESAMPLE_MAX_PHASES 1024
+// the longest filter used when downsampling
+#define RESAMPLE_MAX_TAPS   1024
+// how far a variable ratio may move below the one the filter was computed for before it's recomputed
+#define RESAMPLE_RATIO_SLACK 0.02
+
+using namespace std;
+
+struct SResamplePreset
+{
+  unsigned int taps;   ///< filter length at ratios >= 1
+  unsigned int phases; ///< table size when interpolating between phases
+  double       cutoff; ///< relative to the nyquist frequency of the input
+  double       beta;   ///< kaiser window parameter
+};
+
+static const SResamplePreset presets[] =
+{
+  {  16,  64, 0.80,  5.0 }, // QUALITY_LOW
+  {  32, 128, 0.87,  7.0 }, // QUALITY_MEDIUM
+  {  64, 256, 0.92,  9.0 }, // QUALITY_HIGH
+  { 128, 512, 0.95, 11.0 }  // QUALITY_BEST
+};
+
+/* filter kernels, with simd versions selected at runtime from the cpu features.
+ * taps is always a multiple of 4, and neither pointer need be aligned */
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+  #if defined(_MSC_VER)
+    #define KERNEL_TARGET(x)
+    #define HAS_KERNELS_SSE2
+  #elif defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+    #define KERNEL_TARGET(x) __attribute__((target(x)))
+    #define HAS_KERNELS_SSE2
+  #elif defined(__SSE2__)
+    #define KERNEL_TARGET(x)
+    #define HAS_KERNELS_SSE2
+  #endif
+#elif defined(__ARM_NEON__)
+  #define HAS_KERNELS_NEON
+#endif
+
+#if defined(HAS_KERNELS_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(HAS_KERNELS_NEON)
+#include <arm_neon.h>
+#endif
+
+static float Dot_C(const float *coeffs, const float *samples, unsigned int taps)
+{
+  float sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+  for (unsigned int i = 0; i < taps; i += 4)
+  {
+    sum0 += coeffs[i    ] * samples[i    ];
+    sum1 += coeffs[i + 1] * samples[i + 1];
+    sum2 += coeffs[i + 2] * samples[i + 2];
+    sum3 += coeffs[i + 3] * samples[i + 3];
+  }
+  return (sum0 + sum2) + (sum1 + sum3);
+}
+
+static void Lerp_C(float *out, const float *a, const float *b, float t, unsigned int taps)
+{
+  for (unsigned int i = 0; i < taps; ++i)
+    out[i] = a[i] + (b[i] - a[i]) * t;
+}
+
+#if defined(HAS_KERNELS_SSE2)
+KERNEL_TARGET("sse2")
+static float Dot_SSE2(const float *coeffs, const float *samples, unsigned int taps)
+{
+  __m128 sum0 = _mm_setzero_ps();
+  __m128 sum1 = _mm_setzero_ps();
+  unsigned int i = 0;
+  for (; i + 8 <= taps; i += 8)
+  {
+    sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(coeffs + i    ), _mm_loadu_ps(samples + i    )));
+    sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(coeffs + i + 4), _mm_loadu_ps(samples + i + 4)));
+  }
+  if (i < taps)
+    sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(coeffs + i), _mm_loadu_ps(samples + i)));
+
+  sum0 = _mm_add_ps(sum0, sum1);
+  sum0 = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+  sum0 = _mm_add_ss(sum0, _mm_shuffle_ps(sum0, sum0, 1));
+  return _mm_cvtss_f32(sum0);
+}
+
+KERNEL_TARGET("sse2")
+static void Lerp_SSE2(float *out, const float *a, const float *b, float t, unsigned int taps)
+{
+  const __m128 factor = _mm_set1_ps(t);
+  for (unsigned int i = 0; i < taps; i += 4)
+  {
+    __m128 first = _mm_loadu_ps(a + i);
+    __m128 delta = _mm_sub_ps(_mm_loadu_ps(b + i), first);
+    _mm_storeu_ps(out + i, _mm_add_ps(first, _mm_mul_ps(delta, factor)));
+  }
+}
+#endif
+
+#if defined(HAS_KERNELS_NEON)
+static float Dot_NEON(const float *coeffs, const float *samples, unsigned int taps)
+{
+  float32x4_t sum = vdupq_n_f32(0.0f);
+  for (unsigned int i = 0; i < taps; i += 4)
+    sum = vmlaq_f32(sum, vld1q_f32(coeffs + i), vld1q_f32(samples + i));
+
+  float32x2_t half = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+  return vget_lane_f32(vpadd_f32(half, half), 0);
+}
+
+static void Lerp_NEON(float *out, const float *a, const float *b, float t, unsigned int taps)
+{
+  for (unsigned int i = 0; i < taps; i += 4)
+  {
+    float32x4_t first = vld1q_f32(a + i);
+    vst1q_f32(out + i, vmlaq_n_f32(first, vsubq_f32(vld1q_f32(b + i), first), t));
+  }
+}
+#endif
+
+struct CResampleKernels
+{
+  CResampleKernels()
+  {
+    Dot  = Dot_C;
+    Lerp = Lerp_C;
+
+    int features = g_cpuInfo.GetCPUFeatures();
+#if defined(HAS_KERNELS_SSE2)
+    if (features & CPU_FEATURE_SSE2)
+    {
+      Dot  = Dot_SSE2;
+      Lerp = Lerp_SSE2;
+    }
+#endif
+#if defined(HAS_KERNELS_NEON)
+    if (features & CPU_FEATURE_NEON)
+    {
+      Dot  = Dot_NEON;
+      Lerp = Lerp_NEON;
+    }
+#endif
+  }
+
+  float (*Dot)(const float *coeffs, const float *samples, unsigned int taps);
+  void  (*Lerp)(float *out, const float *a, const float *b, float t, unsigned int taps);
+};
+
+static const CResampleKernels& GetResampleKernels()
+{
+  static CResampleKernels kernels;
+  return kernels;
+}
+
+// zeroth order modified bessel function of the first kind, for the kaiser window
+static double BesselI0(double x)
+{
+  double sum = 1.0, term = 1.0;
+  for (int k = 1; k < 50 && term > sum * 1e-12; ++k)
+  {
+    term *= (x * x) / (4.0 * k * k);
+    sum += term;
+  }
+  return sum;
+}
+
+static double Sinc(double x)
+{
+  if (fabs(x) < 1e-9)
+    return 1.0;
+  return sin(M_PI * x) / (M_PI * x);
+}
+
+static unsigned int GreatestCommonDivisor(unsigned int a, unsigned int b)
+{
+  while (b)
+  {
+    unsigned int r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+CPolyphaseResampler::CPolyphaseResampler()
+{
+  m_channels = 0;
+  m_quality = QUALITY_MEDIUM;
+  m_taps = 0;
+  m_phases = 0;
+  m_interpolate = false;
+  m_ratio = 1.0;
+  m_filterRatio = 1.0;
+  m_position = 0;
+  m_phase = 0;
+  m_phaseStep = 0;
+  m_fraction = 0;
+  m_step = 1.0;
+  m_historyFrames = 0;
+  m_passthrough = false;
+  m_outputSize = 0;
+  m_outputPos = 0;
+}
+
+CPolyphaseResampler::~CPolyphaseResampler()
+{
+  DeInitialize();
+}
+
+bool CPolyphaseResampler::Init(unsigned int channels, unsigned int inputRate, unsigned int outputRate, Quality quality)
+{
+  if (!inputRate || !outputRate || (unsigned int)quality > QUALITY_BEST)
+    return false;
+
+  unsigned int divisor = GreatestCommonDivisor(inputRate, outputRate);
+  if (outputRate / divisor <= RESAMPLE_MAX_PHASES)
+  { // output frames land on one of outputRate / divisor positions between input frames
+    m_interpolate = false;
+    m_phases = outputRate / divisor;
+    m_phaseStep = inputRate / divisor;
+  }
+  else
+  {
+    m_interpolate = true;
+    m_phases = presets[quality].phases;
+  }
+  return Setup(channels, (double)outputRate / inputRate, quality);
+}
+
+bool CPolyphaseResampler::InitVariableRatio(unsigned int channels, double ratio, Quality quality)
+{
+  if ((unsigned int)quality > QUALITY_BEST)
+    return false;
+
+  m_interpolate = true;
+  m_phases = presets[quality].phases;
+  return Setup(channels, ratio, quality);
+}
+
+bool CPolyphaseResampler::Setup(unsigned int channels, double ratio, Quality quality)
+{
+  if (!channels || ratio <= 0.0)
+    return false;
+
+  m_channels = channels;
+  m_quality = quality;
+  m_ratio = ratio;
+  m_step = 1.0 / ratio;
+
+  // when downsampling the cutoff drops below the nyquist frequency of the input, so the filter
+  // is lengthened to keep the same transition band relative to it
+  double taps = ceil(presets[quality].taps / min(1.0, ratio));
+  m_taps = min((unsigned int)taps, (unsigned int)RESAMPLE_MAX_TAPS);
+  m_taps = (m_taps + 3) & ~3;
+
+  m_scratch.resize(m_taps);
+  m_history.assign(m_channels, vector<float>());
+  BuildFilter(ratio);
+  Reset();
+
+  CLog::Log(LOGDEBUG, "CPolyphaseResampler::%s - %u channels, ratio %f, %u taps, %u %s phases", __FUNCTION__,
+            m_channels, m_ratio, m_taps, m_phases, m_interpolate ? "interpolated" : "exact");
+  return true;
+}
+
+void CPolyphaseResampler::BuildFilter(double ratio)
+{
+  const SResamplePreset &preset = presets[m_quality];
+  double cutoff = preset.cutoff * min(1.0, ratio);
+  double norm = 1.0 / BesselI0(preset.beta);
+  int half = m_taps / 2;
+
+  // interpolation needs the phase at the next input frame as well
+  unsigned int rows = m_interpolate ? m_phases + 1 : m_phases;
+  m_coeffs.resize(rows * m_taps);
+
+  vector<double> values(m_taps);
+  for (unsigned int row = 0; row < rows; ++row)
+  {
+    // tap k of the window is (half - 1 - k) + fraction input frames before the output frame
+    double fraction = (double)row / m_phases;
+    double sum = 0;
+    for (unsigned int k = 0; k < m_taps; ++k)
+    {
+      double t = (double)k - (half - 1) - fraction;
+      double x = t / half;
+      double window = x * x < 1.0 ? BesselI0(preset.beta * sqrt(1.0 - x * x)) * norm : 0.0;
+      values[k] = cutoff * Sinc(cutoff * t) * window;
+      sum += values[k];
+    }
+
+    // normalize each phase to unity gain, so that there's no ripple at dc
+    float *coeffs = &m_coeffs[row * m_taps];
+    for (unsigned int k = 0; k < m_taps; ++k)
+      coeffs[k] = (float)(values[k] / sum);
+  }
+  m_filterRatio = ratio;
+}
+
+void CPolyphaseResampler::SetRatio(double ratio)
+{
+  if (!m_interpolate || ratio <= 0.0)
+    return;
+
+  m_ratio = ratio;
+  m_step = 1.0 / ratio;
+
+  // only the cutoff depends on the ratio, and then only when downsampling
+  double cutoff = min(1.0, ratio);
+  double filterCutoff = min(1.0, m_filterRatio);
+  if (cutoff < filterCutoff * (1.0 - RESAMPLE_RATIO_SLACK) || cutoff > filterCutoff * (1.0 + RESAMPLE_RATIO_SLACK))
+    BuildFilter(ratio);
+}
+
+void CPolyphaseResampler::Reset()
+{
+  // prime the history so that the first output frame lines up with the first input frame
+  m_historyFrames = m_taps ? m_taps / 2 - 1 : 0;
+  for (unsigned int ch = 0; ch < m_history.size(); ++ch)
+    m_history[ch].assign(m_historyFrames, 0.0f);
+
+  m_position = 0;
+  m_phase = 0;
+  m_fraction = 0;
+}
+
+void CPolyphaseResampler::PutFrames(const float *data, unsigned int frames)
+{
+  if (!m_channels || !frames)
+    return;
+
+  // drop the frames that are no longer within the window
+  if (m_position)
+  {
+    for (unsigned int ch = 0; ch < m_channels; ++ch)
+      m_history[ch].erase(m_history[ch].begin(), m_history[ch].begin() + min(m_position, m_historyFrames));
+    if (m_position > m_historyFrames)
+    {
+      m_position -= m_historyFrames;
+      m_historyFrames = 0;
+    }
+    else
+    {
+      m_historyFrames -= m_position;
+      m_position = 0;
+    }
+  }
+
+  for (unsigned int ch = 0; ch < m_channels; ++ch)
+  {
+    m_history[ch].resize(m_historyFrames + frames);
+    float *out = &m_history[ch][m_historyFrames];
+    const float *in = data + ch;
+    for (unsigned int f = 0; f < frames; ++f, in += m_channels)
+      out[f] = *in;
+  }
+  m_historyFrames += frames;
+}
+
+unsigned int CPolyphaseResampler::GetFrames(float *data, unsigned int frames)
+{
+  if (!m_channels)
+    return 0;
+
+  const CResampleKernels &kernels = GetResampleKernels();
+  unsigned int produced = 0;
+  while (produced < frames && m_position + m_taps <= m_historyFrames)
+  {
+    const float *coeffs;
+    if (m_interpolate)
+    {
+      double phase = m_fraction * m_phases;
+      unsigned int row = (unsigned int)phase;
+      kernels.Lerp(&m_scratch[0], &m_coeffs[row * m_taps], &m_coeffs[(row + 1) * m_taps], (float)(phase - row), m_taps);
+      coeffs = &m_scratch[0];
+    }
+    else
+      coeffs = &m_coeffs[m_phase * m_taps];
+
+    for (unsigned int ch = 0; ch < m_channels; ++ch)
+      *data++ = kernels.Dot(coeffs, &m_history[ch][m_position], m_taps);
+    produced++;
+
+    if (m_interpolate)
+    {
+      m_fraction += m_step;
+      unsigned int whole = (unsigned int)m_fraction;
+      m_position += whole;
+      m_fraction -= whole;
+    }
+    else
+    {
+      m_phase += m_phaseStep;
+      m_position += m_phase / m_phases;
+      m_phase %= m_phases;
+    }
+  }
+  return produced;
+}
+
+unsigned int CPolyphaseResampler::GetInputFramesNeeded(unsigned int frames) const
+{
+  if (!m_channels || !frames)
+    return 0;
+
+  // the window of the last of the output frames must be filled
+  unsigned int last;
+  if (m_interpolate)
+    last = m_position + (unsigned int)(m_fraction + (frames - 1) * m_step);
+  else
+    last = m_position + (unsigned int)((m_phase + (uint64_t)(frames - 1) * m_phaseStep) / m_phases);
+
+  unsigned int needed = last + m_taps;
+  return needed > m_historyFrames ? needed - m_historyFrames : 0;
+}
+
+bool CPolyphaseResampler::InitConverter(int OldFreq, int Channels, int NewFreq, int NewBPS, int OutputBufferSize, Quality quality)
+{
+  DeInitialize();
+
+  // the input is always float, and only 16 bit output is supported
+  if (Channels <= 0 || OldFreq <= 0 || NewFreq <= 0 || NewBPS != 16 || OutputBufferSize <= 0)
+    return false;
+
+  m_outputSize = OutputBufferSize / sizeof(int16_t);
+  m_outputPos = 0;
+  m_output.resize(m_outputSize);
+
+  if (OldFreq == NewFreq)
+  { // nothing to resample, just convert
+    m_passthrough = true;
+    m_channels = Channels;
+    return true;
+  }
+  return Init(Channels, OldFreq, NewFreq, quality);
+}
+
+void CPolyphaseResampler::DeInitialize()
+{
+  m_channels = 0;
+  m_taps = 0;
+  m_phases = 0;
+  m_coeffs.clear();
+  m_scratch.clear();
+  m_history.clear();
+  m_historyFrames = 0;
+  m_position = 0;
+
+  m_passthrough = false;
+  m_outputSize = 0;
+  m_outputPos = 0;
+  m_output.clear();
+  m_converted.clear();
+}
+
+int CPolyphaseResampler::GetInputSamples()
+{
+  // First check whether we have enough space in our output buffer, or whether they
+  // should take data out of it first
+  if (!m_channels || m_outputPos >= m_outputSize)
+    return 0;
+
+  unsigned int frames = (m_outputSize - m_outputPos + m_channels - 1) / m_channels;
+  if (m_passthrough)
+    return frames * m_channels;
+
+  return max(GetInputFramesNeeded(frames), 1u) * m_channels;
+}
+
+int CPolyphaseResampler::PutFloatData(float *pInData, int numSamples)
+{
+  if (!m_channels || m_outputPos >= m_outputSize || numSamples <= 0)
+    return 0;
+
+  unsigned int frames = numSamples / m_channels;
+  int consumed = frames * m_channels;
+  const float *input = pInData;
+  if (!m_passthrough)
+  {
+    PutFrames(pInData, frames);
+
+    unsigned int wanted = (m_outputSize - m_outputPos + m_channels - 1) / m_channels;
+    m_converted.resize(wanted * m_channels);
+    frames = GetFrames(&m_converted[0], wanted);
+    input = &m_converted[0];
+  }
+
+  // convert float -> short with rounding, the last frame may overhang the packet
+  unsigned int samples = frames * m_channels;
+  if (m_output.size() < m_outputPos + samples)
+    m_output.resize(m_outputPos + samples);
+
+  int16_t *output = &m_output[m_outputPos];
+  for (unsigned int i = 0; i < samples; ++i)
+  {
+    int value = MathUtils::round_int(input[i] * 32767.0f);
+    if (value > INT16_MAX)
+      value = INT16_MAX;
+    else if (value < INT16_MIN)
+      value = INT16_MIN;
+    output[i] = value;
+  }
+  m_outputPos += samples;
+
+  return consumed;
+}
+
+bool CPolyphaseResampler::GetData(unsigned char *pOutData)
+{
+  // See if we have data to return
+  if (!m_outputSize || m_outputPos < m_outputSize)
+    return false;
+
+  memcpy(pOutData, &m_output[0], m_outputSize * sizeof(int16_t));
+  // Now move any extra data in our output buffer to the front
+  m_outputPos -= m_outputSize;
+  if (m_outputPos)
+    memmove(&m_output[0], &m_output[m_outputSize], m_outputPos * sizeof(int16_t));
+  return true;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include <vector>
+#include <stdint.h>
+
+/*! \brief Polyphase windowed-sinc sample rate converter
+ Each output frame is the dot product of a window of input frames with one phase of a
+ kaiser-windowed sinc filter.  When the rates have a small common ratio (eg 44.1kHz -> 48kHz
+ has 160 phases) the phases are computed exactly, otherwise (and for variable ratios) the
+ coefficients are interpolated between neighbouring phases of a finer table.  The dot products
+ use SSE2 or NEON where the cpu supports them.
+
+ The quality presets trade the length of the filter (and hence cpu use and latency) against
+ the width of its transition band and the stopband attenuation.
+
+ There are two interfaces - frames in and frames out, as used by CDVDPlayerResampler, and
+ fixed size packets of 16 bit output as used by PAPlayer, which matches that of Cssrc.
+ */
+class CPolyphaseResampler
+{
+public:
+  enum Quality
+  {
+    QUALITY_LOW = 0, ///< 16 taps, ~50dB
+    QUALITY_MEDIUM,  ///< 32 taps, ~70dB
+    QUALITY_HIGH,    ///< 64 taps, ~90dB
+    QUALITY_BEST     ///< 128 taps, ~110dB
+  };
+
+  CPolyphaseResampler();
+  ~CPolyphaseResampler();
+
+  /*! \brief Setup to convert between two fixed rates
+   \param channels number of interleaved channels
+   \param inputRate sample rate of the input
+   \param outputRate sample rate of the output
+   \param quality the quality preset to use
+   \return true if successful, false otherwise.
+   */
+  bool Init(unsigned int channels, unsigned int inputRate, unsigned int outputRate, Quality quality);
+
+  /*! \brief Setup to convert at a ratio that may be changed while converting
+   \param channels number of interleaved channels
+   \param ratio number of output frames per input frame
+   \param quality the quality preset to use
+   \return true if successful, false otherwise.
+   \sa SetRatio
+   */
+  bool InitVariableRatio(unsigned int channels, double ratio, Quality quality);
+
+  /*! \brief Change the ratio of a variable ratio conversion
+   \param ratio number of output frames per input frame
+   */
+  void SetRatio(double ratio);
+
+  /*! \brief Discard any buffered input, eg after a seek
+   */
+  void Reset();
+
+  /*! \brief Add interleaved input frames
+   */
+  void PutFrames(const float *data, unsigned int frames);
+
+  /*! \brief Retrieve interleaved output frames
+   \param data [out] buffer to hold the output
+   \param frames maximum number of frames to retrieve
+   \return the number of frames retrieved, which is less than requested once the input runs out.
+   */
+  unsigned int GetFrames(float *data, unsigned int frames);
+
+  /*! \brief Retrieve the number of further input frames needed to produce some output frames
+   */
+  unsigned int GetInputFramesNeeded(unsigned int frames) const;
+
+  /*! \brief Retrieve the delay of the filter, in input frames
+   */
+  unsigned int GetLatency() const { return m_taps / 2; };
+
+  // packet interface, as Cssrc but for float input, whatever the bits per sample of the source
+  bool InitConverter(int OldFreq, int Channels, int NewFreq, int NewBPS, int OutputBufferSize, Quality quality = QUALITY_MEDIUM);
+  void DeInitialize();
+  int  GetInputSamples();
+  int  PutFloatData(float *pInData, int numSamples);
+  bool GetData(unsigned char *pOutData);
+
+private:
+  bool Setup(unsigned int channels, double ratio, Quality quality);
+  void BuildFilter(double ratio);
+
+  unsigned int m_channels;
+  Quality      m_quality;
+  unsigned int m_taps;         ///< length of each phase, a multiple of 4
+  unsigned int m_phases;       ///< number of phases in the table
+  bool         m_interpolate;  ///< whether coefficients are interpolated between phases
+  double       m_ratio;        ///< output frames per input frame
+  double       m_filterRatio;  ///< ratio the cutoff of the filter was computed for
+  std::vector<float> m_coeffs;  ///< the phases of the filter, m_taps each
+  std::vector<float> m_scratch; ///< interpolated coefficients
+
+  // position of the next output frame, as the start of its window within the history and the phase
+  unsigned int m_position;
+  unsigned int m_phase;        ///< phase (exact phases)
+  unsigned int m_phaseStep;    ///< input frames per output frame, in phases (exact phases)
+  double       m_fraction;     ///< fractional position (interpolated phases)
+  double       m_step;         ///< input frames per output frame (interpolated phases)
+
+  std::vector< std::vector<float> > m_history; ///< planar input, per channel
+  unsigned int m_historyFrames;
+
+  // packet interface
+  bool                 m_passthrough;
+  unsigned int         m_outputSize;   ///< in samples
+  unsigned int         m_outputPos;    ///< in samples
+  std::vector<int16_t> m_output;
+  std::vector<float>   m_converted;
+};
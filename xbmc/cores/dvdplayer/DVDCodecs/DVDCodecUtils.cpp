@@ -23,9 +23,138 @@
 #include "DVDClock.h"
 #include "cores/VideoRenderers/RenderManager.h"
 #include "utils/log.h"
-#include "utils/fastmemcpy.h"
-#include "../Codecs/DllSwScale.h"
-#include "../Codecs/DllAvCodec.h"
+#include "PictureKernels.h"
+#include "SingleLock.h"
+#include <map>
+
+#define PICTURE_BUFFER_ALIGN    16
+#define PICTURE_BUFFER_MAX_FREE 8   // max number of free buffers kept per size
+
+// pool of picture plane buffers, keyed by size, so software decoding
+// doesn't allocate and free a full frame for every converted picture
+class CDVDPictureBufferPool
+{
+public:
+  CDVDPictureBufferPool()
+  {
+    m_generation  = 0;
+    m_allocations = 0;
+    m_reuses      = 0;
+  }
+ ~CDVDPictureBufferPool()
+  {
+    Release();
+  }
+
+  BYTE* Get(int size)
+  {
+    CSingleLock lock(m_section);
+
+    BYTE* data;
+    FreeBuffers::iterator it = m_free.find(size);
+    if (it != m_free.end())
+    {
+      data = it->second;
+      m_free.erase(it);
+      m_reuses++;
+    }
+    else
+    {
+      data = (BYTE*)_aligned_malloc(size, PICTURE_BUFFER_ALIGN);
+      if (!data)
+        return NULL;
+      m_allocations++;
+    }
+    m_used[data] = CBufferInfo(size, m_generation);
+    return data;
+  }
+
+  void Put(BYTE* data)
+  {
+    CSingleLock lock(m_section);
+
+    UsedBuffers::iterator it = m_used.find(data);
+    if (it == m_used.end())
+    {
+      CLog::Log(LOGERROR, "CDVDPictureBufferPool::Put - buffer %p not allocated by the pool", data);
+      return;
+    }
+    CBufferInfo info = it->second;
+    m_used.erase(it);
+
+    // drop buffers handed out before the last release, or if we have plenty
+    if (info.generation != m_generation || m_free.count(info.size) >= PICTURE_BUFFER_MAX_FREE)
+      _aligned_free(data);
+    else
+      m_free.insert(std::make_pair(info.size, data));
+  }
+
+  void Release()
+  {
+    CSingleLock lock(m_section);
+
+    if (m_allocations)
+      CLog::Log(LOGDEBUG, "CDVDPictureBufferPool::Release - %u allocations, %u reused, %u cached, %u in use",
+                m_allocations, m_reuses, (unsigned int)m_free.size(), (unsigned int)m_used.size());
+
+    for (FreeBuffers::iterator it = m_free.begin(); it != m_free.end(); ++it)
+      _aligned_free(it->second);
+    m_free.clear();
+    m_generation++;
+  }
+
+  void GetStats(unsigned int &allocations, unsigned int &reuses, unsigned int &cached)
+  {
+    CSingleLock lock(m_section);
+    allocations = m_allocations;
+    reuses      = m_reuses;
+    cached      = m_free.size();
+  }
+
+private:
+  struct CBufferInfo
+  {
+    CBufferInfo(int s = 0, unsigned int g = 0) : size(s), generation(g) {}
+    int          size;
+    unsigned int generation;
+  };
+  typedef std::multimap<int, BYTE*>   FreeBuffers;
+  typedef std::map<BYTE*, CBufferInfo> UsedBuffers;
+
+  CCriticalSection m_section;
+  FreeBuffers      m_free;
+  UsedBuffers      m_used;
+  unsigned int     m_generation;
+  unsigned int     m_allocations;
+  unsigned int     m_reuses;
+};
+
+static CDVDPictureBufferPool g_pictureBufferPool;
+
+void CDVDCodecUtils::ReleasePictureBuffers()
+{
+  g_pictureBufferPool.Release();
+}
+
+void CDVDCodecUtils::GetPictureBufferStats(unsigned int &allocations, unsigned int &reuses, unsigned int &cached)
+{
+  g_pictureBufferPool.GetStats(allocations, reuses, cached);
+}
+
+void CDVDCodecUtils::InterleaveUV(uint8_t *uv, const uint8_t *u, const uint8_t *v, int width)
+{
+  GetPictureKernels().InterleaveUV(uv, u, v, width);
+}
+
+void CDVDCodecUtils::DeinterleaveUV(uint8_t *u, uint8_t *v, const uint8_t *uv, int width)
+{
+  GetPictureKernels().DeinterleaveUV(u, v, uv, width);
+}
+
+void CDVDCodecUtils::PackYUV422(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool uyvy)
+{
+  GetPictureKernels().Pack422(dst, y, u, v, width, uyvy);
+}
 
 // allocate a new picture (PIX_FMT_YUV420P)
 DVDVideoPicture* CDVDCodecUtils::AllocatePicture(int iWidth, int iHeight)
@@ -40,7 +169,7 @@ DVDVideoPicture* CDVDCodecUtils::AllocatePicture(int iWidth, int iHeight)
     int h = iHeight / 2;
     int size = w * h;
     int totalsize = (iWidth * iHeight) + size * 2;
-    BYTE* data = new BYTE[totalsize];
+    BYTE* data = g_pictureBufferPool.Get(totalsize);
     if (data)
     {
       pPicture->data[0] = data;
@@ -64,100 +193,38 @@ DVDVideoPicture* CDVDCodecUtils::AllocatePicture(int iWidth, int iHeight)
 
 void CDVDCodecUtils::FreePicture(DVDVideoPicture* pPicture)
 {
-  delete[] pPicture->data[0];
+  if (pPicture->data[0])
+    g_pictureBufferPool.Put(pPicture->data[0]);
   delete pPicture;
 }
 
 bool CDVDCodecUtils::CopyPicture(DVDVideoPicture* pDst, DVDVideoPicture* pSrc)
 {
-  BYTE *s, *d;
   int w = pSrc->iWidth;
   int h = pSrc->iHeight;
 
-  s = pSrc->data[0];
-  d = pDst->data[0];
-
-  for (int y = 0; y < h; y++)
-  {
-    fast_memcpy(d, s, w);
-    s += pSrc->iLineSize[0];
-    d += pDst->iLineSize[0];
-  }
+  CopyPlane(pDst->data[0], pDst->iLineSize[0], pSrc->data[0], pSrc->iLineSize[0], w, h);
 
   w >>= 1;
   h >>= 1;
 
-  s = pSrc->data[1];
-  d = pDst->data[1];
-  for (int y = 0; y < h; y++)
-  {
-    fast_memcpy(d, s, w);
-    s += pSrc->iLineSize[1];
-    d += pDst->iLineSize[1];
-  }
-
-  s = pSrc->data[2];
-  d = pDst->data[2];
-  for (int y = 0; y < h; y++)
-  {
-    fast_memcpy(d, s, w);
-    s += pSrc->iLineSize[2];
-    d += pDst->iLineSize[2];
-  }
+  CopyPlane(pDst->data[1], pDst->iLineSize[1], pSrc->data[1], pSrc->iLineSize[1], w, h);
+  CopyPlane(pDst->data[2], pDst->iLineSize[2], pSrc->data[2], pSrc->iLineSize[2], w, h);
   return true;
 }
 
 bool CDVDCodecUtils::CopyPicture(YV12Image* pImage, DVDVideoPicture *pSrc)
 {
-  BYTE *s = pSrc->data[0];
-  BYTE *d = pImage->plane[0];
   int w = pSrc->iWidth;
   int h = pSrc->iHeight;
-  if ((w == pSrc->iLineSize[0]) && ((unsigned int) pSrc->iLineSize[0] == pImage->stride[0]))
-  {
-    fast_memcpy(d, s, w*h);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      fast_memcpy(d, s, w);
-      s += pSrc->iLineSize[0];
-      d += pImage->stride[0];
-    }
-  }
-  s = pSrc->data[1];
-  d = pImage->plane[1];
-  w = pSrc->iWidth >> 1;
-  h = pSrc->iHeight >> 1;
-  if ((w==pSrc->iLineSize[1]) && ((unsigned int) pSrc->iLineSize[1]==pImage->stride[1]))
-  {
-    fast_memcpy(d, s, w*h);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      fast_memcpy(d, s, w);
-      s += pSrc->iLineSize[1];
-      d += pImage->stride[1];
-    }
-  }
-  s = pSrc->data[2];
-  d = pImage->plane[2];
-  if ((w==pSrc->iLineSize[2]) && ((unsigned int) pSrc->iLineSize[2]==pImage->stride[2]))
-  {
-    fast_memcpy(d, s, w*h);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      fast_memcpy(d, s, w);
-      s += pSrc->iLineSize[2];
-      d += pImage->stride[2];
-    }
-  }
+
+  CopyPlane(pImage->plane[0], pImage->stride[0], pSrc->data[0], pSrc->iLineSize[0], w, h);
+
+  w >>= 1;
+  h >>= 1;
+
+  CopyPlane(pImage->plane[1], pImage->stride[1], pSrc->data[1], pSrc->iLineSize[1], w, h);
+  CopyPlane(pImage->plane[2], pImage->stride[2], pSrc->data[2], pSrc->iLineSize[2], w, h);
   return true;
 }
 
@@ -173,7 +240,7 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToNV12Picture(DVDVideoPicture *pSrc)
     int h = pPicture->iHeight / 2;
     int size = w * h;
     int totalsize = (pPicture->iWidth * pPicture->iHeight) + size * 2;
-    BYTE* data = new BYTE[totalsize];
+    BYTE* data = g_pictureBufferPool.Get(totalsize);
     if (data)
     {
       pPicture->data[0] = data;
@@ -187,25 +254,15 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToNV12Picture(DVDVideoPicture *pSrc)
       pPicture->format = DVDVideoPicture::FMT_NV12;
       
       // copy luma
-      uint8_t *s = pSrc->data[0];
-      uint8_t *d = pPicture->data[0];
-      for (int y = 0; y < (int)pSrc->iHeight; y++)
-      {
-        fast_memcpy(d, s, pSrc->iWidth);
-        s += pSrc->iLineSize[0];
-        d += pPicture->iLineSize[0];
-      }
+      CopyPlane(pPicture->data[0], pPicture->iLineSize[0], pSrc->data[0], pSrc->iLineSize[0], pSrc->iWidth, pSrc->iHeight);
 
       //copy chroma
-      uint8_t *s_u, *s_v, *d_uv;
-      for (int y = 0; y < (int)pSrc->iHeight/2; y++) {
-        s_u = pSrc->data[1] + (y * pSrc->iLineSize[1]);
-        s_v = pSrc->data[2] + (y * pSrc->iLineSize[2]);
-        d_uv = pPicture->data[1] + (y * pPicture->iLineSize[1]);
-        for (int x = 0; x < (int)pSrc->iWidth/2; x++) {
-          *d_uv++ = *s_u++;
-          *d_uv++ = *s_v++;
-        }
+      for (int y = 0; y < (int)pSrc->iHeight/2; y++)
+      {
+        InterleaveUV(pPicture->data[1] + (y * pPicture->iLineSize[1]),
+                     pSrc->data[1] + (y * pSrc->iLineSize[1]),
+                     pSrc->data[2] + (y * pSrc->iLineSize[2]),
+                     pSrc->iWidth/2);
       }
       
     }
@@ -227,8 +284,10 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToYUV422PackedPicture(DVDVideoPicture *p
   {
     *pPicture = *pSrc;
 
-    int totalsize = pPicture->iWidth * pPicture->iHeight * 2;
-    BYTE* data = new BYTE[totalsize];
+    // a macropixel holds two luma samples, so odd widths need an extra one
+    int linesize = ((pPicture->iWidth + 1) & ~1) * 2;
+    int totalsize = linesize * pPicture->iHeight;
+    BYTE* data = g_pictureBufferPool.Get(totalsize);
 
     if (data)
     {
@@ -236,40 +295,29 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToYUV422PackedPicture(DVDVideoPicture *p
       pPicture->data[1] = NULL;
       pPicture->data[2] = NULL;
       pPicture->data[3] = NULL;
-      pPicture->iLineSize[0] = pPicture->iWidth * 2;
+      pPicture->iLineSize[0] = linesize;
       pPicture->iLineSize[1] = 0;
       pPicture->iLineSize[2] = 0;
       pPicture->iLineSize[3] = 0;
       pPicture->format = format;
 
-      //if this is going to be used for anything else than testing the renderer
-      //the libraries should not be loaded on every function call
-      DllAvUtil   dllAvUtil;
-      DllAvCodec  dllAvCodec;
-      DllSwScale  dllSwScale;
-      if (!dllAvUtil.Load() || !dllAvCodec.Load() || !dllSwScale.Load())
-      {
-        CLog::Log(LOGERROR,"CDVDCodecUtils::ConvertToYUY2Picture - failed to load rescale libraries!");
-      }
-      else
+      // every chroma row is shared by two luma rows
+      bool uyvy = (format == DVDVideoPicture::FMT_UYVY);
+      int  w    = pSrc->iWidth / 2;
+      for (int y = 0; y < (int)pSrc->iHeight; y++)
       {
-        // Perform the scaling.
-        uint8_t* src[] =       { pSrc->data[0],          pSrc->data[1],      pSrc->data[2],      NULL };
-        int      srcStride[] = { pSrc->iLineSize[0],     pSrc->iLineSize[1], pSrc->iLineSize[2], 0    };
-        uint8_t* dst[] =       { pPicture->data[0],      NULL,               NULL,               NULL };
-        int      dstStride[] = { pPicture->iLineSize[0], 0,                  0,                  0    };
-
-        int dstformat;
-        if (format == DVDVideoPicture::FMT_UYVY)
-          dstformat = PIX_FMT_UYVY422;
-        else
-          dstformat = PIX_FMT_YUYV422;
-
-        struct SwsContext *ctx = dllSwScale.sws_getContext(pSrc->iWidth, pSrc->iHeight, PIX_FMT_YUV420P,
-                                                           pPicture->iWidth, pPicture->iHeight, dstformat,
-                                                           SWS_FAST_BILINEAR, NULL, NULL, NULL);
-        dllSwScale.sws_scale(ctx, src, srcStride, 0, pSrc->iHeight, dst, dstStride);
-        dllSwScale.sws_freeContext(ctx);
+        uint8_t *d    = pPicture->data[0] + (y * pPicture->iLineSize[0]);
+        uint8_t *s_y  = pSrc->data[0] + (y * pSrc->iLineSize[0]);
+        uint8_t *s_u  = pSrc->data[1] + ((y >> 1) * pSrc->iLineSize[1]);
+        uint8_t *s_v  = pSrc->data[2] + ((y >> 1) * pSrc->iLineSize[2]);
+        PackYUV422(d, s_y, s_u, s_v, w, uyvy);
+
+        // the last luma sample of an odd width has its own chroma sample, repeat it to fill the macropixel
+        if (pSrc->iWidth & 1)
+        {
+          uint8_t last[2] = { s_y[2 * w], s_y[2 * w] };
+          PackYUV422(d + 4 * w, last, s_u + w, s_v + w, 1, uyvy);
+        }
       }
     }
     else
@@ -284,69 +332,21 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToYUV422PackedPicture(DVDVideoPicture *p
 
 bool CDVDCodecUtils::CopyNV12Picture(YV12Image* pImage, DVDVideoPicture *pSrc)
 {
-  BYTE *s = pSrc->data[0];
-  BYTE *d = pImage->plane[0];
-  int w = pSrc->iWidth;
-  int h = pSrc->iHeight;
+
   // Copy Y
-  if ((w == pSrc->iLineSize[0]) && ((unsigned int) pSrc->iLineSize[0] == pImage->stride[0]))
-  {
-    fast_memcpy(d, s, w*h);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      fast_memcpy(d, s, w);
-      s += pSrc->iLineSize[0];
-      d += pImage->stride[0];
-    }
-  }
-  
-  s = pSrc->data[1];
-  d = pImage->plane[1];
-  w = pSrc->iWidth;
-  h = pSrc->iHeight >> 1;
+  CopyPlane(pImage->plane[0], pImage->stride[0], pSrc->data[0], pSrc->iLineSize[0], pSrc->iWidth, pSrc->iHeight);
+
   // Copy packed UV (width is same as for Y as it's both U and V components)
-  if ((w==pSrc->iLineSize[1]) && ((unsigned int) pSrc->iLineSize[1]==pImage->stride[1]))
-  {
-    fast_memcpy(d, s, w*h);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      fast_memcpy(d, s, w);
-      s += pSrc->iLineSize[1];
-      d += pImage->stride[1];
-    }
-  }
+  CopyPlane(pImage->plane[1], pImage->stride[1], pSrc->data[1], pSrc->iLineSize[1], pSrc->iWidth, pSrc->iHeight >> 1);
 
   return true;
 }
 
 bool CDVDCodecUtils::CopyYUV422PackedPicture(YV12Image* pImage, DVDVideoPicture *pSrc)
 {
-  BYTE *s = pSrc->data[0];
-  BYTE *d = pImage->plane[0];
-  int w = pSrc->iWidth;
-  int h = pSrc->iHeight;
-
   // Copy YUYV
-  if ((w * 2 == pSrc->iLineSize[0]) && ((unsigned int) pSrc->iLineSize[0] == pImage->stride[0]))
-  {
-    fast_memcpy(d, s, w*h*2);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      fast_memcpy(d, s, w*2);
-      s += pSrc->iLineSize[0];
-      d += pImage->stride[0];
-    }
-  }
-  
+  CopyPlane(pImage->plane[0], pImage->stride[0], pSrc->data[0], pSrc->iLineSize[0], pSrc->iWidth * 2, pSrc->iHeight);
+
   return true;
 }
 
@@ -30,6 +30,11 @@ class CDVDCodecUtils
 public:
   static DVDVideoPicture* AllocatePicture(int iWidth, int iHeight);
   static void FreePicture(DVDVideoPicture* pPicture);
+
+  /* plane buffers of freed pictures are kept for reuse by pictures of the same
+   * size, this drops the cached buffers, and should be called on stream changes */
+  static void ReleasePictureBuffers();
+  static void GetPictureBufferStats(unsigned int &allocations, unsigned int &reuses, unsigned int &cached);
   static bool CopyPicture(DVDVideoPicture* pDst, DVDVideoPicture* pSrc);
   static bool CopyPicture(YV12Image* pDst, DVDVideoPicture *pSrc);
   
@@ -38,6 +43,12 @@ public:
   static bool CopyNV12Picture(YV12Image* pImage, DVDVideoPicture *pSrc);
   static bool CopyYUV422PackedPicture(YV12Image* pImage, DVDVideoPicture *pSrc);
 
+  /* row conversion kernels, using sse2/ssse3/avx2/neon where the cpu supports it,
+   * width is the number of chroma samples in the row */
+  static void InterleaveUV(uint8_t *uv, const uint8_t *u, const uint8_t *v, int width);
+  static void DeinterleaveUV(uint8_t *u, uint8_t *v, const uint8_t *uv, int width);
+  static void PackYUV422(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool uyvy);
+
   static bool IsVP3CompatibleWidth(int width);
 
   static double NormalizeFrameduration(double frameduration);
@@ -0,0 +1,372 @@
+/*
+ *      Copyright (C) 2005-2008 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "PictureKernels.h"
+#include "utils/CPUInfo.h"
+#include <string.h>
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+  #if defined(_MSC_VER)
+    #define KERNEL_TARGET(x)
+    #define HAS_KERNELS_SSE2
+    #define HAS_KERNELS_SSSE3
+    #if _MSC_VER >= 1700
+      #define HAS_KERNELS_AVX2
+    #endif
+  #elif defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+    #define KERNEL_TARGET(x) __attribute__((target(x)))
+    #define HAS_KERNELS_SSE2
+    #define HAS_KERNELS_SSSE3
+    #define HAS_KERNELS_AVX2
+  #elif defined(__SSE2__)
+    #define KERNEL_TARGET(x)
+    #define HAS_KERNELS_SSE2
+  #endif
+#elif defined(__ARM_NEON__)
+  #define HAS_KERNELS_NEON
+#endif
+
+#if defined(HAS_KERNELS_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(HAS_KERNELS_SSSE3)
+#include <tmmintrin.h>
+#endif
+#if defined(HAS_KERNELS_AVX2)
+#include <immintrin.h>
+#endif
+#if defined(HAS_KERNELS_NEON)
+#include <arm_neon.h>
+#endif
+
+static void InterleaveUV_C(uint8_t *uv, const uint8_t *u, const uint8_t *v, int width)
+{
+  for (int x = 0; x < width; x++)
+  {
+    *uv++ = *u++;
+    *uv++ = *v++;
+  }
+}
+
+static void DeinterleaveUV_C(uint8_t *u, uint8_t *v, const uint8_t *uv, int width)
+{
+  for (int x = 0; x < width; x++)
+  {
+    *u++ = *uv++;
+    *v++ = *uv++;
+  }
+}
+
+static void PackYUY2_C(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width)
+{
+  for (int x = 0; x < width; x++)
+  {
+    *dst++ = *y++;
+    *dst++ = *u++;
+    *dst++ = *y++;
+    *dst++ = *v++;
+  }
+}
+
+static void PackUYVY_C(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width)
+{
+  for (int x = 0; x < width; x++)
+  {
+    *dst++ = *u++;
+    *dst++ = *y++;
+    *dst++ = *v++;
+    *dst++ = *y++;
+  }
+}
+
+#if defined(HAS_KERNELS_SSE2)
+KERNEL_TARGET("sse2")
+static void InterleaveUV_SSE2(uint8_t *uv, const uint8_t *u, const uint8_t *v, int width)
+{
+  int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    __m128i mu = _mm_loadu_si128((const __m128i*)(u + x));
+    __m128i mv = _mm_loadu_si128((const __m128i*)(v + x));
+    _mm_storeu_si128((__m128i*)(uv + 2 * x)     , _mm_unpacklo_epi8(mu, mv));
+    _mm_storeu_si128((__m128i*)(uv + 2 * x + 16), _mm_unpackhi_epi8(mu, mv));
+  }
+  InterleaveUV_C(uv + 2 * x, u + x, v + x, width - x);
+}
+
+KERNEL_TARGET("sse2")
+static void DeinterleaveUV_SSE2(uint8_t *u, uint8_t *v, const uint8_t *uv, int width)
+{
+  const __m128i mask = _mm_set1_epi16(0x00ff);
+  int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    __m128i a = _mm_loadu_si128((const __m128i*)(uv + 2 * x));
+    __m128i b = _mm_loadu_si128((const __m128i*)(uv + 2 * x + 16));
+    _mm_storeu_si128((__m128i*)(u + x), _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+    _mm_storeu_si128((__m128i*)(v + x), _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+  }
+  DeinterleaveUV_C(u + x, v + x, uv + 2 * x, width - x);
+}
+
+KERNEL_TARGET("sse2")
+static void Pack422_SSE2(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool uyvy)
+{
+  int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    __m128i y0   = _mm_loadu_si128((const __m128i*)(y + 2 * x));
+    __m128i y1   = _mm_loadu_si128((const __m128i*)(y + 2 * x + 16));
+    __m128i mu   = _mm_loadu_si128((const __m128i*)(u + x));
+    __m128i mv   = _mm_loadu_si128((const __m128i*)(v + x));
+    __m128i uvlo = _mm_unpacklo_epi8(mu, mv);
+    __m128i uvhi = _mm_unpackhi_epi8(mu, mv);
+    __m128i *out = (__m128i*)(dst + 4 * x);
+    if (uyvy)
+    {
+      _mm_storeu_si128(out    , _mm_unpacklo_epi8(uvlo, y0));
+      _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(uvlo, y0));
+      _mm_storeu_si128(out + 2, _mm_unpacklo_epi8(uvhi, y1));
+      _mm_storeu_si128(out + 3, _mm_unpackhi_epi8(uvhi, y1));
+    }
+    else
+    {
+      _mm_storeu_si128(out    , _mm_unpacklo_epi8(y0, uvlo));
+      _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(y0, uvlo));
+      _mm_storeu_si128(out + 2, _mm_unpacklo_epi8(y1, uvhi));
+      _mm_storeu_si128(out + 3, _mm_unpackhi_epi8(y1, uvhi));
+    }
+  }
+  if (uyvy)
+    PackUYVY_C(dst + 4 * x, y + 2 * x, u + x, v + x, width - x);
+  else
+    PackYUY2_C(dst + 4 * x, y + 2 * x, u + x, v + x, width - x);
+}
+#endif
+
+#if defined(HAS_KERNELS_SSSE3)
+KERNEL_TARGET("ssse3")
+static void DeinterleaveUV_SSSE3(uint8_t *u, uint8_t *v, const uint8_t *uv, int width)
+{
+  // gather the even bytes in the low, and the odd bytes in the high half
+  const __m128i shuffle = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+  int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(uv + 2 * x))     , shuffle);
+    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(uv + 2 * x + 16)), shuffle);
+    _mm_storeu_si128((__m128i*)(u + x), _mm_unpacklo_epi64(a, b));
+    _mm_storeu_si128((__m128i*)(v + x), _mm_unpackhi_epi64(a, b));
+  }
+  DeinterleaveUV_C(u + x, v + x, uv + 2 * x, width - x);
+}
+#endif
+
+#if defined(HAS_KERNELS_AVX2)
+// avx2 unpacks work within 128 bit lanes, so the lanes are swapped back in order afterwards
+KERNEL_TARGET("avx2")
+static void InterleaveUV_AVX2(uint8_t *uv, const uint8_t *u, const uint8_t *v, int width)
+{
+  int x = 0;
+  for (; x + 32 <= width; x += 32)
+  {
+    __m256i mu = _mm256_loadu_si256((const __m256i*)(u + x));
+    __m256i mv = _mm256_loadu_si256((const __m256i*)(v + x));
+    __m256i lo = _mm256_unpacklo_epi8(mu, mv);
+    __m256i hi = _mm256_unpackhi_epi8(mu, mv);
+    _mm256_storeu_si256((__m256i*)(uv + 2 * x)     , _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256((__m256i*)(uv + 2 * x + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+  }
+  _mm256_zeroupper();
+  InterleaveUV_SSE2(uv + 2 * x, u + x, v + x, width - x);
+}
+
+KERNEL_TARGET("avx2")
+static void DeinterleaveUV_AVX2(uint8_t *u, uint8_t *v, const uint8_t *uv, int width)
+{
+  const __m256i mask = _mm256_set1_epi16(0x00ff);
+  int x = 0;
+  for (; x + 32 <= width; x += 32)
+  {
+    __m256i a  = _mm256_loadu_si256((const __m256i*)(uv + 2 * x));
+    __m256i b  = _mm256_loadu_si256((const __m256i*)(uv + 2 * x + 32));
+    __m256i mu = _mm256_packus_epi16(_mm256_and_si256(a, mask), _mm256_and_si256(b, mask));
+    __m256i mv = _mm256_packus_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+    _mm256_storeu_si256((__m256i*)(u + x), _mm256_permute4x64_epi64(mu, 0xd8));
+    _mm256_storeu_si256((__m256i*)(v + x), _mm256_permute4x64_epi64(mv, 0xd8));
+  }
+  _mm256_zeroupper();
+  DeinterleaveUV_SSE2(u + x, v + x, uv + 2 * x, width - x);
+}
+
+KERNEL_TARGET("avx2")
+static void Pack422_AVX2(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool uyvy)
+{
+  int x = 0;
+  for (; x + 32 <= width; x += 32)
+  {
+    __m256i mu   = _mm256_loadu_si256((const __m256i*)(u + x));
+    __m256i mv   = _mm256_loadu_si256((const __m256i*)(v + x));
+    __m256i uvlo = _mm256_unpacklo_epi8(mu, mv);
+    __m256i uvhi = _mm256_unpackhi_epi8(mu, mv);
+    __m256i uv[2];
+    uv[0] = _mm256_permute2x128_si256(uvlo, uvhi, 0x20);
+    uv[1] = _mm256_permute2x128_si256(uvlo, uvhi, 0x31);
+    for (int i = 0; i < 2; i++)
+    {
+      __m256i my = _mm256_loadu_si256((const __m256i*)(y + 2 * x + 32 * i));
+      __m256i lo, hi;
+      if (uyvy)
+      {
+        lo = _mm256_unpacklo_epi8(uv[i], my);
+        hi = _mm256_unpackhi_epi8(uv[i], my);
+      }
+      else
+      {
+        lo = _mm256_unpacklo_epi8(my, uv[i]);
+        hi = _mm256_unpackhi_epi8(my, uv[i]);
+      }
+      __m256i *out = (__m256i*)(dst + 4 * x + 64 * i);
+      _mm256_storeu_si256(out    , _mm256_permute2x128_si256(lo, hi, 0x20));
+      _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+  }
+  _mm256_zeroupper();
+  Pack422_SSE2(dst + 4 * x, y + 2 * x, u + x, v + x, width - x, uyvy);
+}
+#endif
+
+#if defined(HAS_KERNELS_NEON)
+static void InterleaveUV_NEON(uint8_t *uv, const uint8_t *u, const uint8_t *v, int width)
+{
+  int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    uint8x16x2_t muv;
+    muv.val[0] = vld1q_u8(u + x);
+    muv.val[1] = vld1q_u8(v + x);
+    vst2q_u8(uv + 2 * x, muv);
+  }
+  InterleaveUV_C(uv + 2 * x, u + x, v + x, width - x);
+}
+
+static void DeinterleaveUV_NEON(uint8_t *u, uint8_t *v, const uint8_t *uv, int width)
+{
+  int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    uint8x16x2_t muv = vld2q_u8(uv + 2 * x);
+    vst1q_u8(u + x, muv.val[0]);
+    vst1q_u8(v + x, muv.val[1]);
+  }
+  DeinterleaveUV_C(u + x, v + x, uv + 2 * x, width - x);
+}
+
+static void Pack422_NEON(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool uyvy)
+{
+  int x = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    uint8x8x2_t my = vld2_u8(y + 2 * x); // even and odd luma samples
+    uint8x8_t   mu = vld1_u8(u + x);
+    uint8x8_t   mv = vld1_u8(v + x);
+    uint8x8x4_t out;
+    if (uyvy)
+    {
+      out.val[0] = mu; out.val[1] = my.val[0]; out.val[2] = mv; out.val[3] = my.val[1];
+    }
+    else
+    {
+      out.val[0] = my.val[0]; out.val[1] = mu; out.val[2] = my.val[1]; out.val[3] = mv;
+    }
+    vst4_u8(dst + 4 * x, out);
+  }
+  if (uyvy)
+    PackUYVY_C(dst + 4 * x, y + 2 * x, u + x, v + x, width - x);
+  else
+    PackYUY2_C(dst + 4 * x, y + 2 * x, u + x, v + x, width - x);
+}
+#endif
+
+static void Pack422_C(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool uyvy)
+{
+  if (uyvy)
+    PackUYVY_C(dst, y, u, v, width);
+  else
+    PackYUY2_C(dst, y, u, v, width);
+}
+
+CPictureKernels::CPictureKernels(int features)
+{
+  InterleaveUV   = InterleaveUV_C;
+  DeinterleaveUV = DeinterleaveUV_C;
+  Pack422        = Pack422_C;
+
+#if defined(HAS_KERNELS_SSE2)
+  if (features & CPU_FEATURE_SSE2)
+  {
+    InterleaveUV   = InterleaveUV_SSE2;
+    DeinterleaveUV = DeinterleaveUV_SSE2;
+    Pack422        = Pack422_SSE2;
+  }
+#endif
+#if defined(HAS_KERNELS_SSSE3)
+  if (features & CPU_FEATURE_SSSE3)
+    DeinterleaveUV = DeinterleaveUV_SSSE3;
+#endif
+#if defined(HAS_KERNELS_AVX2)
+  if (features & CPU_FEATURE_AVX2)
+  {
+    InterleaveUV   = InterleaveUV_AVX2;
+    DeinterleaveUV = DeinterleaveUV_AVX2;
+    Pack422        = Pack422_AVX2;
+  }
+#endif
+#if defined(HAS_KERNELS_NEON)
+  if (features & CPU_FEATURE_NEON)
+  {
+    InterleaveUV   = InterleaveUV_NEON;
+    DeinterleaveUV = DeinterleaveUV_NEON;
+    Pack422        = Pack422_NEON;
+  }
+#endif
+}
+
+void CopyPlane(uint8_t *dst, int dstStride, const uint8_t *src, int srcStride, int width, int height)
+{
+  if (width == srcStride && width == dstStride)
+  {
+    memcpy(dst, src, width * height);
+    return;
+  }
+  for (int y = 0; y < height; y++)
+  {
+    memcpy(dst, src, width);
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+const CPictureKernels& GetPictureKernels()
+{
+  static CPictureKernels kernels(g_cpuInfo.GetCPUFeatures());
+  return kernels;
+}
@@ -0,0 +1,44 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2008 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include <stdint.h>
+
+/* row kernels for the picture conversions of CDVDCodecUtils, using sse2/ssse3/
+ * avx2/neon where the cpu supports it. the widths are in chroma samples, so a
+ * row holds 2 * width luma samples */
+struct CPictureKernels
+{
+  /* picks the kernels for the given CPU_FEATURE_* flags */
+  CPictureKernels(int features);
+
+  void (*InterleaveUV)(uint8_t *uv, const uint8_t *u, const uint8_t *v, int width);
+  void (*DeinterleaveUV)(uint8_t *u, uint8_t *v, const uint8_t *uv, int width);
+  void (*Pack422)(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool uyvy);
+};
+
+/* the kernels for this cpu */
+const CPictureKernels& GetPictureKernels();
+
+/* copies height rows of width bytes, in one go where neither side is padded. this
+ * is plain memcpy, which the c library already vectorizes for the cpu, and which is
+ * faster than fast_memcpy() (see tools/Benchmarks/PictureBenchmark) */
+void CopyPlane(uint8_t *dst, int dstStride, const uint8_t *src, int srcStride, int width, int height);
@@ -38,6 +38,7 @@
 #include "utils/log.h"
 #include "utils/fastmemcpy.h"
 #include "Codecs/DllSwScale.h"
+#include "DVDCodecs/DVDCodecUtils.h"
 #include "utils/TimeUtils.h"
 
 namespace BCM
@@ -635,18 +636,11 @@ void CMPCOutputThread::CopyOutAsYV12(CPictureBuffer *pBuffer, BCM::BC_DTS_PROC_O
   }
   //copy chroma
   //copy uv packed to u,v planes (1/2 the width and 1/2 the height of y)
-  uint8_t *s_uv;
+  uint8_t *s_uv = procOut->UVbuff;
   uint8_t *d_u = pBuffer->m_u_buffer_ptr;
   uint8_t *d_v = pBuffer->m_v_buffer_ptr;
-  for (int y = 0; y < h/2; y++)
-  {
-    s_uv = procOut->UVbuff + (y * stride);
-    for (int x = 0; x < w/2; x++)
-    {
-      *d_u++ = *s_uv++;
-      *d_v++ = *s_uv++;
-    }
-  }
+  for (int y = 0; y < h/2; y++, s_uv += stride, d_u += w/2, d_v += w/2)
+    CDVDCodecUtils::DeinterleaveUV(d_u, d_v, s_uv, w/2);
 }
 
 void CMPCOutputThread::CopyOutAsYV12DeInterlace(CPictureBuffer *pBuffer, BCM::BC_DTS_PROC_OUT *procOut, int w, int h, int stride)
@@ -663,23 +657,18 @@ void CMPCOutputThread::CopyOutAsYV12DeInterlace(CPictureBuffer *pBuffer, BCM::BC
   }
   //copy chroma
   //copy uv packed to u,v planes (1/2 the width and 1/2 the height of y)
-  uint8_t *s_uv;
+  uint8_t *s_uv = procOut->UVbuff;
   uint8_t *d_u = pBuffer->m_u_buffer_ptr;
   uint8_t *d_v = pBuffer->m_v_buffer_ptr;
-  for (int y = 0; y < h/4; y++)
+  for (int y = 0; y < h/4; y++, s_uv += stride)
   {
-    s_uv = procOut->UVbuff + (y * stride);
-    for (int x = 0; x < w/2; x++)
-    {
-      *d_u++ = *s_uv++;
-      *d_v++ = *s_uv++;
-    }
-    s_uv = procOut->UVbuff + (y * stride);
-    for (int x = 0; x < w/2; x++)
-    {
-      *d_u++ = *s_uv++;
-      *d_v++ = *s_uv++;
-    }
+    CDVDCodecUtils::DeinterleaveUV(d_u, d_v, s_uv, w/2);
+    d_u += w/2;
+    d_v += w/2;
+    fast_memcpy(d_u, d_u - w/2, w/2);
+    fast_memcpy(d_v, d_v - w/2, w/2);
+    d_u += w/2;
+    d_v += w/2;
   }
 
   pBuffer->m_interlace = false;
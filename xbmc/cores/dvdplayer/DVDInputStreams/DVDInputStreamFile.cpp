@@ -22,13 +22,98 @@
 #include "DVDInputStreamFile.h"
 #include "FileItem.h"
 #include "FileSystem/File.h"
+#include "FileSystem/SpecialProtocol.h"
+#include "AdvancedSettings.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+#ifdef _LINUX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <sys/sysmacros.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#endif
+
+// size of the window of a local file that is mapped at a time, so that large files
+// don't exhaust the address space of 32bit systems
+#define MAP_WINDOW_SIZE (64 * 1024 * 1024)
+// amount of data the kernel is asked to read ahead of the read position
+#define MAP_READ_AHEAD  (4 * 1024 * 1024)
+
+// files modified this recently (in seconds) may still be growing, eg recordings, so aren't mapped
+#define MAP_MIN_AGE     60
 
 using namespace XFILE;
 
+#ifdef _LINUX
+/*! \brief Whether a file is on a local disk filesystem.
+ A page of a mapped file that can't be read raises SIGBUS, which kills the process, where read()
+ would just fail with EIO, so network and fuse mounts are read instead.
+ */
+static bool IsLocalFileSystem(int fd)
+{
+  struct statfs fs;
+  if (fstatfs(fd, &fs) != 0)
+    return false;
+  switch ((unsigned long)fs.f_type)
+  {
+  case 0xEF53:     // ext2/3/4
+  case 0x58465342: // xfs
+  case 0x3153464A: // jfs
+  case 0x52654973: // reiserfs
+    return true;
+  default:
+    return false;
+  }
+}
+
+/*! \brief Whether the block device holding a file may go away while it's in use, eg a usb drive or a memory card.
+ Devices that can't be identified count as removable.
+ */
+static bool IsRemovableDevice(dev_t device)
+{
+  char sysPath[64];
+  snprintf(sysPath, sizeof(sysPath), "/sys/dev/block/%u:%u", major(device), minor(device));
+  char *real = realpath(sysPath, NULL);
+  if (!real)
+    return true;
+  CStdString path(real);
+  free(real);
+  if (path.Find("/usb") >= 0 || path.Find("/mmc") >= 0)
+    return true;
+
+  // partitions don't have the attribute, the disk they're on does
+  FILE *file = fopen((path + "/removable").c_str(), "r");
+  if (!file)
+    file = fopen((path + "/../removable").c_str(), "r");
+  if (!file)
+    return true;
+  int removable = 1;
+  if (fscanf(file, "%d", &removable) != 1)
+    removable = 1;
+  fclose(file);
+  return removable != 0;
+}
+#endif
+
 CDVDInputStreamFile::CDVDInputStreamFile() : CDVDInputStream(DVDSTREAM_TYPE_FILE)
 {
   m_pFile = NULL;
   m_eof = true;
+  m_mapFile = -1;
+  m_mapData = NULL;
+  m_mapOffset = 0;
+  m_mapSize = 0;
+  m_mapPosition = 0;
+  m_mapLength = 0;
+  m_readAhead = 0;
 }
 
 CDVDInputStreamFile::~CDVDInputStreamFile()
@@ -66,13 +151,107 @@ bool CDVDInputStreamFile::Open(const char* strFile, const std::string& content)
   if (m_pFile->GetImplemenation() && (content.empty() || content == "application/octet-stream"))
     m_content = m_pFile->GetImplemenation()->GetContent();
 
+  if (g_advancedSettings.m_memoryMapFiles)
+    OpenMapping(CSpecialProtocol::TranslatePath(strFile));
+
   m_eof = true;
   return true;
 }
 
+bool CDVDInputStreamFile::OpenMapping(const CStdString &path)
+{
+#ifdef _LINUX
+  // only plain files on local, fixed disks can be mapped, as a mapped file that is truncated or whose
+  // device goes away raises SIGBUS rather than a read error
+  if (path.Left(1) != "/")
+    return false;
+
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat buffer;
+  if (fstat(fd, &buffer) != 0 || !S_ISREG(buffer.st_mode) || buffer.st_size <= 0 ||
+      time(NULL) - buffer.st_mtime < MAP_MIN_AGE ||
+      !IsLocalFileSystem(fd) || IsRemovableDevice(buffer.st_dev))
+  {
+    close(fd);
+    return false;
+  }
+
+  m_mapFile = fd;
+  m_mapLength = buffer.st_size;
+  m_mapPosition = 0;
+  if (!MapWindow(0))
+  {
+    CLog::Log(LOGDEBUG, "%s - unable to map %s, reading it instead", __FUNCTION__, path.c_str());
+    CloseMapping();
+    return false;
+  }
+  m_stats.Start();
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CDVDInputStreamFile::CloseMapping()
+{
+#ifdef _LINUX
+  if (m_mapData)
+    munmap(m_mapData, (size_t)m_mapSize);
+  if (m_mapFile >= 0)
+    close(m_mapFile);
+#endif
+  m_mapFile = -1;
+  m_mapData = NULL;
+  m_mapOffset = 0;
+  m_mapSize = 0;
+  m_mapPosition = 0;
+  m_mapLength = 0;
+  m_readAhead = 0;
+}
+
+bool CDVDInputStreamFile::MapWindow(__int64 position)
+{
+#ifdef _LINUX
+  if (m_mapData && position >= m_mapOffset && position < m_mapOffset + m_mapSize)
+    return true;
+
+  if (m_mapData)
+    munmap(m_mapData, (size_t)m_mapSize);
+  m_mapData = NULL;
+  m_mapSize = 0;
+
+  if (position >= m_mapLength)
+    return false;
+
+  // mappings have to start on a page boundary
+  static const __int64 pageSize = sysconf(_SC_PAGESIZE);
+  __int64 offset = position - position % pageSize;
+  __int64 size = std::min((__int64)MAP_WINDOW_SIZE, m_mapLength - offset);
+  void *data = mmap(NULL, (size_t)size, PROT_READ, MAP_SHARED, m_mapFile, (off_t)offset);
+  if (data == MAP_FAILED)
+  {
+    CLog::Log(LOGERROR, "%s - mmap failed: %s", __FUNCTION__, strerror(errno));
+    return false;
+  }
+  madvise(data, (size_t)size, MADV_SEQUENTIAL);
+
+  m_mapData = (BYTE *)data;
+  m_mapOffset = offset;
+  m_mapSize = size;
+  m_readAhead = position;
+  return true;
+#else
+  return false;
+#endif
+}
+
 // close file and reset everyting
 void CDVDInputStreamFile::Close()
 {
+  CloseMapping();
   if (m_pFile)
   {
     m_pFile->Close();
@@ -88,6 +267,44 @@ int CDVDInputStreamFile::Read(BYTE* buf, int buf_size)
 {
   if(!m_pFile) return -1;
 
+  if (m_mapFile >= 0)
+  {
+#ifdef _LINUX
+    if (m_mapPosition + buf_size > m_mapLength)
+    { // the file may still be growing, eg while it's recorded
+      struct stat buffer;
+      if (fstat(m_mapFile, &buffer) == 0 && buffer.st_size > m_mapLength)
+        m_mapLength = buffer.st_size;
+    }
+#endif
+    int read = 0;
+    while (read < buf_size && MapWindow(m_mapPosition))
+    {
+      __int64 offset = m_mapPosition - m_mapOffset;
+      int size = (int)std::min((__int64)(buf_size - read), m_mapSize - offset);
+      memcpy(buf + read, m_mapData + offset, size);
+      read += size;
+      m_mapPosition += size;
+    }
+
+#ifdef _LINUX
+    // keep the kernel reading ahead of us, so that we don't block on page faults
+    if (m_mapData && m_mapPosition + MAP_READ_AHEAD / 2 > m_readAhead)
+    {
+      __int64 start = std::max(m_readAhead, m_mapPosition) - m_mapOffset;
+      start -= start % sysconf(_SC_PAGESIZE);
+      __int64 end = std::min(m_mapPosition + MAP_READ_AHEAD - m_mapOffset, m_mapSize);
+      if (end > start)
+        madvise(m_mapData + start, (size_t)(end - start), MADV_WILLNEED);
+      m_readAhead = m_mapOffset + end;
+    }
+#endif
+
+    if (read <= 0) m_eof = true;
+    m_stats.AddSampleBytes(read);
+    return read;
+  }
+
   unsigned int ret = m_pFile->Read(buf, buf_size);
 
   /* we currently don't support non completing reads */
@@ -99,6 +316,32 @@ int CDVDInputStreamFile::Read(BYTE* buf, int buf_size)
 __int64 CDVDInputStreamFile::Seek(__int64 offset, int whence)
 {
   if(!m_pFile) return -1;
+
+  if (m_mapFile >= 0)
+  {
+    __int64 position;
+    switch (whence)
+    {
+    case SEEK_POSSIBLE:
+      return 1;
+    case SEEK_SET:
+      position = offset;
+      break;
+    case SEEK_CUR:
+      position = m_mapPosition + offset;
+      break;
+    case SEEK_END:
+      position = m_mapLength + offset;
+      break;
+    default:
+      return -1;
+    }
+    if (position < 0)
+      return -1;
+    m_mapPosition = position;
+    m_eof = false;
+    return position;
+  }
   __int64 ret = m_pFile->Seek(offset, whence);
 
   /* if we succeed, we are not eof anymore */
@@ -109,6 +352,8 @@ __int64 CDVDInputStreamFile::Seek(__int64 offset, int whence)
 
 __int64 CDVDInputStreamFile::GetLength()
 {
+  if (m_mapFile >= 0)
+    return m_mapLength;
   if (m_pFile)
     return m_pFile->GetLength();
   return 0;
@@ -116,8 +361,8 @@ __int64 CDVDInputStreamFile::GetLength()
 
 BitstreamStats CDVDInputStreamFile::GetBitstreamStats() const
 {
-  if (!m_pFile)
-    return m_stats; // dummy return. defined in CDVDInputStream
+  if (!m_pFile || m_mapFile >= 0)
+    return m_stats; // dummy return, or the stats of the mapped file. defined in CDVDInputStream
 
   if(m_pFile->GetBitstreamStats())
     return *m_pFile->GetBitstreamStats();
@@ -127,7 +372,9 @@ BitstreamStats CDVDInputStreamFile::GetBitstreamStats() const
 
 int CDVDInputStreamFile::GetBlockSize()
 {
-  if(m_pFile)
+  if(m_mapFile >= 0)
+    return 0; // reads of any size are served from the mapping
+  else if(m_pFile)
     return m_pFile->GetChunkSize();
   else
     return 0;
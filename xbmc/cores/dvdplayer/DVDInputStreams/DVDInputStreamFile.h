@@ -38,6 +38,27 @@ public:
   virtual BitstreamStats GetBitstreamStats() const ;
   virtual int GetBlockSize();
 protected:
+  /*! \brief Map a local file into memory, so that it's read without read() calls or intermediate buffers
+   \param path the local path of the file
+   \return true if the file was mapped, false if it's to be read through m_pFile.
+   */
+  bool OpenMapping(const CStdString &path);
+  void CloseMapping();
+
+  /*! \brief Map the window of the file holding the given position
+   \param position the position within the file
+   \return true if the position is within the mapped window, false otherwise.
+   */
+  bool MapWindow(__int64 position);
+
   XFILE::CFile* m_pFile;
   bool m_eof;
+
+  int     m_mapFile;     ///< descriptor of the mapped file, -1 if the file isn't mapped
+  BYTE*   m_mapData;     ///< window of the file that is currently mapped
+  __int64 m_mapOffset;   ///< offset of the mapped window within the file
+  __int64 m_mapSize;     ///< size of the mapped window
+  __int64 m_mapPosition; ///< read position within the mapped file
+  __int64 m_mapLength;   ///< length of the mapped file
+  __int64 m_readAhead;   ///< position up to which the kernel has been asked to read ahead
 };
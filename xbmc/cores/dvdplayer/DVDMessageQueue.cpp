@@ -25,6 +25,7 @@
 #include "SingleLock.h"
 #include "DVDClock.h"
 #include "MathUtils.h"
+#include "utils/Atomics.h"
 
 using namespace std;
 
@@ -39,8 +40,17 @@ CDVDMessageQueue::CDVDMessageQueue(const string &owner)
 
   m_TimeBack      = DVD_NOPTS_VALUE;
   m_TimeFront     = DVD_NOPTS_VALUE;
+  m_TimeFrontSequence = 0;
   m_TimeSize      = 1.0 / 4.0; /* 4 seconds */
   m_hEvent = CreateEvent(NULL, true, false, NULL);
+
+  m_ring      = NULL;
+  m_ringSize  = 0;
+  m_ringWrite = 0;
+  m_ringRead  = 0;
+  m_ringDataSize = 0;
+  m_iSequence = 0;
+  m_iWaiting  = 0;
 }
 
 CDVDMessageQueue::~CDVDMessageQueue()
@@ -48,15 +58,42 @@ CDVDMessageQueue::~CDVDMessageQueue()
   // remove all remaining messages
   Flush();
 
+  delete[] m_ring;
   CloseHandle(m_hEvent);
 }
 
+void CDVDMessageQueue::SetLockFreeSize(unsigned int packets)
+{
+  CSingleLock lock(m_section);
+
+  Flush(CDVDMsg::DEMUXER_PACKET);
+  delete[] m_ring;
+  m_ring      = NULL;
+  m_ringSize  = 0;
+  m_ringWrite = 0;
+  m_ringRead  = 0;
+
+#ifndef HAS_ATOMICS
+  packets = 0;
+#endif
+  if (packets == 0)
+    return;
+
+  // round up to a power of two, so the indices can simply wrap
+  m_ringSize = 1;
+  while (m_ringSize < packets)
+    m_ringSize <<= 1;
+  m_ring = new DVDMessageRingItem[m_ringSize];
+}
+
 void CDVDMessageQueue::Init()
 {
-  m_iDataSize     = 0;
   m_bAbortRequest = false;
   m_bEmptied      = true;
   m_bInitialized  = true;
+
+  CSingleLock lock(m_dataSection);
+  m_iDataSize     = 0;
   m_TimeBack      = DVD_NOPTS_VALUE;
   m_TimeFront     = DVD_NOPTS_VALUE;
 }
@@ -75,10 +112,19 @@ void CDVDMessageQueue::Flush(CDVDMsg::Message type)
 
   if (type == CDVDMsg::DEMUXER_PACKET ||  type == CDVDMsg::NONE)
   {
+    // we hold the consumer side of the ring
+    while (RingReady())
+    {
+      m_ring[m_ringRead & (m_ringSize - 1)].message->Release();
+      ReleaseRingItem();
+    }
+
+    m_bEmptied = true;
+
+    CSingleLock dataLock(m_dataSection);
     m_iDataSize = 0;
     m_TimeBack  = DVD_NOPTS_VALUE;
     m_TimeFront = DVD_NOPTS_VALUE;
-    m_bEmptied = true;
   }
 }
 
@@ -98,13 +144,16 @@ void CDVDMessageQueue::End()
   Flush();
 
   m_bInitialized  = false;
-  m_iDataSize     = 0;
   m_bAbortRequest = false;
 }
 
 
 MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority)
 {
+  if (pMsg && priority == 0 && m_ring && m_bInitialized
+  && pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && PutRing(pMsg))
+    return MSGQ_OK;
+
   CSingleLock lock(m_section);
 
   if (!m_bInitialized)
@@ -126,21 +175,14 @@ MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority)
       break;
     it++;
   }
-  m_list.insert(it, DVDMessageListItem(pMsg, priority));
+  it = m_list.insert(it, DVDMessageListItem(pMsg, priority));
+  it->sequence = AtomicIncrement(&m_iSequence);
 
   if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && priority == 0)
   {
     DemuxPacket* packet = ((CDVDMsgDemuxerPacket*)pMsg)->GetPacket();
     if(packet)
-    {
-      m_iDataSize += packet->iSize;
-      if     (packet->dts != DVD_NOPTS_VALUE)
-        m_TimeFront = packet->dts;
-      else if(packet->pts != DVD_NOPTS_VALUE)
-        m_TimeFront = packet->pts;
-      if(m_TimeBack == DVD_NOPTS_VALUE)
-        m_TimeBack = m_TimeFront;
-    }
+      AddPacket(packet, it->sequence);
   }
 
   pMsg->Release();
@@ -150,6 +192,125 @@ MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority)
   return MSGQ_OK;
 }
 
+bool CDVDMessageQueue::PutRing(CDVDMsg* pMsg)
+{
+  long write = m_ringWrite;
+  if ((unsigned long)(write - m_ringRead) >= m_ringSize)
+    return false; // full, fall back to the locked list
+
+  // the ring item takes over the reference of the caller
+  DVDMessageRingItem& item = m_ring[write & (m_ringSize - 1)];
+  item.message  = pMsg;
+  item.sequence = AtomicIncrement(&m_iSequence);
+  item.size     = 0;
+  item.time     = DVD_NOPTS_VALUE;
+
+  DemuxPacket* packet = ((CDVDMsgDemuxerPacket*)pMsg)->GetPacket();
+  if(packet)
+  {
+    item.size = packet->iSize;
+    if     (packet->dts != DVD_NOPTS_VALUE)
+      item.time = packet->dts;
+    else if(packet->pts != DVD_NOPTS_VALUE)
+      item.time = packet->pts;
+    AtomicAdd(&m_ringDataSize, item.size);
+  }
+
+  // publish the item, then only signal the consumer when it's actually waiting
+  AtomicIncrement(&m_ringWrite);
+  if (m_iWaiting)
+    SetEvent(m_hEvent);
+
+  return true;
+}
+
+void CDVDMessageQueue::AddPacket(DemuxPacket* packet, long sequence)
+{
+  CSingleLock lock(m_dataSection);
+  m_iDataSize += packet->iSize;
+  if     (packet->dts != DVD_NOPTS_VALUE)
+    m_TimeFront = packet->dts;
+  else if(packet->pts != DVD_NOPTS_VALUE)
+    m_TimeFront = packet->pts;
+  m_TimeFrontSequence = sequence;
+  if(m_TimeBack == DVD_NOPTS_VALUE)
+    m_TimeBack = m_TimeFront;
+}
+
+void CDVDMessageQueue::RemovePacket(DemuxPacket* packet)
+{
+  CSingleLock lock(m_dataSection);
+  m_iDataSize -= packet->iSize;
+  if     (packet->dts != DVD_NOPTS_VALUE)
+    m_TimeBack = packet->dts;
+  else if(packet->pts != DVD_NOPTS_VALUE)
+    m_TimeBack = packet->pts;
+}
+
+void CDVDMessageQueue::ReleaseRingItem()
+{
+  // the item is only handed back to the producer with m_dataSection held, so
+  // GetLevel() can look at the queued ring items while it holds that
+  CSingleLock lock(m_dataSection);
+  const DVDMessageRingItem& item = m_ring[m_ringRead & (m_ringSize - 1)];
+  AtomicSubtract(&m_ringDataSize, item.size);
+  if(item.time != DVD_NOPTS_VALUE)
+  {
+    m_TimeBack = item.time;
+    if(item.sequence - m_TimeFrontSequence > 0)
+    {
+      m_TimeFront         = item.time;
+      m_TimeFrontSequence = item.sequence;
+    }
+  }
+  AtomicIncrement(&m_ringRead);
+}
+
+bool CDVDMessageQueue::TakeMessage(CDVDMsg** pMsg, int &priority)
+{
+  // data packets in the ring all have priority 0, and are
+  // ordered against the list using their sequence numbers
+  DVDMessageRingItem* ring = NULL;
+  if (priority <= 0 && RingReady())
+    ring = &m_ring[m_ringRead & (m_ringSize - 1)];
+
+  if(!m_list.empty() && m_list.back().priority >= priority
+  && (!ring || m_list.back().priority > 0 || m_list.back().sequence - ring->sequence < 0))
+  {
+    DVDMessageListItem& item(m_list.back());
+    priority = item.priority;
+
+    if (item.message->IsType(CDVDMsg::DEMUXER_PACKET) && item.priority == 0)
+    {
+      DemuxPacket* packet = ((CDVDMsgDemuxerPacket*)item.message)->GetPacket();
+      if(packet)
+        RemovePacket(packet);
+
+      if(m_bEmptied && GetDataSize() > 0)
+        m_bEmptied = false;
+    }
+
+    *pMsg = item.message->Acquire();
+    m_list.pop_back();
+    return true;
+  }
+
+  if (ring)
+  {
+    priority = 0;
+
+    // hand the ring's reference over to the caller
+    *pMsg = ring->message;
+    ReleaseRingItem();
+
+    if(m_bEmptied && GetDataSize() > 0)
+      m_bEmptied = false;
+
+    return true;
+  }
+  return false;
+}
+
 MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutInMilliSeconds, int &priority)
 {
   CSingleLock lock(m_section);
@@ -164,7 +325,7 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
     return MSGQ_NOT_INITIALIZED;
   }
 
-  if(m_list.empty() && m_bEmptied == false && priority == 0 && m_owner != "teletext")
+  if(m_list.empty() && !RingReady() && m_bEmptied == false && priority == 0 && m_owner != "teletext")
   {
     CLog::Log(LOGWARNING, "CDVDMessageQueue(%s)::Get - asked for new data packet, with nothing available", m_owner.c_str());
     m_bEmptied = true;
@@ -172,30 +333,8 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
 
   while (!m_bAbortRequest)
   {
-    if(!m_list.empty() && m_list.back().priority >= priority && !m_bCaching)
+    if(!m_bCaching && TakeMessage(pMsg, priority))
     {
-      DVDMessageListItem& item(m_list.back());
-      priority = item.priority;
-
-      if (item.message->IsType(CDVDMsg::DEMUXER_PACKET) && item.priority == 0)
-      {
-        DemuxPacket* packet = ((CDVDMsgDemuxerPacket*)item.message)->GetPacket();
-        if(packet)
-        {
-          m_iDataSize -= packet->iSize;
-          if     (packet->dts != DVD_NOPTS_VALUE)
-            m_TimeBack = packet->dts;
-          else if(packet->pts != DVD_NOPTS_VALUE)
-            m_TimeBack = packet->pts;
-        }
-
-        if(m_bEmptied && m_iDataSize > 0)
-          m_bEmptied = false;
-      }
-
-      *pMsg = item.message->Acquire();
-      m_list.pop_back();
-
       ret = MSGQ_OK;
       break;
     }
@@ -207,10 +346,21 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
     else
     {
       ResetEvent(m_hEvent);
+
+      // the ring producer only signals us while we're waiting, so
+      // check again once we have announced that we are
+      AtomicIncrement(&m_iWaiting);
+      if(priority <= 0 && RingReady())
+      {
+        AtomicDecrement(&m_iWaiting);
+        continue;
+      }
       lock.Leave();
 
       // wait for a new message
-      if (WaitForSingleObject(m_hEvent, iTimeoutInMilliSeconds) == WAIT_TIMEOUT)
+      DWORD result = WaitForSingleObject(m_hEvent, iTimeoutInMilliSeconds);
+      AtomicDecrement(&m_iWaiting);
+      if (result == WAIT_TIMEOUT)
         return MSGQ_TIMEOUT;
 
       lock.Enter();
@@ -237,6 +387,9 @@ unsigned CDVDMessageQueue::GetPacketCount(CDVDMsg::Message type)
       count++;
   }
 
+  if(m_ring && (type == CDVDMsg::DEMUXER_PACKET || type == CDVDMsg::NONE))
+    count += (unsigned long)(m_ringWrite - m_ringRead);
+
   return count;
 }
 
@@ -249,17 +402,40 @@ void CDVDMessageQueue::WaitUntilEmpty()
     msg->Release();
 }
 
+int CDVDMessageQueue::GetDataSize() const
+{
+  CSingleLock lock(m_dataSection);
+  return m_iDataSize + m_ringDataSize;
+}
+
 int CDVDMessageQueue::GetLevel() const
 {
-  if(m_iDataSize > m_iMaxDataSize)
+  CSingleLock lock(m_dataSection);
+  int iDataSize = m_iDataSize + m_ringDataSize;
+  if(iDataSize > m_iMaxDataSize)
     return 100;
-  if(m_iDataSize == 0)
+  if(iDataSize <= 0)
     return 0;
 
-  if(m_TimeBack  == DVD_NOPTS_VALUE
-  || m_TimeFront == DVD_NOPTS_VALUE
-  || m_TimeFront <= m_TimeBack)
-    return min(100, 100 * m_iDataSize / m_iMaxDataSize);
+  double front = m_TimeFront;
+  double back  = m_TimeBack;
+  long   read  = m_ringRead;
+  long   write = m_ringWrite;
+  if(m_ring && write != read)
+  {
+    // the items between read and write can't be reused by the producer while we hold m_dataSection
+    const DVDMessageRingItem& newest = m_ring[(write - 1) & (m_ringSize - 1)];
+    if(newest.time != DVD_NOPTS_VALUE && newest.sequence - m_TimeFrontSequence > 0)
+      front = newest.time;
+    const DVDMessageRingItem& oldest = m_ring[read & (m_ringSize - 1)];
+    if(back == DVD_NOPTS_VALUE)
+      back = oldest.time;
+  }
+
+  if(back  == DVD_NOPTS_VALUE
+  || front == DVD_NOPTS_VALUE
+  || front <= back)
+    return min(100, 100 * iDataSize / m_iMaxDataSize);
 
-  return min(100, MathUtils::round_int(100.0 * m_TimeSize * (m_TimeFront - m_TimeBack) / DVD_TIME_BASE ));
+  return min(100, MathUtils::round_int(100.0 * m_TimeSize * (front - back) / DVD_TIME_BASE ));
 }
@@ -32,11 +32,13 @@ struct DVDMessageListItem
   {
     message  = msg->Acquire();
     priority = prio;
+    sequence = 0;
   }
   DVDMessageListItem()
   {
     message  = NULL;
     priority = 0;
+    sequence = 0;
   }
   DVDMessageListItem(const DVDMessageListItem& item)
   {
@@ -45,6 +47,7 @@ struct DVDMessageListItem
     else
       message = NULL;
     priority = item.priority;
+    sequence = item.sequence;
   }
  ~DVDMessageListItem()
   {
@@ -61,11 +64,21 @@ struct DVDMessageListItem
     else
       message = NULL;
     priority = item.priority;
+    sequence = item.sequence;
     return *this;
   }
 
   CDVDMsg* message;
   int      priority;
+  long     sequence; // order of arrival, to merge priority 0 messages with the lock free ring
+};
+
+struct DVDMessageRingItem
+{
+  CDVDMsg* message;
+  long     sequence;
+  int      size;     // of the packet, so the consumer can account for it without the producer
+  double   time;     // dts, else pts of the packet
 };
 
 enum MsgQueueReturnCode
@@ -105,7 +118,7 @@ public:
     return Get(pMsg, iTimeoutInMilliSeconds, priority);
   }
 
-  int GetDataSize() const               { return m_iDataSize; }
+  int GetDataSize() const;
   unsigned GetPacketCount(CDVDMsg::Message type);
   bool ReceivedAbortRequest()           { return m_bAbortRequest; }
   void WaitUntilEmpty();
@@ -119,8 +132,25 @@ public:
   int GetMaxDataSize() const            { return m_iMaxDataSize; }
   bool IsInited() const                 { return m_bInitialized; }
 
+  /**
+   * Pass demuxer packets through a lock free ring of (at least) the given number
+   * of packets, instead of the locked message list. Only valid when data packets
+   * are put from a single thread, and fetched from a single other thread. Control
+   * messages, and packets that don't fit in the ring, still take the locked path.
+   * Must be called while the queue is not in use, 0 disables the ring. Ignored
+   * where the atomics the ring relies on aren't available.
+   */
+  void SetLockFreeSize(unsigned int packets);
+
 private:
 
+  bool PutRing(CDVDMsg* pMsg);
+  bool TakeMessage(CDVDMsg** pMsg, int &priority);
+  bool RingReady() const                { return m_ring && m_ringWrite != m_ringRead; }
+  void AddPacket(DemuxPacket* packet, long sequence);
+  void RemovePacket(DemuxPacket* packet);
+  void ReleaseRingItem();
+
   HANDLE m_hEvent;
   mutable CCriticalSection m_section;
 
@@ -128,8 +158,13 @@ private:
   bool m_bInitialized;
   bool m_bCaching;
 
-  int m_iDataSize;
+  // the size and time span of the packets in the list, and of those taken from the ring. the
+  // producer of the ring never takes this, the packets it has put are only counted in
+  // m_ringDataSize until they are taken, and their times are read from the ring itself
+  mutable CCriticalSection m_dataSection;
+  int    m_iDataSize;
   double m_TimeFront;
+  long   m_TimeFrontSequence;
   double m_TimeBack;
   double m_TimeSize;
 
@@ -139,5 +174,13 @@ private:
 
   typedef std::list<DVDMessageListItem> SList;
   SList m_list;
+
+  DVDMessageRingItem* m_ring;
+  unsigned long m_ringSize;
+  volatile long m_ringWrite;  // only advanced by the producer
+  volatile long m_ringRead;   // only advanced by the consumer, with m_section and m_dataSection held
+  volatile long m_ringDataSize;
+  volatile long m_iSequence;
+  volatile long m_iWaiting;   // consumer is waiting on m_hEvent
 };
 
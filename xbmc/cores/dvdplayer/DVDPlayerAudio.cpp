@@ -165,6 +165,7 @@ CDVDPlayerAudio::CDVDPlayerAudio(CDVDClock* pClock, CDVDMessageQueue& parent)
 
   m_messageQueue.SetMaxDataSize(6 * 1024 * 1024);
   m_messageQueue.SetMaxTimeSize(8.0);
+  m_messageQueue.SetLockFreeSize(2048); // packets are only put by the demuxer thread
   g_dvdPerformanceCounter.EnableAudioQueue(&m_messageQueue);
 }
 
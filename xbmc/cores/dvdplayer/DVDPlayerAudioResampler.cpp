@@ -27,10 +27,7 @@
 CDVDPlayerResampler::CDVDPlayerResampler()
 {
   m_nrchannels = -1;
-  m_converter = NULL;
-  m_converterdata.end_of_input = 0;
-  m_converterdata.src_ratio = 1.0;
-  m_quality = SRC_LINEAR;
+  m_quality = CPolyphaseResampler::QUALITY_LOW;
   m_ratio = 1.0;
 
   m_buffer = NULL;
@@ -53,36 +50,34 @@ void CDVDPlayerResampler::Add(DVDAudioFrame &audioframe, double pts)
   float scale = (float)(1 << (audioframe.bits_per_sample - 1));
   int   nrframes = audioframe.size / audioframe.channels / (audioframe.bits_per_sample / 8);
 
-  //resize sample buffer if necessary
-  //we want the buffer to be large enough to hold the current frames in it,
-  //the number of frames needed for libsamplerate's input
-  //and the maximum number of frames libsamplerate might generate, times 2 for safety
-  ResizeSampleBuffer(m_bufferfill + nrframes + nrframes * MathUtils::round_int(m_ratio + 0.5) * 2);
-
-  //assign samplebuffers
-  m_converterdata.input_frames = nrframes;
-  m_converterdata.output_frames = m_buffersize - m_bufferfill - m_converterdata.input_frames;
-  //output buffer starts at the place where the buffer doesn't hold samples
-  m_converterdata.data_out = m_buffer + m_bufferfill * m_nrchannels;
-  //intput buffer is a block of data at the end of the buffer
-  m_converterdata.data_in = m_converterdata.data_out + m_converterdata.output_frames * m_nrchannels;
-
   //add samples to the resample input buffer
+  m_input.resize(nrframes * m_nrchannels);
   int16_t* inputptr  = (int16_t*)audioframe.data;
-  float*   outputptr = m_converterdata.data_in;
+  float*   outputptr = &m_input[0];
 
   for (int i = 0; i < nrframes * m_nrchannels; i++)
     *outputptr++ = (float)*inputptr++ / scale;
 
-  //resample
-  m_converterdata.src_ratio = m_ratio;
-  src_set_ratio(m_converter, m_ratio);
-  src_process(m_converter, &m_converterdata);
+  m_converter.SetRatio(m_ratio);
+  m_converter.PutFrames(&m_input[0], nrframes);
+
+  //resample, the filter may hold back a few frames from the previous call so we
+  //keep going until it runs out of input
+  int maxframes = (int)(nrframes * m_ratio) + 2;
+  int generated = 0;
+  while (true)
+  {
+    ResizeSampleBuffer(m_bufferfill + generated + maxframes);
+    int frames = m_converter.GetFrames(m_buffer + (m_bufferfill + generated) * m_nrchannels, maxframes);
+    generated += frames;
+    if (frames < maxframes)
+      break;
+  }
 
   //calculate a pts for each sample
-  for (int i = 0; i < m_converterdata.output_frames_gen; i++)
+  for (int i = 0; i < generated; i++)
   {
-    m_ptsbuffer[m_bufferfill] = pts + i * (audioframe.duration / (double)m_converterdata.output_frames_gen);
+    m_ptsbuffer[m_bufferfill] = pts + i * (audioframe.duration / (double)generated);
     m_bufferfill++;
   }
 }
@@ -123,13 +118,12 @@ bool CDVDPlayerResampler::Retrieve(DVDAudioFrame &audioframe, double &pts)
 
 void CDVDPlayerResampler::CheckResampleBuffers(int channels)
 {
-  int error;
   if (channels != m_nrchannels)
   {
     Clean();
 
     m_nrchannels = channels;
-    m_converter = src_new(m_quality, m_nrchannels, &error);
+    m_converter.InitVariableRatio(m_nrchannels, m_ratio, m_quality);
   }
 }
 
@@ -152,19 +146,18 @@ void CDVDPlayerResampler::SetRatio(double ratio)
 void CDVDPlayerResampler::Flush()
 {
   m_bufferfill = 0;
+  m_converter.Reset();
 }
 
 void CDVDPlayerResampler::SetQuality(int quality)
 {
-  int qualitylookup[] = {SRC_LINEAR, SRC_SINC_FASTEST, SRC_SINC_MEDIUM_QUALITY, SRC_SINC_BEST_QUALITY};
-  m_quality = qualitylookup[Clamp(quality, 0, 3)];
+  m_quality = (CPolyphaseResampler::Quality)Clamp(quality, (int)CPolyphaseResampler::QUALITY_LOW, (int)CPolyphaseResampler::QUALITY_BEST);
   Clean();
 }
 
 void CDVDPlayerResampler::Clean()
 {
-  if (m_converter) src_delete(m_converter);
-  m_converter = NULL;
+  m_converter.DeInitialize();
 
   free(m_buffer);
   m_buffer = NULL;
@@ -175,7 +168,5 @@ void CDVDPlayerResampler::Clean()
   m_buffersize = 0;
 
   m_nrchannels = -1;
-  m_converterdata.end_of_input = 0;
-  m_converterdata.src_ratio = 1.0;
   m_ratio = 1.0;
 }
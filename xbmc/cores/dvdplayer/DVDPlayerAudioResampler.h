@@ -20,7 +20,9 @@
  */
 #pragma once
 
-#include <samplerate.h>
+#include "cores/PolyphaseResampler.h"
+
+#include <vector>
 
 #define MAXRATIO 30
 
@@ -49,9 +51,9 @@ class CDVDPlayerResampler
   private:
 
     int        m_nrchannels;
-    int        m_quality;
-    SRC_STATE* m_converter;
-    SRC_DATA   m_converterdata;
+    CPolyphaseResampler::Quality m_quality;
+    CPolyphaseResampler m_converter;
+    std::vector<float>  m_input; //the audioframes converted to float
     double     m_ratio;
 
     float*     m_buffer;     //buffer for the audioframes
@@ -25,6 +25,7 @@
 #include "FileItem.h"
 #include "MusicInfoTag.h"
 #include "utils/SingleLock.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 #include <math.h>
 
@@ -67,6 +68,16 @@ bool CAudioDecoder::Create(const CFileItem &file, __int64 seekOffset, unsigned i
 {
   Destroy();
 
+  ICodec *codec = OpenCodec(file, seekOffset);
+  if (!codec)
+    return false;
+  return Create(codec, nBufferSize);
+}
+
+bool CAudioDecoder::Create(ICodec *codec, unsigned int nBufferSize)
+{
+  Destroy();
+
   CSingleLock lock(m_critSection);
   // create our pcm buffer
   m_pcmBuffer.Create((int)std::max<unsigned int>(2, nBufferSize) *
@@ -75,6 +86,17 @@ bool CAudioDecoder::Create(const CFileItem &file, __int64 seekOffset, unsigned i
   // reset our playback timing variables
   m_eof = false;
 
+  m_codec = codec;
+  m_blockSize = m_codec->m_Channels * m_codec->m_BitsPerSample / 8;
+  m_trim.Reset(m_codec->m_EncoderDelay * m_codec->m_Channels, m_codec->m_EncoderPadding * m_codec->m_Channels);
+
+  m_status = STATUS_QUEUING;
+
+  return true;
+}
+
+ICodec *CAudioDecoder::OpenCodec(const CFileItem &file, __int64 seekOffset)
+{
   // get correct cache size
   unsigned int filecache = g_guiSettings.GetInt("cacheaudio.internet");
   if ( file.IsHD() )
@@ -85,26 +107,86 @@ bool CAudioDecoder::Create(const CFileItem &file, __int64 seekOffset, unsigned i
     filecache = g_guiSettings.GetInt("cacheaudio.lan");
 
   // create our codec
-  m_codec=CodecFactory::CreateCodecDemux(file.m_strPath, file.GetMimeType(), filecache * 1024);
+  ICodec *codec = CodecFactory::CreateCodecDemux(file.m_strPath, file.GetMimeType(), filecache * 1024);
 
-  if (!m_codec || !m_codec->Init(file.m_strPath, filecache * 1024))
+  if (!codec || !codec->Init(file.m_strPath, filecache * 1024))
   {
     CLog::Log(LOGERROR, "CAudioDecoder: Unable to Init Codec while loading file %s", file.m_strPath.c_str());
-    Destroy();
-    return false;
+    delete codec;
+    return NULL;
   }
-  m_blockSize = m_codec->m_Channels * m_codec->m_BitsPerSample / 8;
-  
+
   // set total time from the given tag
   if (file.HasMusicInfoTag() && file.GetMusicInfoTag()->GetDuration())
-    m_codec->SetTotalTime(file.GetMusicInfoTag()->GetDuration());
+    codec->SetTotalTime(file.GetMusicInfoTag()->GetDuration());
 
+  // the encoder delay is only at the start of the stream
   if (seekOffset)
-    m_codec->Seek(seekOffset);
+  {
+    codec->Seek(seekOffset);
+    codec->m_EncoderDelay = 0;
+  }
 
-  m_status = STATUS_QUEUING;
+  return codec;
+}
 
-  return true;
+class CQueuedCodecJob : public CJob
+{
+public:
+  CQueuedCodecJob(const boost::shared_ptr<CQueuedCodec> &queued) : m_queued(queued) {};
+
+  virtual bool DoWork()
+  {
+    // the player may have given up on the file in the meantime, in which case we're the only reference
+    ICodec *codec = NULL;
+    if (!m_queued.unique())
+      codec = CAudioDecoder::OpenCodec(*m_queued->m_file, m_queued->m_seekOffset);
+
+    CSingleLock lock(m_queued->m_critSection);
+    m_queued->m_codec = codec;
+    m_queued->m_done = true;
+    return codec != NULL;
+  }
+
+private:
+  boost::shared_ptr<CQueuedCodec> m_queued;
+};
+
+CQueuedCodec::CQueuedCodec(const CFileItem &file, __int64 seekOffset)
+{
+  m_file = new CFileItem(file);
+  m_seekOffset = seekOffset;
+  m_codec = NULL;
+  m_done = false;
+}
+
+CQueuedCodec::~CQueuedCodec()
+{
+  delete m_codec;
+  delete m_file;
+}
+
+boost::shared_ptr<CQueuedCodec> CQueuedCodec::Open(const CFileItem &file, __int64 seekOffset)
+{
+  boost::shared_ptr<CQueuedCodec> queued(new CQueuedCodec(file, seekOffset));
+  // high priority, as the track has to be open before the current one ends, and the
+  // normal pool may be busy loading the details of a listing
+  CJobManager::GetInstance().AddJob(new CQueuedCodecJob(queued), NULL, CJob::PRIORITY_HIGH);
+  return queued;
+}
+
+bool CQueuedCodec::IsDone()
+{
+  CSingleLock lock(m_critSection);
+  return m_done;
+}
+
+ICodec *CQueuedCodec::TakeCodec()
+{
+  CSingleLock lock(m_critSection);
+  ICodec *codec = m_codec;
+  m_codec = NULL;
+  return codec;
 }
 
 void CAudioDecoder::GetDataFormat(unsigned int *channels, unsigned int *samplerate, unsigned int *bitspersample)
@@ -120,6 +202,7 @@ void CAudioDecoder::GetDataFormat(unsigned int *channels, unsigned int *samplera
 __int64 CAudioDecoder::Seek(__int64 time)
 {
   m_pcmBuffer.Clear();
+  m_trim.Flush();
   if (!m_codec)
     return 0;
   if (time < 0) time = 0;
@@ -217,6 +300,9 @@ int CAudioDecoder::ReadSamples(int numsamples)
     else
       result = ReadPCMSamples(m_inputBuffer, numsamples, &actualsamples);
 
+    if (result != READ_ERROR)
+      actualsamples = m_trim.Trim(m_inputBuffer, actualsamples, result == READ_EOF);
+
     if ( result != READ_ERROR && actualsamples )
     {
       // do any post processing of the audio (eg replaygain etc.)
@@ -25,6 +25,8 @@
 #include "ICodec.h"
 #include "utils/CriticalSection.h"
 #include "utils/RingBuffer.h"
+#include "EncoderTrim.h"
+#include "boost/shared_ptr.hpp"
 
 class CFileItem;
 
@@ -50,6 +52,45 @@ class CFileItem;
 #define RET_SUCCESS 0
 #define RET_SLEEP 1
 
+/*! \brief The codec of a file that is being opened in the background
+ Opening a codec (and seeking into it) may take several seconds on network sources, so the next
+ file to play is opened on a job and handed to a CAudioDecoder once it's ready.
+ \sa CAudioDecoder::OpenCodec
+ */
+class CQueuedCodec
+{
+public:
+  ~CQueuedCodec();
+
+  /*! \brief Start opening the codec of a file in the background
+   \param file the file to open
+   \param seekOffset time (in ms) to seek to once the file is open
+   \return the queued codec, to be polled with IsDone()
+   */
+  static boost::shared_ptr<CQueuedCodec> Open(const CFileItem &file, __int64 seekOffset);
+
+  /*! \brief Whether the codec has been opened, or failed to open
+   */
+  bool IsDone();
+
+  /*! \brief Take ownership of the opened codec
+   \return the codec, NULL if it failed to open (or was taken already).
+   */
+  ICodec *TakeCodec();
+
+  const CFileItem &GetFile() const { return *m_file; };
+
+private:
+  CQueuedCodec(const CFileItem &file, __int64 seekOffset);
+  friend class CQueuedCodecJob;
+
+  CFileItem*       m_file;
+  __int64          m_seekOffset;
+  ICodec*          m_codec;
+  bool             m_done;
+  CCriticalSection m_critSection;
+};
+
 class CAudioDecoder
 {
 public:
@@ -57,8 +98,22 @@ public:
   ~CAudioDecoder();
 
   bool Create(const CFileItem &file, __int64 seekOffset, unsigned int nBufferSize);
+
+  /*! \brief Setup the decoder with a codec that has already been opened
+   \param codec the codec, which the decoder takes ownership of
+   \param nBufferSize size of the pcm buffer, in seconds
+   \sa OpenCodec
+   */
+  bool Create(ICodec *codec, unsigned int nBufferSize);
   void Destroy();
 
+  /*! \brief Open the codec of a file, ready for decoding
+   \param file the file to open
+   \param seekOffset time (in ms) to seek to once the file is open
+   \return the codec, NULL on failure.
+   */
+  static ICodec *OpenCodec(const CFileItem &file, __int64 seekOffset);
+
   int ReadSamples(int numsamples);
 
   bool CanSeek() { if (m_codec) return m_codec->CanSeek(); else return false; };
@@ -98,6 +153,9 @@ private:
   BYTE m_pcmInputBuffer[INPUT_SIZE];
   float m_inputBuffer[INPUT_SAMPLES];
 
+  // drops the encoder delay and padding of the codec
+  CEncoderTrim m_trim;
+
   // status
   bool    m_eof;
   int     m_status;
@@ -27,6 +27,7 @@
 #include "DVDDemuxers/DVDDemuxUtils.h"
 #include "DVDStreamInfo.h"
 #include "DVDCodecs/DVDFactoryCodec.h"
+#include "MusicInfoTagLoaderMP4.h"
 #include "utils/log.h"
 
 #include "AudioDecoder.h"
@@ -144,12 +145,15 @@ bool DVDPlayerCodec::Init(const CStdString &strFile, unsigned int filecache)
   // we have to decode initial data in order to get channels/samplerate
   // for sanity - we read no more than 10 packets
   int nErrors = 0;
+  int nDropped = 0;
   for (int nPacket=0; nPacket < 10 && (m_Channels == 0 || m_SampleRate == 0); nPacket++)
   {
     BYTE dummy[256];
-    int nSize = 256;
-    if (ReadPCM(dummy, nSize, &nSize) == READ_ERROR)
+    int nSize = 0;
+    if (ReadPCM(dummy, sizeof(dummy), &nSize) == READ_ERROR)
       ++nErrors;
+    else
+      nDropped += nSize;
 
     // We always ask ffmpeg to return s16le
     m_BitsPerSample = m_pAudioCodec->GetBitsPerSample();
@@ -163,6 +167,8 @@ bool DVDPlayerCodec::Init(const CStdString &strFile, unsigned int filecache)
     return false;
   }
 
+  if (m_decoded)
+    nDropped += m_nDecodedLen;
   m_nDecodedLen = 0;
 
   if (m_Channels == 0) // no data - just guess and hope for the best
@@ -171,6 +177,19 @@ bool DVDPlayerCodec::Init(const CStdString &strFile, unsigned int filecache)
   if (m_SampleRate == 0)
     m_SampleRate = 44100;
 
+  // AAC from iTunes and Nero tells us its encoder delay and padding, which we leave to CAudioDecoder
+  // to trim.  What we've decoded (and dropped) above already counts towards the delay.
+  CStdString strExtension = CUtil::GetExtension(strFile);
+  unsigned int delay, padding;
+  if (m_BitsPerSample > 0 && (strExtension.Equals(".m4a") || strExtension.Equals(".mp4")) &&
+      MUSIC_INFO::CMusicInfoTagLoaderMP4::GetGaplessInfo(strFile, delay, padding))
+  {
+    unsigned int dropped = nDropped / (m_BitsPerSample / 8 * m_Channels);
+    m_EncoderDelay = delay > dropped ? delay - dropped : 0;
+    m_EncoderPadding = padding;
+    CLog::Log(LOGDEBUG, "%s: encoder delay %u, padding %u samples", __FUNCTION__, delay, padding);
+  }
+
   m_TotalTime = m_pDemuxer->GetStreamLength();
   m_pDemuxer->GetStreamCodecName(m_nAudioStream,m_CodecName);
 
@@ -0,0 +1,73 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "EncoderTrim.h"
+#include <algorithm>
+#include <string.h>
+
+CEncoderTrim::CEncoderTrim()
+{
+  m_delay = 0;
+  m_padding = 0;
+}
+
+void CEncoderTrim::Reset(unsigned int delay, unsigned int padding)
+{
+  m_delay = delay;
+  m_padding = padding;
+  m_held.clear();
+}
+
+void CEncoderTrim::Flush()
+{
+  m_delay = 0;
+  m_held.clear();
+}
+
+unsigned int CEncoderTrim::Trim(float *data, unsigned int samples, bool eof)
+{
+  unsigned int skip = std::min(m_delay, samples);
+  m_delay -= skip;
+  samples -= skip;
+
+  if (!m_padding)
+  {
+    if (skip)
+      memmove(data, data + skip, samples * sizeof(float));
+    return samples;
+  }
+
+  // hold back the last m_padding samples, and play those they push out.  As we never hold more
+  // than m_padding, that's no more than we were given.
+  m_held.insert(m_held.end(), data + skip, data + skip + samples);
+  unsigned int play = 0;
+  if (m_held.size() > m_padding)
+  {
+    play = m_held.size() - m_padding;
+    std::copy(m_held.begin(), m_held.begin() + play, data);
+    m_held.erase(m_held.begin(), m_held.begin() + play);
+  }
+
+  // whatever is still held at the end is the padding
+  if (eof)
+    m_held.clear();
+  return play;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include <vector>
+
+/*! \brief Trims the encoder delay and padding off decoded audio
+ Lossy encoders add samples at the start (the delay) and the end (the padding) of a track, which
+ leave a gap between the tracks of a gapless album.  The padding is only known to be padding once
+ the stream has ended, so the last samples decoded are held back until then.
+ \sa ICodec::m_EncoderDelay
+ */
+class CEncoderTrim
+{
+public:
+  CEncoderTrim();
+
+  /*! \brief Start trimming a stream from its beginning
+   \param delay number of samples (distributed over channels) to drop at the start
+   \param padding number of samples (distributed over channels) to drop at the end
+   */
+  void Reset(unsigned int delay, unsigned int padding);
+
+  /*! \brief Continue from another position in the stream, after a seek
+   Nothing is dropped at the new position, and the samples that were held back are forgotten.
+   */
+  void Flush();
+
+  /*! \brief Trim the next block of decoded samples
+   \param data the samples, which are replaced by those to play
+   \param samples number of samples in data
+   \param eof whether the stream ends with this block
+   \return the number of samples to play, never more than were given.
+   */
+  unsigned int Trim(float *data, unsigned int samples, bool eof);
+
+private:
+  unsigned int       m_delay;   ///< samples still to drop at the start
+  unsigned int       m_padding;
+  std::vector<float> m_held;    ///< the last samples decoded, which may turn out to be padding
+};
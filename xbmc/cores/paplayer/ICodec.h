@@ -39,6 +39,8 @@ public:
     m_BitsPerSample = 0;
     m_Channels = 0;
     m_Bitrate = 0;
+    m_EncoderDelay = 0;
+    m_EncoderPadding = 0;
     m_CodecName = "";
   };
   virtual ~ICodec() {};
@@ -105,6 +107,10 @@ public:
   int m_BitsPerSample;
   int m_Channels;
   int m_Bitrate;
+  // samples (per channel) that the encoder added at the start and end of the stream, which
+  // CAudioDecoder trims off for gapless playback.  Codecs that trim them themselves leave these at 0.
+  unsigned int m_EncoderDelay;
+  unsigned int m_EncoderPadding;
   CStdString m_CodecName;
   CReplayGain m_replayGain;
   XFILE::CFile m_file;
@@ -32,6 +32,7 @@
 #include "MusicInfoTag.h"
 #include "../AudioRenderers/AudioRendererFactory.h"
 #include "../../utils/TimeUtils.h"
+#include "utils/SingleLock.h"
 #include "utils/log.h"
 
 #ifdef _LINUX
@@ -44,7 +45,6 @@
 
 #define FADE_TIME 2 * 2048.0f / XBMC_SAMPLE_RATE.0f      // 2 packets
 
-#define TIME_TO_CACHE_NEXT_FILE 5000L         // 5 seconds
 #define TIME_TO_CROSS_FADE      10000L        // 10 seconds
 
 // PAP: Psycho-acoustic Audio Player
@@ -214,28 +214,86 @@ void PAPlayer::OnNothingToQueueNotify()
   m_bQueueFailed = true;
 }
 
+bool PAPlayer::IsNextCueSheetItem(const CFileItem &file) const
+{
+  return file.m_strPath == m_currentFile->m_strPath &&
+         file.m_lStartOffset > 0 &&
+         file.m_lStartOffset == m_currentFile->m_lEndOffset;
+}
+
 bool PAPlayer::QueueNextFile(const CFileItem &file)
 {
-  return QueueNextFile(file, true);
+  if (ContinueCueSheet(file))
+    return true;
+
+  // open the file in the background so that slow sources don't hold up the application,
+  // it's handed to our spare decoder by HandleQueuedFile() once it's ready.  We accept it
+  // here, and tell our callback if it then fails to open.
+  CLog::Log(LOGINFO, "PAPlayer: Opening next file %s", file.m_strPath.c_str());
+  CSingleLock lock(m_queueSection);
+  m_queuedCodec = CQueuedCodec::Open(file, (file.m_lStartOffset * 1000) / 75);
+  return true;
 }
 
-bool PAPlayer::QueueNextFile(const CFileItem &file, bool checkCrossFading)
+bool PAPlayer::ContinueCueSheet(const CFileItem &file)
 {
   if (IsPaused())
     Pause();
 
-  if (file.m_strPath == m_currentFile->m_strPath &&
-      file.m_lStartOffset > 0 &&
-      file.m_lStartOffset == m_currentFile->m_lEndOffset)
+  if (IsNextCueSheetItem(file))
   { // continuing on a .cue sheet item - return true to say we'll handle the transistion
     *m_nextFile = file;
     return true;
   }
+  return false;
+}
+
+bool PAPlayer::QueueNextFile(const CFileItem &file, bool checkCrossFading)
+{
+  if (ContinueCueSheet(file))
+    return true;
+
+  // this file takes the place of any we were opening in the background
+  {
+    CSingleLock lock(m_queueSection);
+    m_queuedCodec.reset();
+  }
 
-  // check if we can handle this file at all
-  int decoder = 1 - m_currentDecoder;
   int64_t seekOffset = (file.m_lStartOffset * 1000) / 75;
-  if (!m_decoder[decoder].Create(file, seekOffset, m_crossFading))
+  return QueueCodec(file, CAudioDecoder::OpenCodec(file, seekOffset), checkCrossFading);
+}
+
+bool PAPlayer::IsOpeningNextFile()
+{
+  CSingleLock lock(m_queueSection);
+  return m_queuedCodec.get() != NULL;
+}
+
+void PAPlayer::HandleQueuedFile()
+{
+  // the spare decoder is still in use while crossfading
+  if (m_currentlyCrossFading)
+    return;
+
+  boost::shared_ptr<CQueuedCodec> queued;
+  {
+    CSingleLock lock(m_queueSection);
+    if (!m_queuedCodec || !m_queuedCodec->IsDone())
+      return;
+    queued = m_queuedCodec;
+    m_queuedCodec.reset();
+  }
+  if (!QueueCodec(queued->GetFile(), queued->TakeCodec(), true))
+    m_callback.OnQueueNextItemFailed();
+}
+
+bool PAPlayer::QueueCodec(const CFileItem &file, ICodec *codec, bool checkCrossFading)
+{
+  // check if we can handle this file at all.  It's decoded into a buffer of its own until we get
+  // to it, which holds enough for the crossfade and a stall of its source.
+  int decoder = 1 - m_currentDecoder;
+  int bufferSize = std::max(m_crossFading, g_advancedSettings.m_musicNextTrackBuffer);
+  if (!codec || !m_decoder[decoder].Create(codec, bufferSize))
   {
     m_bQueueFailed = true;
     return false;
@@ -285,6 +343,11 @@ bool PAPlayer::CloseFileInternal(bool bAudioDevice /*= true*/)
   m_visBufferLength = 0;
   StopThread();
 
+  {
+    CSingleLock lock(m_queueSection);
+    m_queuedCodec.reset();
+  }
+
   // kill both our streams if we need to
   for (int i = 0; i < 2; i++)
   {
@@ -399,7 +462,7 @@ bool PAPlayer::CreateStream(int num, unsigned int channels, unsigned int sampler
   // set initial volume
   SetStreamVolume(num, g_settings.m_nVolumeLevel);
 
-  m_resampler[num].InitConverter(samplerate, bitspersample, channels, outputSampleRate, m_bitsPerSample[num], PACKET_SIZE);
+  m_resampler[num].InitConverter(samplerate, channels, outputSampleRate, m_bitsPerSample[num], PACKET_SIZE, (CPolyphaseResampler::Quality)g_advancedSettings.m_musicResampleQuality);
 
   // TODO: How do we best handle the callback, given that our samplerate etc. may be
   // changing at this point?
@@ -543,12 +606,14 @@ bool PAPlayer::ProcessPAP()
 
     UpdateCacheLevel();
 
-    // check whether we should queue the next file up
-    if ((GetTotalTime64() > 0) && GetTotalTime64() - GetTime() < TIME_TO_CACHE_NEXT_FILE + m_crossFading * 1000L && !m_cachingNextFile)
+    // check whether we should queue the next file up, early enough for it to be opened and
+    // partly decoded before we need it
+    if ((GetTotalTime64() > 0) && GetTotalTime64() - GetTime() < g_advancedSettings.m_musicNextTrackLookahead * 1000L + m_crossFading * 1000L && !m_cachingNextFile)
     { // request the next file from our application
       m_callback.OnQueueNextItem();
       m_cachingNextFile = true;
     }
+    HandleQueuedFile();
 
     if (m_crossFading && m_decoder[0].GetChannels() == m_decoder[1].GetChannels())
     {
@@ -620,7 +685,7 @@ bool PAPlayer::ProcessPAP()
             {
               CLog::Log(LOGINFO, "PAPlayer: Restarting resampler due to a change in data format");
               m_resampler[m_currentStream].DeInitialize();
-              if (!m_resampler[m_currentStream].InitConverter(samplerate2, bitspersample2, channels2, g_advancedSettings.m_musicResample, 16, PACKET_SIZE))
+              if (!m_resampler[m_currentStream].InitConverter(samplerate2, channels2, g_advancedSettings.m_musicResample, 16, PACKET_SIZE, (CPolyphaseResampler::Quality)g_advancedSettings.m_musicResampleQuality))
               {
                 CLog::Log(LOGERROR, "PAPlayer: Error initializing resampler!");
                 return false;
@@ -662,7 +727,7 @@ bool PAPlayer::ProcessPAP()
               m_cachingNextFile = true;
             }
           }
-          else
+          else if (!IsOpeningNextFile())
           {
             // no track queued - return and get another one once we are finished
             // with the current stream
@@ -704,10 +769,16 @@ bool PAPlayer::ProcessPAP()
         return false;
       }
 
-      int retVal2 = m_decoder[1 - m_currentDecoder].ReadSamples(PACKET_SIZE);
-      if (retVal2 == RET_ERROR)
+      // decode the next track while the current one doesn't need to, so that its buffer is
+      // filled ahead of time without holding up the current track (unless we're fading into it)
+      int retVal2 = RET_SLEEP;
+      if (retVal == RET_SLEEP || m_currentlyCrossFading)
       {
-        m_decoder[1 - m_currentDecoder].Destroy();
+        retVal2 = m_decoder[1 - m_currentDecoder].ReadSamples(PACKET_SIZE);
+        if (retVal2 == RET_ERROR)
+        {
+          m_decoder[1 - m_currentDecoder].Destroy();
+        }
       }
 
       // if we're cross-fading, then we do this for both streams, otherwise
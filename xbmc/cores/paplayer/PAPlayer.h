@@ -24,7 +24,7 @@
 #include "cores/IPlayer.h"
 #include "utils/Thread.h"
 #include "AudioDecoder.h"
-#include "cores/ssrc.h"
+#include "cores/PolyphaseResampler.h"
 #include "cores/AudioRenderers/IAudioRenderer.h"
 
 class CFileItem;
@@ -132,6 +132,10 @@ private:
   int m_currentDecoder;
   CAudioDecoder m_decoder[2]; // our 2 audiodecoders (for crossfading + precaching)
 
+  // the next file while it's being opened in the background, see HandleQueuedFile()
+  boost::shared_ptr<CQueuedCodec> m_queuedCodec;
+  CCriticalSection m_queueSection;
+
 #ifndef _LINUX
   void SetupDirectSound(int channels);
 #endif
@@ -151,6 +155,11 @@ private:
 
   void UpdateCrossFadingTime(const CFileItem& file);
   bool QueueNextFile(const CFileItem &file, bool checkCrossFading);
+  bool ContinueCueSheet(const CFileItem &file); ///< unpause, and note the file if it's the next item of the .cue sheet being played
+  bool QueueCodec(const CFileItem &file, ICodec *codec, bool checkCrossFading);
+  void HandleQueuedFile();
+  bool IsOpeningNextFile();
+  bool IsNextCueSheetItem(const CFileItem &file) const;
   void UpdateCacheLevel();
 
   int m_currentStream;
@@ -185,7 +194,7 @@ private:
   unsigned int     m_LastCacheLevelCheck;
 
     // resampler
-  Cssrc            m_resampler[2];
+  CPolyphaseResampler m_resampler[2];
   bool             m_resampleAudio;
 
   // our file
@@ -112,6 +112,13 @@ bool CGUIWindowKaraokeLyrics::OnMessage(CGUIMessage& message)
 }
 
 
+void CGUIWindowKaraokeLyrics::Process(unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  // the lyrics and background are rendered directly, every frame
+  g_windowManager.MarkDirty();
+  CGUIWindow::Process(currentTime, dirtyregions);
+}
+
 void CGUIWindowKaraokeLyrics::Render()
 {
   g_application.ResetScreenSaver();
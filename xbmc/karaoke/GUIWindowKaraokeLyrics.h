@@ -34,6 +34,7 @@ public:
   virtual ~CGUIWindowKaraokeLyrics(void);
   virtual bool OnMessage(CGUIMessage& message);
   virtual bool OnAction(const CAction &action);
+  virtual void Process(unsigned int currentTime, CDirtyRegionList &dirtyregions);
   virtual void Render();
 
   void    newSong( CKaraokeLyrics * lyrics );
@@ -29,6 +29,8 @@
 #include "dataset.h"
 #include "utils/log.h"
 #include <cstring>
+#include <algorithm>
+#include <memory>
 
 #ifndef __GNUC__
 #pragma warning (disable:4800)
@@ -63,6 +65,38 @@ int Database::connectFull(const char *newHost, const char *newPort, const char *
   return connect();
 }
 
+string Database::prepare(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  string result = vprepare(format, args);
+  va_end(args);
+  return result;
+}
+
+int Database::insert_rows(const string &table, const string &columns, const vector<vector<string> > &rows) {
+  // database servers take many rows per statement, which saves a round trip for each of them.
+  // the statements are kept to a few hundred rows, well below the servers' packet size limits.
+  const size_t rows_per_statement = 200;
+  if (rows.empty()) return 0;
+  auto_ptr<Dataset> ds(CreateDataset());
+  size_t done = 0;
+  while (done < rows.size()) {
+    size_t end = min(rows.size(), done + rows_per_statement);
+    string sql = "INSERT INTO " + table + " (" + columns + ") VALUES ";
+    for (size_t i = done; i < end; i++) {
+      sql += (i > done) ? ",(" : "(";
+      for (size_t j = 0; j < rows[i].size(); j++) {
+        if (j) sql += ",";
+        sql += prepare("'%s'", rows[i][j].c_str());
+      }
+      sql += ")";
+    }
+    ds->exec(sql);
+    done = end;
+  }
+  return (int)done;
+}
+
 
 
 
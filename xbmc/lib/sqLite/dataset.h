@@ -132,9 +132,16 @@ public:
 
 /* virtual methods for formatting */
   virtual std::string vprepare(const char *format, va_list args) { return std::string(""); };
+  std::string prepare(const char *format, ...);
 
   virtual bool in_transaction() {return false;};
 
+/* virtual method for bulk inserts: inserts each row of values, given as text, into the
+   columns of table, and returns the number of rows inserted. The default sends the rows
+   in multi-row INSERT statements. */
+  virtual int insert_rows(const std::string &table, const std::string &columns,
+                          const std::vector<std::vector<std::string> > &rows);
+
 };
 
 
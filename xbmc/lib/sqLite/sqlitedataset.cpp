@@ -248,6 +248,9 @@ bool SqliteDatabase::exists(void)
 
 void SqliteDatabase::disconnect(void) {
   if (active == false) return;
+  for (map<string, sqlite3_stmt*>::iterator i = statements.begin(); i != statements.end(); i++)
+    sqlite3_finalize(i->second);
+  statements.clear();
   sqlite3_close(conn);
   active = false;
 }
@@ -315,6 +318,48 @@ void SqliteDatabase::rollback_transaction() {
 }
 
 
+int SqliteDatabase::insert_rows(const string &table, const string &columns, const vector<vector<string> > &rows) {
+  if (!active) throw DbErrors("No Database Connection");
+  if (rows.empty()) return 0;
+
+  string sql = "INSERT INTO " + table + " (" + columns + ") VALUES (";
+  for (size_t j = 0; j < rows[0].size(); j++)
+    sql += j ? ",?" : "?";
+  sql += ")";
+
+  // the statement only needs to be compiled once, for all rows and for later calls
+  sqlite3_stmt *stmt;
+  map<string, sqlite3_stmt*>::iterator cached = statements.find(sql);
+  if (cached != statements.end())
+    stmt = cached->second;
+  else
+  {
+  #ifdef __APPLE__
+    if (setErr(sqlite3_prepare(conn, sql.c_str(), -1, &stmt, NULL), sql.c_str()) != SQLITE_OK)
+  #else
+    if (setErr(sqlite3_prepare_v2(conn, sql.c_str(), -1, &stmt, NULL), sql.c_str()) != SQLITE_OK)
+  #endif
+      throw DbErrors(getErrorMsg());
+    statements[sql] = stmt;
+  }
+
+  for (size_t i = 0; i < rows.size(); i++)
+  {
+    for (size_t j = 0; j < rows[i].size(); j++)
+      sqlite3_bind_text(stmt, (int)j + 1, rows[i][j].c_str(), (int)rows[i][j].size(), SQLITE_STATIC);
+    int rc = sqlite3_step(stmt);
+    // reset gives the actual error where the legacy sqlite3_prepare() is used
+    int reset = sqlite3_reset(stmt);
+    if (rc != SQLITE_DONE)
+    {
+      setErr(reset != SQLITE_OK ? reset : rc, sql.c_str());
+      throw DbErrors(getErrorMsg());
+    }
+  }
+  return (int)rows.size();
+}
+
+
 // methods for formatting
 // ---------------------------------------------
 string SqliteDatabase::vprepare(const char *format, va_list args)
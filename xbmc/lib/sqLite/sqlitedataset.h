@@ -49,6 +49,8 @@ protected:
   sqlite3 *conn;
   bool _in_transaction;
   int last_err;
+/* prepared statements kept for reuse by insert_rows() */
+  std::map<std::string, sqlite3_stmt*> statements;
 
 public:
 /* default constructor */
@@ -90,6 +92,10 @@ public:
 
   bool in_transaction() {return _in_transaction;}; 	
 
+/* inserts the rows through a prepared statement, which is kept for the next call */
+  virtual int insert_rows(const std::string &table, const std::string &columns,
+                          const std::vector<std::vector<std::string> > &rows);
+
 };
 
 
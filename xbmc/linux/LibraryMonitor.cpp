@@ -0,0 +1,372 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "LibraryMonitor.h"
+
+#if defined(_LINUX) && !defined(__APPLE__)
+
+#include "GUIDialogVideoScan.h"
+#include "GUIDialogMusicScan.h"
+#include "GUIWindowManager.h"
+#include "VideoDatabase.h"
+#include "MusicDatabase.h"
+#include "AdvancedSettings.h"
+#include "Settings.h"
+#include "Util.h"
+#include "utils/TimeUtils.h"
+#include "utils/SingleLock.h"
+#include "utils/log.h"
+
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace ADDON;
+
+// time (in ms) that a folder must be left alone before it's updated, so that a copy
+// of several files results in a single update
+#define MONITOR_SETTLE_TIME 5000
+// time (in ms) after which changes are updated even if the folders are still changing
+#define MONITOR_MAX_DELAY   60000
+
+// new files are only picked up once they've been written
+#define MONITOR_EVENTS (IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_MOVE_SELF)
+
+CLibraryMonitor::CLibraryMonitor()
+{
+  m_videoScan = NULL;
+  m_musicScan = NULL;
+  m_libraries = 0;
+  m_fd = -1;
+  m_overflowed = false;
+  m_firstChange = 0;
+  m_lastChange = 0;
+}
+
+CLibraryMonitor::~CLibraryMonitor()
+{
+  Stop();
+}
+
+void CLibraryMonitor::Start()
+{
+  Stop();
+
+  m_libraries = 0;
+  if (g_advancedSettings.m_bVideoLibraryMonitor)
+    m_libraries |= LIBRARY_VIDEO;
+  if (g_advancedSettings.m_bMusicLibraryMonitor)
+    m_libraries |= LIBRARY_MUSIC;
+  if (!m_libraries)
+    return;
+
+  m_videoScan = (CGUIDialogVideoScan *)g_windowManager.GetWindow(WINDOW_DIALOG_VIDEO_SCAN);
+  m_musicScan = (CGUIDialogMusicScan *)g_windowManager.GetWindow(WINDOW_DIALOG_MUSIC_SCAN);
+  Create();
+}
+
+void CLibraryMonitor::Stop()
+{
+  StopThread();
+}
+
+void CLibraryMonitor::Process()
+{
+  m_fd = inotify_init();
+  if (m_fd < 0)
+  {
+    CLog::Log(LOGERROR, "%s - unable to initialize inotify: %s", __FUNCTION__, strerror(errno));
+    return;
+  }
+
+  // walking the sources may take a while, hence we do it here rather than in Start()
+  map<CStdString, int> roots;
+  GetRoots(roots);
+  m_overflowed = false;
+  for (map<CStdString, int>::const_iterator i = roots.begin(); i != roots.end() && !m_bStop; ++i)
+    AddWatches(i->first, i->second);
+  CLog::Log(LOGNOTICE, "%s - watching %u folders in %u sources", __FUNCTION__, (unsigned int)m_watches.size(), (unsigned int)roots.size());
+
+  while (!m_bStop)
+  {
+    struct pollfd fd;
+    fd.fd = m_fd;
+    fd.events = POLLIN;
+    fd.revents = 0;
+    if (poll(&fd, 1, 500) > 0 && (fd.revents & POLLIN))
+      ReadEvents();
+    PrepareChangedFolders();
+  }
+
+  close(m_fd);
+  m_fd = -1;
+  m_watches.clear();
+
+  CSingleLock lock(m_section);
+  m_changed.clear();
+  m_videoPaths.clear();
+  m_musicPaths.clear();
+}
+
+void CLibraryMonitor::UpdateLibraries()
+{
+  // folders whose scanner is busy are kept until it's done
+  set<CStdString> videoPaths, musicPaths;
+  {
+    CSingleLock lock(m_section);
+    if (!m_videoPaths.empty() && m_videoScan && !m_videoScan->IsScanning())
+      videoPaths.swap(m_videoPaths);
+    if (!m_musicPaths.empty() && m_musicScan && !m_musicScan->IsScanning())
+      musicPaths.swap(m_musicPaths);
+  }
+
+  if (!videoPaths.empty())
+  {
+    CLog::Log(LOGDEBUG, "%s - updating %u changed video folders", __FUNCTION__, (unsigned int)videoPaths.size());
+    m_videoScan->UpdateDirectories(videoPaths);
+  }
+  if (!musicPaths.empty())
+  {
+    CLog::Log(LOGDEBUG, "%s - updating %u changed music folders", __FUNCTION__, (unsigned int)musicPaths.size());
+    m_musicScan->UpdateDirectories(musicPaths);
+  }
+}
+
+void CLibraryMonitor::GetRoots(map<CStdString, int> &roots)
+{
+  if (m_libraries & LIBRARY_VIDEO)
+  { // the paths the video scanner updates are those of the sources and tvshows with content
+    CVideoDatabase database;
+    set<CStdString> paths;
+    if (database.Open())
+    {
+      database.GetPaths(paths);
+      database.Close();
+    }
+    for (set<CStdString>::const_iterator i = paths.begin(); i != paths.end(); ++i)
+    {
+      if (i->Left(1) == "/")
+        roots[*i] |= LIBRARY_VIDEO;
+    }
+  }
+
+  if (m_libraries & LIBRARY_MUSIC)
+  { // the music scanner updates the folders holding songs, so watch the sources those are in
+    CMusicDatabase database;
+    set<CStdString> paths;
+    if (database.Open())
+    {
+      database.GetPaths(paths);
+      database.Close();
+    }
+    for (VECSOURCES::const_iterator source = g_settings.m_musicSources.begin(); source != g_settings.m_musicSources.end(); ++source)
+    {
+      for (vector<CStdString>::const_iterator i = source->vecPaths.begin(); i != source->vecPaths.end(); ++i)
+      {
+        CStdString path(*i);
+        CUtil::AddSlashAtEnd(path);
+        if (path.Left(1) != "/")
+          continue;
+        set<CStdString>::const_iterator song = paths.lower_bound(path);
+        if (song != paths.end() && song->Left(path.size()) == path)
+          roots[path] |= LIBRARY_MUSIC;
+      }
+    }
+  }
+}
+
+void CLibraryMonitor::AddWatches(const CStdString &path, int libraries)
+{
+  int wd = inotify_add_watch(m_fd, path.c_str(), MONITOR_EVENTS);
+  if (wd < 0)
+  {
+    if (errno == ENOSPC && !m_overflowed)
+    {
+      CLog::Log(LOGWARNING, "%s - out of inotify watches, some folders won't be monitored (see /proc/sys/fs/inotify/max_user_watches)", __FUNCTION__);
+      m_overflowed = true;
+    }
+    return;
+  }
+
+  // folders reached twice (eg via a symlink) share the same watch
+  CWatch &watch = m_watches[wd];
+  if ((watch.m_libraries & libraries) == libraries)
+    return;
+  if (watch.m_path.IsEmpty())
+    watch.m_path = path;
+  watch.m_libraries |= libraries;
+
+  DIR *dir = opendir(path.c_str());
+  if (!dir)
+    return;
+
+  struct dirent *entry;
+  while ((entry = readdir(dir)) && !m_bStop)
+  {
+    if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, ".."))
+      continue;
+
+    CStdString folder = path + entry->d_name;
+    bool isFolder = entry->d_type == DT_DIR;
+    if (entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK)
+    {
+      struct stat buffer;
+      isFolder = stat(folder.c_str(), &buffer) == 0 && S_ISDIR(buffer.st_mode);
+    }
+    if (isFolder)
+      AddWatches(folder + "/", libraries);
+  }
+  closedir(dir);
+}
+
+void CLibraryMonitor::RemoveWatches(const CStdString &path)
+{
+  for (map<int, CWatch>::iterator i = m_watches.begin(); i != m_watches.end(); )
+  {
+    if (i->second.m_path.Left(path.size()) == path)
+    {
+      inotify_rm_watch(m_fd, i->first);
+      m_watches.erase(i++);
+    }
+    else
+      ++i;
+  }
+}
+
+void CLibraryMonitor::ReadEvents()
+{
+  char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  ssize_t length = read(m_fd, buffer, sizeof(buffer));
+  if (length <= 0)
+    return;
+
+  for (char *ptr = buffer; ptr < buffer + length; )
+  {
+    const struct inotify_event *event = (const struct inotify_event *)ptr;
+    ptr += sizeof(struct inotify_event) + event->len;
+
+    if (event->mask & IN_Q_OVERFLOW)
+    { // we've missed some changes, so update everything we're watching
+      CLog::Log(LOGWARNING, "%s - inotify queue overflowed, updating all sources", __FUNCTION__);
+      map<CStdString, int> roots;
+      GetRoots(roots);
+      for (map<CStdString, int>::const_iterator i = roots.begin(); i != roots.end(); ++i)
+        OnChanged(i->first, i->second);
+      continue;
+    }
+
+    map<int, CWatch>::iterator it = m_watches.find(event->wd);
+    if (it == m_watches.end())
+      continue;
+    if (event->mask & IN_IGNORED)
+    { // the folder has gone, or was unmounted
+      m_watches.erase(it);
+      continue;
+    }
+    const CWatch watch = it->second;
+    if (event->mask & IN_MOVE_SELF)
+    { // the folder was moved somewhere we don't watch, so its path and those below it are stale.
+      // moves within watched folders have already dropped the watch on IN_MOVED_FROM.
+      RemoveWatches(watch.m_path);
+      OnChanged(watch.m_path, watch.m_libraries);
+      continue;
+    }
+    if (!event->len)
+      continue;
+
+    if (event->mask & IN_ISDIR)
+    { // the scanners handle new folders as well as those that have gone, without the need to list the parent
+      CStdString folder = watch.m_path + event->name + "/";
+      if (event->mask & IN_MOVED_FROM)
+        RemoveWatches(folder); // if it's moved to a watched folder it's watched again under its new path
+      if (event->mask & (IN_CREATE | IN_MOVED_TO))
+        AddWatches(folder, watch.m_libraries);
+      OnChanged(folder, watch.m_libraries);
+    }
+    else if (!(event->mask & IN_CREATE)) // new files are handled once they're written
+      OnChanged(watch.m_path, watch.m_libraries);
+  }
+}
+
+void CLibraryMonitor::OnChanged(const CStdString &path, int libraries)
+{
+  CSingleLock lock(m_section);
+  unsigned int now = CTimeUtils::GetTimeMS();
+  if (m_changed.empty())
+    m_firstChange = now;
+  m_lastChange = now;
+  m_changed[path] |= libraries;
+}
+
+void CLibraryMonitor::PrepareChangedFolders()
+{
+  map<CStdString, int> changed;
+  {
+    CSingleLock lock(m_section);
+    unsigned int now = CTimeUtils::GetTimeMS();
+    if (m_changed.empty() || (now - m_lastChange < MONITOR_SETTLE_TIME && now - m_firstChange < MONITOR_MAX_DELAY))
+      return;
+    changed.swap(m_changed);
+  }
+
+  set<CStdString> videoPaths, musicPaths;
+  CVideoDatabase database;
+  bool haveDatabase = (m_libraries & LIBRARY_VIDEO) && database.Open();
+  for (map<CStdString, int>::const_iterator i = changed.begin(); i != changed.end(); ++i)
+  {
+    if (i->second & LIBRARY_VIDEO)
+      videoPaths.insert(haveDatabase ? GetVideoScanPath(database, i->first) : i->first);
+    if (i->second & LIBRARY_MUSIC)
+      musicPaths.insert(i->first);
+  }
+  if (haveDatabase)
+    database.Close();
+
+  CSingleLock lock(m_section);
+  m_videoPaths.insert(videoPaths.begin(), videoPaths.end());
+  m_musicPaths.insert(musicPaths.begin(), musicPaths.end());
+}
+
+CStdString CLibraryMonitor::GetVideoScanPath(CVideoDatabase &database, const CStdString &path)
+{
+  VIDEO::SScanSettings settings;
+  bool foundDirectly = false;
+  ScraperPtr scraper = database.GetScraperForPath(path, settings, foundDirectly);
+  if (!scraper || scraper->Content() != CONTENT_TVSHOWS)
+    return path;
+
+  // walk up to the tvshow's folder, the one just below where the content is set
+  CStdString folder(path), parent;
+  while (!foundDirectly && CUtil::GetParentPath(folder, parent))
+  {
+    database.GetScraperForPath(parent, settings, foundDirectly);
+    if (foundDirectly)
+      break;
+    folder = parent;
+  }
+  return folder;
+}
+
+#endif
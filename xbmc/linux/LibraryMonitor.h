@@ -0,0 +1,127 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "StdString.h"
+#include "utils/Thread.h"
+#include "utils/CriticalSection.h"
+
+#include <map>
+#include <set>
+
+class CGUIDialogVideoScan;
+class CGUIDialogMusicScan;
+class CVideoDatabase;
+
+/*! \brief Watches the local sources of the libraries for changes using inotify
+ Folders that have files added, removed or renamed are handed to the library scanners in a single
+ batch once the changes have settled for a few seconds, so that new files show up in the library
+ without a scan of the whole source.  Only local paths are watched, as inotify can't see changes
+ made to network shares by other machines.
+
+ Enabled via <videolibrary><monitor> and <musiclibrary><monitor> in advancedsettings.xml.
+ */
+class CLibraryMonitor : public CThread
+{
+public:
+  CLibraryMonitor();
+  virtual ~CLibraryMonitor();
+
+  /*! \brief Start (or restart) watching the sources of the libraries it is enabled for.
+   Must be called from the application thread.
+   */
+  void Start();
+
+  /*! \brief Stop watching the sources
+   */
+  void Stop();
+
+  /*! \brief Hand the folders whose changes have settled to the scanners, if they're idle.
+   Must be called from the application thread, as that's where the scans are started from the GUI.
+   The folders are worked out on the monitor thread beforehand, so this doesn't touch the databases.
+   */
+  void UpdateLibraries();
+
+protected:
+  virtual void Process();
+
+private:
+  enum LIBRARY { LIBRARY_VIDEO = 1, LIBRARY_MUSIC = 2 };
+
+  /*! \brief A watched folder, and the libraries whose sources it is within
+   */
+  class CWatch
+  {
+  public:
+    CWatch() { m_libraries = 0; };
+    CStdString m_path;
+    int        m_libraries;
+  };
+
+  /*! \brief Retrieve the local folders holding library content
+   \param roots [out] the folders to watch, along with the libraries they belong to
+   */
+  void GetRoots(std::map<CStdString, int> &roots);
+
+  /*! \brief Watch a folder and all its subfolders
+   \param path the folder to watch
+   \param libraries the libraries the folder belongs to
+   */
+  void AddWatches(const CStdString &path, int libraries);
+
+  /*! \brief Stop watching a folder and all its subfolders, eg once it has been moved away
+   \param path the folder to stop watching
+   */
+  void RemoveWatches(const CStdString &path);
+
+  /*! \brief Read the pending inotify events, noting the folders that changed
+   */
+  void ReadEvents();
+
+  /*! \brief Note that a folder changed, so that it's updated once changes have settled
+   */
+  void OnChanged(const CStdString &path, int libraries);
+
+  /*! \brief Work out the folders to scan once changes have settled.  Called on the monitor thread,
+   as finding the folder to scan for a video folder needs the video database.
+   */
+  void PrepareChangedFolders();
+
+  /*! \brief Retrieve the folder to scan to pick up a change in a video folder
+   Episodes are scanned per tvshow, so a change anywhere within a tvshow's folder updates the tvshow.
+   */
+  CStdString GetVideoScanPath(CVideoDatabase &database, const CStdString &path);
+
+  CGUIDialogVideoScan *m_videoScan;
+  CGUIDialogMusicScan *m_musicScan;
+  int m_libraries;                       ///< the libraries whose sources are watched
+
+  int m_fd;                              ///< inotify instance
+  bool m_overflowed;                     ///< whether we've warned that the inotify watch limit was reached
+  std::map<int, CWatch> m_watches;       ///< watched folders by watch descriptor
+  CCriticalSection m_section;            ///< protects the changed folders, the change times and the folders to scan
+  std::map<CStdString, int> m_changed;   ///< changed folders, along with the libraries they belong to
+  std::set<CStdString> m_videoPaths;     ///< settled folders for the video scanner to update
+  std::set<CStdString> m_musicPaths;     ///< settled folders for the music scanner to update
+  unsigned int m_firstChange;            ///< time (in ms) of the first change not yet handed to the scanners
+  unsigned int m_lastChange;             ///< time (in ms) of the most recent change
+};
@@ -22,6 +22,8 @@
 #include "Archive.h"
 #include "FileSystem/File.h"
 
+#include <algorithm>
+
 using namespace XFILE;
 
 #define BUFFER_MAX 4096
@@ -32,20 +34,24 @@ CArchive::CArchive(CFile* pFile, int mode)
   m_iMode = mode;
 
   m_pBuffer = new BYTE[BUFFER_MAX];
-  memset(m_pBuffer, 0, sizeof(m_pBuffer));
+  memset(m_pBuffer, 0, BUFFER_MAX);
 
   m_BufferPos = 0;
+  m_BufferSize = 0;
+  m_stringTable = false;
 }
 
 CArchive::~CArchive()
 {
-  FlushBuffer();
+  Close();
   delete[] m_pBuffer;
   m_BufferPos = 0;
 }
 
 void CArchive::Close()
 {
+  if (m_iMode == store && m_stringTable)
+    WriteStringTable();
   FlushBuffer();
 }
 
@@ -59,6 +65,59 @@ bool CArchive::IsStoring()
   return (m_iMode == store);
 }
 
+bool CArchive::UseStringTable()
+{
+  if (m_iMode == store)
+  {
+    m_stringTable = true;
+    return true;
+  }
+
+  // the table is located via its offset, stored at the very end of the archive
+  int64_t start = m_pFile->GetPosition() - (m_BufferSize - m_BufferPos);
+  int64_t length = m_pFile->GetLength();
+  int64_t offset = 0;
+  if (length < start + (int64_t)sizeof(offset) || m_pFile->Seek(length - sizeof(offset), SEEK_SET) < 0)
+    return false;
+  m_BufferPos = m_BufferSize = 0;
+  *this >> offset;
+
+  if (offset < start || offset > length - (int64_t)sizeof(offset) || m_pFile->Seek(offset, SEEK_SET) != offset)
+    return false;
+  m_BufferPos = m_BufferSize = 0;
+  int count = 0;
+  *this >> count;
+  if (count < 0 || count > length - offset)
+    return false;
+  m_loadedStrings.resize(count);
+  for (int i = 0; i < count; ++i)
+    *this >> m_loadedStrings[i];
+
+  if (m_pFile->Seek(start, SEEK_SET) != start)
+    return false;
+  m_BufferPos = m_BufferSize = 0;
+  m_stringTable = true;
+  return true;
+}
+
+void CArchive::WriteStringTable()
+{
+  std::vector<const CStdString *> strings(m_storedStrings.size());
+  for (std::map<CStdString, int>::const_iterator i = m_storedStrings.begin(); i != m_storedStrings.end(); ++i)
+    strings[i->second] = &i->first;
+
+  FlushBuffer();
+  int64_t offset = m_pFile->GetPosition();
+
+  // the table itself holds the strings inline
+  m_stringTable = false;
+  *this << (int)strings.size();
+  for (unsigned int i = 0; i < strings.size(); ++i)
+    *this << *strings[i];
+  *this << offset;
+  m_storedStrings.clear();
+}
+
 CArchive& CArchive::operator<<(float f)
 {
   int size = sizeof(float);
@@ -145,6 +204,12 @@ CArchive& CArchive::operator<<(char c)
 
 CArchive& CArchive::operator<<(const CStdString& str)
 {
+  if (m_stringTable)
+  {
+    std::pair<std::map<CStdString, int>::iterator, bool> stored = m_storedStrings.insert(std::make_pair(str, (int)m_storedStrings.size()));
+    return *this << stored.first->second;
+  }
+
   *this << str.GetLength();
 
   int size = str.GetLength();
@@ -212,59 +277,70 @@ CArchive& CArchive::operator<<(IArchivable& obj)
 
 CArchive& CArchive::operator>>(float& f)
 {
-  m_pFile->Read((void*)&f, sizeof(float));
+  Read(&f, sizeof(float));
 
   return *this;
 }
 
 CArchive& CArchive::operator>>(double& d)
 {
-  m_pFile->Read((void*)&d, sizeof(double));
+  Read(&d, sizeof(double));
 
   return *this;
 }
 
 CArchive& CArchive::operator>>(int& i)
 {
-  m_pFile->Read((void*)&i, sizeof(int));
+  Read(&i, sizeof(int));
 
   return *this;
 }
 
 CArchive& CArchive::operator>>(unsigned int& i)
 {
-  m_pFile->Read((void*)&i, sizeof(unsigned int));
+  Read(&i, sizeof(unsigned int));
 
   return *this;
 }
 
 CArchive& CArchive::operator>>(int64_t& i64)
 {
-  m_pFile->Read((void*)&i64, sizeof(int64_t));
+  Read(&i64, sizeof(int64_t));
 
   return *this;
 }
 
 CArchive& CArchive::operator>>(bool& b)
 {
-  m_pFile->Read((void*)&b, sizeof(bool));
+  Read(&b, sizeof(bool));
 
   return *this;
 }
 
 CArchive& CArchive::operator>>(char& c)
 {
-  m_pFile->Read((void*)&c, sizeof(char));
+  Read(&c, sizeof(char));
 
   return *this;
 }
 
 CArchive& CArchive::operator>>(CStdString& str)
 {
+  if (m_stringTable)
+  {
+    int index = -1;
+    *this >> index;
+    if (index >= 0 && index < (int)m_loadedStrings.size())
+      str = m_loadedStrings[index];
+    else
+      str.clear();
+    return *this;
+  }
+
   int iLength = 0;
   *this >> iLength;
 
-  m_pFile->Read((void*)str.GetBufferSetLength(iLength), iLength);
+  Read(str.GetBufferSetLength(iLength), iLength);
   str.ReleaseBuffer();
 
 
@@ -276,7 +352,7 @@ CArchive& CArchive::operator>>(CStdStringW& str)
   int iLength = 0;
   *this >> iLength;
 
-  m_pFile->Read((void*)str.GetBufferSetLength(iLength), iLength);
+  Read(str.GetBufferSetLength(iLength), iLength);
   str.ReleaseBuffer();
 
 
@@ -285,7 +361,7 @@ CArchive& CArchive::operator>>(CStdStringW& str)
 
 CArchive& CArchive::operator>>(SYSTEMTIME& time)
 {
-  m_pFile->Read((void*)&time, sizeof(SYSTEMTIME));
+  Read(&time, sizeof(SYSTEMTIME));
 
   return *this;
 }
@@ -297,9 +373,41 @@ CArchive& CArchive::operator>>(IArchivable& obj)
   return *this;
 }
 
+void CArchive::Read(void *data, unsigned int size)
+{
+  uint8_t *dest = (uint8_t *)data;
+  while (size)
+  {
+    if (m_BufferPos >= m_BufferSize)
+    {
+      m_BufferPos = 0;
+      if (size >= BUFFER_MAX)
+      { // no point in buffering large reads
+        m_BufferSize = 0;
+        unsigned int read = m_pFile->Read(dest, size);
+        if (read < size)
+          memset(dest + read, 0, size - read);
+        return;
+      }
+      m_BufferSize = m_pFile->Read(m_pBuffer, BUFFER_MAX);
+      if (m_BufferSize <= 0 || m_BufferSize > BUFFER_MAX)
+      { // out of data
+        m_BufferSize = 0;
+        memset(dest, 0, size);
+        return;
+      }
+    }
+    unsigned int copy = std::min(size, (unsigned int)(m_BufferSize - m_BufferPos));
+    memcpy(dest, m_pBuffer + m_BufferPos, copy);
+    m_BufferPos += copy;
+    dest += copy;
+    size -= copy;
+  }
+}
+
 void CArchive::FlushBuffer()
 {
-  if (m_BufferPos > 0)
+  if (m_iMode == store && m_BufferPos > 0)
   {
     m_pFile->Write(m_pBuffer, m_BufferPos);
     m_BufferPos = 0;
@@ -24,6 +24,9 @@
 #include "StdString.h"
 #include "system.h" // for SYSTEMTIME
 
+#include <map>
+#include <vector>
+
 namespace XFILE
 {
   class CFile;
@@ -72,15 +75,30 @@ public:
   bool IsLoading();
   bool IsStoring();
 
+  /*! \brief Store each distinct string once, in a table at the end of the archive
+   Strings are archived as their index in the table, which keeps archives of many similar items (eg
+   a library listing) small, and lets the loaded strings share their data.  Must be called before any
+   strings are archived, both when storing and when loading.  Loading requires a seekable file.
+   \return true if the string table is in use, false if the archive has no valid string table.
+   */
+  bool UseStringTable();
+
   void Close();
 
   enum Mode {load = 0, store};
 
 protected:
   void FlushBuffer();
+  void Read(void *data, unsigned int size);
+  void WriteStringTable();
   XFILE::CFile* m_pFile;
   int m_iMode;
   uint8_t *m_pBuffer;
   int m_BufferPos;
+  int m_BufferSize; ///< amount of data read into the buffer when loading
+
+  bool m_stringTable;                        ///< whether strings are archived via the string table
+  std::map<CStdString, int> m_storedStrings; ///< index of the strings stored so far
+  std::vector<CStdString> m_loadedStrings;   ///< the strings of a loaded archive, by index
 };
 
@@ -32,6 +32,11 @@ long AtomicDecrement(volatile long* pAddr);
 long AtomicAdd(volatile long* pAddr, long amount);
 long AtomicSubtract(volatile long* pAddr, long amount);
 
+// the above are yet to be implemented on ARM, where lock free code must not be used
+#if !defined(__arm__)
+#define HAS_ATOMICS
+#endif
+
 class CAtomicSpinLock
 {
 public:
@@ -53,10 +53,48 @@ static inline int _private_gettimeofday( struct timeval *tv, void *tz )
 #define gettimeofday(TV, TZ) _private_gettimeofday((TV), (TZ))
 #endif
 
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define HAS_CPUID
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static void cpuid(int func, int subfunc, unsigned int regs[4])
+{
+#ifdef _MSC_VER
+  __cpuidex((int*)regs, func, subfunc);
+#elif defined(__i386__) && defined(__PIC__)
+  // ebx holds the GOT pointer, so preserve it
+  __asm__ __volatile__ ("xchgl %%ebx, %1\n\t"
+                        "cpuid\n\t"
+                        "xchgl %%ebx, %1"
+                        : "=a" (regs[0]), "=r" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+                        : "a" (func), "c" (subfunc));
+#else
+  __asm__ __volatile__ ("cpuid"
+                        : "=a" (regs[0]), "=b" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+                        : "a" (func), "c" (subfunc));
+#endif
+}
+
+static unsigned int xgetbv(unsigned int index)
+{
+#ifdef _MSC_VER
+  return (unsigned int)_xgetbv(index);
+#else
+  unsigned int eax, edx;
+  // xgetbv, spelled out for assemblers that don't know it
+  __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (index));
+  return eax;
+#endif
+}
+#endif
+
 CCPUInfo::CCPUInfo(void)
 {
   m_fProcStat = m_fProcTemperature = m_fCPUInfo = NULL;
   m_lastUsedPercentage = 0;
+  m_cpuFeatures = 0;
 
 #ifdef __APPLE__
   size_t len = 4;
@@ -158,6 +196,13 @@ CCPUInfo::CCPUInfo(void)
           m_cores[nCurrId].m_strModel.Trim();
         }
       }
+      else if (strncmp(buffer, "Features", strlen("Features"))==0)
+      {
+        // arm only, x86 reports its features through cpuid
+        char *needle = strstr(buffer, ":");
+        if (needle && strstr(needle, " neon"))
+          m_cpuFeatures |= CPU_FEATURE_NEON;
+      }
     }
   }
   else
@@ -168,6 +213,44 @@ CCPUInfo::CCPUInfo(void)
 
   readProcStat(m_userTicks, m_niceTicks, m_systemTicks, m_idleTicks, m_ioTicks);
 #endif
+
+  ReadCPUFeatures();
+}
+
+void CCPUInfo::ReadCPUFeatures()
+{
+#ifdef HAS_CPUID
+  unsigned int regs[4];
+  cpuid(0, 0, regs);
+  unsigned int maxFunc = regs[0];
+  if (maxFunc < 1)
+    return;
+
+  cpuid(1, 0, regs);
+  if (regs[3] & (1 << 23)) m_cpuFeatures |= CPU_FEATURE_MMX;
+  if (regs[3] & (1 << 25)) m_cpuFeatures |= CPU_FEATURE_SSE | CPU_FEATURE_MMX2;
+  if (regs[3] & (1 << 26)) m_cpuFeatures |= CPU_FEATURE_SSE2;
+  if (regs[2] & (1 << 0))  m_cpuFeatures |= CPU_FEATURE_SSE3;
+  if (regs[2] & (1 << 9))  m_cpuFeatures |= CPU_FEATURE_SSSE3;
+  if (regs[2] & (1 << 19)) m_cpuFeatures |= CPU_FEATURE_SSE4;
+  if (regs[2] & (1 << 20)) m_cpuFeatures |= CPU_FEATURE_SSE42;
+
+  // avx needs the os to save the ymm registers on context switches
+  bool osxsave = (regs[2] & (1 << 27)) && (xgetbv(0) & 6) == 6;
+  if (osxsave && (regs[2] & (1 << 28)))
+  {
+    m_cpuFeatures |= CPU_FEATURE_AVX;
+    if (maxFunc >= 7)
+    {
+      cpuid(7, 0, regs);
+      if (regs[1] & (1 << 5))
+        m_cpuFeatures |= CPU_FEATURE_AVX2;
+    }
+  }
+#elif defined(__ARM_NEON__) && !defined(_LINUX)
+  // without /proc/cpuinfo, trust the compiler target
+  m_cpuFeatures |= CPU_FEATURE_NEON;
+#endif
 }
 
 CCPUInfo::~CCPUInfo()
@@ -29,6 +29,18 @@
 #include <string>
 #include <map>
 
+#define CPU_FEATURE_MMX      (1 << 0)
+#define CPU_FEATURE_MMX2     (1 << 1)
+#define CPU_FEATURE_SSE      (1 << 2)
+#define CPU_FEATURE_SSE2     (1 << 3)
+#define CPU_FEATURE_SSE3     (1 << 4)
+#define CPU_FEATURE_SSSE3    (1 << 5)
+#define CPU_FEATURE_SSE4     (1 << 6)
+#define CPU_FEATURE_SSE42    (1 << 7)
+#define CPU_FEATURE_AVX      (1 << 8)
+#define CPU_FEATURE_AVX2     (1 << 9)
+#define CPU_FEATURE_NEON     (1 << 10)
+
 struct CoreInfo
 {
   int    m_id;
@@ -55,6 +67,7 @@ public:
   float getCPUFrequency();
   CTemperature getTemperature();
   std::string& getCPUModel() { return m_cpuModel; }
+  int GetCPUFeatures() const { return m_cpuFeatures; }
 
   const CoreInfo &GetCoreInfo(int nCoreId);
   bool HasCoreId(int nCoreId) const;
@@ -64,6 +77,7 @@ public:
 private:
   bool readProcStat(unsigned long long& user, unsigned long long& nice, unsigned long long& system,
     unsigned long long& idle, unsigned long long& io);
+  void ReadCPUFeatures();
 
   FILE* m_fProcStat;
   FILE* m_fProcTemperature;
@@ -79,6 +93,7 @@ private:
   time_t m_lastReadTime;
   std::string m_cpuModel;
   int m_cpuCount;
+  int m_cpuFeatures;
 
   std::map<int, CoreInfo> m_cores;
 };
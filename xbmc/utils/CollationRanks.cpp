@@ -0,0 +1,131 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "CollationRanks.h"
+
+#include <algorithm>
+#include <locale>
+#include <set>
+#include <string.h>
+
+using namespace std;
+
+// AlphaNumericCompare() only compares numbers of up to 15 digits at a time
+#define SORT_MAX_DIGITS 15
+
+namespace
+{
+  class CCollate
+  {
+  public:
+    CCollate() : m_coll(use_facet< collate<wchar_t> >(locale())) {};
+    bool operator()(const wchar_t &left, const wchar_t &right) const
+    {
+      return m_coll.compare(&left, &left + 1, &right, &right + 1) < 0;
+    }
+  private:
+    const collate<wchar_t> &m_coll;
+  };
+}
+
+CCollationRanks::CCollationRanks(const vector<const CStdStringW *> &labels)
+{
+  // gather the characters in use, as collating every character of the locale would be a waste
+  bool seen[256] = { false };
+  set<wchar_t> others;
+  seen[L'0'] = true;
+  for (vector<const CStdStringW *>::const_iterator i = labels.begin(); i != labels.end(); ++i)
+  {
+    for (const wchar_t *c = (*i)->c_str(); *c; ++c)
+    {
+      wchar_t lc = Fold(*c);
+      if (lc >= 0 && lc < 256)
+        seen[lc] = true;
+      else
+        others.insert(lc);
+    }
+  }
+  vector<wchar_t> chars;
+  for (int c = 0; c < 256; ++c)
+  {
+    if (seen[c])
+      chars.push_back((wchar_t)c);
+  }
+  chars.insert(chars.end(), others.begin(), others.end());
+  stable_sort(chars.begin(), chars.end(), CCollate());
+
+  // characters that collate equally share a rank
+  CCollate compare;
+  uint32_t rank = 0;
+  memset(m_ascii, 0, sizeof(m_ascii));
+  for (unsigned int i = 0; i < chars.size(); ++i)
+  {
+    if (i == 0 || compare(chars[i-1], chars[i]))
+      rank++;
+    if (chars[i] >= 0 && chars[i] < 256)
+      m_ascii[chars[i]] = rank;
+    else
+      m_others[chars[i]] = rank;
+  }
+}
+
+uint32_t CCollationRanks::Rank(wchar_t c) const
+{
+  c = Fold(c);
+  if (c >= 0 && c < 256)
+    return m_ascii[c];
+  map<wchar_t, uint32_t>::const_iterator i = m_others.find(c);
+  return i != m_others.end() ? i->second : 0;
+}
+
+void CCollationRanks::MakeSortKey(const CStdStringW &label, vector<uint32_t> &key) const
+{
+  const uint32_t digitRank = Rank(L'0');
+  key.reserve(label.size() + 2);
+  for (const wchar_t *c = label.c_str(); *c; )
+  {
+    if (*c >= L'0' && *c <= L'9')
+    {
+      const wchar_t *end = c;
+      while (*end >= L'0' && *end <= L'9' && end < c + SORT_MAX_DIGITS)
+        end++;
+      const wchar_t *digits = c;
+      while (digits < end - 1 && *digits == L'0')
+        digits++;
+      if (*digits == L'0')
+        digits = end; // zero has no significant digits
+      key.push_back(digitRank);
+      key.push_back(end - digits);
+      for (; digits < end; ++digits)
+        key.push_back(*digits - L'0');
+      c = end;
+    }
+    else
+      key.push_back(Rank(*c++));
+  }
+}
+
+wchar_t CCollationRanks::Fold(wchar_t c)
+{
+  if (c >= L'A' && c <= L'Z')
+    c += L'a' - L'A';
+  return c;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "StdString.h"
+
+#include <map>
+#include <vector>
+#include <stdint.h>
+
+/*! \brief Ranks of characters in the collation order of the current locale, ignoring ASCII case
+ Used to build sort keys that order as StringUtils::AlphaNumericCompare() does, so that a list can be
+ sorted with plain integer comparisons instead of collating each pair of labels.
+ */
+class CCollationRanks
+{
+public:
+  /*! \brief Rank the characters used by a set of labels
+   \param labels the labels that keys will be built for.  Characters not in these rank as 0.
+   */
+  CCollationRanks(const std::vector<const CStdStringW *> &labels);
+
+  /*! \brief Retrieve the rank of a character, equal for characters that collate equally
+   */
+  uint32_t Rank(wchar_t c) const;
+
+  /*! \brief Build the sort key of a label
+   Characters are replaced by their rank, while each run of digits is replaced by the rank of '0',
+   the number of significant digits and the digits themselves, so that numbers order by value.
+   \param label the label, which must be one of those the ranks were built for
+   \param key [out] the key, to be compared with std::lexicographical_compare()
+   */
+  void MakeSortKey(const CStdStringW &label, std::vector<uint32_t> &key) const;
+
+private:
+  static wchar_t Fold(wchar_t c);
+
+  uint32_t m_ascii[256];
+  std::map<wchar_t, uint32_t> m_others;
+};
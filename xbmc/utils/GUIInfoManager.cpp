@@ -72,11 +72,13 @@
 #include "MediaManager.h"
 #include "TimeUtils.h"
 #include "SingleLock.h"
+#include "AutoPtrHandle.h"
 #include "log.h"
 
 #include "addons/AddonManager.h"
 
 #define SYSHEATUPDATEINTERVAL 60000
+#define MAX_EXPRESSION_DEPTH 64 // max number of operands pending evaluation in a boolean expression
 
 using namespace std;
 using namespace XFILE;
@@ -88,6 +90,8 @@ CGUIInfoManager::CCombinedValue& CGUIInfoManager::CCombinedValue::operator =(con
   this->m_info = mSrc.m_info;
   this->m_id = mSrc.m_id;
   this->m_postfix = mSrc.m_postfix;
+  this->m_depth = mSrc.m_depth;
+  this->m_categories = mSrc.m_categories;
   return *this;
 }
 
@@ -107,6 +111,10 @@ CGUIInfoManager::CGUIInfoManager(void)
   m_currentSlide = new CFileItem;
   m_frameCounter = 0;
   m_lastFPSTime = 0;
+  m_boolEvaluations = 0;
+  m_boolCacheHits = 0;
+  m_evaluationsPerFrame = 0;
+  m_cacheHitsPerFrame = 0;
   ResetLibraryBools();
 }
 
@@ -1697,6 +1705,7 @@ bool CGUIInfoManager::GetBool(int condition1, int contextWindow, const CGUIListI
   if (!item && IsCached(condition1, contextWindow, bReturn)) // never use cache for list items
     return bReturn;
 
+  m_boolEvaluations++;
   int condition = abs(condition1);
 
   if(condition >= COMBINED_VALUES_START && (condition - COMBINED_VALUES_START) < (int)(m_CombinedValues.size()) )
@@ -3513,38 +3522,38 @@ int CGUIInfoManager::GetOperator(const char ch)
 
 bool CGUIInfoManager::EvaluateBooleanExpression(const CCombinedValue &expression, bool &result, int contextWindow, const CGUIListItem *item)
 {
-  // stack to save our bool state as we go
-  stack<bool> save;
-
-  for (list<int>::const_iterator it = expression.m_postfix.begin(); it != expression.m_postfix.end(); ++it)
+  // stack to save our bool state as we go.  the rare expressions too deep for the stack
+  // on hand get one from the heap
+  bool fixed[MAX_EXPRESSION_DEPTH];
+  AUTOPTR::auto_aptr<bool> deep(expression.m_depth > MAX_EXPRESSION_DEPTH ? new bool[expression.m_depth] : NULL);
+  bool *save = deep.get() ? deep.get() : fixed;
+  unsigned int size = 0;
+
+  for (vector<int>::const_iterator it = expression.m_postfix.begin(); it != expression.m_postfix.end(); ++it)
   {
     int expr = *it;
     if (expr == -OPERATOR_NOT)
     { // NOT the top item on the stack
-      if (save.size() < 1) return false;
-      bool expr = save.top();
-      save.pop();
-      save.push(!expr);
+      if (size < 1) return false;
+      save[size - 1] = !save[size - 1];
     }
     else if (expr == -OPERATOR_AND)
     { // AND the top two items on the stack
-      if (save.size() < 2) return false;
-      bool right = save.top(); save.pop();
-      bool left = save.top(); save.pop();
-      save.push(left && right);
+      if (size < 2) return false;
+      size--;
+      save[size - 1] = save[size - 1] && save[size];
     }
     else if (expr == -OPERATOR_OR)
     { // OR the top two items on the stack
-      if (save.size() < 2) return false;
-      bool right = save.top(); save.pop();
-      bool left = save.top(); save.pop();
-      save.push(left || right);
+      if (size < 2) return false;
+      size--;
+      save[size - 1] = save[size - 1] || save[size];
     }
     else  // operator
-      save.push(GetBool(expr, contextWindow, item));
+      save[size++] = GetBool(expr, contextWindow, item);
   }
-  if (save.size() != 1) return false;
-  result = save.top();
+  if (size != 1) return false;
+  result = save[0];
   return true;
 }
 
@@ -3621,6 +3630,26 @@ int CGUIInfoManager::TranslateBooleanExpression(const CStdString &expression)
     save.pop();
   }
 
+  // work out the depth of the evaluation stack, and the state the expression depends on
+  comb.m_depth = 0;
+  comb.m_categories = CACHE_CONSTANT;
+  unsigned int depth = 0;
+  for (vector<int>::const_iterator it = comb.m_postfix.begin(); it != comb.m_postfix.end(); ++it)
+  {
+    if (*it == -OPERATOR_AND || *it == -OPERATOR_OR)
+      depth--;
+    else if (*it != -OPERATOR_NOT)
+    {
+      comb.m_depth = std::max(comb.m_depth, ++depth);
+      comb.m_categories |= GetCacheCategories(*it);
+    }
+  }
+  if (comb.m_depth > MAX_EXPRESSION_DEPTH)
+  { // still evaluated, just never kept across frames
+    CLog::Log(LOGWARNING, "Boolean expression %s is nested deeper than %i, it won't be cached", expression.c_str(), MAX_EXPRESSION_DEPTH);
+    comb.m_categories |= CACHE_VOLATILE;
+  }
+
   // test evaluate
   bool test;
   if (!EvaluateBooleanExpression(comb, test, WINDOW_INVALID))
@@ -3633,6 +3662,11 @@ int CGUIInfoManager::TranslateBooleanExpression(const CStdString &expression)
 void CGUIInfoManager::Clear()
 {
   m_CombinedValues.clear();
+
+  // the ids of the combined values are reused
+  CSingleLock lock(m_critInfo);
+  m_boolCache.clear();
+  m_persistentBoolCache.clear();
 }
 
 void CGUIInfoManager::UpdateFPS()
@@ -3645,11 +3679,21 @@ void CGUIInfoManager::UpdateFPS()
   {
     fTimeSpan /= 1000.0f;
     m_fps = m_frameCounter / fTimeSpan;
+    m_evaluationsPerFrame = m_boolEvaluations / m_frameCounter;
+    m_cacheHitsPerFrame = m_boolCacheHits / m_frameCounter;
     m_lastFPSTime = curTime;
     m_frameCounter = 0;
+    m_boolEvaluations = 0;
+    m_boolCacheHits = 0;
   }
 }
 
+void CGUIInfoManager::GetBoolStats(unsigned int &evaluated, unsigned int &cached) const
+{
+  evaluated = m_evaluationsPerFrame;
+  cached = m_cacheHitsPerFrame;
+}
+
 int CGUIInfoManager::AddListItemProp(const CStdString &str, int offset)
 {
   for (int i=0; i < (int)m_listitemProperties.size(); i++)
@@ -4103,19 +4147,53 @@ void CGUIInfoManager::ResetPersistentCache()
   m_persistentBoolCache.clear();
 }
 
-inline void CGUIInfoManager::CacheBool(int condition, int contextWindow, bool result, bool persistent)
+void CGUIInfoManager::InvalidateCache(unsigned int categories)
+{
+  CSingleLock lock(m_critInfo);
+  for (map<int, pair<bool, unsigned int> >::iterator it = m_persistentBoolCache.begin(); it != m_persistentBoolCache.end(); )
+  {
+    if (it->second.second & categories)
+      m_persistentBoolCache.erase(it++);
+    else
+      ++it;
+  }
+}
+
+unsigned int CGUIInfoManager::GetCacheCategories(int condition) const
+{
+  condition = abs(condition);
+  if (condition >= COMBINED_VALUES_START && (condition - COMBINED_VALUES_START) < (int)m_CombinedValues.size())
+    return m_CombinedValues[condition - COMBINED_VALUES_START].m_categories;
+  if (condition == SYSTEM_ALWAYS_TRUE || condition == SYSTEM_ALWAYS_FALSE || condition == SYSTEM_ETHERNET_LINK_ACTIVE ||
+     (condition >= SYSTEM_PLATFORM_XBOX && condition <= SYSTEM_PLATFORM_OSX))
+    return CACHE_CONSTANT;
+  if (condition >= LIBRARY_HAS_MUSIC && condition <= LIBRARY_HAS_MUSICVIDEOS)
+    return CACHE_LIBRARY;
+  if (condition >= SKIN_HAS_THEME_START && condition <= SKIN_HAS_THEME_END)
+    return CACHE_SKIN;  // changing the theme reloads the skin
+  if (condition >= MULTI_INFO_START && condition <= MULTI_INFO_END && (condition - MULTI_INFO_START) < (int)m_multiInfo.size())
+  {
+    int info = abs(m_multiInfo[condition - MULTI_INFO_START].m_info);
+    if (info == SKIN_BOOL || info == SKIN_STRING)
+      return CACHE_SKIN;
+  }
+  return CACHE_VOLATILE;
+}
+
+inline void CGUIInfoManager::CacheBool(int condition, int contextWindow, bool result)
 {
   // windows have id's up to 13100 or thereabouts (ie 2^14 needed)
   // conditionals have id's up to 100000 or thereabouts (ie 2^18 needed)
+  unsigned int categories = GetCacheCategories(condition);
   CSingleLock lock(m_critInfo);
   int hash = ((contextWindow & 0x3fff) << 18) | (condition & 0x3ffff);
-  if (persistent)
-    m_persistentBoolCache.insert(pair<int, bool>(hash, result));
-  else
+  if (categories & CACHE_VOLATILE)
     m_boolCache.insert(pair<int, bool>(hash, result));
+  else
+    m_persistentBoolCache.insert(make_pair(hash, make_pair(result, categories)));
 }
 
-bool CGUIInfoManager::IsCached(int condition, int contextWindow, bool &result) const
+bool CGUIInfoManager::IsCached(int condition, int contextWindow, bool &result)
 {
   // windows have id's up to 13100 or thereabouts (ie 2^14 needed)
   // conditionals have id's up to 100000 or thereabouts (ie 2^18 needed)
@@ -4126,12 +4204,14 @@ bool CGUIInfoManager::IsCached(int condition, int contextWindow, bool &result) c
   if (it != m_boolCache.end())
   {
     result = (*it).second;
+    m_boolCacheHits++;
     return true;
   }
-  it = m_persistentBoolCache.find(hash);
-  if (it != m_persistentBoolCache.end())
+  map<int, pair<bool, unsigned int> >::const_iterator persistent = m_persistentBoolCache.find(hash);
+  if (persistent != m_persistentBoolCache.end())
   {
-    result = (*it).second;
+    result = persistent->second.first;
+    m_boolCacheHits++;
     return true;
   }
 
@@ -4334,6 +4414,7 @@ void CGUIInfoManager::SetLibraryBool(int condition, bool value)
     default:
       break;
   }
+  InvalidateCache(CACHE_LIBRARY);
 }
 
 void CGUIInfoManager::ResetLibraryBools()
@@ -4342,6 +4423,7 @@ void CGUIInfoManager::ResetLibraryBools()
   m_libraryHasMovies = -1;
   m_libraryHasTVShows = -1;
   m_libraryHasMusicVideos = -1;
+  InvalidateCache(CACHE_LIBRARY);
 }
 
 bool CGUIInfoManager::GetLibraryBool(int condition)
@@ -35,6 +35,7 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 namespace MUSIC_INFO
 {
@@ -548,6 +549,19 @@ private:
 class CGUIInfoManager : public IMsgTargetCallback
 {
 public:
+  /*! \brief Categories of state that bool conditions depend on.
+   Conditions that only depend on stable state (the skin settings, the library contents, or nothing at all)
+   are cached until the state they depend on is invalidated, rather than being evaluated every frame.
+   \sa InvalidateCache()
+   */
+  enum CACHE_CATEGORY
+  {
+    CACHE_CONSTANT = 0,    ///< doesn't change while the skin is loaded
+    CACHE_VOLATILE = 0x01, ///< may change at any time, so is evaluated every frame
+    CACHE_SKIN     = 0x02, ///< depends on the skin settings
+    CACHE_LIBRARY  = 0x04  ///< depends on the library contents
+  };
+
   CGUIInfoManager(void);
   virtual ~CGUIInfoManager(void);
 
@@ -620,6 +634,17 @@ public:
   void ResetCache();
   void ResetPersistentCache();
 
+  /*! \brief Invalidate the cached conditions that depend on the given categories of state
+   \param categories the categories that have changed, a combination of CACHE_CATEGORY values
+   */
+  void InvalidateCache(unsigned int categories);
+
+  /*! \brief Retrieve the number of bool conditions evaluated per frame, averaged over the last second
+   \param evaluated [out] number of conditions evaluated per frame
+   \param cached [out] number of conditions retrieved from the cache per frame
+   */
+  void GetBoolStats(unsigned int &evaluated, unsigned int &cached) const;
+
   CStdString GetItemLabel(const CFileItem *item, int info) const;
   CStdString GetItemImage(const CFileItem *item, int info) const;
 
@@ -698,6 +723,12 @@ protected:
   unsigned int m_frameCounter;
   unsigned int m_lastFPSTime;
 
+  // condition evaluation counters
+  unsigned int m_boolEvaluations;  ///< conditions evaluated since the last fps update
+  unsigned int m_boolCacheHits;    ///< conditions retrieved from the cache since the last fps update
+  unsigned int m_evaluationsPerFrame;
+  unsigned int m_cacheHitsPerFrame;
+
   std::map<int, int> m_containerMoves;  // direction of list moving
   int m_nextWindowID;
   int m_prevWindowID;
@@ -707,7 +738,9 @@ protected:
   public:
     CStdString m_info;    // the text expression
     int m_id;             // the id used to identify this expression
-    std::list<int> m_postfix;  // the postfix binary expression
+    std::vector<int> m_postfix;  // the postfix binary expression
+    unsigned int m_depth;        // the maximum depth of the evaluation stack
+    unsigned int m_categories;   // the CACHE_CATEGORY values of the operands
     CCombinedValue& operator=(const CCombinedValue& mSrc);
   };
 
@@ -718,12 +751,13 @@ protected:
   std::vector<CCombinedValue> m_CombinedValues;
 
   // routines for caching the bool results
-  bool IsCached(int condition, int contextWindow, bool &result) const;
-  void CacheBool(int condition, int contextWindow, bool result, bool persistent=false);
+  bool IsCached(int condition, int contextWindow, bool &result);
+  void CacheBool(int condition, int contextWindow, bool result);
+  unsigned int GetCacheCategories(int condition) const;
   std::map<int, bool> m_boolCache;
 
-  // persistent cache
-  std::map<int, bool> m_persistentBoolCache;
+  // persistent cache of conditions that don't depend on volatile state, along with the categories they depend on
+  std::map<int, std::pair<bool, unsigned int> > m_persistentBoolCache;
   int m_libraryHasMusic;
   int m_libraryHasMovies;
   int m_libraryHasTVShows;
@@ -22,6 +22,10 @@
 #include "JobManager.h"
 #include <algorithm>
 #include "SingleLock.h"
+#include "TimeUtils.h"
+#include "CPUInfo.h"
+#include "AdvancedSettings.h"
+#include "log.h"
 
 using namespace std;
 
@@ -32,9 +36,11 @@ bool CJob::ShouldCancel(unsigned int progress, unsigned int total) const
   return false;
 }
 
-CJobWorker::CJobWorker(CJobManager *manager)
+CJobWorker::CJobWorker(CJobManager *manager, CJob::PRIORITY priority, unsigned int slot)
 {
   m_jobManager = manager;
+  m_pool = priority;
+  m_slot = slot;
   Create(true); // start work immediately, and kill ourselves when we're done
 }
 
@@ -61,7 +67,7 @@ void CJobWorker::Process()
 
     // we have a job to do
     bool success = job->DoWork();
-    m_jobManager->OnJobComplete(success, job);
+    m_jobManager->OnJobComplete(this, success, job);
   }
 }
 
@@ -131,6 +137,21 @@ void CJobQueue::CancelJobs()
   m_processing.clear();
 }
 
+CJobManager::CWorkerPool::CWorkerPool()
+{
+  m_workers = 0;
+  m_idle = 0;
+  m_slotsUsed = 0;
+  m_nextSlot = 0;
+  m_queued = 0;
+  m_processing = 0;
+  m_completed = 0;
+  m_stolen = 0;
+  m_avgWaitTime = 0;
+  m_maxWaitTime = 0;
+  m_avgRunTime = 0;
+}
+
 CJobManager &CJobManager::GetInstance()
 {
   static CJobManager sJobManager;
@@ -140,31 +161,49 @@ CJobManager &CJobManager::GetInstance()
 CJobManager::CJobManager()
 {
   m_jobCounter = 0;
+  m_workers = 0;
+  for (unsigned int priority = CJob::PRIORITY_LOW; priority <= CJob::PRIORITY_HIGH; ++priority)
+    m_retire[priority] = 0;
   m_running = true;
 }
 
 void CJobManager::CancelJobs()
 {
-  CSingleLock lock(m_section);
   m_running = false;
 
-  // clear any pending jobs
   for (unsigned int priority = CJob::PRIORITY_LOW; priority <= CJob::PRIORITY_HIGH; ++priority)
   {
-    for_each(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), mem_fun_ref(&CWorkItem::FreeJob));
-    m_jobQueue[priority].clear();
+    CWorkerPool &pool = m_pools[priority];
+    for (long i = 0; i < pool.m_slotsUsed; ++i)
+    {
+      CWorkerSlot &slot = pool.m_slots[i];
+      CSingleLock lock(slot.m_section);
+
+      // clear any pending jobs
+      long cleared = slot.m_queue.size();
+      for_each(slot.m_queue.begin(), slot.m_queue.end(), mem_fun_ref(&CWorkItem::FreeJob));
+      slot.m_queue.clear();
+
+      // cancel any callbacks on jobs still processing
+      slot.m_current.Cancel();
+      lock.Leave();
+
+      CSingleLock poolLock(pool.m_section);
+      pool.m_queued -= cleared;
+    }
   }
 
-  // cancel any callbacks on jobs still processing
-  for_each(m_processing.begin(), m_processing.end(), mem_fun_ref(&CWorkItem::Cancel));
+  LogStats();
 
   // tell our workers to finish
-  while (m_workers.size())
+  for (unsigned int priority = CJob::PRIORITY_LOW; priority <= CJob::PRIORITY_HIGH; ++priority)
   {
-    lock.Leave();
-    m_jobEvent.Set();
-    Sleep(0); // yield after setting the event to give the workers some time to die
-    lock.Enter();
+    CWorkerPool &pool = m_pools[priority];
+    while (pool.m_workers)
+    {
+      pool.m_jobEvent.Set();
+      Sleep(0); // yield after setting the event to give the workers some time to die
+    }
   }
 }
 
@@ -174,150 +213,324 @@ CJobManager::~CJobManager()
 
 unsigned int CJobManager::AddJob(CJob *job, IJobCallback *callback, CJob::PRIORITY priority)
 {
-  CSingleLock lock(m_section);
+  CWorkerPool &pool = m_pools[priority];
 
   // create a work item for this job
-  CWorkItem work(job, m_jobCounter++, callback);
-  m_jobQueue[priority].push_back(work);
+  CWorkItem work(job, 0, callback);
+  work.m_queued = CTimeUtils::GetTimeMS();
+
+  // spread the jobs over the worker queues - idle workers steal them from each other
+  unsigned int slot;
+  {
+    CSingleLock lock(pool.m_section);
+    slot = pool.m_nextSlot++ % GetMaxWorkers();
+    if (pool.m_slotsUsed <= (long)slot)
+      pool.m_slotsUsed = slot + 1;
+    pool.m_queued++;
+
+    CSingleLock managerLock(m_section);
+    work.m_id = ++m_jobCounter;
+  }
+
+  {
+    CSingleLock lock(pool.m_slots[slot].m_section);
+    pool.m_slots[slot].m_queue.push_back(work);
+  }
 
-  StartWorkers(priority);
+  // wake up an idle worker, or start a new one if all are busy
+  pool.m_jobEvent.Set();
+  StartWorker(priority);
   return work.m_id;
 }
 
 void CJobManager::CancelJob(unsigned int jobID)
 {
-  CSingleLock lock(m_section);
-
-  // check whether we have this job in the queue
   for (unsigned int priority = CJob::PRIORITY_LOW; priority <= CJob::PRIORITY_HIGH; ++priority)
   {
-    JobQueue::iterator i = find(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), jobID);
-    if (i != m_jobQueue[priority].end())
+    CWorkerPool &pool = m_pools[priority];
+    for (long i = 0; i < pool.m_slotsUsed; ++i)
     {
-      delete i->m_job;
-      m_jobQueue[priority].erase(i);
-      return;
+      CWorkerSlot &slot = pool.m_slots[i];
+      CSingleLock lock(slot.m_section);
+
+      // check whether we have this job in the queue
+      CWorkerSlot::JobQueue::iterator it = find(slot.m_queue.begin(), slot.m_queue.end(), jobID);
+      if (it != slot.m_queue.end())
+      {
+        delete it->m_job;
+        slot.m_queue.erase(it);
+        lock.Leave();
+
+        CSingleLock poolLock(pool.m_section);
+        pool.m_queued--;
+        return;
+      }
+      // or if we're processing it
+      if (slot.m_current.m_job && slot.m_current.m_id == jobID)
+      {
+        slot.m_current.Cancel(); // job is in progress, so only thing to do is to remove callback
+        return;
+      }
     }
   }
-  // or if we're processing it
-  Processing::iterator it = find(m_processing.begin(), m_processing.end(), jobID);
-  if (it != m_processing.end())
-    it->m_callback = NULL; // job is in progress, so only thing to do is to remove callback
 }
 
-void CJobManager::StartWorkers(CJob::PRIORITY priority)
+void CJobManager::StartWorker(CJob::PRIORITY priority)
 {
-  CSingleLock lock(m_section);
+  CWorkerPool &pool = m_pools[priority];
+  CSingleLock lock(pool.m_section);
+
+  // check whether a worker is still needed
+  if (pool.m_idle || !pool.m_queued || !m_running)
+    return;
 
-  // check how many free threads we have
-  if (m_processing.size() >= GetMaxWorkers(priority))
+  CSingleLock managerLock(m_section);
+  if (m_workers >= GetMaxWorkers(priority))
+  { // ask an idle worker of another pool to make way for us.  Their idle counts are read
+    // without holding their sections, which is fine as the worker checks again once woken
+    for (unsigned int other = CJob::PRIORITY_LOW; other <= CJob::PRIORITY_HIGH; ++other)
+    {
+      if (other != (unsigned int)priority && (long)m_retire[other] < m_pools[other].m_idle)
+      {
+        m_retire[other]++;
+        m_pools[other].m_jobEvent.Set();
+        break;
+      }
+    }
     return;
+  }
 
-  // do we have any sleeping threads?
-  if (m_processing.size() < m_workers.size())
+  // attach a new worker to the first free slot
+  for (unsigned int i = 0; i < JOBMANAGER_MAX_WORKERS; ++i)
   {
-    m_jobEvent.Set();
+    CWorkerSlot &slot = pool.m_slots[i];
+    if (slot.m_worker)
+      continue;
+
+    if (pool.m_slotsUsed <= (long)i)
+      pool.m_slotsUsed = i + 1;
+
+    m_workers++;
+    pool.m_workers++;
+    slot.m_worker = new CJobWorker(this, priority, i);
     return;
   }
+}
 
-  // everyone is busy - we need more workers
-  m_workers.push_back(new CJobWorker(this));
+void CJobManager::StartWaitingWorkers()
+{
+  for (unsigned int priority = CJob::PRIORITY_HIGH + 1; priority-- > CJob::PRIORITY_LOW; )
+    StartWorker(CJob::PRIORITY(priority));
 }
 
-CJob *CJobManager::PopJob()
+bool CJobManager::ShouldRetire(CJob::PRIORITY priority)
 {
   CSingleLock lock(m_section);
-  for (int priority = CJob::PRIORITY_HIGH; priority >= CJob::PRIORITY_LOW; --priority)
+  if (!m_retire[priority])
+    return false;
+  m_retire[priority]--;
+  return true;
+}
+
+bool CJobManager::TakeJob(CWorkerPool &pool, unsigned int from, unsigned int to)
+{
+  CWorkerSlot &source = pool.m_slots[from];
+  CWorkerSlot &target = pool.m_slots[to];
+
+  // hold both slots (always in the same order) so that the job is visible to CancelJob() throughout
+  CSingleLock lock1(from < to ? source.m_section : target.m_section);
+  CSingleLock lock2(from < to ? target.m_section : source.m_section);
+  if (source.m_queue.empty())
+    return false;
+
+  target.m_current = source.m_queue.front();
+  source.m_queue.pop_front();
+  return true;
+}
+
+CJob *CJobManager::PopJob(CJobWorker *worker)
+{
+  CWorkerPool &pool = m_pools[worker->m_pool];
+
+  // process our own queue first, then steal from the other workers in the pool
+  unsigned int slots;
   {
-    if (m_jobQueue[priority].size() && m_processing.size() < GetMaxWorkers(CJob::PRIORITY(priority)))
-    {
-      CWorkItem job = m_jobQueue[priority].front();
-      m_jobQueue[priority].pop_front();
-      // add to the processing vector
-      m_processing.push_back(job);
-      job.m_job->m_callback = this;
-      return job.m_job;
-    }
+    CSingleLock lock(pool.m_section);
+    slots = pool.m_slotsUsed;
+  }
+  for (unsigned int i = 0; i < slots; ++i)
+  {
+    unsigned int from = (worker->m_slot + i) % slots;
+    if (!TakeJob(pool, from, worker->m_slot))
+      continue;
+
+    // only our own thread changes the current job, so we can safely access it unlocked
+    CWorkItem &job = pool.m_slots[worker->m_slot].m_current;
+    job.m_started = CTimeUtils::GetTimeMS();
+
+    CSingleLock lock(pool.m_section);
+    long wait = job.m_started - job.m_queued;
+    pool.m_avgWaitTime += wait - pool.m_avgWaitTime / 16;
+    if (wait > pool.m_maxWaitTime)
+      pool.m_maxWaitTime = wait;
+    pool.m_queued--;
+    pool.m_processing++;
+    if (from != worker->m_slot)
+      pool.m_stolen++;
+
+    // there may have been several jobs queued while only one idle worker was woken
+    if (pool.m_queued > 0 && pool.m_idle > 0)
+      pool.m_jobEvent.Set();
+    lock.Leave();
+
+    job.m_job->m_callback = this;
+    return job.m_job;
   }
   return NULL;
 }
 
-CJob *CJobManager::GetNextJob(const CJobWorker *worker)
+CJob *CJobManager::GetNextJob(CJobWorker *worker)
 {
-  CSingleLock lock(m_section);
+  CWorkerPool &pool = m_pools[worker->m_pool];
   while (m_running)
   {
     // grab a job off the queue if we have one
-    CJob *job = PopJob();
+    CJob *job = PopJob(worker);
     if (job)
       return job;
     // no jobs are left - sleep for 30 seconds to allow new jobs to come in
-    lock.Leave();
-    bool newJob = m_jobEvent.WaitMSec(30000);
-    lock.Enter();
-    if (!newJob)
+    {
+      CSingleLock lock(pool.m_section);
+      pool.m_idle++;
+    }
+    bool newJob = pool.m_jobEvent.WaitMSec(30000);
+    {
+      CSingleLock lock(pool.m_section);
+      pool.m_idle--;
+    }
+    // exit if we've been asked to make way for a worker of another pool
+    if (!newJob || ShouldRetire(worker->m_pool))
       break;
   }
   // ensure no jobs have come in during the period after
   // timeout and before we held the lock
-  CJob *job = PopJob();
+  CSingleLock lock(pool.m_section);
+  CJob *job = PopJob(worker);
   if (job)
     return job;
   // have no jobs
   RemoveWorker(worker);
+  lock.Leave();
+
+  // another pool may have been waiting for us to exit
+  StartWaitingWorkers();
   return NULL;
 }
 
 bool CJobManager::OnJobProgress(unsigned int progress, unsigned int total, const CJob *job) const
 {
-  CSingleLock lock(m_section);
-  // find the job in the processing queue, and check whether it's cancelled (no callback)
-  Processing::const_iterator i = find(m_processing.begin(), m_processing.end(), job);
-  if (i != m_processing.end())
+  // find the job amongst those being processed, and check whether it's cancelled (no callback)
+  for (unsigned int priority = CJob::PRIORITY_LOW; priority <= CJob::PRIORITY_HIGH; ++priority)
   {
-    CWorkItem item(*i);
-    lock.Leave(); // leave section prior to call
-    if (item.m_callback)
+    const CWorkerPool &pool = m_pools[priority];
+    for (long i = 0; i < pool.m_slotsUsed; ++i)
     {
-      item.m_callback->OnJobProgress(item.m_id, progress, total, job);
-      return false;
+      const CWorkerSlot &slot = pool.m_slots[i];
+      CSingleLock lock(slot.m_section);
+      if (slot.m_current.m_job != job)
+        continue;
+
+      CWorkItem item(slot.m_current);
+      lock.Leave(); // leave section prior to call
+      if (item.m_callback)
+      {
+        item.m_callback->OnJobProgress(item.m_id, progress, total, job);
+        return false;
+      }
+      return true;
     }
   }
   return true; // couldn't find the job, or it's been cancelled
 }
 
-void CJobManager::OnJobComplete(bool success, CJob *job)
+void CJobManager::OnJobComplete(CJobWorker *worker, bool success, CJob *job)
 {
-  CSingleLock lock(m_section);
-  // remove the job from the processing queue
-  Processing::iterator i = find(m_processing.begin(), m_processing.end(), job);
-  if (i != m_processing.end())
+  CWorkerPool &pool = m_pools[worker->m_pool];
+  CWorkerSlot &slot = pool.m_slots[worker->m_slot];
+
+  CSingleLock lock(slot.m_section);
+  if (slot.m_current.m_job != job)
+    return;
+
+  // tell any listeners we're done with the job, then delete it
+  CWorkItem item(slot.m_current);
+  lock.Leave();
+  if (item.m_callback)
+    item.m_callback->OnJobComplete(item.m_id, success, item.m_job);
+  lock.Enter();
+  slot.m_current = CWorkItem();
+  lock.Leave();
+  item.FreeJob();
+
+  long run = CTimeUtils::GetTimeMS() - item.m_started;
+  CSingleLock poolLock(pool.m_section);
+  pool.m_avgRunTime += run - pool.m_avgRunTime / 16;
+  pool.m_processing--;
+  pool.m_completed++;
+}
+
+void CJobManager::RemoveWorker(const CJobWorker *worker)
+{
+  CWorkerPool &pool = m_pools[worker->m_pool];
+  CSingleLock lock(pool.m_section);
+  // remove our worker - its queue stays behind for the others to steal from
+  CWorkerSlot &slot = pool.m_slots[worker->m_slot];
+  if (slot.m_worker == worker)
   {
-    // tell any listeners we're done with the job, then delete it
-    CWorkItem item(*i);
-    lock.Leave();
-    if (item.m_callback)
-      item.m_callback->OnJobComplete(item.m_id, success, item.m_job);
-    lock.Enter();
-    Processing::iterator j = find(m_processing.begin(), m_processing.end(), job);
-    if (j != m_processing.end())
-      m_processing.erase(j);
-    lock.Leave();
-    item.FreeJob();
+    slot.m_worker = NULL; // workers auto-delete
+    pool.m_workers--;
+    CSingleLock managerLock(m_section);
+    m_workers--;
   }
 }
 
-void CJobManager::RemoveWorker(const CJobWorker *worker)
+unsigned int CJobManager::GetMaxWorkers() const
 {
-  CSingleLock lock(m_section);
-  // remove our worker
-  Workers::iterator i = find(m_workers.begin(), m_workers.end(), worker);
-  if (i != m_workers.end())
-    m_workers.erase(i); // workers auto-delete
+  int max_workers = g_advancedSettings.m_jobManagerMaxWorkers;
+  if (max_workers <= 0)
+    max_workers = std::max(5, g_cpuInfo.getCPUCount());
+  return std::min(std::max(max_workers, 3), JOBMANAGER_MAX_WORKERS);
 }
 
 unsigned int CJobManager::GetMaxWorkers(CJob::PRIORITY priority) const
 {
-  static const unsigned int max_workers = 5;
-  return max_workers - (CJob::PRIORITY_HIGH - priority);
+  // keep the last workers for the higher priorities
+  return GetMaxWorkers() - (CJob::PRIORITY_HIGH - priority);
+}
+
+void CJobManager::GetStats(CJob::PRIORITY priority, CStats &stats) const
+{
+  const CWorkerPool &pool = m_pools[priority];
+  CSingleLock lock(pool.m_section);
+  stats.workers     = pool.m_workers;
+  stats.queued      = std::max((long)pool.m_queued, 0L);
+  stats.processing  = std::max((long)pool.m_processing, 0L);
+  stats.completed   = pool.m_completed;
+  stats.stolen      = pool.m_stolen;
+  stats.avgWaitTime = pool.m_avgWaitTime / 16;
+  stats.maxWaitTime = pool.m_maxWaitTime;
+  stats.avgRunTime  = pool.m_avgRunTime / 16;
+}
+
+void CJobManager::LogStats() const
+{
+  static const char *names[] = { "low", "normal", "high" };
+  for (unsigned int priority = CJob::PRIORITY_LOW; priority <= CJob::PRIORITY_HIGH; ++priority)
+  {
+    CStats stats;
+    GetStats(CJob::PRIORITY(priority), stats);
+    CLog::Log(LOGDEBUG, "%s - %s priority: %u workers, %u jobs completed (%u stolen), %u queued, wait avg %ums/max %ums, run avg %ums",
+              __FUNCTION__, names[priority], stats.workers, stats.completed, stats.stolen, stats.queued,
+              stats.avgWaitTime, stats.maxWaitTime, stats.avgRunTime);
+  }
 }
@@ -24,21 +24,14 @@
 #include <vector>
 #include <string>
 #include "CriticalSection.h"
+#include "Event.h"
 #include "Thread.h"
 #include "Job.h"
 
 class CJobManager;
+class CJobWorker;
 
-class CJobWorker : public CThread
-{
-public:
-  CJobWorker(CJobManager *manager);
-  virtual ~CJobWorker();
-
-  void Process();
-private:
-  CJobManager  *m_jobManager;
-};
+#define JOBMANAGER_MAX_WORKERS 32
 
 /*!
  \ingroup jobs
@@ -145,9 +138,20 @@ private:
  \brief Job Manager class for scheduling asynchronous jobs.
 
  Controls asynchronous job execution, by allowing clients to add and cancel jobs.
- Should be accessed via CJobManager::GetInstance().  Jobs are allocated based on
- priority levels.  Lower priority jobs are executed only if there are sufficient
- spare worker threads free to allow for higher priority jobs that may arise.
+ Should be accessed via CJobManager::GetInstance().
+
+ Each job priority has its own pool of worker threads, so that a flood of low priority
+ jobs (eg thumbnail extraction during a library scan) can never prevent a high priority
+ job from being started.  Within a pool, every worker has its own queue of jobs, and
+ new jobs are spread over these queues.  A worker processes its own queue first and
+ steals jobs from the other queues in the pool once it runs dry, so workers only contend
+ with each other when they are actually short of work.
+
+ The total number of workers may be set via the <jobmanager><maxworkers> tag in
+ advancedsettings.xml and defaults to the number of CPU cores (minimum 5).  As before the
+ pools were introduced, the last worker is reserved for high priority jobs, and the last
+ but one for normal or high priority jobs.  Should a pool be refused a worker while other
+ pools have idle ones, one of those is asked to exit to make way for it.
 
  \sa CJob and IJobCallback
  */
@@ -156,11 +160,21 @@ class CJobManager
   class CWorkItem
   {
   public:
+    CWorkItem()
+    {
+      m_job = NULL;
+      m_id = 0;
+      m_callback = NULL;
+      m_queued = 0;
+      m_started = 0;
+    }
     CWorkItem(CJob *job, unsigned int id, IJobCallback *callback)
     {
       m_job = job;
       m_id = id;
       m_callback = callback;
+      m_queued = 0;
+      m_started = 0;
     }
     bool operator==(unsigned int jobID) const
     {
@@ -182,9 +196,72 @@ class CJobManager
     CJob         *m_job;
     unsigned int  m_id;
     IJobCallback *m_callback;
+    unsigned int  m_queued;  ///< time (in ms) at which the job was queued
+    unsigned int  m_started; ///< time (in ms) at which processing of the job started
+  };
+
+  /*!
+   \brief A queue of jobs owned by (at most) one worker.
+   The queue outlives the worker attached to it, so jobs queued on it after
+   the worker has exited are simply stolen by the remaining workers.
+   */
+  class CWorkerSlot
+  {
+  public:
+    CWorkerSlot() { m_worker = NULL; };
+
+    typedef std::deque<CWorkItem> JobQueue;
+
+    CCriticalSection m_section; ///< guards m_queue and m_current
+    JobQueue         m_queue;
+    CWorkItem        m_current; ///< job currently processed by this slot's worker
+    CJobWorker      *m_worker;  ///< worker attached to this slot, guarded by the pool's section
+  };
+
+  /*!
+   \brief The set of workers processing jobs of a single priority.
+   */
+  class CWorkerPool
+  {
+  public:
+    CWorkerPool();
+
+    CWorkerSlot      m_slots[JOBMANAGER_MAX_WORKERS];
+    CCriticalSection m_section;  ///< guards worker creation and removal, and the counters below
+    CEvent           m_jobEvent; ///< set whenever a job is queued, to wake an idle worker
+    long             m_workers;  ///< number of running workers
+    long             m_idle;     ///< number of workers waiting for a job
+    volatile long    m_slotsUsed;///< number of slots that may contain jobs, only ever grows
+    unsigned long    m_nextSlot; ///< round robin counter for distributing new jobs
+
+    // statistics
+    long             m_queued;     ///< number of jobs waiting to be processed
+    long             m_processing; ///< number of jobs currently being processed
+    long             m_completed;  ///< number of jobs processed to date
+    long             m_stolen;     ///< number of jobs taken from another worker's queue
+    long             m_avgWaitTime;///< running average of the time (in 1/16 ms) jobs spent queued
+    long             m_maxWaitTime;///< maximum time (in ms) that a job spent queued
+    long             m_avgRunTime; ///< running average of the time (in 1/16 ms) taken to process a job
   };
 
 public:
+  /*!
+   \brief Snapshot of the statistics of a worker pool.
+   \sa GetStats()
+   */
+  class CStats
+  {
+  public:
+    unsigned int workers;     ///< number of running worker threads
+    unsigned int queued;      ///< number of jobs waiting to be processed
+    unsigned int processing;  ///< number of jobs currently being processed
+    unsigned int completed;   ///< number of jobs processed to date
+    unsigned int stolen;      ///< number of jobs stolen from another worker's queue
+    unsigned int avgWaitTime; ///< average time (in ms) a job spent queued before being processed
+    unsigned int maxWaitTime; ///< maximum time (in ms) a job spent queued before being processed
+    unsigned int avgRunTime;  ///< average time (in ms) taken to process a job
+  };
+
   /*!
    \brief The only way through which the global instance of the CJobManager should be accessed.
    \return the global instance.
@@ -215,6 +292,14 @@ public:
    */
   void CancelJobs();
 
+  /*!
+   \brief Retrieve queue depth and latency statistics for the given priority.
+   \param priority the priority of the worker pool to query.
+   \param stats [out] the current statistics of the pool.
+   \sa CStats
+   */
+  void GetStats(CJob::PRIORITY priority, CStats &stats) const;
+
 protected:
   friend class CJobWorker;
   friend class CJob;
@@ -224,16 +309,17 @@ protected:
    \param worker a pointer to the current CJobWorker instance requesting a job.
    \sa CJob
    */
-  CJob *GetNextJob(const CJobWorker *worker);
+  CJob *GetNextJob(CJobWorker *worker);
 
   /*!
    \brief Callback from CJobWorker after a job has completed.
    Calls IJobCallback::OnJobComplete(), and then destroys job.
-   \param job a pointer to the calling subclassed CJob instance.
+   \param worker a pointer to the CJobWorker instance that processed the job.
    \param success the result from the DoWork call
+   \param job a pointer to the calling subclassed CJob instance.
    \sa IJobCallback, CJob
    */
-  void  OnJobComplete(bool success, CJob *job);
+  void  OnJobComplete(CJobWorker *worker, bool success, CJob *job);
 
   /*!
    \brief Callback from CJob to report progress and check for cancellation.
@@ -253,26 +339,66 @@ private:
   CJobManager const& operator=(CJobManager const&);
   virtual ~CJobManager();
 
-  /*! \brief Pop a job off the job queue and add to the processing queue ready to process
+  /*! \brief Take a job off the worker's own queue, or steal one from another worker of the same pool.
+   \param worker the worker requesting a job.
    \return the job to process, NULL if no jobs are available
    */
-  CJob *PopJob();
+  CJob *PopJob(CJobWorker *worker);
+
+  /*! \brief Take the oldest job off a slot's queue and make it the current job of the worker's slot.
+   \return true if a job was taken.
+   */
+  bool TakeJob(CWorkerPool &pool, unsigned int from, unsigned int to);
+
+  /*! \brief Start a worker for the given pool, if it has no idle workers and we're allowed another.
+   Should we be at our limit, an idle worker of another pool is asked to exit to make way.
+   */
+  void StartWorker(CJob::PRIORITY priority);
+
+  /*! \brief Start workers for pools that have jobs waiting but no workers to process them.
+   Called once a worker has exited.
+   */
+  void StartWaitingWorkers();
+
+  /*! \brief Check whether an idle worker of the given pool should exit to make way for another pool.
+   */
+  bool ShouldRetire(CJob::PRIORITY priority);
 
-  void StartWorkers(CJob::PRIORITY priority);
   void RemoveWorker(const CJobWorker *worker);
-  unsigned int GetMaxWorkers(CJob::PRIORITY priority) const;
 
-  unsigned int m_jobCounter;
+  /*! \brief Retrieve the maximum total number of workers.
+   */
+  unsigned int GetMaxWorkers() const;
 
-  typedef std::deque<CWorkItem>    JobQueue;
-  typedef std::vector<CWorkItem>   Processing;
-  typedef std::vector<CJobWorker*> Workers;
+  /*! \brief Retrieve the number of workers (of all pools) beyond which the given pool may not start another.
+   */
+  unsigned int GetMaxWorkers(CJob::PRIORITY priority) const;
+  void LogStats() const;
 
-  JobQueue   m_jobQueue[CJob::PRIORITY_HIGH+1];
-  Processing m_processing;
-  Workers    m_workers;
+  CCriticalSection m_section;  ///< guards the counters below. Taken after a pool's section, never before.
+  unsigned int     m_jobCounter;
+  unsigned int     m_workers;  ///< number of running workers, over all pools
+  unsigned int     m_retire[CJob::PRIORITY_HIGH+1]; ///< number of idle workers per pool asked to exit
 
-  CCriticalSection m_section;
-  CEvent           m_jobEvent;
+  CWorkerPool      m_pools[CJob::PRIORITY_HIGH+1];
   bool             m_running;
 };
+
+/*!
+ \ingroup jobs
+ \brief Worker thread of the CJobManager, processing jobs of a single priority.
+ \sa CJobManager
+ */
+class CJobWorker : public CThread
+{
+public:
+  CJobWorker(CJobManager *manager, CJob::PRIORITY priority, unsigned int slot);
+  virtual ~CJobWorker();
+
+  void Process();
+private:
+  friend class CJobManager;
+  CJobManager   *m_jobManager;
+  CJob::PRIORITY m_pool; ///< priority of the pool this worker belongs to
+  unsigned int   m_slot; ///< index of this worker's queue within the pool
+};
@@ -25,10 +25,13 @@
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
-
+#include <algorithm>
 #include "MathUtils.h"
+
 #include "PCMRemap.h"
+#include "PCMRemapKernels.h"
 #include "utils/log.h"
+#include "utils/CPUInfo.h"
 #include "GUISettings.h"
 #ifdef _WIN32
 #include "../win32/PlatformDefs.h"
@@ -161,6 +164,36 @@ static struct PCMMapInfo PCMDownmixTable[PCM_MAX_CH][PCM_MAX_MIX] =
   }
 };
 
+/*
+  the simd mixing kernel for this cpu, NULL if there is none. without one the
+  per sample loop is used, as mixing planes in C is slower than that.
+*/
+struct CRemapKernels
+{
+  CRemapKernels()
+  {
+    Mix = NULL;
+
+    int features = g_cpuInfo.GetCPUFeatures();
+#if defined(HAS_PCM_MIX_SSE2)
+    if (features & CPU_FEATURE_SSE2)
+      Mix = PCMMix_SSE2;
+#endif
+#if defined(HAS_PCM_MIX_NEON)
+    if (features & CPU_FEATURE_NEON)
+      Mix = PCMMix_NEON;
+#endif
+  }
+
+  PCMMixFunc Mix;
+};
+
+static const CRemapKernels& GetRemapKernels()
+{
+  static CRemapKernels kernels;
+  return kernels;
+}
+
 CPCMRemap::CPCMRemap() :
   m_inSet       (false),
   m_outSet      (false),
@@ -407,6 +440,41 @@ void CPCMRemap::BuildMap()
     }
     CLog::Log(LOGDEBUG, "CPCMRemap: %s = %s\n", PCMChannelStr(m_outMap[out_ch]).c_str(), s.c_str());
   }
+
+  CompileMap();
+}
+
+/*
+  flattens the lookup map of the output channels into the tables used by Remap(),
+  keeping the inputs in map order so the mix is the same as walking the map.
+*/
+void CPCMRemap::CompileMap()
+{
+  memset(m_mixUsed, 0, sizeof(m_mixUsed));
+  for(unsigned int out_ch = 0; out_ch < m_outChannels; ++out_ch)
+  {
+    m_mixCount[out_ch] = 0;
+    m_mixCopy [out_ch] = -1;
+    if (m_outMap[out_ch] == PCM_INVALID)
+      continue;
+
+    struct PCMMapInfo *info = m_lookupMap[m_outMap[out_ch]];
+    if (info->channel != PCM_INVALID && info->copy)
+    {
+      m_mixCopy [out_ch] = info->in_offset / m_inSampleSize;
+      m_mixCount[out_ch] = 1;
+      continue;
+    }
+
+    for(; info->channel != PCM_INVALID; ++info)
+    {
+      int in_ch = info->in_offset / m_inSampleSize;
+      m_mixInput[out_ch][m_mixCount[out_ch]] = in_ch;
+      m_mixLevel[out_ch][m_mixCount[out_ch]] = info->level;
+      m_mixCount[out_ch]++;
+      m_mixUsed [in_ch] = true;
+    }
+  }
 }
 
 void CPCMRemap::DumpMap(CStdString info, unsigned int channels, enum PCMChannels *channelMap)
@@ -487,6 +555,64 @@ void CPCMRemap::SetOutputFormat(unsigned int channels, enum PCMChannels *channel
 
 /* remap the supplied data into out, which must be pre-allocated */
 void CPCMRemap::Remap(void *data, void *out, unsigned int samples)
+{
+  const int16_t *insample  = (const int16_t*)data;
+  int16_t       *outsample = (int16_t*)out;
+  const CRemapKernels &kernels = GetRemapKernels();
+
+  /*
+    the output may have channels the input does not have, so zero the data
+    to stop random data being sent to them.
+  */
+  memset(out, 0, samples * (m_inSampleSize * m_outChannels));
+  if (!kernels.Mix)
+  {
+    RemapSamples(data, out, samples);
+    return;
+  }
+
+  while (samples)
+  {
+    unsigned int frames = std::min(samples, (unsigned int)PCM_REMAP_BLOCK);
+    unsigned int i, ch;
+
+    /* split the mixed inputs into planes, so they can be mixed several frames at a time */
+    for(ch = 0; ch < m_inChannels; ++ch)
+    {
+      if (!m_mixUsed[ch]) continue;
+      const int16_t *src = insample + ch;
+      for(i = 0; i < frames; ++i, src += m_inChannels)
+        m_planes[ch][i] = (float)*src;
+    }
+
+    for(ch = 0; ch < m_outChannels; ++ch)
+    {
+      if (!m_mixCount[ch]) continue;
+
+      /* if it is a 1-1 map, we just copy the data to avoid rounding errors */
+      if (m_mixCopy[ch] >= 0)
+      {
+        const int16_t *src = insample + m_mixCopy[ch];
+        int16_t       *dst = outsample + ch;
+        for(i = 0; i < frames; ++i, src += m_inChannels, dst += m_outChannels)
+          *dst = *src;
+        continue;
+      }
+
+      const float *inputs[PCM_MAX_CH];
+      for(int j = 0; j < m_mixCount[ch]; ++j)
+        inputs[j] = m_planes[m_mixInput[ch][j]];
+      kernels.Mix(outsample + ch, m_outChannels, inputs, m_mixLevel[ch], m_mixCount[ch], frames);
+    }
+
+    insample  += frames * m_inChannels;
+    outsample += frames * m_outChannels;
+    samples   -= frames;
+  }
+}
+
+/* remap a sample at a time, for cpus without a simd mixing kernel */
+void CPCMRemap::RemapSamples(void *data, void *out, unsigned int samples)
 {
   unsigned int i, ch;
   uint8_t      *insample, *outsample;
@@ -495,11 +621,6 @@ void CPCMRemap::Remap(void *data, void *out, unsigned int samples)
   insample  = (uint8_t*)data;
   outsample = (uint8_t*)out;
 
-  /*
-    the output may have channels the input does not have, so zero the data
-    to stop random data being sent to them.
-  */
-  memset(out, 0, samples * (m_inSampleSize * m_outChannels));
   for(i = 0; i < samples; ++i)
   {
     for(ch = 0; ch < m_outChannels; ++ch)
@@ -27,6 +27,7 @@
 #include "guilib/StdString.h"
 
 #define PCM_MAX_CH 18
+#define PCM_REMAP_BLOCK 256 /* frames remapped at a time */
 enum PCMChannels
 {
   PCM_INVALID = -1,
@@ -104,9 +105,19 @@ protected:
   struct PCMMapInfo  m_lookupMap[PCM_MAX_CH + 1][PCM_MAX_CH + 1];
   int                m_counts[PCM_MAX_CH];
 
+  /* the map compiled into flat tables for Remap(), per output channel */
+  int                m_mixCount[PCM_MAX_CH];             /* number of inputs mixed into the channel */
+  int                m_mixCopy [PCM_MAX_CH];             /* input copied to the channel as is, -1 if it is mixed */
+  int                m_mixInput[PCM_MAX_CH][PCM_MAX_CH]; /* inputs mixed into the channel, in map order */
+  float              m_mixLevel[PCM_MAX_CH][PCM_MAX_CH]; /* levels of the inputs mixed into the channel */
+  bool               m_mixUsed [PCM_MAX_CH];             /* whether the input is mixed into any channel */
+  float              m_planes  [PCM_MAX_CH][PCM_REMAP_BLOCK]; /* the mixed inputs of the frames being remapped */
+
   struct PCMMapInfo* ResolveChannel(enum PCMChannels channel, float level, bool ifExists, std::vector<enum PCMChannels> path, struct PCMMapInfo *tablePtr);
   void               ResolveChannels(); //!< Partial BuildMap(), just enough to see which output channels are active
   void               BuildMap();
+  void               CompileMap();
+  void               RemapSamples(void *data, void *out, unsigned int samples);
   void               DumpMap(CStdString info, int unsigned channels, enum PCMChannels *channelMap);
   void               Dispose();
   CStdString         PCMChannelStr(enum PCMChannels ename);
@@ -0,0 +1,122 @@
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "PCMRemapKernels.h"
+#include "PCMRemap.h"
+#include "MathUtils.h"
+
+#if defined(HAS_PCM_MIX_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(HAS_PCM_MIX_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+  round_int() is floor(value + 0.5) computed exactly, which value + 0.5f in single
+  precision is not: 0.49999997f + 0.5f rounds up to 1.0f. the simd kernels instead
+  truncate, take the (exact) fraction that was dropped, and adjust by one when it
+  is at least a half above, or more than a half below, zero.
+*/
+
+void PCMMix_C(int16_t *out, int stride, const float * const *inputs, const float *levels, int count, int frames)
+{
+  for (int f = 0; f < frames; ++f)
+  {
+    float value = 0;
+    for (int i = 0; i < count; ++i)
+      value += inputs[i][f] * levels[i];
+
+    //convert to signed int and clamp to 16 bit
+    int outvalue = MathUtils::round_int(value);
+    if (outvalue > INT16_MAX)
+      outvalue = INT16_MAX;
+    else if (outvalue < INT16_MIN)
+      outvalue = INT16_MIN;
+
+    out[f * stride] = outvalue;
+  }
+}
+
+#if defined(HAS_PCM_MIX_SSE2)
+void PCMMix_SSE2(int16_t *out, int stride, const float * const *inputs, const float *levels, int count, int frames)
+{
+  const __m128 half    = _mm_set1_ps( 0.5f);
+  const __m128 neghalf = _mm_set1_ps(-0.5f);
+  int f = 0;
+  for (; f + 4 <= frames; f += 4)
+  {
+    /* same order of operations as PCMMix_C, so that the result is identical */
+    __m128 value = _mm_setzero_ps();
+    for (int i = 0; i < count; ++i)
+      value = _mm_add_ps(value, _mm_mul_ps(_mm_loadu_ps(inputs[i] + f), _mm_set1_ps(levels[i])));
+
+    /* the comparison masks are -1 where true, and packing saturates to 16 bit */
+    __m128i rounded = _mm_cvttps_epi32(value);
+    __m128  frac    = _mm_sub_ps(value, _mm_cvtepi32_ps(rounded));
+    rounded = _mm_sub_epi32(rounded, _mm_castps_si128(_mm_cmpge_ps(frac, half)));
+    rounded = _mm_add_epi32(rounded, _mm_castps_si128(_mm_cmplt_ps(frac, neghalf)));
+    __m128i packed = _mm_packs_epi32(rounded, rounded);
+
+    out[(f    ) * stride] = _mm_extract_epi16(packed, 0);
+    out[(f + 1) * stride] = _mm_extract_epi16(packed, 1);
+    out[(f + 2) * stride] = _mm_extract_epi16(packed, 2);
+    out[(f + 3) * stride] = _mm_extract_epi16(packed, 3);
+  }
+
+  const float *tail[PCM_MAX_CH];
+  for (int i = 0; i < count; ++i)
+    tail[i] = inputs[i] + f;
+  PCMMix_C(out + f * stride, stride, tail, levels, count, frames - f);
+}
+#endif
+
+#if defined(HAS_PCM_MIX_NEON)
+void PCMMix_NEON(int16_t *out, int stride, const float * const *inputs, const float *levels, int count, int frames)
+{
+  const float32x4_t half    = vdupq_n_f32( 0.5f);
+  const float32x4_t neghalf = vdupq_n_f32(-0.5f);
+  int f = 0;
+  for (; f + 4 <= frames; f += 4)
+  {
+    /* separate multiplies and adds (rather than vmla) to match PCMMix_C */
+    float32x4_t value = vdupq_n_f32(0.0f);
+    for (int i = 0; i < count; ++i)
+      value = vaddq_f32(value, vmulq_f32(vld1q_f32(inputs[i] + f), vdupq_n_f32(levels[i])));
+
+    int32x4_t   rounded = vcvtq_s32_f32(value);
+    float32x4_t frac    = vsubq_f32(value, vcvtq_f32_s32(rounded));
+    rounded = vsubq_s32(rounded, vreinterpretq_s32_u32(vcgeq_f32(frac, half)));
+    rounded = vaddq_s32(rounded, vreinterpretq_s32_u32(vcltq_f32(frac, neghalf)));
+    int16x4_t packed = vqmovn_s32(rounded);
+
+    vst1_lane_s16(out + (f    ) * stride, packed, 0);
+    vst1_lane_s16(out + (f + 1) * stride, packed, 1);
+    vst1_lane_s16(out + (f + 2) * stride, packed, 2);
+    vst1_lane_s16(out + (f + 3) * stride, packed, 3);
+  }
+
+  const float *tail[PCM_MAX_CH];
+  for (int i = 0; i < count; ++i)
+    tail[i] = inputs[i] + f;
+  PCMMix_C(out + f * stride, stride, tail, levels, count, frames - f);
+}
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2010 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include <stdint.h>
+
+/*
+  simd kernels are only used where the scalar mix rounds to float after each
+  operation as they do, ie. not where the compiler does float maths on the x87,
+  whose extended precision sums would give different results.
+*/
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2_MATH__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define HAS_PCM_MIX_SSE2
+#elif defined(__ARM_NEON__)
+  #define HAS_PCM_MIX_NEON
+#endif
+
+/*
+  mixes count input planes, each scaled by its level, into every stride'th sample
+  of out. the inputs are summed in order, then rounded with MathUtils::round_int()
+  and clamped to 16 bit, as CPCMRemap has always done. the simd versions give the
+  same output as PCMMix_C, which they use for the frames left over, and are
+  selected at runtime from the cpu features. CPCMRemap doesn't use PCMMix_C on
+  its own, as its per sample loop is faster.
+*/
+typedef void (*PCMMixFunc)(int16_t *out, int stride, const float * const *inputs, const float *levels, int count, int frames);
+
+void PCMMix_C   (int16_t *out, int stride, const float * const *inputs, const float *levels, int count, int frames);
+#if defined(HAS_PCM_MIX_SSE2)
+void PCMMix_SSE2(int16_t *out, int stride, const float * const *inputs, const float *levels, int count, int frames);
+#endif
+#if defined(HAS_PCM_MIX_NEON)
+void PCMMix_NEON(int16_t *out, int stride, const float * const *inputs, const float *levels, int count, int frames);
+#endif
@@ -544,8 +544,25 @@ DWORD CThread::WaitForSingleObject(HANDLE hHandle, unsigned int milliseconds)
 
 DWORD CThread::WaitForMultipleObjects(DWORD nCount, HANDLE *lpHandles, BOOL bWaitAll, unsigned int milliseconds)
 {
-  // for now not implemented
-  return ::WaitForMultipleObjects(nCount, lpHandles, bWaitAll, milliseconds);
+  // like WaitForSingleObject, waits for any one of the handles also listen to the end thread event
+  if(!bWaitAll && nCount < 8 && milliseconds > 10 && IsCurrentThread())
+  {
+    HANDLE handles[8];
+    for(DWORD i = 0; i < nCount; i++)
+      handles[i] = lpHandles[i];
+    handles[nCount] = m_StopEvent;
+    DWORD result = ::WaitForMultipleObjects(nCount + 1, handles, false, milliseconds);
+
+    if(result == WAIT_TIMEOUT || result < WAIT_OBJECT_0 + nCount)
+      return result;
+
+    if( milliseconds == INFINITE )
+      return WAIT_ABANDONED;
+    else
+      return WAIT_TIMEOUT;
+  }
+  else
+    return ::WaitForMultipleObjects(nCount, lpHandles, bWaitAll, milliseconds);
 }
 
 void CThread::Sleep(unsigned int milliseconds)
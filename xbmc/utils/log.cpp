@@ -31,11 +31,10 @@
 #include "Settings.h"
 #include "AdvancedSettings.h"
 #include "Thread.h"
+#include "Atomics.h"
 
 FILE*       CLog::m_file            = NULL;
-int         CLog::m_repeatCount     = 0;
-int         CLog::m_repeatLogLevel  = -1;
-CStdString* CLog::m_repeatLine      = NULL;
+CLogWriter* CLog::m_writer          = NULL;
 
 static CCriticalSection critSec;
 
@@ -48,73 +47,201 @@ static char levelNames[][8] =
 #define LINE_ENDING "\n"
 #endif
 
+// size of the buffer lines are formatted into, longer lines are formatted on the heap
+#define LOG_LINE_SIZE       2048
+// number of lines that may be queued before lines below LOGWARNING are dropped
+#define LOG_QUEUE_MAX_LINES 10000
+// time (in ms) the writer waits before writing out queued lines
+#define LOG_WRITE_INTERVAL  100
 
-CLog::CLog()
-{}
+/*! \brief A line waiting to be written to the log, allocated to fit its text
+ */
+struct SLogLine
+{
+  SLogLine *next;
+  int      level;
+  time_t   time;
+  uint64_t threadId;
+  char     text[1];
+};
+
+// the queue is lock free where pointers fit the longs of cas().  Elsewhere (arm, which has no atomics
+// yet, and LLP64 platforms) it and its counts are protected by a lock.
+#if defined(HAS_ATOMICS) && !defined(_WIN64)
+#define LOG_QUEUE_LOCK_FREE
+#endif
 
-CLog::~CLog()
-{}
+static SLogLine* volatile logQueue = NULL; ///< queued lines, most recent first
+static long     logQueuedLines = 0;         ///< lines in logQueue
+static long     logDroppedLines = 0;        ///< lines dropped since the last line written
+#if !defined(LOG_QUEUE_LOCK_FREE)
+static CCriticalSection logQueueSection;
+#endif
 
-void CLog::Close()
+/*! \brief Count a line about to be queued, unless the queue is full
+ \return true if the line should be queued, false if it was dropped.
+ */
+static bool ReserveLine(int loglevel)
 {
-  CSingleLock waitLock(critSec);
-  if (m_file)
+  // keep the queue bounded should the writer fall behind, but never lose warnings or errors
+#if defined(LOG_QUEUE_LOCK_FREE)
+  if (AtomicIncrement(&logQueuedLines) > LOG_QUEUE_MAX_LINES && loglevel < LOGWARNING)
   {
-    fclose(m_file);
-    m_file = NULL;
+    AtomicDecrement(&logQueuedLines);
+    AtomicIncrement(&logDroppedLines);
+    return false;
+  }
+#else
+  CSingleLock lock(logQueueSection);
+  if (logQueuedLines >= LOG_QUEUE_MAX_LINES && loglevel < LOGWARNING)
+  {
+    logDroppedLines++;
+    return false;
   }
-  delete m_repeatLine;
-  m_repeatLine = NULL;
+  logQueuedLines++;
+#endif
+  return true;
 }
 
+/*! \brief Queue a line for the writer
+ Lines are pushed onto a list that the writer takes as a whole, so neither side ever waits on the other.
+ */
+static void QueueLine(SLogLine *line)
+{
+#if defined(LOG_QUEUE_LOCK_FREE)
+  SLogLine *head;
+  do
+  {
+    head = logQueue;
+    line->next = head;
+  } while (cas((volatile long *)&logQueue, (long)head, (long)line) != (long)head);
+#else
+  CSingleLock lock(logQueueSection);
+  line->next = logQueue;
+  logQueue = line;
+#endif
+}
 
-void CLog::Log(int loglevel, const char *format, ... )
+/*! \brief Take all the queued lines
+ \param dropped [out] the number of lines dropped since the last time the lines were taken
+ \return the queued lines in the order they were logged, NULL if there are none.
+ */
+static SLogLine *TakeQueuedLines(long &dropped)
 {
-  if (g_advancedSettings.m_logLevel > LOG_LEVEL_NORMAL ||
-     (g_advancedSettings.m_logLevel > LOG_LEVEL_NONE && loglevel >= LOGNOTICE))
+  SLogLine *head;
+#if defined(LOG_QUEUE_LOCK_FREE)
+  do
   {
-    CSingleLock waitLock(critSec);
-    if (!m_file)
-      return;
+    head = logQueue;
+  } while (head && cas((volatile long *)&logQueue, (long)head, 0) != (long)head);
+#else
+  CSingleLock lock(logQueueSection);
+  head = logQueue;
+  logQueue = NULL;
+#endif
+
+  long count = 0;
+  SLogLine *lines = NULL;
+  while (head)
+  {
+    SLogLine *next = head->next;
+    head->next = lines;
+    lines = head;
+    head = next;
+    count++;
+  }
+
+#if defined(LOG_QUEUE_LOCK_FREE)
+  AtomicSubtract(&logQueuedLines, count);
+  dropped = logDroppedLines;
+  if (dropped)
+    AtomicSubtract(&logDroppedLines, dropped);
+#else
+  logQueuedLines -= count;
+  dropped = logDroppedLines;
+  logDroppedLines = 0;
+#endif
+  return lines;
+}
+
+/*! \brief Background thread writing out the lines queued by CLog::Log()
+ */
+class CLogWriter : public CThread
+{
+public:
+  CLogWriter()
+  {
+    m_repeatCount = 0;
+    m_repeatLogLevel = -1;
+    m_lastTime = 0;
+    m_freeMemory = 0;
+    memset(&m_localTime, 0, sizeof(m_localTime));
+  }
 
-    SYSTEMTIME time;
-    GetLocalTime(&time);
+  /*! \brief Write out the queued lines
+   Called from the writer thread, from threads logging an error, and from CLog::Close() once the
+   writer thread has stopped.
+   */
+  void WriteQueued()
+  {
+    CSingleLock lock(m_section);
+    long dropped;
+    SLogLine *line = TakeQueuedLines(dropped);
+    if (!line)
+      return;
 
+    // free memory is only sampled once per batch of lines, as retrieving it isn't cheap
     MEMORYSTATUS stat;
     GlobalMemoryStatus(&stat);
+    m_freeMemory = (uint64_t)stat.dwAvailPhys;
 
-    CStdString strPrefix, strData;
-
-    strPrefix.Format("%02.2d:%02.2d:%02.2d T:%"PRIu64" M:%9"PRIu64" %7s: ", time.wHour, time.wMinute, time.wSecond, (uint64_t)CThread::GetCurrentThreadId(), (uint64_t)stat.dwAvailPhys, levelNames[loglevel]);
+    if (dropped)
+    {
+      CStdString text;
+      text.Format("Logging fell behind, %ld lines were dropped.", dropped);
+      WriteLine(LOGWARNING, line->time, line->threadId, text);
+    }
+    while (line)
+    {
+      Write(line);
+      SLogLine *next = line->next;
+      free(line);
+      line = next;
+    }
+    if (CLog::m_file)
+      fflush(CLog::m_file);
+  }
 
-    strData.reserve(16384);
-    va_list va;
-    va_start(va, format);
-    strData.FormatV(format,va);
-    va_end(va);
+protected:
+  virtual void Process()
+  {
+    while (!m_bStop)
+    {
+      Sleep(LOG_WRITE_INTERVAL);
+      WriteQueued();
+    }
+  }
 
-    if (m_repeatLogLevel == loglevel && *m_repeatLine == strData)
+private:
+  void Write(const SLogLine *line)
+  {
+    if (m_repeatLogLevel == line->level && m_repeatLine == line->text)
     {
       m_repeatCount++;
       return;
     }
     else if (m_repeatCount)
     {
-      CStdString strPrefix2, strData2;
-      strPrefix2.Format("%02.2d:%02.2d:%02.2d T:%"PRIu64" M:%9"PRIu64" %7s: ", time.wHour, time.wMinute, time.wSecond, (uint64_t)CThread::GetCurrentThreadId(), (uint64_t)stat.dwAvailPhys, levelNames[m_repeatLogLevel]);
-
-      strData2.Format("Previous line repeats %d times." LINE_ENDING, m_repeatCount);
-      fwrite(strPrefix2.c_str(),strPrefix2.size(),1,m_file);
-      fwrite(strData2.c_str(),strData2.size(),1,m_file);
-#if !defined(_LINUX) && (defined(_DEBUG) || defined(PROFILE))
-      OutputDebugString(strData2.c_str());
-#endif
+      CStdString text;
+      text.Format("Previous line repeats %d times.", m_repeatCount);
+      WriteLine(m_repeatLogLevel, line->time, line->threadId, text);
       m_repeatCount = 0;
     }
-    
-    *m_repeatLine     = strData;
-    m_repeatLogLevel  = loglevel;
 
+    m_repeatLine     = line->text;
+    m_repeatLogLevel = line->level;
+
+    CStdString strData(line->text);
     unsigned int length = 0;
     while ( length != strData.length() )
     {
@@ -127,6 +254,23 @@ void CLog::Log(int loglevel, const char *format, ... )
     if (!length)
       return;
 
+    WriteLine(line->level, line->time, line->threadId, strData);
+  }
+
+  void WriteLine(int level, time_t time, uint64_t threadId, CStdString &strData)
+  {
+    if (!CLog::m_file)
+      return;
+
+    if (time != m_lastTime)
+    {
+      m_localTime = *localtime(&time);
+      m_lastTime = time;
+    }
+
+    CStdString strPrefix;
+    strPrefix.Format("%02.2d:%02.2d:%02.2d T:%"PRIu64" M:%9"PRIu64" %7s: ", m_localTime.tm_hour, m_localTime.tm_min, m_localTime.tm_sec, threadId, m_freeMemory, levelNames[level]);
+
 #if !defined(_LINUX) && (defined(_DEBUG) || defined(PROFILE))
     OutputDebugString(strData.c_str());
     OutputDebugString("\n");
@@ -136,9 +280,87 @@ void CLog::Log(int loglevel, const char *format, ... )
     strData.Replace("\n", LINE_ENDING"                                            ");
     strData += LINE_ENDING;
 
-    fwrite(strPrefix.c_str(),strPrefix.size(),1,m_file);
-    fwrite(strData.c_str(),strData.size(),1,m_file);
-    fflush(m_file);
+    fwrite(strPrefix.c_str(),strPrefix.size(),1,CLog::m_file);
+    fwrite(strData.c_str(),strData.size(),1,CLog::m_file);
+  }
+
+  CCriticalSection m_section; ///< serializes the writer thread and threads logging errors
+  int        m_repeatCount;
+  int        m_repeatLogLevel;
+  CStdString m_repeatLine;
+  uint64_t   m_freeMemory;
+  time_t     m_lastTime;
+  struct tm  m_localTime;
+};
+
+CLog::CLog()
+{}
+
+CLog::~CLog()
+{}
+
+void CLog::Close()
+{
+  CSingleLock waitLock(critSec);
+  if (m_writer)
+  {
+    m_writer->StopThread();
+    m_writer->WriteQueued();
+    delete m_writer;
+    m_writer = NULL;
+  }
+  if (m_file)
+  {
+    fclose(m_file);
+    m_file = NULL;
+  }
+}
+
+
+void CLog::Log(int loglevel, const char *format, ... )
+{
+  if (g_advancedSettings.m_logLevel > LOG_LEVEL_NORMAL ||
+     (g_advancedSettings.m_logLevel > LOG_LEVEL_NONE && loglevel >= LOGNOTICE))
+  {
+    if (!m_file)
+      return;
+
+    if (!ReserveLine(loglevel))
+      return;
+
+    char buffer[LOG_LINE_SIZE];
+    va_list va;
+    va_start(va, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, va);
+    va_end(va);
+
+    SLogLine *line;
+    if (length >= 0 && length < (int)sizeof(buffer))
+    {
+      line = (SLogLine *)malloc(sizeof(SLogLine) + length);
+      memcpy(line->text, buffer, length + 1);
+    }
+    else
+    { // too long for the buffer (or truncated, as some vsnprintf()'s don't tell us the length)
+      CStdString strData;
+      va_start(va, format);
+      strData.FormatV(format, va);
+      va_end(va);
+      line = (SLogLine *)malloc(sizeof(SLogLine) + strData.size());
+      memcpy(line->text, strData.c_str(), strData.size() + 1);
+    }
+    line->level = loglevel;
+    line->time = time(NULL);
+    line->threadId = (uint64_t)CThread::GetCurrentThreadId();
+    QueueLine(line);
+
+    // write errors out before returning, in case we're about to crash
+    if (loglevel >= LOGERROR)
+    {
+      CSingleLock waitLock(critSec);
+      if (m_writer)
+        m_writer->WriteQueued();
+    }
   }
 #ifndef _LINUX
 #if defined(_DEBUG) || defined(PROFILE)
@@ -211,8 +433,11 @@ bool CLog::Init(const char* path)
     fwrite(BOM, sizeof(BOM), 1, m_file);
   }
 
-  if (!m_repeatLine)
-    m_repeatLine = new CStdString;
+  if (m_file && !m_writer)
+  {
+    m_writer = new CLogWriter;
+    m_writer->Create();
+  }
 
   return m_file != NULL;
 }
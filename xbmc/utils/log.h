@@ -47,12 +47,17 @@
 #define ATTRIB_LOG_FORMAT
 #endif
 
+class CLogWriter;
+
+/*! \brief The log file
+ Lines are formatted on the thread that logs them and queued, while a background thread timestamps
+ and writes them out, so that logging doesn't hold up time critical threads (eg the players).
+ */
 class CLog
 {
+  friend class CLogWriter;
   static FILE*       m_file;
-  static int         m_repeatCount;
-  static int         m_repeatLogLevel;
-  static CStdString* m_repeatLine;
+  static CLogWriter* m_writer;
 public:
   CLog();
   virtual ~CLog(void);